@@ -32,6 +32,7 @@
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #pragma once
+#include "musicstream.h"
 #include "wwstd.h"
 
 /*=========================================================================*/
@@ -120,6 +121,9 @@ typedef enum
 /* The following prototypes are for the file: SOUNDIO.CPP						*/
 /*=========================================================================*/
 int File_Stream_Sample_Vol(char const* filename, int volume, bool real_time_start = false);
+bool File_Stream_Prefetch(char const* filename, bool follow_on = false);
+bool File_Stream_Handed_Off(int handle);
+void File_Stream_Get_Stats(MusicStreamStatsType& stats);
 void Sound_Callback(void);
 void* Load_Sample(char const* filename);
 void Free_Sample(void const* sample);
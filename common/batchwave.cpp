@@ -0,0 +1,77 @@
+#include "batchwave.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+void Run_In_Waves(std::vector<int> const& groups,
+                  int threads,
+                  const std::function<void(int index, const std::function<void()>& ready)>& job)
+{
+    threads = std::max(threads, 1);
+
+    /*
+    ** Keep the jobs of a group together, in the order the groups and their jobs were given.
+    */
+    std::vector<int> order;
+    std::vector<bool> taken(groups.size(), false);
+    for (size_t first = 0; first < groups.size(); ++first) {
+        if (taken[first]) {
+            continue;
+        }
+        for (size_t index = first; index < groups.size(); ++index) {
+            if (!taken[index] && groups[index] == groups[first]) {
+                taken[index] = true;
+                order.push_back(int(index));
+            }
+        }
+    }
+
+    size_t start = 0;
+    while (start < order.size()) {
+        size_t end = start + 1;
+        while (end < order.size() && end - start < size_t(threads) && groups[order[end]] == groups[order[start]]) {
+            ++end;
+        }
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        size_t loaded = 0;
+        size_t count = end - start;
+
+        auto ready = [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (++loaded == count) {
+                cond.notify_all();
+            } else {
+                cond.wait(lock, [&]() { return loaded == count; });
+            }
+        };
+
+        std::vector<std::thread> wave;
+        for (size_t index = start; index < end; ++index) {
+            wave.emplace_back([&, index]() {
+                bool waited = false;
+                std::function<void()> once = [&]() {
+                    if (!waited) {
+                        waited = true;
+                        ready();
+                    }
+                };
+                job(order[index], once);
+
+                /*
+                ** A job that gave up before it was ready still has to count, or the rest of
+                ** the wave would wait for it forever.
+                */
+                once();
+            });
+        }
+
+        for (std::thread& thread : wave) {
+            thread.join();
+        }
+        start = end;
+    }
+}
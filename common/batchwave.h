@@ -0,0 +1,23 @@
+#ifndef BATCHWAVE_H
+#define BATCHWAVE_H
+
+#include <functional>
+#include <vector>
+
+/**
+ * Runs a list of jobs that load shared data before they start working, such as matches that
+ * read the rules into the type classes every instance shares. Jobs in the same group load the
+ * same data and may run side by side, jobs in different groups never do.
+ *
+ * The jobs are run in waves of up to threads jobs from one group. Every job of a wave loads,
+ * then calls ready, which returns once all of the wave have loaded. A wave only starts when the
+ * one before it has finished, so no load ever happens while another job is past its ready call.
+ *
+ * groups holds the group of each job, job(index, ready) is called once for every index on a
+ * thread of its own. Jobs are taken a group at a time in the order each group first appears.
+ */
+void Run_In_Waves(std::vector<int> const& groups,
+                  int threads,
+                  const std::function<void(int index, const std::function<void()>& ready)>& job);
+
+#endif /* BATCHWAVE_H */
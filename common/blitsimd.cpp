@@ -0,0 +1,467 @@
+#include "blitsimd.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BLIT_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/*
+** The kernels are compiled for their instruction set regardless of the flags the rest of the
+** build uses, the CPU is checked before any of them are handed out.
+*/
+#if defined(BLIT_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_SSE2  __attribute__((target("sse2")))
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+
+/*
+** Scalar kernels, also used for the tail of each line by the vector versions.
+*/
+static void Trans_Scalar(int width, unsigned char* dst, const unsigned char* src)
+{
+    for (int i = 0; i < width; ++i) {
+        if (src[i] != 0) {
+            dst[i] = src[i];
+        }
+    }
+}
+
+static void Lut_Scalar(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut)
+{
+    for (int i = 0; i < width; ++i) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+static void Lut_Trans_Scalar(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut)
+{
+    for (int i = 0; i < width; ++i) {
+        if (src[i] != 0) {
+            dst[i] = lut[src[i]];
+        }
+    }
+}
+
+static void Ghost_Scalar(int width,
+                         unsigned char* dst,
+                         const unsigned char* src,
+                         const unsigned char* lookup,
+                         const unsigned char* tab)
+{
+    for (int i = 0; i < width; ++i) {
+        unsigned char sbyte = src[i];
+        unsigned char fade = lookup[sbyte];
+
+        if (fade != 0xFF) {
+            sbyte = tab[dst[i] + fade * 256];
+        }
+
+        dst[i] = sbyte;
+    }
+}
+
+static void Ghost_Trans_Scalar(int width,
+                               unsigned char* dst,
+                               const unsigned char* src,
+                               const unsigned char* lookup,
+                               const unsigned char* tab)
+{
+    for (int i = 0; i < width; ++i) {
+        unsigned char sbyte = src[i];
+
+        if (sbyte != 0) {
+            unsigned char fade = lookup[sbyte];
+
+            if (fade != 0xFF) {
+                sbyte = tab[dst[i] + fade * 256];
+            }
+
+            dst[i] = sbyte;
+        }
+    }
+}
+
+#ifdef BLIT_X86
+
+/*
+** SSE2 has no byte shuffle so table lookups are still done a byte at a time, the vector unit
+** only handles the transparency masking and the check for blocks without any ghost pixels.
+*/
+TARGET_SSE2 static void Trans_SSE2(int width, unsigned char* dst, const unsigned char* src)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        __m128i d = _mm_loadu_si128((const __m128i*)dst);
+        __m128i m = _mm_cmpeq_epi8(s, zero);
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(m, d), _mm_andnot_si128(m, s)));
+    }
+
+    Trans_Scalar(width, dst, src);
+}
+
+TARGET_SSE2 static void
+Lut_Trans_SSE2(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut)
+{
+    const __m128i zero = _mm_setzero_si128();
+    alignas(16) unsigned char mapped[16];
+
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        for (int i = 0; i < 16; ++i) {
+            mapped[i] = lut[src[i]];
+        }
+
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        __m128i d = _mm_loadu_si128((const __m128i*)dst);
+        __m128i l = _mm_load_si128((const __m128i*)mapped);
+        __m128i m = _mm_cmpeq_epi8(s, zero);
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(m, d), _mm_andnot_si128(m, l)));
+    }
+
+    Lut_Trans_Scalar(width, dst, src, lut);
+}
+
+TARGET_SSE2 static void Ghost_SSE2(int width,
+                                   unsigned char* dst,
+                                   const unsigned char* src,
+                                   const unsigned char* lookup,
+                                   const unsigned char* tab)
+{
+    const __m128i none = _mm_set1_epi8((char)0xFF);
+    alignas(16) unsigned char fades[16];
+
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        for (int i = 0; i < 16; ++i) {
+            fades[i] = lookup[src[i]];
+        }
+
+        __m128i f = _mm_load_si128((const __m128i*)fades);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(f, none)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)src));
+        } else {
+            Ghost_Scalar(16, dst, src, lookup, tab);
+        }
+    }
+
+    Ghost_Scalar(width, dst, src, lookup, tab);
+}
+
+TARGET_SSE2 static void Ghost_Trans_SSE2(int width,
+                                         unsigned char* dst,
+                                         const unsigned char* src,
+                                         const unsigned char* lookup,
+                                         const unsigned char* tab)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i none = _mm_set1_epi8((char)0xFF);
+    alignas(16) unsigned char fades[16];
+
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        for (int i = 0; i < 16; ++i) {
+            fades[i] = lookup[src[i]];
+        }
+
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        __m128i f = _mm_load_si128((const __m128i*)fades);
+        __m128i m = _mm_cmpeq_epi8(s, zero);
+
+        /*
+        ** Transparent pixels never read the ghost table so they count as plain.
+        */
+        if (_mm_movemask_epi8(_mm_or_si128(m, _mm_cmpeq_epi8(f, none))) == 0xFFFF) {
+            __m128i d = _mm_loadu_si128((const __m128i*)dst);
+            _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(m, d), _mm_andnot_si128(m, s)));
+        } else {
+            Ghost_Trans_Scalar(16, dst, src, lookup, tab);
+        }
+    }
+
+    Ghost_Trans_Scalar(width, dst, src, lookup, tab);
+}
+
+/*
+** 256 entry table lookup with PSHUFB, one 16 entry shuffle per high nibble.
+*/
+TARGET_SSSE3 static inline __m128i Lookup_SSSE3(__m128i s, const unsigned char* lut)
+{
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i lo = _mm_and_si128(s, nibble);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(s, 4), nibble);
+    __m128i result = _mm_setzero_si128();
+
+    for (int h = 0; h < 16; ++h) {
+        __m128i table = _mm_loadu_si128((const __m128i*)(lut + h * 16));
+        __m128i m = _mm_cmpeq_epi8(hi, _mm_set1_epi8((char)h));
+        result = _mm_or_si128(result, _mm_and_si128(m, _mm_shuffle_epi8(table, lo)));
+    }
+
+    return result;
+}
+
+TARGET_SSSE3 static void
+Lut_SSSE3(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut)
+{
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        _mm_storeu_si128((__m128i*)dst, Lookup_SSSE3(s, lut));
+    }
+
+    Lut_Scalar(width, dst, src, lut);
+}
+
+TARGET_SSSE3 static void
+Lut_Trans_SSSE3(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        __m128i d = _mm_loadu_si128((const __m128i*)dst);
+        __m128i l = Lookup_SSSE3(s, lut);
+        __m128i m = _mm_cmpeq_epi8(s, zero);
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(m, d), _mm_andnot_si128(m, l)));
+    }
+
+    Lut_Trans_Scalar(width, dst, src, lut);
+}
+
+TARGET_SSSE3 static void Ghost_SSSE3(int width,
+                                     unsigned char* dst,
+                                     const unsigned char* src,
+                                     const unsigned char* lookup,
+                                     const unsigned char* tab)
+{
+    const __m128i none = _mm_set1_epi8((char)0xFF);
+
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        __m128i f = Lookup_SSSE3(s, lookup);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(f, none)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)dst, s);
+        } else {
+            Ghost_Scalar(16, dst, src, lookup, tab);
+        }
+    }
+
+    Ghost_Scalar(width, dst, src, lookup, tab);
+}
+
+TARGET_SSSE3 static void Ghost_Trans_SSSE3(int width,
+                                           unsigned char* dst,
+                                           const unsigned char* src,
+                                           const unsigned char* lookup,
+                                           const unsigned char* tab)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i none = _mm_set1_epi8((char)0xFF);
+
+    for (; width >= 16; width -= 16, src += 16, dst += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)src);
+        __m128i f = Lookup_SSSE3(s, lookup);
+        __m128i m = _mm_cmpeq_epi8(s, zero);
+
+        if (_mm_movemask_epi8(_mm_or_si128(m, _mm_cmpeq_epi8(f, none))) == 0xFFFF) {
+            __m128i d = _mm_loadu_si128((const __m128i*)dst);
+            _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(m, d), _mm_andnot_si128(m, s)));
+        } else {
+            Ghost_Trans_Scalar(16, dst, src, lookup, tab);
+        }
+    }
+
+    Ghost_Trans_Scalar(width, dst, src, lookup, tab);
+}
+
+TARGET_AVX2 static void Trans_AVX2(int width, unsigned char* dst, const unsigned char* src)
+{
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (; width >= 32; width -= 32, src += 32, dst += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)src);
+        __m256i d = _mm256_loadu_si256((const __m256i*)dst);
+        __m256i m = _mm256_cmpeq_epi8(s, zero);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_blendv_epi8(s, d, m));
+    }
+
+    Trans_SSE2(width, dst, src);
+}
+
+TARGET_AVX2 static inline __m256i Lookup_AVX2(__m256i s, const unsigned char* lut)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_and_si256(s, nibble);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(s, 4), nibble);
+    __m256i result = _mm256_setzero_si256();
+
+    for (int h = 0; h < 16; ++h) {
+        __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(lut + h * 16)));
+        __m256i m = _mm256_cmpeq_epi8(hi, _mm256_set1_epi8((char)h));
+        result = _mm256_or_si256(result, _mm256_and_si256(m, _mm256_shuffle_epi8(table, lo)));
+    }
+
+    return result;
+}
+
+TARGET_AVX2 static void Lut_AVX2(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut)
+{
+    for (; width >= 32; width -= 32, src += 32, dst += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)src);
+        _mm256_storeu_si256((__m256i*)dst, Lookup_AVX2(s, lut));
+    }
+
+    Lut_SSSE3(width, dst, src, lut);
+}
+
+TARGET_AVX2 static void
+Lut_Trans_AVX2(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut)
+{
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (; width >= 32; width -= 32, src += 32, dst += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)src);
+        __m256i d = _mm256_loadu_si256((const __m256i*)dst);
+        __m256i m = _mm256_cmpeq_epi8(s, zero);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_blendv_epi8(Lookup_AVX2(s, lut), d, m));
+    }
+
+    Lut_Trans_SSSE3(width, dst, src, lut);
+}
+
+TARGET_AVX2 static void Ghost_AVX2(int width,
+                                   unsigned char* dst,
+                                   const unsigned char* src,
+                                   const unsigned char* lookup,
+                                   const unsigned char* tab)
+{
+    const __m256i none = _mm256_set1_epi8((char)0xFF);
+
+    for (; width >= 32; width -= 32, src += 32, dst += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)src);
+        __m256i f = Lookup_AVX2(s, lookup);
+
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(f, none)) == -1) {
+            _mm256_storeu_si256((__m256i*)dst, s);
+        } else {
+            Ghost_Scalar(32, dst, src, lookup, tab);
+        }
+    }
+
+    Ghost_SSSE3(width, dst, src, lookup, tab);
+}
+
+TARGET_AVX2 static void Ghost_Trans_AVX2(int width,
+                                         unsigned char* dst,
+                                         const unsigned char* src,
+                                         const unsigned char* lookup,
+                                         const unsigned char* tab)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i none = _mm256_set1_epi8((char)0xFF);
+
+    for (; width >= 32; width -= 32, src += 32, dst += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)src);
+        __m256i f = Lookup_AVX2(s, lookup);
+        __m256i m = _mm256_cmpeq_epi8(s, zero);
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(m, _mm256_cmpeq_epi8(f, none))) == -1) {
+            __m256i d = _mm256_loadu_si256((const __m256i*)dst);
+            _mm256_storeu_si256((__m256i*)dst, _mm256_blendv_epi8(s, d, m));
+        } else {
+            Ghost_Trans_Scalar(32, dst, src, lookup, tab);
+        }
+    }
+
+    Ghost_Trans_SSSE3(width, dst, src, lookup, tab);
+}
+
+#endif /* BLIT_X86 */
+
+BlitLevelType Blit_Detect_Level()
+{
+#if defined(BLIT_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return BLIT_AVX2;
+    }
+
+    if (__builtin_cpu_supports("ssse3")) {
+        return BLIT_SSSE3;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        return BLIT_SSE2;
+    }
+#elif defined(BLIT_X86) && defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool ssse3 = (info[2] & (1 << 9)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    /*
+    ** AVX2 also needs the OS to save the upper halves of the YMM registers.
+    */
+    if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+
+        if (info[1] & (1 << 5)) {
+            return BLIT_AVX2;
+        }
+    }
+
+    if (ssse3) {
+        return BLIT_SSSE3;
+    }
+
+    if (sse2) {
+        return BLIT_SSE2;
+    }
+#endif
+
+    return BLIT_SCALAR;
+}
+
+bool Blit_Get_Kernels(BlitLevelType level, BlitKernelsType& kernels)
+{
+    if (level < BLIT_SCALAR || level >= BLIT_LEVEL_COUNT || level > Blit_Detect_Level()) {
+        return false;
+    }
+
+    switch (level) {
+#ifdef BLIT_X86
+    case BLIT_SSE2:
+        kernels = {"SSE2", Trans_SSE2, Lut_Scalar, Lut_Trans_SSE2, Ghost_SSE2, Ghost_Trans_SSE2};
+        break;
+
+    case BLIT_SSSE3:
+        kernels = {"SSSE3", Trans_SSE2, Lut_SSSE3, Lut_Trans_SSSE3, Ghost_SSSE3, Ghost_Trans_SSSE3};
+        break;
+
+    case BLIT_AVX2:
+        kernels = {"AVX2", Trans_AVX2, Lut_AVX2, Lut_Trans_AVX2, Ghost_AVX2, Ghost_Trans_AVX2};
+        break;
+#endif
+
+    default:
+        kernels = {"Scalar", Trans_Scalar, Lut_Scalar, Lut_Trans_Scalar, Ghost_Scalar, Ghost_Trans_Scalar};
+        break;
+    }
+
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef BLITSIMD_H
+#define BLITSIMD_H
+
+/*
+** Instruction set levels the shape blitters can be built for. The scalar level is always
+** available and is what the BF_* reference blitters in keybuff.cpp implement.
+*/
+typedef enum
+{
+    BLIT_SCALAR,
+    BLIT_SSE2,
+    BLIT_SSSE3,
+    BLIT_AVX2,
+    BLIT_LEVEL_COUNT
+} BlitLevelType;
+
+/*
+** Row kernels, each processes width pixels of a single line.
+**
+** Trans       - Copy src to dst, skipping index 0.
+** Lut         - dst = lut[src].
+** Lut_Trans   - dst = lut[src], skipping index 0.
+** Ghost       - dst = lookup[src] == 0xFF ? src : tab[dst + lookup[src] * 256].
+** Ghost_Trans - As Ghost, skipping index 0.
+*/
+typedef struct
+{
+    const char* Name;
+    void (*Trans)(int width, unsigned char* dst, const unsigned char* src);
+    void (*Lut)(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut);
+    void (*Lut_Trans)(int width, unsigned char* dst, const unsigned char* src, const unsigned char* lut);
+    void (*Ghost)(int width,
+                  unsigned char* dst,
+                  const unsigned char* src,
+                  const unsigned char* lookup,
+                  const unsigned char* tab);
+    void (*Ghost_Trans)(int width,
+                        unsigned char* dst,
+                        const unsigned char* src,
+                        const unsigned char* lookup,
+                        const unsigned char* tab);
+} BlitKernelsType;
+
+/*
+** Highest level supported by both the build and the CPU we are running on.
+*/
+BlitLevelType Blit_Detect_Level();
+
+/*
+** Fetch the kernels for a level, returns false if the level is unavailable.
+*/
+bool Blit_Get_Kernels(BlitLevelType level, BlitKernelsType& kernels);
+
+/*
+** Select the kernels Buffer_Frame_To_Page uses. Levels above what the CPU supports are
+** clamped. The best level is selected automatically at startup.
+*/
+BlitLevelType Set_Shape_Blit_Level(BlitLevelType level);
+BlitLevelType Get_Shape_Blit_Level();
+
+/*
+** Select the kernels Buffer_Print uses, in the same way.
+*/
+BlitLevelType Set_Font_Blit_Level(BlitLevelType level);
+BlitLevelType Get_Font_Blit_Level();
+
+#endif /* BLITSIMD_H */
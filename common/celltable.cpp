@@ -0,0 +1,81 @@
+#include "celltable.h"
+
+#include <string.h>
+
+CellTableClass::CellTableClass(int width, int height)
+    : TableWidth(width)
+    , TableHeight(height)
+{
+    int size = width * height;
+
+    Block = new unsigned char[size * (ZONE_TYPES + 3)];
+    for (int type = 0; type < ZONE_TYPES; ++type) {
+        Zones[type] = Block + size * type;
+    }
+    Composites = Block + size * ZONE_TYPES;
+    Lands = Composites + size;
+    Walls = Lands + size;
+
+    Clear();
+}
+
+CellTableClass::~CellTableClass()
+{
+    delete[] Block;
+}
+
+void CellTableClass::Clear()
+{
+    memset(Block, 0, TableWidth * TableHeight * (ZONE_TYPES + 3));
+}
+
+/*
+** The loop has no branches so the compiler is free to vectorise it, a row of the map is only
+** a handful of vectors long.
+*/
+int CellTableClass::Clear_Row(int cell, int count, CellQueryType const& query, unsigned char* result) const
+{
+    const unsigned char* composite = Composites + cell;
+    const unsigned char* land = Lands + cell;
+    const unsigned char* wall = Walls + cell;
+    unsigned char blocking = query.Blocking;
+    unsigned char limit = query.WallLimit;
+    unsigned mask = query.LandMask;
+    int clear = 0;
+
+    if (query.Zone == -1) {
+        for (int i = 0; i < count; ++i) {
+            unsigned char ok = ((composite[i] & blocking) == 0) & (wall[i] <= limit) & ((mask >> land[i]) & 1);
+            result[i] = ok;
+            clear += ok;
+        }
+    } else {
+        const unsigned char* zone = Zones[query.ZoneType] + cell;
+        int match = query.Zone;
+
+        for (int i = 0; i < count; ++i) {
+            unsigned char ok = ((composite[i] & blocking) == 0) & (wall[i] <= limit) & ((mask >> land[i]) & 1)
+                               & (zone[i] == match);
+            result[i] = ok;
+            clear += ok;
+        }
+    }
+
+    return clear;
+}
+
+int CellTableClass::Clear_Rect(int x,
+                               int y,
+                               int width,
+                               int height,
+                               CellQueryType const& query,
+                               unsigned char* result) const
+{
+    int clear = 0;
+
+    for (int row = 0; row < height; ++row) {
+        clear += Clear_Row((y + row) * TableWidth + x, width, query, result + row * width);
+    }
+
+    return clear;
+}
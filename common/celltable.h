@@ -0,0 +1,137 @@
+#ifndef CELLTABLE_H
+#define CELLTABLE_H
+
+/*
+** Dense, cell indexed copies of the few cell fields movement checks read. The map cell
+** objects are large and mix these bytes in with pointers and rendering state, so scanning a
+** row of cells for passability touches a cache line per cell. Here each field lives in its
+** own array and a row of cells is a run of consecutive bytes.
+**
+** The tables are only a mirror, the game keeps them in step whenever it changes the cell
+** fields they copy.
+*/
+
+/*
+** Wall classes, ordered by how hard the wall is to get through.
+*/
+typedef enum
+{
+    CELLWALL_NONE,
+    CELLWALL_CRUSHABLE,
+    CELLWALL_SOLID
+} CellWallType;
+
+/*
+** What makes a cell clear for a query, see CellTableClass::Is_Clear.
+**
+** LandMask  - Bit per land type that can be crossed.
+** Blocking  - Occupation bits that block.
+** WallLimit - Highest wall class that can be crossed, the land under such a wall counts as clear.
+** ZoneType  - Which of the zone tables Zone is matched against.
+** Zone      - Required zone, or -1 for any.
+*/
+typedef struct
+{
+    unsigned LandMask;
+    unsigned char Blocking;
+    unsigned char WallLimit;
+    int ZoneType;
+    int Zone;
+} CellQueryType;
+
+class CellTableClass
+{
+public:
+    enum
+    {
+        ZONE_TYPES = 4
+    };
+
+    CellTableClass(int width, int height);
+    ~CellTableClass();
+
+    /*
+    ** Zero every table.
+    */
+    void Clear();
+
+    int Width() const
+    {
+        return TableWidth;
+    }
+    int Height() const
+    {
+        return TableHeight;
+    }
+
+    unsigned char Zone(int cell, int type) const
+    {
+        return Zones[type][cell];
+    }
+    unsigned char Composite(int cell) const
+    {
+        return Composites[cell];
+    }
+    unsigned char Land(int cell) const
+    {
+        return Lands[cell];
+    }
+    unsigned char Wall(int cell) const
+    {
+        return Walls[cell];
+    }
+
+    void Set_Zone(int cell, int type, unsigned char zone)
+    {
+        Zones[type][cell] = zone;
+    }
+    void Set_Composite(int cell, unsigned char composite)
+    {
+        Composites[cell] = composite;
+    }
+
+    /*
+    ** Store the land type and wall class. The land should be the one the cell has with any
+    ** wall on it cleared away, as that is what a unit able to cross the wall will drive on.
+    */
+    void Set_Terrain(int cell, unsigned char land, unsigned char wall)
+    {
+        Lands[cell] = land;
+        Walls[cell] = wall;
+    }
+
+    bool Is_Clear(int cell, CellQueryType const& query) const
+    {
+        if (query.Zone != -1 && Zones[query.ZoneType][cell] != query.Zone) {
+            return false;
+        }
+        return (Composites[cell] & query.Blocking) == 0 && Walls[cell] <= query.WallLimit
+               && (query.LandMask >> Lands[cell]) & 1;
+    }
+
+    /*
+    ** Test count cells along a row from cell. Each result byte is set to 1 if the cell is
+    ** clear and 0 if not. Returns the number of clear cells.
+    */
+    int Clear_Row(int cell, int count, CellQueryType const& query, unsigned char* result) const;
+
+    /*
+    ** Test a width x height block of cells with x, y at its top left. Results are packed row
+    ** after row, width bytes per row. The block must lie within the table.
+    */
+    int Clear_Rect(int x, int y, int width, int height, CellQueryType const& query, unsigned char* result) const;
+
+private:
+    CellTableClass(CellTableClass const&);
+    CellTableClass& operator=(CellTableClass const&);
+
+    int TableWidth;
+    int TableHeight;
+    unsigned char* Block;
+    unsigned char* Zones[ZONE_TYPES];
+    unsigned char* Composites;
+    unsigned char* Lands;
+    unsigned char* Walls;
+};
+
+#endif /* CELLTABLE_H */
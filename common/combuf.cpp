@@ -43,7 +43,11 @@
  *   CommBufferClass::Add_Delay -- adds a new delay value for response time*
  *   CommBufferClass::Avg_Response_Time -- returns average response time  	*
  *   CommBufferClass::Max_Response_Time -- returns max response time  		*
+ *   CommBufferClass::Smooth_Response_Time -- returns smoothed response time*
+ *   CommBufferClass::Response_Jitter -- returns response time deviation   *
+ *   CommBufferClass::Response_Percentile -- returns a delay percentile    *
  *   CommBufferClass::Reset_Response_Time -- resets computations				*
+ *   CommBufferClass::Add_Stall -- records a frame-sync stall              *
  *   Mono_Debug_Print -- Debug output routine                              *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
@@ -187,10 +191,10 @@ void CommBufferClass::Init(void)
     SendTotal = 0;
     ReceiveTotal = 0;
 
-    DelaySum = 0;
-    NumDelay = 0;
-    MeanDelay = 0;
-    MaxDelay = 0;
+    Reset_Response_Time();
+
+    StallCount = 0;
+    StallTime = 0;
 
     SendCount = 0;
 
@@ -667,6 +671,7 @@ ReceiveQueueType* CommBufferClass::Get_Receive(int index)
 void CommBufferClass::Add_Delay(unsigned int delay)
 {
     int roundoff = 0;
+    unsigned int bucket;
 
     if (NumDelay == 256) {
         DelaySum -= MeanDelay;
@@ -684,6 +689,41 @@ void CommBufferClass::Add_Delay(unsigned int delay)
         MaxDelay = delay;
     }
 
+    //------------------------------------------------------------------------
+    //	Update the smoothed delay & its mean deviation.  The first sample
+    // seeds both; after that the delay moves 1/8 and the deviation 1/4 of
+    // the way toward each new sample.
+    //------------------------------------------------------------------------
+    if (NumDelay == 1) {
+        SmoothDelay = delay << 3;
+        DelayDeviation = delay << 1;
+    } else {
+        int error = (int)(delay << 3) - (int)SmoothDelay;
+        SmoothDelay = (unsigned int)((int)SmoothDelay + (error >> 3));
+        if (error < 0) {
+            error = -error;
+        }
+        DelayDeviation = (unsigned int)((int)DelayDeviation + (((error >> 1) - (int)DelayDeviation) >> 2));
+    }
+
+    //------------------------------------------------------------------------
+    //	Add to the histogram, halving it once it's full so old delays fade.
+    //------------------------------------------------------------------------
+    if (DelayHistCount >= DELAY_HIST_LIMIT) {
+        DelayHistCount = 0;
+        for (int i = 0; i < DELAY_BUCKETS; i++) {
+            DelayHist[i] >>= 1;
+            DelayHistCount += DelayHist[i];
+        }
+    }
+
+    bucket = delay / DELAY_BUCKET_TICKS;
+    if (bucket >= DELAY_BUCKETS) {
+        bucket = DELAY_BUCKETS - 1;
+    }
+    DelayHist[bucket]++;
+    DelayHistCount++;
+
 } /* end of Add_Delay */
 
 /***************************************************************************
@@ -728,6 +768,87 @@ unsigned int CommBufferClass::Max_Response_Time(void)
 
 } /* end of Max_Response_Time */
 
+/***************************************************************************
+ * CommBufferClass::Smooth_Response_Time -- returns smoothed response time	*
+ *                                                                         *
+ * Unlike Avg_Response_Time, this tracks the last dozen or so delays			*
+ * rather than the last 256, so it follows a change in line conditions		*
+ * within a few seconds.																	*
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none.																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		smoothed response time, rounded to the nearest tick						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+unsigned int CommBufferClass::Smooth_Response_Time(void)
+{
+    return ((SmoothDelay + 4) >> 3);
+
+} /* end of Smooth_Response_Time */
+
+/***************************************************************************
+ * CommBufferClass::Response_Jitter -- returns response time deviation     *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none.																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		smoothed mean deviation of the response time, in ticks, rounded up	*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+unsigned int CommBufferClass::Response_Jitter(void)
+{
+    return ((DelayDeviation + 3) >> 2);
+
+} /* end of Response_Jitter */
+
+/***************************************************************************
+ * CommBufferClass::Response_Percentile -- returns a delay percentile      *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		percent		percentile to find, 0 - 100										*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		upper edge of the histogram bucket holding that percentile, in			*
+ *		ticks; 0 if no delays have been recorded yet									*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		Delays in the last bucket are reported as that bucket's lower edge.	*
+ *=========================================================================*/
+unsigned int CommBufferClass::Response_Percentile(int percent)
+{
+    unsigned int wanted;
+    unsigned int seen = 0;
+    int i;
+
+    if (DelayHistCount == 0) {
+        return (0);
+    }
+
+    if (percent < 0) {
+        percent = 0;
+    } else if (percent > 100) {
+        percent = 100;
+    }
+    wanted = (DelayHistCount * percent + 99) / 100;
+
+    for (i = 0; i < DELAY_BUCKETS - 1; i++) {
+        seen += DelayHist[i];
+        if (seen >= wanted && seen > 0) {
+            return ((i + 1) * DELAY_BUCKET_TICKS - 1);
+        }
+    }
+
+    return ((DELAY_BUCKETS - 1) * DELAY_BUCKET_TICKS);
+
+} /* end of Response_Percentile */
+
 /***************************************************************************
  * CommBufferClass::Reset_Response_Time -- resets computations					*
  *                                                                         *
@@ -749,9 +870,36 @@ void CommBufferClass::Reset_Response_Time(void)
     NumDelay = 0;
     MeanDelay = 0;
     MaxDelay = 0;
+    SmoothDelay = 0;
+    DelayDeviation = 0;
+    DelayHistCount = 0;
+    memset(DelayHist, 0, sizeof(DelayHist));
 
 } /* end of Reset_Response_Time */
 
+/***************************************************************************
+ * CommBufferClass::Add_Stall -- records a frame-sync stall                *
+ *                                                                         *
+ * Called when the game had to wait on this connection before it could		*
+ * advance to the next frame.  Stalls aren't cleared by						*
+ * Reset_Response_Time(), so they cover the whole game.							*
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		ticks		how long the stall lasted												*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		none.																						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+void CommBufferClass::Add_Stall(unsigned int ticks)
+{
+    StallCount++;
+    StallTime += ticks;
+
+} /* end of Add_Stall */
+
 /***************************************************************************
  * CommBufferClass::Configure_Debug -- sets up special debug values        *
  *                                                                         *
@@ -43,6 +43,12 @@
  * that delay into a computed average delay over the last few message 		*
  * delays.																						*
  *                                                                         *
+ * Alongside the average, each delay also feeds a smoothed round-trip		*
+ * estimate and its mean deviation (the jitter), kept in fixed point the	*
+ * same way TCP does, and a decaying histogram from which percentiles can	*
+ * be read.  The game's frame-sync logic records how long it stalled		*
+ * waiting on this connection with Add_Stall().									*
+ *                                                                         *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #ifndef COMBUF_H
@@ -85,6 +91,15 @@ typedef struct BITFIELD_STRUCT
 } ReceiveQueueType;
 #pragma pack(pop)
 
+/*---------------------------------------------------------------------------
+Delay histogram layout: DELAY_BUCKETS buckets of DELAY_BUCKET_TICKS each, the
+last one catching everything longer.  Once DELAY_HIST_LIMIT samples are held
+every bucket is halved, so the percentiles follow the recent delays.
+---------------------------------------------------------------------------*/
+#define DELAY_BUCKETS      32
+#define DELAY_BUCKET_TICKS 2
+#define DELAY_HIST_LIMIT   512
+
 /*
 ***************************** Class Declaration *****************************
 */
@@ -143,10 +158,26 @@ public:
     /*
     ....................... Response time routines ........................
     */
-    void Add_Delay(unsigned int delay);   // accumulates response time
-    unsigned int Avg_Response_Time(void); // gets mean response time
-    unsigned int Max_Response_Time(void); // gets max response time
-    void Reset_Response_Time(void);       // resets computations
+    void Add_Delay(unsigned int delay);            // accumulates response time
+    unsigned int Avg_Response_Time(void);          // gets mean response time
+    unsigned int Max_Response_Time(void);          // gets max response time
+    unsigned int Smooth_Response_Time(void);       // gets smoothed round-trip time
+    unsigned int Response_Jitter(void);            // gets mean round-trip deviation
+    unsigned int Response_Percentile(int percent); // gets a percentile of recent delays
+    void Reset_Response_Time(void);                // resets computations
+
+    /*
+    ........................ Stall counter routines ........................
+    */
+    void Add_Stall(unsigned int ticks); // records a frame-sync stall
+    unsigned int Stall_Count(void)
+    {
+        return (StallCount);
+    } // # stalls on this queue
+    unsigned int Stall_Time(void)
+    {
+        return (StallTime);
+    } // total ticks stalled
 
     /*
     ........................ Debug output routines ........................
@@ -170,10 +201,20 @@ private:
     /*
     ....................... Response time variables .......................
     */
-    unsigned int DelaySum;  // sum of last 4 delay times
-    unsigned int NumDelay;  // current # delay times summed
-    unsigned int MeanDelay; // current average delay time
-    unsigned int MaxDelay;  // max delay ever for this queue
+    unsigned int DelaySum;                 // sum of last 4 delay times
+    unsigned int NumDelay;                 // current # delay times summed
+    unsigned int MeanDelay;                // current average delay time
+    unsigned int MaxDelay;                 // max delay ever for this queue
+    unsigned int SmoothDelay;              // smoothed delay, 8x fixed point
+    unsigned int DelayDeviation;           // mean deviation, 4x fixed point
+    unsigned int DelayHist[DELAY_BUCKETS]; // recent delay histogram
+    unsigned int DelayHistCount;           // # samples in the histogram
+
+    /*
+    ........................ Stall counter variables .......................
+    */
+    unsigned int StallCount; // # times frame-sync waited on this queue
+    unsigned int StallTime;  // total ticks spent waiting
 
     /*
     ........................ Send Queue variables .........................
@@ -124,6 +124,15 @@ public:
     virtual unsigned int Response_Time(void) = 0;
     virtual void Set_Timing(unsigned int retrydelta, unsigned int maxretries, unsigned int timeout) = 0;
 
+    /*.....................................................................
+    Latency statistics, per connection or (with no ID) over all of them
+    .....................................................................*/
+    virtual unsigned int Smooth_Response_Time(int id = CONNECTION_NONE) = 0;
+    virtual unsigned int Response_Jitter(int id = CONNECTION_NONE) = 0;
+    virtual unsigned int Response_Percentile(int percent, int id = CONNECTION_NONE) = 0;
+    virtual void Add_Stall(int id, unsigned int ticks) = 0;
+    virtual unsigned int Stall_Count(int id = CONNECTION_NONE) = 0;
+
     /*.....................................................................
     Debugging
     .....................................................................*/
@@ -31,6 +31,7 @@
 
 #include "wwstd.h"
 #include "timer.h"
+#include "tickwait.h"
 
 void Delay(int duration)
 {
@@ -40,7 +41,7 @@ void Delay(int duration)
     while (duration--) {
         count = timer.Time() + 1;
         while (count >= (unsigned)timer.Time()) {
-            ;
+            Wait_For_Tick();
         }
     }
 
@@ -30,6 +30,9 @@
  *   Char_Pixel_Width -- Return pixel width of a character.                *
  *   String_Pixel_Width -- Return pixel width of a string of characters.   *
  *   Get_Next_Text_Print_XY -- Calculates X and Y given ret value from Text_P*
+ *   Buffer_Print_Direct -- C++ text print to graphic buffer routine       *
+ *   Buffer_Print -- C++ text print to graphic buffer routine              *
+ *   Free_Font_Cache -- Frees the decoded glyphs and drawn strings.        *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "font.h"
@@ -38,8 +41,11 @@
 #include "file.h"
 #include "memflag.h"
 #include "endianness.h"
+#include "blitsimd.h"
+#include "settings.h"
 
 #include <errno.h>
+#include <stdint.h>
 #include <string.h>
 
 int FontXSpacing = 0;
@@ -312,9 +318,10 @@ struct FontHeader
 };
 #pragma pack(pop)
 /***************************************************************************
- * Buffer_Print -- C++ text print to graphic buffer routine                *
- *                                                                         *
+ * Buffer_Print_Direct -- C++ text print to graphic buffer routine         *
  *                                                                         *
+ *    Decodes the glyph data of each character as it draws it. This is     *
+ *    the original routine, Buffer_Print must draw the same pixels.        *
  *                                                                         *
  * INPUT:                                                                  *
  *                                                                         *
@@ -328,7 +335,7 @@ struct FontHeader
  *   01/17/1995 PWG : Created.                                             *
  *   18/08/2020 OmniBlade : Translation to C++ added.                      *
  *=========================================================================*/
-int Buffer_Print(void* thisptr, const char* string, int x, int y, int fground, int bground)
+int Buffer_Print_Direct(void* thisptr, const char* string, int x, int y, int fground, int bground)
 {
     GraphicViewPortClass& vp = *static_cast<GraphicViewPortClass*>(thisptr);
     const FontHeader* fntheader = reinterpret_cast<const FontHeader*>(FontPtr);
@@ -492,6 +499,579 @@ int Buffer_Print(void* thisptr, const char* string, int x, int y, int fground, i
     return 0;
 }
 
+/*
+** Buffer_Print decodes each glyph once for a font and set of colors into 8 bit pixels, where 0
+** leaves the background showing, and copies whole lines of those. Each line is flagged empty,
+** solid or transparent so only the lines that need it go through the transparent blitter.
+** Whole strings that fit on one line can also be kept ready drawn, see Settings.Video.TextRunCache.
+*/
+#define FONT_ATLAS_COUNT    16
+#define FONT_RUN_BUCKETS    256
+#define FONT_RUN_MAX_LENGTH 255
+
+typedef enum
+{
+    FONT_LINE_EMPTY,
+    FONT_LINE_SOLID,
+    FONT_LINE_TRANS
+} FontLineType;
+
+/*
+** Width by font height pixels, followed by a FontLineType for each line.
+*/
+typedef struct
+{
+    unsigned char* Pixels;
+    int Width;
+} FontImageType;
+
+typedef struct
+{
+    void const* Font;
+    unsigned char Xlat[16];
+    unsigned LastUsed;
+    FontImageType Glyphs[256];
+} FontAtlasType;
+
+/*
+** A string drawn in one font and set of colors. The block holds the entry followed by the
+** text and then the pixels.
+*/
+typedef struct tFontRunType
+{
+    tFontRunType* Prev;
+    tFontRunType* Next;
+    tFontRunType* HashNext;
+    unsigned Hash;
+    void const* Font;
+    unsigned char Xlat[16];
+    int Spacing;
+    int Length;
+    int Size;
+    FontImageType Image;
+} FontRunType;
+
+static FontAtlasType FontAtlases[FONT_ATLAS_COUNT];
+static unsigned FontAtlasClock = 0;
+
+static FontRunType* FontRunBuckets[FONT_RUN_BUCKETS];
+static FontRunType* FontRunHead = nullptr; // Most recently used.
+static FontRunType* FontRunTail = nullptr; // Least recently used.
+static FontCacheStatsType FontRunStats;
+
+static BlitKernelsType FontKernels;
+static BlitLevelType FontBlitLevel = BLIT_SCALAR;
+
+static char const* Font_Run_Text(FontRunType const* run)
+{
+    return reinterpret_cast<char const*>(run + 1);
+}
+
+static void Font_Set_Lines(FontImageType& image, int height)
+{
+    unsigned char const* src = image.Pixels;
+    unsigned char* lines = image.Pixels + image.Width * height;
+
+    for (int i = 0; i < height; ++i) {
+        int solid = 0;
+
+        for (int j = 0; j < image.Width; ++j) {
+            solid += src[j] != 0;
+        }
+
+        if (solid == 0) {
+            lines[i] = FONT_LINE_EMPTY;
+        } else if (solid == image.Width) {
+            lines[i] = FONT_LINE_SOLID;
+        } else {
+            lines[i] = FONT_LINE_TRANS;
+        }
+
+        src += image.Width;
+    }
+}
+
+/*
+** Copy a line of pixels, leaving the destination alone where the source is 0. The vector
+** blitters only get whole blocks of 32 pixels, glyph lines and the ends of longer lines are done
+** eight and then four pixels at a time with the zero bytes masked out instead.
+*/
+static inline void Font_Trans_Line(unsigned char* dst, unsigned char const* src, int width)
+{
+    if (width >= 32) {
+        int blocks = width & ~31;
+        FontKernels.Trans(blocks, dst, src);
+        width -= blocks;
+        src += blocks;
+        dst += blocks;
+    }
+
+    for (; width >= 8; width -= 8, src += 8, dst += 8) {
+        uint64_t s;
+        uint64_t d;
+        memcpy(&s, src, sizeof(s));
+        memcpy(&d, dst, sizeof(d));
+        uint64_t set = (((s & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | s) & 0x8080808080808080ULL;
+        d = (d & ~((set >> 7) * 0xFF)) | s;
+        memcpy(dst, &d, sizeof(d));
+    }
+
+    if (width >= 4) {
+        uint32_t s;
+        uint32_t d;
+        memcpy(&s, src, sizeof(s));
+        memcpy(&d, dst, sizeof(d));
+        uint32_t set = (((s & 0x7F7F7F7FU) + 0x7F7F7F7FU) | s) & 0x80808080U;
+        d = (d & ~((set >> 7) * 0xFF)) | s;
+        memcpy(dst, &d, sizeof(d));
+        width -= 4;
+        src += 4;
+        dst += 4;
+    }
+
+    for (; width > 0; --width, ++src, ++dst) {
+        if (*src != 0) {
+            *dst = *src;
+        }
+    }
+}
+
+static void Font_Blit(FontImageType const& image, int height, unsigned char* dst, int pitch)
+{
+    unsigned char const* src = image.Pixels;
+    unsigned char const* lines = image.Pixels + image.Width * height;
+
+    for (int i = 0; i < height; ++i) {
+        if (lines[i] == FONT_LINE_SOLID) {
+            memcpy(dst, src, image.Width);
+        } else if (lines[i] == FONT_LINE_TRANS) {
+            Font_Trans_Line(dst, src, image.Width);
+        }
+
+        src += image.Width;
+        dst += pitch;
+    }
+}
+
+/*
+** Decode a glyph the same way Buffer_Print_Direct draws it.
+*/
+static FontImageType const& Font_Glyph(FontAtlasType& atlas, unsigned char char_num)
+{
+    FontImageType& glyph = atlas.Glyphs[char_num];
+
+    if (glyph.Pixels != nullptr) {
+        return glyph;
+    }
+
+    const FontHeader* fntheader = reinterpret_cast<const FontHeader*>(atlas.Font);
+    const unsigned short* datalist = reinterpret_cast<const unsigned short*>(
+        reinterpret_cast<const char*>(atlas.Font) + le16toh(fntheader->OffsetBlockOffset));
+    const unsigned char* widthlist =
+        reinterpret_cast<const unsigned char*>(atlas.Font) + le16toh(fntheader->WidthBlockOffset);
+    const unsigned short* linelist = reinterpret_cast<const unsigned short*>(reinterpret_cast<const char*>(atlas.Font)
+                                                                             + le16toh(fntheader->HeightOffset));
+
+    int fntheight = fntheader->MaxHeight;
+    int width = widthlist[char_num];
+    unsigned short dlist;
+    memcpy(&dlist, datalist + char_num, sizeof(unsigned short));
+    dlist = le16toh(dlist);
+    const unsigned char* char_data = reinterpret_cast<const unsigned char*>(atlas.Font) + dlist;
+    short char_lle;
+    memcpy(&char_lle, linelist + char_num, sizeof(short));
+    char_lle = le16toh(char_lle);
+    int char_ypos = MIN(char_lle & 0xFF, fntheight);
+    int char_lines = MIN((char_lle >> 8) & 0xFF, fntheight - char_ypos);
+    int char_height = fntheight - (char_ypos + char_lines);
+
+    glyph.Width = width;
+    glyph.Pixels = new unsigned char[width * fntheight + fntheight];
+    memset(glyph.Pixels, 0, width * fntheight);
+
+    unsigned char* dst = glyph.Pixels;
+    unsigned char bground = atlas.Xlat[0];
+
+    memset(dst, bground, width * char_ypos);
+    dst += width * char_ypos;
+
+    for (int i = 0; i < char_lines; ++i) {
+        for (int j = 0; j < width; j += 2) {
+            unsigned char color_packed = *char_data++;
+            dst[j] = atlas.Xlat[color_packed & 0x0F];
+
+            if (j + 1 < width) {
+                dst[j + 1] = atlas.Xlat[color_packed >> 4];
+            }
+        }
+
+        dst += width;
+    }
+
+    // Lines below the glyph are only filled in when it has some lines of its own.
+    if (char_lines) {
+        memset(dst, bground, width * char_height);
+    }
+
+    Font_Set_Lines(glyph, fntheight);
+    return glyph;
+}
+
+/*
+** Find the atlas for the current font and colors, reusing the least recently used one if there
+** isn't one yet.
+*/
+static FontAtlasType& Font_Atlas()
+{
+    FontAtlasType* oldest = &FontAtlases[0];
+
+    ++FontAtlasClock;
+
+    for (int i = 0; i < FONT_ATLAS_COUNT; ++i) {
+        FontAtlasType* atlas = &FontAtlases[i];
+
+        if (atlas->Font == FontPtr && memcmp(atlas->Xlat, ColorXlat[0], sizeof(atlas->Xlat)) == 0) {
+            atlas->LastUsed = FontAtlasClock;
+            return *atlas;
+        }
+
+        if (atlas->LastUsed < oldest->LastUsed) {
+            oldest = atlas;
+        }
+    }
+
+    for (int i = 0; i < 256; ++i) {
+        delete[] oldest->Glyphs[i].Pixels;
+        oldest->Glyphs[i].Pixels = nullptr;
+    }
+
+    oldest->Font = FontPtr;
+    memcpy(oldest->Xlat, ColorXlat[0], sizeof(oldest->Xlat));
+    oldest->LastUsed = FontAtlasClock;
+    return *oldest;
+}
+
+static void Font_Run_Unlink(FontRunType* run)
+{
+    if (run->Prev) {
+        run->Prev->Next = run->Next;
+    } else {
+        FontRunHead = run->Next;
+    }
+
+    if (run->Next) {
+        run->Next->Prev = run->Prev;
+    } else {
+        FontRunTail = run->Prev;
+    }
+
+    run->Prev = nullptr;
+    run->Next = nullptr;
+}
+
+static void Font_Run_Push_Front(FontRunType* run)
+{
+    run->Prev = nullptr;
+    run->Next = FontRunHead;
+
+    if (FontRunHead) {
+        FontRunHead->Prev = run;
+    } else {
+        FontRunTail = run;
+    }
+
+    FontRunHead = run;
+}
+
+static void Font_Run_Free(FontRunType* run)
+{
+    FontRunType** link = &FontRunBuckets[run->Hash % FONT_RUN_BUCKETS];
+
+    while (*link != run) {
+        link = &(*link)->HashNext;
+    }
+
+    *link = run->HashNext;
+    Font_Run_Unlink(run);
+    FontRunStats.Bytes -= run->Size;
+    FontRunStats.Entries--;
+    delete[] reinterpret_cast<char*>(run);
+}
+
+/*
+** Find the drawn string, drawing it first if need be. Strings that would be split over more
+** than one line aren't kept and return NULL.
+*/
+static FontRunType* Font_Run(FontAtlasType& atlas, const char* string, int x, int vp_width)
+{
+    const FontHeader* fntheader = reinterpret_cast<const FontHeader*>(atlas.Font);
+    const unsigned char* widthlist =
+        reinterpret_cast<const unsigned char*>(atlas.Font) + le16toh(fntheader->WidthBlockOffset);
+    int fntheight = fntheader->MaxHeight;
+
+    unsigned hash = 2166136261U;
+    int length = 0;
+    int width = 0;
+
+    for (; string[length] != '\0'; ++length) {
+        unsigned char char_num = string[length];
+
+        if (char_num == '\n' || char_num == '\r' || length == FONT_RUN_MAX_LENGTH) {
+            return nullptr;
+        }
+
+        width += FontXSpacing + widthlist[char_num];
+        hash = (hash ^ char_num) * 16777619U;
+    }
+
+    if (length == 0 || x + width > vp_width) {
+        return nullptr;
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        hash = (hash ^ atlas.Xlat[i]) * 16777619U;
+    }
+    hash = (hash ^ unsigned(FontXSpacing)) * 16777619U;
+    hash ^= unsigned(reinterpret_cast<uintptr_t>(atlas.Font) >> 4);
+
+    FontRunType** bucket = &FontRunBuckets[hash % FONT_RUN_BUCKETS];
+
+    for (FontRunType* run = *bucket; run != nullptr; run = run->HashNext) {
+        if (run->Hash == hash && run->Font == atlas.Font && run->Spacing == FontXSpacing && run->Length == length
+            && memcmp(run->Xlat, atlas.Xlat, sizeof(run->Xlat)) == 0
+            && memcmp(Font_Run_Text(run), string, length) == 0) {
+            FontRunStats.Hits++;
+
+            if (FontRunHead != run) {
+                Font_Run_Unlink(run);
+                Font_Run_Push_Front(run);
+            }
+
+            return run;
+        }
+    }
+
+    FontRunStats.Misses++;
+
+    /*
+    ** The spacing after the last glyph isn't part of the drawn string.
+    */
+    width -= FontXSpacing;
+
+    int size = sizeof(FontRunType) + length + width * fntheight + fntheight;
+    FontRunType* run = reinterpret_cast<FontRunType*>(new char[size]);
+    run->Prev = nullptr;
+    run->Next = nullptr;
+    run->Hash = hash;
+    run->Font = atlas.Font;
+    memcpy(run->Xlat, atlas.Xlat, sizeof(run->Xlat));
+    run->Spacing = FontXSpacing;
+    run->Length = length;
+    run->Size = size;
+    memcpy(reinterpret_cast<char*>(run + 1), string, length);
+    run->Image.Width = width;
+    run->Image.Pixels = reinterpret_cast<unsigned char*>(run + 1) + length;
+    memset(run->Image.Pixels, 0, width * fntheight);
+
+    int pos = 0;
+    for (int i = 0; i < length; ++i) {
+        FontImageType const& glyph = Font_Glyph(atlas, string[i]);
+        unsigned char const* src = glyph.Pixels;
+        unsigned char* dst = run->Image.Pixels + pos;
+
+        for (int j = 0; j < fntheight; ++j) {
+            Font_Trans_Line(dst, src, glyph.Width);
+            src += glyph.Width;
+            dst += width;
+        }
+
+        pos += FontXSpacing + glyph.Width;
+    }
+
+    Font_Set_Lines(run->Image, fntheight);
+
+    run->HashNext = *bucket;
+    *bucket = run;
+    Font_Run_Push_Front(run);
+    FontRunStats.Bytes += size;
+    FontRunStats.Entries++;
+
+    while (FontRunStats.Entries > unsigned(Settings.Video.TextRunCache) && FontRunTail != run) {
+        Font_Run_Free(FontRunTail);
+        FontRunStats.Evictions++;
+    }
+
+    return run;
+}
+
+/***************************************************************************
+ * Buffer_Print -- C++ text print to graphic buffer routine                *
+ *                                                                         *
+ *    Draws the same pixels as Buffer_Print_Direct, from glyphs decoded    *
+ *    ahead of time for the font and colors in use.                        *
+ *                                                                         *
+ * INPUT:   thisptr  -- The GraphicViewPortClass to draw to.               *
+ *          string   -- The text to draw.                                  *
+ *          x,y      -- Where to draw it.                                  *
+ *          fground  -- Color to draw the text in.                         *
+ *          bground  -- Color to fill behind the text, 0 to leave it.      *
+ *                                                                         *
+ * OUTPUT:  Always 0.                                                      *
+ *                                                                         *
+ * WARNINGS:   Text that would go past the bottom of the viewport isn't    *
+ *             drawn.                                                      *
+ *                                                                         *
+ *=========================================================================*/
+int Buffer_Print(void* thisptr, const char* string, int x, int y, int fground, int bground)
+{
+    GraphicViewPortClass& vp = *static_cast<GraphicViewPortClass*>(thisptr);
+    const FontHeader* fntheader = reinterpret_cast<const FontHeader*>(FontPtr);
+    int pitch = vp.Get_XAdd() + vp.Get_Width() + vp.Get_Pitch();
+    unsigned char* offset = y * pitch + reinterpret_cast<unsigned char*>(vp.Get_Offset());
+    unsigned char* dst = x + offset;
+    int base_x = x;
+
+    if (FontPtr == nullptr) {
+        return 0;
+    }
+
+    const unsigned char* widthlist =
+        reinterpret_cast<const unsigned char*>(FontPtr) + le16toh(fntheader->WidthBlockOffset);
+    int fntheight = fntheader->MaxHeight;
+    int ydisplace = FontYSpacing + fntheight;
+
+    // Check if we are drawing in bounds, we don't draw clipped text
+    if (y + fntheight > vp.Get_Height()) {
+        return 0;
+    }
+
+    int fntbottom = y + fntheight;
+    ColorXlat[0][1] = fground;
+    ColorXlat[0][0] = bground;
+
+    FontAtlasType& atlas = Font_Atlas();
+
+    if (Settings.Video.TextRunCache > 0 && FontXSpacing >= 0) {
+        FontRunType* run = Font_Run(atlas, string, x, vp.Get_Width());
+
+        if (run != nullptr) {
+            Font_Blit(run->Image, fntheight, dst, pitch);
+            return 0;
+        }
+    }
+
+    while (true) {
+        // Handle a new line, the same way as Buffer_Print_Direct
+        unsigned char char_num;
+        unsigned char* char_dst;
+        while (true) {
+            char_num = *string;
+
+            if (char_num == '\0') {
+                return 0;
+            }
+
+            char_dst = dst;
+            ++string;
+
+            if (char_num != '\n' && char_num != '\r') {
+                break;
+            }
+
+            if (ydisplace + fntbottom > vp.Get_Height()) {
+                return 0;
+            }
+
+            x = char_num == '\n' ? 0 : base_x;
+            dst = ydisplace * pitch + offset + x;
+            offset += ydisplace * pitch;
+            fntbottom += ydisplace;
+        }
+
+        int char_width = widthlist[char_num];
+        dst += FontXSpacing + char_width;
+
+        // Handle text wrapping for long strings
+        if (FontXSpacing + char_width + x > vp.Get_Width()) {
+            --string;
+
+            if (ydisplace + fntbottom > vp.Get_Height()) {
+                return 0;
+            }
+
+            x = base_x;
+            dst = ydisplace * pitch + offset + x;
+            offset += ydisplace * pitch;
+            fntbottom += ydisplace;
+
+            continue;
+        }
+
+        x += FontXSpacing + char_width;
+        Font_Blit(Font_Glyph(atlas, char_num), fntheight, char_dst, pitch);
+    }
+}
+
+/***************************************************************************
+ * Free_Font_Cache -- Frees the decoded glyphs and drawn strings.          *
+ *                                                                         *
+ *    Must be called before a font passed to Set_Font is freed, if the     *
+ *    memory could be reused for another font.                             *
+ *                                                                         *
+ * INPUT:   none                                                           *
+ *                                                                         *
+ * OUTPUT:  none                                                           *
+ *                                                                         *
+ * WARNINGS:   none                                                        *
+ *                                                                         *
+ *=========================================================================*/
+void Free_Font_Cache()
+{
+    for (int i = 0; i < FONT_ATLAS_COUNT; ++i) {
+        for (int j = 0; j < 256; ++j) {
+            delete[] FontAtlases[i].Glyphs[j].Pixels;
+            FontAtlases[i].Glyphs[j].Pixels = nullptr;
+        }
+
+        FontAtlases[i].Font = nullptr;
+        FontAtlases[i].LastUsed = 0;
+    }
+
+    while (FontRunHead) {
+        Font_Run_Free(FontRunHead);
+    }
+}
+
+void Get_Font_Cache_Stats(FontCacheStatsType& stats)
+{
+    stats = FontRunStats;
+}
+
+BlitLevelType Set_Font_Blit_Level(BlitLevelType level)
+{
+    BlitLevelType best = Blit_Detect_Level();
+
+    if (level > best) {
+        level = best;
+    }
+
+    if (level <= BLIT_SCALAR || !Blit_Get_Kernels(level, FontKernels)) {
+        level = BLIT_SCALAR;
+        Blit_Get_Kernels(BLIT_SCALAR, FontKernels);
+    }
+
+    FontBlitLevel = level;
+    return level;
+}
+
+BlitLevelType Get_Font_Blit_Level()
+{
+    return FontBlitLevel;
+}
+
+// Pick the best blitters the CPU supports before anything is drawn.
+static BlitLevelType InitialFontBlitLevel = Set_Font_Blit_Level(BLIT_AVX2);
+
 void* Get_Font_Palette_Ptr()
 {
     return ColorXlat;
@@ -35,6 +35,8 @@
 #ifndef FONT_H
 #define FONT_H
 
+#include <stddef.h>
+
 //////////////////////////////////////// Defines //////////////////////////////////////////
 
 // defines for font header, offsets to block offsets
@@ -50,6 +52,15 @@
 #define FONTINFOMAXHEIGHT 4
 #define FONTINFOMAXWIDTH  5
 
+typedef struct
+{
+    unsigned Hits;
+    unsigned Misses;
+    unsigned Evictions;
+    unsigned Entries;
+    size_t Bytes;
+} FontCacheStatsType;
+
 //////////////////////////////////////// Prototypes //////////////////////////////////////////
 
 class GraphicViewPortClass;
@@ -65,6 +76,9 @@ void* Load_Font(char const* name);
 /* The following prototypes are for the file: TEXTPRNT.ASM                 */
 /*=========================================================================*/
 int Buffer_Print(void* thisptr, const char* str, int x, int y, int fcolor, int bcolor);
+int Buffer_Print_Direct(void* thisptr, const char* str, int x, int y, int fcolor, int bcolor);
+void Free_Font_Cache();
+void Get_Font_Cache_Stats(FontCacheStatsType& stats);
 void* Get_Font_Palette_Ptr();
 /*=========================================================================*/
 
@@ -0,0 +1,15 @@
+#ifndef GAMELOCAL_H
+#define GAMELOCAL_H
+
+/*
+** Storage class for simulation state that belongs to a single running match. Builds that
+** run several headless game instances in one process define GAME_INSTANCES, which gives
+** every instance thread its own copy. All other builds see ordinary globals.
+*/
+#ifdef GAME_INSTANCES
+#define INSTANCE_LOCAL thread_local
+#else
+#define INSTANCE_LOCAL
+#endif
+
+#endif /* GAMELOCAL_H */
@@ -34,14 +34,16 @@
  *  Write_Interpolation_Palette -- writes an interpolation palette to disk                     *
  *  Create_Palette_Interpolation_Table -- build the palette interpolation table                *
  *  Increase_Palette_Luminance -- increase the contrast of a palette                           *
- *  Interpolate_2X_Scale -- Stretch a 320x200 graphic buffer into 640x400                      *
+ *  Interpolate_2X_Scale -- Stretch a 320x200 graphic buffer by 2, 3 or 4                      *
  *                                                                                             *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "interpal.h"
 #include "ccfile.h"
 #include "gbuffer.h"
+#include "interpscale.h"
 #include "winasm.h"
+#include "settings.h"
 
 void Show_Mouse();
 void Hide_Mouse();
@@ -364,6 +366,15 @@ void Interpolate_2X_Scale(GraphicBufferClass* source,
 
     int h = source->Get_Height();
 
+    /*
+    ** Stretch by the configured factor when the destination has room for it. The game pages are
+    ** 640x400, so they always get 2x.
+    */
+    int scale = Settings.Video.InterpolationScale;
+    while (scale > 2 && (dest->Get_Width() < src_width * scale || dest->Get_Height() < h * scale)) {
+        scale--;
+    }
+
     /*
     ** Call the appropriate assembly language copy routine
     */
@@ -375,15 +386,16 @@ void Interpolate_2X_Scale(GraphicBufferClass* source,
         break;
 
     case 0:
-        Asm_Interpolate(src_ptr, dest_ptr, source->Get_Height(), src_width, dest_width);
-        break;
-
     case 1:
-        Asm_Interpolate_Line_Double(src_ptr, dest_ptr, source->Get_Height(), src_width, dest_width);
-        break;
-
     case 2:
-        Asm_Interpolate_Line_Interpolate(src_ptr, dest_ptr, source->Get_Height(), src_width, dest_width);
+        Interpolate_Scale(src_ptr,
+                          dest_ptr,
+                          h,
+                          src_width,
+                          dest_width / (scale_factor + 1),
+                          scale,
+                          mode,
+                          &InterpolationTable->PaletteInterpolationTable[0][0]);
         break;
     }
 
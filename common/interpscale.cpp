@@ -0,0 +1,283 @@
+#include "interpscale.h"
+#include "workerpool.h"
+
+#include <string.h>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define INTERP_X86
+#include <immintrin.h>
+#endif
+
+#if defined(INTERP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+/*
+** Keep bands big enough that handing them to the pool is worth it.
+*/
+#define MIN_BAND_ROWS 16
+
+/*
+** Output columns per source pixel that get a precomputed tap, larger scales look theirs up.
+*/
+#define MAX_TAPS 8
+
+typedef void (*BlendFunc)(int width,
+                          unsigned char* dst,
+                          const unsigned char* a,
+                          const unsigned char* b,
+                          const unsigned char* table);
+
+/*
+** dst = table[a][b] for every pixel of a row.
+*/
+static void Blend_Scalar(int width,
+                         unsigned char* dst,
+                         const unsigned char* a,
+                         const unsigned char* b,
+                         const unsigned char* table)
+{
+    for (int i = 0; i < width; ++i) {
+        dst[i] = table[a[i] * 256 + b[i]];
+    }
+}
+
+#ifdef INTERP_X86
+
+TARGET_AVX2 static inline __m256i
+Gather_AVX2(const unsigned char* a, const unsigned char* b, const unsigned char* table)
+{
+    __m256i va = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)a));
+    __m256i vb = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)b));
+    __m256i index = _mm256_add_epi32(_mm256_slli_epi32(va, 8), vb);
+
+    return _mm256_and_si256(_mm256_i32gather_epi32((const int*)table, index, 1), _mm256_set1_epi32(0xFF));
+}
+
+TARGET_AVX2 static void
+Blend_AVX2(int width, unsigned char* dst, const unsigned char* a, const unsigned char* b, const unsigned char* table)
+{
+    for (; width >= 16; width -= 16, a += 16, b += 16, dst += 16) {
+        __m256i lo = Gather_AVX2(a, b, table);
+        __m256i hi = Gather_AVX2(a + 8, b + 8, table);
+
+        /*
+        ** The packs work within each 128 bit lane, leaving pixels 0-3 and 8-11 in the low lane
+        ** and 4-7 and 12-15 in the high one.
+        */
+        __m256i words = _mm256_packus_epi32(lo, hi);
+        __m256i bytes = _mm256_packus_epi16(words, words);
+        __m128i low = _mm256_castsi256_si128(bytes);
+        __m128i high = _mm256_extracti128_si256(bytes, 1);
+
+        _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi32(low, high));
+    }
+
+    Blend_Scalar(width, dst, a, b, table);
+}
+
+#endif /* INTERP_X86 */
+
+static BlitLevelType Detect_Level()
+{
+    BlitLevelType level = Blit_Detect_Level();
+    return level == BLIT_AVX2 ? BLIT_AVX2 : BLIT_SCALAR;
+}
+
+static BlitLevelType InterpolateLevel = Detect_Level();
+
+static BlendFunc Blend_Kernel()
+{
+#ifdef INTERP_X86
+    if (InterpolateLevel == BLIT_AVX2) {
+        return Blend_AVX2;
+    }
+#endif
+    return Blend_Scalar;
+}
+
+BlitLevelType Set_Interpolate_Level(BlitLevelType level)
+{
+    BlitLevelType detected = Detect_Level();
+
+    InterpolateLevel = level >= BLIT_AVX2 ? detected : BLIT_SCALAR;
+    return InterpolateLevel;
+}
+
+BlitLevelType Get_Interpolate_Level()
+{
+    return InterpolateLevel;
+}
+
+/*
+** Which quarter step between two pixels the j'th of scale output pixels lands nearest to.
+*/
+static inline int Quarter(int j, int scale)
+{
+    return (4 * j + scale / 2) / scale;
+}
+
+/*
+** Stretch one source row to width * scale pixels. The last pixel has nothing to blend with
+** and is followed by black, as the original routines did.
+*/
+static void Expand_Row(const unsigned char* src,
+                       unsigned char* out,
+                       int width,
+                       int scale,
+                       unsigned char* scratch,
+                       BlendFunc blend,
+                       const unsigned char* table)
+{
+    int pairs = width - 1;
+    unsigned char* half = scratch;
+    unsigned char* quarter = scratch + width;
+    unsigned char* three_quarter = scratch + width * 2;
+
+    blend(pairs, half, src, src + 1, table);
+
+    if (scale == 2) {
+        for (int i = 0; i < pairs; ++i) {
+            out[i * 2] = src[i];
+            out[i * 2 + 1] = half[i];
+        }
+    } else {
+        blend(pairs, quarter, src, half, table);
+        blend(pairs, three_quarter, half, src + 1, table);
+
+        const unsigned char* steps[4] = {src, quarter, half, three_quarter};
+        const unsigned char* taps[MAX_TAPS];
+        int tapcount = scale < MAX_TAPS ? scale : MAX_TAPS;
+
+        for (int j = 0; j < tapcount; ++j) {
+            taps[j] = steps[Quarter(j, scale)];
+        }
+
+        for (int i = 0; i < pairs; ++i) {
+            unsigned char* block = out + i * scale;
+            for (int j = 0; j < scale; ++j) {
+                block[j] = j < MAX_TAPS ? taps[j][i] : steps[Quarter(j, scale)][i];
+            }
+        }
+    }
+
+    out[pairs * scale] = src[pairs];
+    memset(out + pairs * scale + 1, 0, scale - 1);
+}
+
+/*
+** Fill the rows of a block between two stretched source rows.
+*/
+static void Fill_Between(const unsigned char* top,
+                         const unsigned char* bottom,
+                         unsigned char* out,
+                         int width,
+                         int scale,
+                         int dst_pitch,
+                         unsigned char* half,
+                         BlendFunc blend,
+                         const unsigned char* table)
+{
+    blend(width, half, top, bottom, table);
+
+    for (int j = 1; j < scale; ++j) {
+        unsigned char* row = out + j * dst_pitch;
+
+        switch (Quarter(j, scale)) {
+        case 1:
+            blend(width, row, top, half, table);
+            break;
+        case 2:
+            memcpy(row, half, width);
+            break;
+        default:
+            blend(width, row, half, bottom, table);
+            break;
+        }
+    }
+}
+
+static void Scale_Band(const unsigned char* src,
+                       unsigned char* dst,
+                       int first,
+                       int last,
+                       int src_height,
+                       int src_width,
+                       int dst_pitch,
+                       int scale,
+                       int mode,
+                       const unsigned char* table,
+                       BlendFunc blend)
+{
+    static thread_local std::vector<unsigned char> scratch;
+
+    int out_width = src_width * scale;
+    scratch.resize(src_width * 3 + out_width * 3);
+
+    unsigned char* expand = &scratch[0];
+    unsigned char* top = expand + src_width * 3;
+    unsigned char* bottom = top + out_width;
+    unsigned char* half = bottom + out_width;
+
+    Expand_Row(src + first * src_width, top, src_width, scale, expand, blend, table);
+
+    for (int row = first; row < last; ++row) {
+        unsigned char* out = dst + row * scale * dst_pitch;
+        bool has_next = row + 1 < src_height;
+
+        memcpy(out, top, out_width);
+
+        if (has_next && (mode == 2 || row + 1 < last)) {
+            Expand_Row(src + (row + 1) * src_width, bottom, src_width, scale, expand, blend, table);
+        }
+
+        if (mode == 1) {
+            for (int j = 1; j < scale; ++j) {
+                memcpy(out + j * dst_pitch, top, out_width);
+            }
+        } else if (mode == 2 && has_next) {
+            Fill_Between(top, bottom, out, out_width, scale, dst_pitch, half, blend, table);
+        }
+
+        std::swap(top, bottom);
+    }
+}
+
+void Interpolate_Scale(const unsigned char* src,
+                       unsigned char* dst,
+                       int src_height,
+                       int src_width,
+                       int dst_pitch,
+                       int scale,
+                       int mode,
+                       const unsigned char* table)
+{
+    if (src_height <= 0 || src_width <= 0 || scale <= 0) {
+        return;
+    }
+
+    BlendFunc blend = Blend_Kernel();
+    int bands = src_height / MIN_BAND_ROWS;
+
+    if (bands > 1) {
+        WorkerPoolClass& pool = Worker_Pool();
+        if (bands > pool.Thread_Count()) {
+            bands = pool.Thread_Count();
+        }
+    }
+
+    if (bands <= 1) {
+        Scale_Band(src, dst, 0, src_height, src_height, src_width, dst_pitch, scale, mode, table, blend);
+        return;
+    }
+
+    Worker_Pool().Run(bands, [&](int band) {
+        int first = src_height * band / bands;
+        int last = src_height * (band + 1) / bands;
+        Scale_Band(src, dst, first, last, src_height, src_width, dst_pitch, scale, mode, table, blend);
+    });
+}
@@ -0,0 +1,41 @@
+#ifndef INTERPSCALE_H
+#define INTERPSCALE_H
+
+#include "blitsimd.h"
+
+/*
+** Palette interpolating upscaler used by Interpolate_2X_Scale. Each source pixel becomes a
+** scale x scale block, with the pixels between source pixels taken from the 256x256 palette
+** interpolation table. Blends other than the midpoint are built by blending twice, so each
+** output pixel uses the nearest quarter step between its neighbours.
+**
+** The mode matches Settings.Video.InterpolationMode:
+**
+** 0 - Interpolate along each row, only the first of every scale destination rows is written.
+** 1 - Interpolate along each row and repeat it down the block.
+** 2 - Interpolate along rows and between rows. The rows below the last source row are left
+**     alone.
+**
+** At a scale of 2 the output matches the Asm_Interpolate routines in winasm.cpp. Rows are
+** split across the shared worker pool.
+**
+** The table is read up to 3 bytes past its end, the InterpolationTable line buffers that
+** follow it cover this.
+*/
+void Interpolate_Scale(const unsigned char* src,
+                       unsigned char* dst,
+                       int src_height,
+                       int src_width,
+                       int dst_pitch,
+                       int scale,
+                       int mode,
+                       const unsigned char* table);
+
+/*
+** Select the instruction set the blend kernel uses, clamped to what the CPU supports. Only
+** AVX2 has the gathers the table lookups need, the other levels use the scalar kernel.
+*/
+BlitLevelType Set_Interpolate_Level(BlitLevelType level);
+BlitLevelType Get_Interpolate_Level();
+
+#endif /* INTERPSCALE_H */
@@ -9,6 +9,7 @@
 // distributed with this program. You should have received a copy of the
 // GNU General Public License along with permitted additional restrictions
 // with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+#include "blitsimd.h"
 #include "debugstring.h"
 #include "graphicsviewport.h"
 #include "keyframe.h"
@@ -630,7 +631,7 @@ void BF_Predator_Ghost_Fading_Trans(int width,
 }
 
 // Jump table for BF_* functions
-static const BF_Function OldShapeJumpTable[16] = {BF_Copy,
+static BF_Function OldShapeJumpTable[16] = {BF_Copy,
                                                   BF_Trans,
                                                   BF_Ghost,
                                                   BF_Ghost_Trans,
@@ -1171,12 +1172,213 @@ static Single_Line_Function NewShapeJumpTable[32] = {Single_Line_Copy,
                                                      Single_Line_Skip,
                                                      Single_Line_Skip};
 
+// Vector versions of the most common blitters, these call the row kernels from blitsimd.cpp
+// for the level chosen by Set_Shape_Blit_Level and must produce the same pixels as the BF_*
+// and Single_Line_* versions above.
+static BlitKernelsType ShapeKernels;
+static BlitLevelType ShapeBlitLevel = BLIT_SCALAR;
+
+// Applying the fade table count times is the same as a single lookup into the composed table.
+static void Build_Fade_Table(unsigned char* table, unsigned char* fade_tab, int count)
+{
+    for (int i = 0; i < 256; ++i) {
+        unsigned char sbyte = i;
+
+        for (int j = 0; j < count; ++j) {
+            sbyte = fade_tab[sbyte];
+        }
+
+        table[i] = sbyte;
+    }
+}
+
+void BF_Trans_Vector(int width,
+                     int height,
+                     unsigned char* dst,
+                     unsigned char* src,
+                     int dst_pitch,
+                     int src_pitch,
+                     unsigned char* ghost_lookup,
+                     unsigned char* ghost_tab,
+                     unsigned char* fade_tab,
+                     int count)
+{
+    while (height--) {
+        ShapeKernels.Trans(width, dst, src);
+        src += width + src_pitch;
+        dst += width + dst_pitch;
+    }
+}
+
+void BF_Ghost_Vector(int width,
+                     int height,
+                     unsigned char* dst,
+                     unsigned char* src,
+                     int dst_pitch,
+                     int src_pitch,
+                     unsigned char* ghost_lookup,
+                     unsigned char* ghost_tab,
+                     unsigned char* fade_tab,
+                     int count)
+{
+    while (height--) {
+        ShapeKernels.Ghost(width, dst, src, ghost_lookup, ghost_tab);
+        src += width + src_pitch;
+        dst += width + dst_pitch;
+    }
+}
+
+void BF_Ghost_Trans_Vector(int width,
+                           int height,
+                           unsigned char* dst,
+                           unsigned char* src,
+                           int dst_pitch,
+                           int src_pitch,
+                           unsigned char* ghost_lookup,
+                           unsigned char* ghost_tab,
+                           unsigned char* fade_tab,
+                           int count)
+{
+    while (height--) {
+        ShapeKernels.Ghost_Trans(width, dst, src, ghost_lookup, ghost_tab);
+        src += width + src_pitch;
+        dst += width + dst_pitch;
+    }
+}
+
+void BF_Fading_Vector(int width,
+                      int height,
+                      unsigned char* dst,
+                      unsigned char* src,
+                      int dst_pitch,
+                      int src_pitch,
+                      unsigned char* ghost_lookup,
+                      unsigned char* ghost_tab,
+                      unsigned char* fade_tab,
+                      int count)
+{
+    // Composing the table costs more than it saves on very small frames.
+    if (width * height * count < 256) {
+        BF_Fading(width, height, dst, src, dst_pitch, src_pitch, ghost_lookup, ghost_tab, fade_tab, count);
+        return;
+    }
+
+    unsigned char table[256];
+    Build_Fade_Table(table, fade_tab, count);
+
+    while (height--) {
+        ShapeKernels.Lut(width, dst, src, table);
+        src += width + src_pitch;
+        dst += width + dst_pitch;
+    }
+}
+
+void BF_Fading_Trans_Vector(int width,
+                            int height,
+                            unsigned char* dst,
+                            unsigned char* src,
+                            int dst_pitch,
+                            int src_pitch,
+                            unsigned char* ghost_lookup,
+                            unsigned char* ghost_tab,
+                            unsigned char* fade_tab,
+                            int count)
+{
+    if (width * height * count < 256) {
+        BF_Fading_Trans(width, height, dst, src, dst_pitch, src_pitch, ghost_lookup, ghost_tab, fade_tab, count);
+        return;
+    }
+
+    unsigned char table[256];
+    Build_Fade_Table(table, fade_tab, count);
+
+    while (height--) {
+        ShapeKernels.Lut_Trans(width, dst, src, table);
+        src += width + src_pitch;
+        dst += width + dst_pitch;
+    }
+}
+
+void Single_Line_Trans_Vector(int width,
+                              unsigned char* dst,
+                              unsigned char* src,
+                              unsigned char* ghost_lookup,
+                              unsigned char* ghost_tab,
+                              unsigned char* fade_tab,
+                              int count)
+{
+    ShapeKernels.Trans(width, dst, src);
+}
+
+void Single_Line_Ghost_Vector(int width,
+                              unsigned char* dst,
+                              unsigned char* src,
+                              unsigned char* ghost_lookup,
+                              unsigned char* ghost_tab,
+                              unsigned char* fade_tab,
+                              int count)
+{
+    ShapeKernels.Ghost(width, dst, src, ghost_lookup, ghost_tab);
+}
+
+void Single_Line_Ghost_Trans_Vector(int width,
+                                    unsigned char* dst,
+                                    unsigned char* src,
+                                    unsigned char* ghost_lookup,
+                                    unsigned char* ghost_tab,
+                                    unsigned char* fade_tab,
+                                    int count)
+{
+    ShapeKernels.Ghost_Trans(width, dst, src, ghost_lookup, ghost_tab);
+}
+
+BlitLevelType Set_Shape_Blit_Level(BlitLevelType level)
+{
+    BlitLevelType best = Blit_Detect_Level();
+
+    if (level > best) {
+        level = best;
+    }
+
+    if (level <= BLIT_SCALAR || !Blit_Get_Kernels(level, ShapeKernels)) {
+        level = BLIT_SCALAR;
+        OldShapeJumpTable[1] = BF_Trans;
+        OldShapeJumpTable[2] = BF_Ghost;
+        OldShapeJumpTable[3] = BF_Ghost_Trans;
+        OldShapeJumpTable[4] = BF_Fading;
+        OldShapeJumpTable[5] = BF_Fading_Trans;
+        NewShapeJumpTable[1] = Single_Line_Trans;
+        NewShapeJumpTable[2] = Single_Line_Ghost;
+        NewShapeJumpTable[3] = Single_Line_Ghost_Trans;
+    } else {
+        OldShapeJumpTable[1] = BF_Trans_Vector;
+        OldShapeJumpTable[2] = BF_Ghost_Vector;
+        OldShapeJumpTable[3] = BF_Ghost_Trans_Vector;
+        OldShapeJumpTable[4] = BF_Fading_Vector;
+        OldShapeJumpTable[5] = BF_Fading_Trans_Vector;
+        NewShapeJumpTable[1] = Single_Line_Trans_Vector;
+        NewShapeJumpTable[2] = Single_Line_Ghost_Vector;
+        NewShapeJumpTable[3] = Single_Line_Ghost_Trans_Vector;
+    }
+
+    ShapeBlitLevel = level;
+    return level;
+}
+
+BlitLevelType Get_Shape_Blit_Level()
+{
+    return ShapeBlitLevel;
+}
+
+// Pick the best blitters the CPU supports before anything is drawn.
+static BlitLevelType InitialShapeBlitLevel = Set_Shape_Blit_Level(BLIT_AVX2);
+
 // Definition copied from 2keyfram.cpp
 typedef struct tShapeHeaderType
 {
     unsigned draw_flags;
     char* shape_data;
-    int shape_buffer; // 1 if shape is in theater buffer
+    int shape_buffer; // 1 if shape is a theater shape
 } ShapeHeaderType;
 
 // Copied from conquer.cpp
@@ -1269,13 +1471,7 @@ void Buffer_Frame_To_Page(int x,
     } else*/
     if (UseBigShapeBuffer) {
         draw_header = static_cast<ShapeHeaderType*>(shape);
-        unsigned char* shape_buff = reinterpret_cast<unsigned char*>(BigShapeBufferStart);
-
-        if (draw_header->shape_buffer) {
-            shape_buff = reinterpret_cast<unsigned char*>(TheaterShapeBufferStart);
-        }
-
-        frame_data = shape_buff + (uintptr_t)draw_header->shape_data;
+        frame_data = reinterpret_cast<unsigned char*>(draw_header->shape_data);
         // use_old_drawer = false;
     }
 
@@ -41,6 +41,7 @@
 #include "keyframe.h"
 #include "debugstring.h"
 #include "endianness.h"
+#include "settings.h"
 
 #include <string.h>
 
@@ -63,56 +64,128 @@ typedef struct
 
 #pragma pack(pop)
 
-#define INITIAL_BIG_SHAPE_BUFFER_SIZE 12000 * 1024
-#define THEATER_BIG_SHAPE_BUFFER_SIZE 2000 * 1024
-#define UNCOMPRESS_MAGIC_NUMBER       56789
+#define UNCOMPRESS_MAGIC_NUMBER 56789
 
 static unsigned short CurrentUncompressMagicNum = UNCOMPRESS_MAGIC_NUMBER;
-static int BigShapeBufferLength = INITIAL_BIG_SHAPE_BUFFER_SIZE;
-static int TheaterShapeBufferLength = THEATER_BIG_SHAPE_BUFFER_SIZE;
-char* BigShapeBufferStart = nullptr;
-char* TheaterShapeBufferStart = nullptr;
 unsigned int UseBigShapeBuffer = false;
 unsigned int IsTheaterShape = false;
-static char* BigShapeBufferPtr = nullptr;
-static int TotalBigShapes = 0;
 static bool ReallocShapeBufferFlag = false;
 static bool OriginalUseBigShapeBuffer = false;
-static const bool AllowBigShapeBufRealloc = false;
-
-/* Get amount of free memory on bigshapebuffer.  */
-#define BIGSHPBUF_AVAILABLE(x) (((ptrdiff_t)BigShapeBufferStart + BigShapeBufferLength) - (ptrdiff_t)(x))
-
-/* Get amount of free memory on theatershapebuffer.  */
-#define THEATERSHPBUF_AVAILABLE(x) (((intptr_t)TheaterShapeBufferStart + TheaterShapeBufferLength) - (intptr_t)(x))
-
-char* TheaterShapeBufferPtr = nullptr;
-int TotalTheaterShapes = 0;
 
 #define MAX_SLOTS          1500
 #define THEATER_SLOT_START 1000
 
-char** KeyFrameSlots[MAX_SLOTS];
-int TotalSlotsUsed = 0;
-int TheaterSlotsUsed = THEATER_SLOT_START;
-
 typedef struct tShapeHeaderType
 {
     unsigned draw_flags;
     char* shape_data;
-    int shape_buffer; // 1 if shape is in theater buffer
+    int shape_buffer; // 1 if shape is a theater shape
 } ShapeHeaderType;
 
+/*
+** Each uncompressed frame is kept in its own block. The block starts with the cache entry,
+** followed by the ShapeHeaderType and line flags the drawers expect and then the pixels.
+** Entries are kept in most recently used order so when the cache grows past its budget only
+** the frames that have not been drawn for the longest time are thrown away.
+*/
+typedef struct tShapeCacheEntryType
+{
+    tShapeCacheEntryType* Prev;
+    tShapeCacheEntryType* Next;
+    unsigned short Slot;
+    unsigned short Frame;
+    int Size;
+} ShapeCacheEntryType;
+
+static ShapeCacheEntryType** KeyFrameSlots[MAX_SLOTS];
+static int TotalSlotsUsed = 0;
+static int TheaterSlotsUsed = THEATER_SLOT_START;
+
+static ShapeCacheEntryType* CacheHead = nullptr; // Most recently used.
+static ShapeCacheEntryType* CacheTail = nullptr; // Least recently used.
+static ShapeCacheStatsType CacheStats;
+static bool SlotsExhausted = false;
+
 static int Length;
 
-void* Get_Shape_Header_Data(void* ptr)
+static ShapeHeaderType* Cache_Header(ShapeCacheEntryType* entry)
 {
-    if (UseBigShapeBuffer) {
+    return reinterpret_cast<ShapeHeaderType*>(entry + 1);
+}
 
-        ShapeHeaderType* header = (ShapeHeaderType*)ptr;
-        return ((void*)(header->shape_data
-                        + (uintptr_t)(header->shape_buffer ? TheaterShapeBufferStart : BigShapeBufferStart)));
+static void Cache_Unlink(ShapeCacheEntryType* entry)
+{
+    if (entry->Prev) {
+        entry->Prev->Next = entry->Next;
+    } else {
+        CacheHead = entry->Next;
+    }
 
+    if (entry->Next) {
+        entry->Next->Prev = entry->Prev;
+    } else {
+        CacheTail = entry->Prev;
+    }
+
+    entry->Prev = nullptr;
+    entry->Next = nullptr;
+}
+
+static void Cache_Push_Front(ShapeCacheEntryType* entry)
+{
+    entry->Prev = nullptr;
+    entry->Next = CacheHead;
+
+    if (CacheHead) {
+        CacheHead->Prev = entry;
+    } else {
+        CacheTail = entry;
+    }
+
+    CacheHead = entry;
+}
+
+static void Cache_Free(ShapeCacheEntryType* entry)
+{
+    Cache_Unlink(entry);
+    KeyFrameSlots[entry->Slot][entry->Frame] = nullptr;
+    CacheStats.Bytes -= entry->Size;
+    CacheStats.Entries--;
+    delete[] reinterpret_cast<char*>(entry);
+}
+
+/*
+** Free every cached frame that belongs to a slot in [first, last).
+*/
+static void Cache_Free_Slots(int first, int last)
+{
+    ShapeCacheEntryType* entry = CacheHead;
+
+    while (entry) {
+        ShapeCacheEntryType* next = entry->Next;
+
+        if (entry->Slot >= first && entry->Slot < last) {
+            Cache_Free(entry);
+        }
+
+        entry = next;
+    }
+
+    for (int i = first; i < last; i++) {
+        delete[] KeyFrameSlots[i];
+        KeyFrameSlots[i] = nullptr;
+    }
+}
+
+static size_t Shape_Cache_Budget()
+{
+    return size_t(Settings.Video.ShapeCacheSize > 0 ? Settings.Video.ShapeCacheSize : 1) * 1024 * 1024;
+}
+
+void* Get_Shape_Header_Data(void* ptr)
+{
+    if (UseBigShapeBuffer) {
+        return ((ShapeHeaderType*)ptr)->shape_data;
     } else {
         return (ptr);
     }
@@ -123,66 +196,57 @@ int Get_Last_Frame_Length(void)
     return (Length);
 }
 
-void Reset_Theater_Shapes(void)
+void Get_Shape_Cache_Stats(ShapeCacheStatsType& stats)
 {
-    /*
-    ** Delete any previously allocated slots
-    */
-    for (int i = THEATER_SLOT_START; i < TheaterSlotsUsed; i++) {
-        delete[] KeyFrameSlots[i];
-    }
+    stats = CacheStats;
+}
 
-    TheaterShapeBufferPtr = TheaterShapeBufferStart;
-    TotalTheaterShapes = 0;
+void Reset_Theater_Shapes(void)
+{
+    Cache_Free_Slots(THEATER_SLOT_START, TheaterSlotsUsed);
     TheaterSlotsUsed = THEATER_SLOT_START;
 }
 
 void Reset_BigShapeBuffer(void)
 {
-    for (int i = 0; i < TotalSlotsUsed; i++) {
-        delete[] KeyFrameSlots[i];
-        KeyFrameSlots[i] = NULL;
-    }
-
-    BigShapeBufferPtr = BigShapeBufferStart;
-    TotalBigShapes = 0;
+    Cache_Free_Slots(0, TotalSlotsUsed);
     TotalSlotsUsed = 0;
 }
 
-extern void Memory_Error_Handler();
+void Free_Shape_Cache(void)
+{
+    Reset_Theater_Shapes();
+    Reset_BigShapeBuffer();
+    CurrentUncompressMagicNum++;
+}
 
+/*
+** Called between game frames once Build_Frame has flagged that the cache needs attention. No
+** frame pointers are held at this point so cold frames can be released safely.
+*/
 void Reallocate_Big_Shape_Buffer()
 {
     if (!ReallocShapeBufferFlag)
         return;
 
-    if (AllowBigShapeBufRealloc) {
-        BigShapeBufferLength += 2000 * 1024; // Extra 2 Mb of uncompressed shape space
-        BigShapeBufferPtr -= (uintptr_t)BigShapeBufferStart;
-        Memory_Error = nullptr;
-        BigShapeBufferStart = (char*)Resize_Alloc(BigShapeBufferStart, BigShapeBufferLength);
-        Memory_Error = &Memory_Error_Handler;
-        /*
-        ** If we have run out of memory then disable the uncompressed shapes
-        ** It may still be possible to continue with compressed shapes
-        */
-        if (!BigShapeBufferStart) {
-            UseBigShapeBuffer = false;
-            return;
-        }
-        BigShapeBufferPtr += (uintptr_t)BigShapeBufferStart;
-    } else {
-        // mrparrot 2021-11-22: A better alternative to disabling bigshapebuffer
-        // is flushing and refilling it in the hope of discarding shapes not
-        // very often used, like enemy building animations, radar animations,
-        // and so on.
-        Reset_Theater_Shapes();
-        Reset_BigShapeBuffer();
-        CurrentUncompressMagicNum++;
-        DBG_LOG("BigShpBuf: flushed. Rebuilding and re-enabling.");
+    /*
+    ** Slot numbers are stamped into the shape data and never reused, if they have run out then
+    ** start over with an empty cache.
+    */
+    if (SlotsExhausted) {
+        Free_Shape_Cache();
+        SlotsExhausted = false;
+        DBG_LOG("ShapeCache: out of slots, flushed.");
+    }
+
+    size_t budget = Shape_Cache_Budget();
+
+    while (CacheStats.Bytes > budget && CacheTail) {
+        Cache_Free(CacheTail);
+        CacheStats.Evictions++;
     }
+
     ReallocShapeBufferFlag = false;
-    UseBigShapeBuffer = true;
 }
 
 void Check_Use_Compressed_Shapes()
@@ -248,10 +312,9 @@ uintptr_t Build_Frame(void const* dataptr, unsigned short framenumber, void* buf
     unsigned short buffsize, currframe, subframe;
     unsigned int length = 0;
     char frameflags;
-    uintptr_t return_value;
-    char* temp_shape_ptr;
     unsigned short keyfr_frames;
     int i;
+    bool cache_frame = true;
 
     //
     // valid pointer??
@@ -279,58 +342,62 @@ uintptr_t Build_Frame(void const* dataptr, unsigned short framenumber, void* buf
     }
 
     if (UseBigShapeBuffer) {
-        /*
-        ** If we havnt yet allocated memory for uncompressed shapes then do so now.
-        **
-        */
-        if (!BigShapeBufferStart) {
-            BigShapeBufferStart = (char*)Alloc(BigShapeBufferLength, MEM_NORMAL);
-            BigShapeBufferPtr = BigShapeBufferStart;
-
-            /*
-            ** Allocate memory for theater specific uncompressed shapes
-            */
-            TheaterShapeBufferStart = (char*)Alloc(TheaterShapeBufferLength, MEM_NORMAL);
-            TheaterShapeBufferPtr = TheaterShapeBufferStart;
-        }
-
         /*
         ** If this animation was not previously uncompressed then
         ** allocate memory to keep the pointers to the uncompressed data
         ** for these animation frames
         */
-        if (keyfr.x != CurrentUncompressMagicNum) {
-            keyfr.x = CurrentUncompressMagicNum;
-            if (IsTheaterShape) {
-                keyfr.y = TheaterSlotsUsed;
-                TheaterSlotsUsed++;
-            } else {
-                keyfr.y = TotalSlotsUsed;
-                TotalSlotsUsed++;
-            }
-            // Commit back to the original pointer.
-            unsigned short x = htole16(keyfr.x);
-            unsigned short y = htole16(keyfr.y);
-            memcpy(Add_Long_To_Pointer(dataptr, offsetof(KeyFrameHeaderType, x)), &x, sizeof(unsigned short));
-            memcpy(Add_Long_To_Pointer(dataptr, offsetof(KeyFrameHeaderType, y)), &y, sizeof(unsigned short));
+        if (keyfr.x != CurrentUncompressMagicNum || keyfr.y >= MAX_SLOTS || KeyFrameSlots[keyfr.y] == nullptr) {
+            int slot = IsTheaterShape ? TheaterSlotsUsed : TotalSlotsUsed;
 
             /*
-            ** Allocate and clear the memory for the shape info
+            ** Out of slots, draw this one from the scratch buffer until the cache is flushed.
             */
-            KeyFrameSlots[keyfr.y] = new char*[keyfr.frames];
-            memset(KeyFrameSlots[keyfr.y], 0, keyfr.frames * sizeof(char*));
+            if (slot >= (IsTheaterShape ? MAX_SLOTS : THEATER_SLOT_START)) {
+                SlotsExhausted = true;
+                ReallocShapeBufferFlag = true;
+                cache_frame = false;
+            } else {
+                keyfr.x = CurrentUncompressMagicNum;
+                keyfr.y = slot;
+                if (IsTheaterShape) {
+                    TheaterSlotsUsed++;
+                } else {
+                    TotalSlotsUsed++;
+                }
+                // Commit back to the original pointer.
+                unsigned short x = htole16(keyfr.x);
+                unsigned short y = htole16(keyfr.y);
+                memcpy(Add_Long_To_Pointer(dataptr, offsetof(KeyFrameHeaderType, x)), &x, sizeof(unsigned short));
+                memcpy(Add_Long_To_Pointer(dataptr, offsetof(KeyFrameHeaderType, y)), &y, sizeof(unsigned short));
+
+                /*
+                ** Allocate and clear the memory for the shape info
+                */
+                KeyFrameSlots[keyfr.y] = new ShapeCacheEntryType*[keyfr.frames];
+                memset(KeyFrameSlots[keyfr.y], 0, keyfr.frames * sizeof(ShapeCacheEntryType*));
+            }
         }
 
         /*
         ** If this frame was previously uncompressed then just return
         ** a pointer to the raw data
         */
-        if (*(KeyFrameSlots[keyfr.y] + framenumber)) {
-            if (IsTheaterShape) {
-                return ((uintptr_t)TheaterShapeBufferStart + (uintptr_t) * (KeyFrameSlots[keyfr.y] + framenumber));
-            } else {
-                return ((uintptr_t)BigShapeBufferStart + (uintptr_t) * (KeyFrameSlots[keyfr.y] + framenumber));
+        if (cache_frame) {
+            ShapeCacheEntryType* entry = KeyFrameSlots[keyfr.y][framenumber];
+
+            if (entry) {
+                CacheStats.Hits++;
+
+                if (entry != CacheHead) {
+                    Cache_Unlink(entry);
+                    Cache_Push_Front(entry);
+                }
+
+                return ((uintptr_t)Cache_Header(entry));
             }
+
+            CacheStats.Misses++;
         }
     }
 
@@ -441,86 +508,42 @@ uintptr_t Build_Frame(void const* dataptr, unsigned short framenumber, void* buf
         }
     }
 
-    if (UseBigShapeBuffer) {
+    if (UseBigShapeBuffer && cache_frame) {
         /*
         ** Save the uncompressed shape data so we dont have to uncompress it
         ** again next time its drawn.
         ** We keep a space free before the raw shape data so we can add line
         ** header info before the shape is drawn for the first time
         */
+        int data_offset = (sizeof(ShapeCacheEntryType) + sizeof(ShapeHeaderType) + keyfr.height + 3) & ~3;
+        int size = data_offset + length;
+        char* block = new char[size];
+
+        ShapeCacheEntryType* entry = reinterpret_cast<ShapeCacheEntryType*>(block);
+        entry->Slot = keyfr.y;
+        entry->Frame = framenumber;
+        entry->Size = size;
+
+        ShapeHeaderType* header = Cache_Header(entry);
+        header->draw_flags = -1; // Flag that headers need to be generated
+        header->shape_data = block + data_offset;
+        header->shape_buffer = IsTheaterShape ? 1 : 0;
+        memcpy(header->shape_data, buffptr, length);
+
+        KeyFrameSlots[keyfr.y][framenumber] = entry;
+        Cache_Push_Front(entry);
+        CacheStats.Bytes += size;
+        CacheStats.Entries++;
 
-        if (IsTheaterShape) {
-            /*
-            ** Shape is a theater specific shape
-            */
-            return_value = (uintptr_t)TheaterShapeBufferPtr;
-            temp_shape_ptr = TheaterShapeBufferPtr + keyfr.height + sizeof(ShapeHeaderType);
-            /*
-            ** align the actual shape data
-            */
-            if (3 & (uintptr_t)temp_shape_ptr) {
-                temp_shape_ptr = (char*)((uintptr_t)(temp_shape_ptr + 3) & ~3);
-            }
-
-            /* Check if it will fit. Else, disable TheaterShpBuffer temporarly.  */
-            if (THEATERSHPBUF_AVAILABLE(temp_shape_ptr) < (int)length && !AllowBigShapeBufRealloc) {
-                DBG_LOG("TheaterShpBuf: shape won't fit. Disabling it temporarly...");
-                UseBigShapeBuffer = false;
-                ReallocShapeBufferFlag = true;
-
-                return (uintptr_t)buffptr;
-            }
-
-            memcpy(temp_shape_ptr, buffptr, length);
-            ((ShapeHeaderType*)TheaterShapeBufferPtr)->draw_flags = -1; // Flag that headers need to be generated
-            ((ShapeHeaderType*)TheaterShapeBufferPtr)->shape_data =
-                temp_shape_ptr - (uintptr_t)TheaterShapeBufferStart;     // pointer to old raw shape data
-            ((ShapeHeaderType*)TheaterShapeBufferPtr)->shape_buffer = 1; // Theater buffer
-            *(KeyFrameSlots[keyfr.y] + framenumber) = TheaterShapeBufferPtr - (uintptr_t)TheaterShapeBufferStart;
-            TheaterShapeBufferPtr = (char*)(length + (uintptr_t)temp_shape_ptr);
-            /*
-            ** Align the next shape
-            */
-            if (3 & (uintptr_t)TheaterShapeBufferPtr) {
-                TheaterShapeBufferPtr = (char*)((uintptr_t)(TheaterShapeBufferPtr + 3) & ~3);
-            }
-            Length = length;
-            return (return_value);
-
-        } else {
-            return_value = (uintptr_t)BigShapeBufferPtr;
-            temp_shape_ptr = BigShapeBufferPtr + keyfr.height + sizeof(ShapeHeaderType);
-            /*
-            ** align the actual shape data
-            */
-            if (3 & (uintptr_t)temp_shape_ptr) {
-                temp_shape_ptr = (char*)((uintptr_t)(temp_shape_ptr + 3) & ~3);
-            }
-
-            /* Check if it will fit. Else, disable BigShpBuffer temporarly.  */
-            if (BIGSHPBUF_AVAILABLE(temp_shape_ptr) <= (int)length) {
-                DBG_LOG("BigShpBuf: shape won't fit. Disabling it temporarly...");
-                UseBigShapeBuffer = false;
-                ReallocShapeBufferFlag = true;
-
-                return (uintptr_t)buffptr;
-            }
-
-            memcpy(temp_shape_ptr, buffptr, length);
-            ((ShapeHeaderType*)BigShapeBufferPtr)->draw_flags = -1; // Flag that headers need to be generated
-            ((ShapeHeaderType*)BigShapeBufferPtr)->shape_data =
-                temp_shape_ptr - (uintptr_t)BigShapeBufferStart;     // pointer to old raw shape data
-            ((ShapeHeaderType*)BigShapeBufferPtr)->shape_buffer = 0; // Normal Big Shape Buffer
-            *(KeyFrameSlots[keyfr.y] + framenumber) = BigShapeBufferPtr - (uintptr_t)BigShapeBufferStart;
-            BigShapeBufferPtr = (char*)(length + (uintptr_t)temp_shape_ptr);
-            // Align the next shape
-            if (3 & (uintptr_t)BigShapeBufferPtr) {
-                BigShapeBufferPtr = (char*)((uintptr_t)(BigShapeBufferPtr + 3) & ~3);
-            }
-            Length = length;
-            return (return_value);
+        /*
+        ** Frames drawn this game frame must stay put, trim the cache once it is over.
+        */
+        if (CacheStats.Bytes > Shape_Cache_Budget()) {
+            ReallocShapeBufferFlag = true;
         }
 
+        Length = length;
+        return ((uintptr_t)header);
     } else {
         return ((uintptr_t)buffptr);
     }
@@ -1,6 +1,7 @@
 #ifndef KEYFRAME_H
 #define KEYFRAME_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 typedef enum
@@ -13,10 +14,17 @@ typedef enum
     KF_MASK = 0xF0
 } KeyFrameType;
 
+typedef struct
+{
+    unsigned Hits;
+    unsigned Misses;
+    unsigned Evictions;
+    unsigned Entries;
+    size_t Bytes;
+} ShapeCacheStatsType;
+
 extern unsigned int IsTheaterShape;
 extern unsigned int UseBigShapeBuffer;
-extern char* BigShapeBufferStart;
-extern char* TheaterShapeBufferStart;
 extern bool UseOldShapeDraw;
 
 uintptr_t Build_Frame(void const* dataptr, unsigned short framenumber, void* buffptr);
@@ -27,5 +35,7 @@ unsigned short Get_Build_Frame_Width(void const* dataptr);
 unsigned short Get_Build_Frame_Height(void const* dataptr);
 bool Get_Build_Frame_Palette(void const* dataptr, void* palette);
 int Get_Last_Frame_Length(void);
+void Get_Shape_Cache_Stats(ShapeCacheStatsType& stats);
+void Free_Shape_Cache(void);
 
 #endif // KEYFRAME_H
@@ -44,6 +44,8 @@
  *   XMP_DER_Length_Encode -- Output the length of a DER block.                                *
  *   XMP_Double_Mul -- Double precision MP multiply.                                           *
  *   XMP_Encode -- Encode MP number into buffer as compactly as possible.                      *
+ *   XMP_Exponent_Mod_Montgomery -- Modular exponentiation with 64 bit Montgomery arithmetic.  *
+ *   XMP_Exponent_Mod_Smith -- Modular exponentiation with Smith's modulo reduction.           *
  *   XMP_Fermat_Test -- Performs Fermat's Little Theorem on an MP number.                      *
  *   XMP_Hybrid_Mul -- Special hybrid short multiply (with carry).                             *
  *   XMP_Inc -- Increment an MP number by one.                                                 *
@@ -2057,10 +2059,14 @@ int XMP_Mod_Mult(digit* prod, const digit* multiplicand, const digit* multiplier
 
                 /* Perform correction if q too large.
                 **  This rarely occurs.
+                **  The borrow goes just above the digits subtracted. That is only
+                **  the top MULTUNIT when the modulus fills its top digit, otherwise
+                **  the subtraction already covered the top MULTUNIT.
                 */
                 if (!(Get_HalfWord(dmph, dmph_offset) & SEMI_UPPER_MOST_BIT)) {
                     if (XMP_Sub(dmpl, dmpl_offset, dmpl, dmpl_offset, _scratch_modulus, false, precision)) {
-                        Set_HalfWord(dmph, dmph_offset, Get_HalfWord(dmph, dmph_offset) - 1);
+                        size_t borrow_offset = dmpl_offset + precision * 2;
+                        Set_HalfWord(dmph, borrow_offset, Get_HalfWord(dmph, borrow_offset) - 1);
                     }
                 }
             }
@@ -2158,12 +2164,45 @@ uint16_t mp_quo_digit(uint16_t* dividend, size_t dividend_offset)
 }
 
 /*
-** Russian peasant combined exponentiation/modulo algorithm.
-** Calls modmult instead of mult.
 ** Computes:  expout = (expin**exponent) mod modulus
+** with whichever of the routines below the build selected. Montgomery
+** arithmetic needs an odd modulus, which every RSA modulus is.
 ** WARNING: All the arguments must be less than the modulus!
 */
 int xmp_exponent_mod(digit* expout, const digit* expin, const digit* exponent_ptr, const digit* modulus, int precision)
+{
+#ifdef XMP_MONTGOMERY
+    if (modulus[0] & 1) {
+        return XMP_Exponent_Mod_Montgomery(expout, expin, exponent_ptr, modulus, precision);
+    }
+#endif
+    return XMP_Exponent_Mod_Smith(expout, expin, exponent_ptr, modulus, precision);
+}
+
+/***********************************************************************************************
+ * XMP_Exponent_Mod_Smith -- Modular exponentiation with Smith's modulo reduction.             *
+ *                                                                                             *
+ *    Russian peasant combined exponentiation/modulo algorithm. Calls modmult instead of mult. *
+ *                                                                                             *
+ * INPUT:   expout      -- Pointer to the MP buffer that will hold the result.                 *
+ *                                                                                             *
+ *          expin       -- The number to raise to the power.                                   *
+ *                                                                                             *
+ *          exponent_ptr-- The power to raise it to.                                           *
+ *                                                                                             *
+ *          modulus     -- The modulus to reduce the result by.                                *
+ *                                                                                             *
+ *          precision   -- The precision of the MP numbers involved.                           *
+ *                                                                                             *
+ * OUTPUT:  Returns 0 on success or a negative error code.                                     *
+ *                                                                                             *
+ * WARNINGS:   All the arguments must be less than the modulus!                                *
+ *=============================================================================================*/
+int XMP_Exponent_Mod_Smith(digit* expout,
+                           const digit* expin,
+                           const digit* exponent_ptr,
+                           const digit* modulus,
+                           int precision)
 {
     digit product[MAX_UNIT_PRECISION];
 
@@ -2245,6 +2284,267 @@ int xmp_exponent_mod(digit* expout, const digit* expin, const digit* exponent_pt
     return 0;
 }
 
+#ifdef XMP_MONTGOMERY
+
+/*
+** The Montgomery routines work on 64 bit limbs, two digits to a limb, with
+** products formed in 128 bits.
+*/
+typedef unsigned __int128 mont_wide;
+
+#define MONT_MAX_LIMBS  ((MAX_UNIT_PRECISION + 1) / 2)
+#define MONT_MAX_WINDOW 5
+
+typedef struct
+{
+    uint64_t Modulus[MONT_MAX_LIMBS];
+    uint64_t Inverse; // -1/Modulus mod 2^64
+    int Limbs;
+} MontgomeryType;
+
+static void Mont_From_Digits(uint64_t* r, const digit* d, int digits, int limbs)
+{
+    for (int i = 0; i < limbs; i++) {
+        uint64_t lo = (2 * i < digits) ? d[2 * i] : 0;
+        uint64_t hi = (2 * i + 1 < digits) ? d[2 * i + 1] : 0;
+        r[i] = lo | (hi << 32);
+    }
+}
+
+static void Mont_To_Digits(digit* d, const uint64_t* r, int digits)
+{
+    for (int i = 0; i < digits; i++) {
+        d[i] = (digit)(r[i / 2] >> ((i & 1) * 32));
+    }
+}
+
+static bool Mont_Sub(uint64_t* r, const uint64_t* a, const uint64_t* b, int limbs)
+{
+    uint64_t borrow = 0;
+
+    for (int i = 0; i < limbs; i++) {
+        mont_wide diff = (mont_wide)a[i] - b[i] - borrow;
+        r[i] = (uint64_t)diff;
+        borrow = (uint64_t)(diff >> 64) & 1;
+    }
+
+    return borrow != 0;
+}
+
+/*
+** r = a * b / 2^(64*limbs) mod modulus, interleaving the multiply with the
+** reduction a limb at a time. The result may alias either input.
+*/
+static void Mont_Mult(uint64_t* r, const uint64_t* a, const uint64_t* b, const MontgomeryType& mont)
+{
+    int n = mont.Limbs;
+    uint64_t t[MONT_MAX_LIMBS + 2];
+    memset(t, 0, sizeof(uint64_t) * (n + 2));
+
+    for (int i = 0; i < n; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < n; j++) {
+            mont_wide sum = (mont_wide)a[j] * b[i] + t[j] + carry;
+            t[j] = (uint64_t)sum;
+            carry = (uint64_t)(sum >> 64);
+        }
+        mont_wide sum = (mont_wide)t[n] + carry;
+        t[n] = (uint64_t)sum;
+        t[n + 1] = (uint64_t)(sum >> 64);
+
+        uint64_t m = t[0] * mont.Inverse;
+        sum = (mont_wide)m * mont.Modulus[0] + t[0];
+        carry = (uint64_t)(sum >> 64);
+        for (int j = 1; j < n; j++) {
+            sum = (mont_wide)m * mont.Modulus[j] + t[j] + carry;
+            t[j - 1] = (uint64_t)sum;
+            carry = (uint64_t)(sum >> 64);
+        }
+        sum = (mont_wide)t[n] + carry;
+        t[n - 1] = (uint64_t)sum;
+        t[n] = t[n + 1] + (uint64_t)(sum >> 64);
+    }
+
+    /*
+    **	The result is below twice the modulus, one subtraction brings it into range.
+    */
+    uint64_t reduced[MONT_MAX_LIMBS];
+    bool borrow = Mont_Sub(reduced, t, mont.Modulus, n);
+    if (t[n] != 0 || !borrow) {
+        memcpy(r, reduced, sizeof(uint64_t) * n);
+    } else {
+        memcpy(r, t, sizeof(uint64_t) * n);
+    }
+
+    memset(t, 0, sizeof(t));
+    memset(reduced, 0, sizeof(reduced));
+}
+
+/***********************************************************************************************
+ * XMP_Exponent_Mod_Montgomery -- Modular exponentiation with 64 bit Montgomery arithmetic.    *
+ *                                                                                             *
+ *    This gives the same results as XMP_Exponent_Mod_Smith, but works in Montgomery form on   *
+ *    64 bit limbs and takes the exponent a window of bits at a time, so it needs far fewer    *
+ *    and far cheaper multiplies. The odd powers of the base that a window can select are      *
+ *    worked out first.                                                                        *
+ *                                                                                             *
+ * INPUT:   expout      -- Pointer to the MP buffer that will hold the result.                 *
+ *                                                                                             *
+ *          expin       -- The number to raise to the power.                                   *
+ *                                                                                             *
+ *          exponent_ptr-- The power to raise it to.                                           *
+ *                                                                                             *
+ *          modulus     -- The modulus to reduce the result by, this must be odd.              *
+ *                                                                                             *
+ *          precision   -- The precision of the MP numbers involved.                           *
+ *                                                                                             *
+ * OUTPUT:  Returns 0 on success or a negative error code.                                     *
+ *                                                                                             *
+ * WARNINGS:   All the arguments must be less than the modulus!                                *
+ *=============================================================================================*/
+int XMP_Exponent_Mod_Montgomery(digit* expout,
+                                const digit* expin,
+                                const digit* exponent_ptr,
+                                const digit* modulus,
+                                int precision)
+{
+    XMP_Init(expout, 1, precision);
+    if (XMP_Test_Eq_Int(exponent_ptr, 0, precision)) {
+        if (XMP_Test_Eq_Int(expin, 0, precision)) {
+            return -1; /* 0 to the 0th power means return error */
+        }
+        return 0; /* otherwise, zero exponent means expout is 1 */
+    }
+
+    if (XMP_Test_Eq_Int(modulus, 0, precision)) {
+        return -2; /* zero modulus means error */
+    }
+
+    if (XMP_Compare(expin, modulus, precision) >= 0) {
+        return -3; /* if expin >= modulus, return error */
+    }
+
+    if (XMP_Compare(exponent_ptr, modulus, precision) >= 0) {
+        return -4; /* if exponent >= modulus, return error */
+    }
+
+    if ((modulus[0] & 1) == 0) {
+        return -5; /* Montgomery reduction needs an odd modulus */
+    }
+
+    int limited_precision = XMP_Significance(modulus, precision);
+
+    MontgomeryType mont;
+    mont.Limbs = (limited_precision + 1) / 2;
+    Mont_From_Digits(mont.Modulus, modulus, limited_precision, mont.Limbs);
+
+    /*
+    **	Newton's iteration doubles the correct low bits of the inverse each time, an odd
+    **	number is its own inverse to 3 bits.
+    */
+    uint64_t inverse = mont.Modulus[0];
+    for (int i = 0; i < 5; i++) {
+        inverse *= 2 - mont.Modulus[0] * inverse;
+    }
+    mont.Inverse = 0 - inverse;
+
+    /*
+    **	Find 2^(128*limbs) mod modulus, which takes numbers into Montgomery form. Doubling the
+    **	highest power of two below the modulus up to 2^(65*limbs) gives 2^limbs in Montgomery
+    **	form, squaring that six times gives 2^(64*limbs) in Montgomery form.
+    */
+    int n = mont.Limbs;
+    int modulus_bits = XMP_Count_Bits(modulus, limited_precision);
+    uint64_t square[MONT_MAX_LIMBS];
+    memset(square, 0, sizeof(square));
+    square[(modulus_bits - 1) / 64] = (uint64_t)1 << ((modulus_bits - 1) % 64);
+    for (int i = modulus_bits - 1; i < 65 * n; i++) {
+        uint64_t carry = square[n - 1] >> 63;
+        for (int j = n - 1; j > 0; j--) {
+            square[j] = (square[j] << 1) | (square[j - 1] >> 63);
+        }
+        square[0] <<= 1;
+
+        uint64_t reduced[MONT_MAX_LIMBS];
+        bool borrow = Mont_Sub(reduced, square, mont.Modulus, n);
+        if (carry != 0 || !borrow) {
+            memcpy(square, reduced, sizeof(uint64_t) * n);
+        }
+    }
+    for (int i = 0; i < 6; i++) {
+        Mont_Mult(square, square, square, mont);
+    }
+
+    int total_bit_count = XMP_Count_Bits(exponent_ptr, limited_precision);
+    int window = 1;
+    if (total_bit_count > 24) {
+        window = (total_bit_count > 80) ? ((total_bit_count > 240) ? ((total_bit_count > 672) ? 5 : 4) : 3) : 2;
+    }
+
+    /*
+    **	The odd powers expin^1, expin^3 ... expin^(2^window - 1) in Montgomery form.
+    */
+    uint64_t powers[1 << (MONT_MAX_WINDOW - 1)][MONT_MAX_LIMBS];
+    uint64_t result[MONT_MAX_LIMBS];
+    Mont_From_Digits(result, expin, limited_precision, n);
+    Mont_Mult(powers[0], result, square, mont);
+    Mont_Mult(result, powers[0], powers[0], mont);
+    for (int i = 1; i < (1 << (window - 1)); i++) {
+        Mont_Mult(powers[i], powers[i - 1], result, mont);
+    }
+
+    /*
+    **	Take the exponent from the top, squaring for each bit and multiplying in the power
+    **	for each window. A window starts and ends on a set bit so its power is always odd.
+    */
+    bool started = false;
+    int bit = total_bit_count - 1;
+    while (bit >= 0) {
+        if (!XMP_Test_Bit(exponent_ptr, bit)) {
+            Mont_Mult(result, result, result, mont);
+            bit--;
+            continue;
+        }
+
+        int low = std::max(bit - window + 1, 0);
+        while (!XMP_Test_Bit(exponent_ptr, low)) {
+            low++;
+        }
+
+        unsigned value = 0;
+        for (int i = bit; i >= low; i--) {
+            value = (value << 1) | (XMP_Test_Bit(exponent_ptr, i) ? 1 : 0);
+            if (started) {
+                Mont_Mult(result, result, result, mont);
+            }
+        }
+
+        if (started) {
+            Mont_Mult(result, result, powers[value >> 1], mont);
+        } else {
+            memcpy(result, powers[value >> 1], sizeof(uint64_t) * n);
+            started = true;
+        }
+        bit = low - 1;
+    }
+
+    /*
+    **	Multiplying by one takes the result back out of Montgomery form.
+    */
+    memset(square, 0, sizeof(square));
+    square[0] = 1;
+    Mont_Mult(result, result, square, mont);
+    Mont_To_Digits(expout, result, limited_precision);
+
+    /* burn the evidence */
+    memset(powers, 0, sizeof(powers));
+    memset(result, 0, sizeof(result));
+
+    return 0;
+}
+
+#endif
+
 int pfunc(const void* pkey, const void* base)
 {
     if (*(uint16_t*)pkey < *(uint16_t*)base)
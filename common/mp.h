@@ -52,6 +52,14 @@ extern uint16_t primeTable[3511];
 #define MAX_BIT_PRECISION   2048
 #define MAX_UNIT_PRECISION  (MAX_BIT_PRECISION / UNITSIZE)
 
+/*
+** Modular exponentiation uses 64 bit Montgomery arithmetic when the build asks
+** for it and the compiler has 128 bit integers.
+*/
+#if defined(MP_MONTGOMERY) && defined(__SIZEOF_INT128__)
+#define XMP_MONTGOMERY
+#endif
+
 int XMP_Significance(const digit* r, int precision);
 void XMP_Inc(digit* r, int precision);
 void XMP_Dec(digit* r, int precision);
@@ -86,6 +94,18 @@ int XMP_Mod_Mult(digit* prod, const digit* multiplicand, const digit* multiplier
 void XMP_Mod_Mult_Clear(int precision);
 uint16_t mp_quo_digit(uint16_t* dividend, size_t dividend_offset);
 int xmp_exponent_mod(digit* expout, const digit* expin, const digit* exponent_ptr, const digit* modulus, int precision);
+int XMP_Exponent_Mod_Smith(digit* expout,
+                           const digit* expin,
+                           const digit* exponent_ptr,
+                           const digit* modulus,
+                           int precision);
+#ifdef XMP_MONTGOMERY
+int XMP_Exponent_Mod_Montgomery(digit* expout,
+                                const digit* expin,
+                                const digit* exponent_ptr,
+                                const digit* modulus,
+                                int precision);
+#endif
 bool XMP_Is_Small_Prime(const digit* candidate, int precision);
 bool XMP_Small_Divisors_Test(const digit* candidate, int precision);
 bool XMP_Fermat_Test(const digit* candidate_prime, unsigned rounds, int precision);
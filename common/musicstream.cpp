@@ -0,0 +1,243 @@
+#include "musicstream.h"
+
+#include <string.h>
+
+MusicStreamClass::MusicStreamClass(int chunk_size, int chunks)
+    : ChunkSize(chunk_size)
+    , Chunks(chunks)
+    , Current(0)
+    , Quit(false)
+{
+    for (int i = 0; i < 2; ++i) {
+        Slots[i].Handle = -1;
+        Slots[i].Data = new char[ChunkSize * Chunks];
+        Slots[i].Sizes = new int[Chunks];
+        Slots[i].Head = 0;
+        Slots[i].Tail = 0;
+        Slots[i].End = false;
+        Slots[i].Busy = false;
+    }
+    memset(&Stats, 0, sizeof(Stats));
+}
+
+MusicStreamClass::~MusicStreamClass()
+{
+    /*
+    ** Tracks still open can't be closed from here, the derived class that closes them is gone.
+    ** It should have called Shutdown already, this just makes sure the reader is stopped.
+    */
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Quit = true;
+    }
+    WakeCond.notify_one();
+    if (Thread.joinable()) {
+        Thread.join();
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        delete[] Slots[i].Data;
+        delete[] Slots[i].Sizes;
+    }
+}
+
+bool MusicStreamClass::Prefetch(char const* name)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    SlotType& slot = Slots[1 - Current];
+
+    if (name != nullptr && slot.Handle != -1 && slot.Name == name) {
+        return true;
+    }
+
+    Close_Slot(slot, lock);
+    lock.unlock();
+
+    if (name == nullptr || !Open_Slot(slot, name)) {
+        return false;
+    }
+
+    lock.lock();
+    Stats.Prefetches++;
+    return true;
+}
+
+bool MusicStreamClass::Start(char const* name)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    Close_Slot(Slots[Current], lock);
+
+    SlotType& next = Slots[1 - Current];
+    if (next.Handle != -1 && next.Name == name) {
+        Current = 1 - Current;
+        Stats.Hits++;
+        Stats.LeadTime = unsigned(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - next.Prefetched)
+                .count());
+        return true;
+    }
+
+    Stats.Misses++;
+    lock.unlock();
+
+    return Open_Slot(Slots[Current], name);
+}
+
+bool MusicStreamClass::Start_Next()
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    SlotType& next = Slots[1 - Current];
+
+    if (next.Handle == -1) {
+        return false;
+    }
+
+    Close_Slot(Slots[Current], lock);
+    Current = 1 - Current;
+    Stats.Handoffs++;
+    Stats.LeadTime = unsigned(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - next.Prefetched)
+            .count());
+    return true;
+}
+
+int MusicStreamClass::Read(void* buffer, bool wait)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    SlotType& slot = Slots[Current];
+
+    if (slot.Handle == -1) {
+        return 0;
+    }
+
+    if (slot.Head == slot.Tail) {
+        if (slot.End) {
+            return 0;
+        }
+        if (!wait) {
+            return STREAM_WAIT;
+        }
+
+        Stats.Underruns++;
+        ReadCond.wait(lock, [&slot] { return slot.Head != slot.Tail || slot.End; });
+
+        if (slot.Head == slot.Tail) {
+            return 0;
+        }
+    }
+
+    /*
+    ** The reader never fills the chunk at the head while it is there, so it can be copied out
+    ** before the head moves on and frees it.
+    */
+    int index = slot.Head % Chunks;
+    int size = slot.Sizes[index];
+    memcpy(buffer, slot.Data + index * ChunkSize, size);
+    slot.Head++;
+    WakeCond.notify_one();
+
+    return size;
+}
+
+void MusicStreamClass::Stop()
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    Close_Slot(Slots[Current], lock);
+}
+
+void MusicStreamClass::Shutdown()
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    Close_Slot(Slots[0], lock);
+    Close_Slot(Slots[1], lock);
+    Quit = true;
+    lock.unlock();
+
+    WakeCond.notify_one();
+    if (Thread.joinable()) {
+        Thread.join();
+    }
+}
+
+void MusicStreamClass::Get_Stats(MusicStreamStatsType& stats)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    stats = Stats;
+}
+
+bool MusicStreamClass::Open_Slot(SlotType& slot, char const* name)
+{
+    int handle = Open_Track(name);
+    if (handle == -1) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(Mutex);
+    slot.Name = name;
+    slot.Head = 0;
+    slot.Tail = 0;
+    slot.End = false;
+    slot.Prefetched = std::chrono::steady_clock::now();
+    slot.Handle = handle;
+
+    if (!Thread.joinable()) {
+        Quit = false;
+        Thread = std::thread(&MusicStreamClass::Reader, this);
+    }
+    WakeCond.notify_one();
+
+    return true;
+}
+
+void MusicStreamClass::Close_Slot(SlotType& slot, std::unique_lock<std::mutex>& lock)
+{
+    ReadCond.wait(lock, [&slot] { return !slot.Busy; });
+
+    if (slot.Handle != -1) {
+        Close_Track(slot.Handle);
+        slot.Handle = -1;
+    }
+}
+
+void MusicStreamClass::Reader()
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+
+    while (!Quit) {
+        /*
+        ** Top up the track being played before reading further into the one to follow.
+        */
+        SlotType* slot = nullptr;
+        for (int i = 0; i < 2 && slot == nullptr; ++i) {
+            SlotType& s = Slots[i == 0 ? Current : 1 - Current];
+            if (s.Handle != -1 && !s.End && s.Tail - s.Head < unsigned(Chunks)) {
+                slot = &s;
+            }
+        }
+
+        if (slot == nullptr) {
+            WakeCond.wait(lock);
+            continue;
+        }
+
+        int index = slot->Tail % Chunks;
+        int handle = slot->Handle;
+        char* dest = slot->Data + index * ChunkSize;
+        slot->Busy = true;
+        lock.unlock();
+
+        int size = Read_Track(handle, dest, ChunkSize);
+
+        lock.lock();
+        slot->Busy = false;
+        if (size > 0) {
+            slot->Sizes[index] = size;
+            slot->Tail++;
+            Stats.Bytes += size;
+        }
+        if (size < ChunkSize) {
+            slot->End = true;
+        }
+        ReadCond.notify_all();
+    }
+}
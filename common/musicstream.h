@@ -0,0 +1,139 @@
+#ifndef MUSICSTREAM_H
+#define MUSICSTREAM_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <string>
+#include <thread>
+
+typedef struct
+{
+    unsigned Prefetches; // Tracks read ahead of being started.
+    unsigned Hits;       // Tracks started from data read ahead.
+    unsigned Misses;     // Tracks that had to be opened when they were started.
+    unsigned Handoffs;   // Tracks that followed straight on from the one before.
+    unsigned Underruns;  // Times the player had to wait for the reader.
+    unsigned LeadTime;   // Milliseconds the last track started from a prefetch was read ahead.
+    size_t Bytes;        // Bytes read in total.
+} MusicStreamStatsType;
+
+/*
+** Reads music tracks on a background thread so starting or playing one never waits on the disk.
+** Each track is read in fixed size chunks into a ring, the reader keeping the ring of the track
+** playing topped up and filling the ring of the track expected to follow, so that its first
+** seconds are already in memory by the time it starts.
+**
+** Tracks are opened and closed on the calling thread, only the reading is done by the reader,
+** so the file layer never has two threads opening files at once.
+*/
+class MusicStreamClass
+{
+public:
+    enum
+    {
+        STREAM_WAIT = -1 // Read found the reader hasn't got that far yet.
+    };
+
+    MusicStreamClass(int chunk_size, int chunks);
+    virtual ~MusicStreamClass();
+
+    /*
+    ** Start reading a track ahead of time, replacing any earlier prefetch that wasn't started.
+    ** A NULL name just drops the prefetch. Returns false if the track couldn't be opened.
+    */
+    bool Prefetch(char const* name);
+
+    /*
+    ** Make a track the one being played, taking it from the prefetch if it is the same track
+    ** and opening it otherwise. Returns false if it couldn't be opened.
+    */
+    bool Start(char const* name);
+
+    /*
+    ** Make the prefetched track the one being played, as it follows on from the last one.
+    ** Returns false if nothing was prefetched.
+    */
+    bool Start_Next();
+
+    /*
+    ** Is a track prefetched and waiting to be started?
+    */
+    bool Is_Prefetched() const
+    {
+        return Slots[1 - Current].Handle != -1;
+    }
+
+    /*
+    ** Copy the next chunk of the track being played. Returns its size, which is less than a
+    ** chunk only at the end of the track and zero after it. If the chunk hasn't been read yet
+    ** either waits for it, counting an underrun, or returns STREAM_WAIT.
+    */
+    int Read(void* buffer, bool wait);
+
+    /*
+    ** Stop the track being played, the prefetch is kept.
+    */
+    void Stop();
+
+    /*
+    ** Stop everything and end the reader. Derived classes need to call this from their destructor
+    ** if not before, as tracks are closed through them.
+    */
+    void Shutdown();
+
+    void Get_Stats(MusicStreamStatsType& stats);
+
+protected:
+    /*
+    ** Open a track, returning a handle for it or -1 if it couldn't be. Always called from the
+    ** thread using the stream.
+    */
+    virtual int Open_Track(char const* name) = 0;
+
+    /*
+    ** Read from a track, returning the bytes read. Called from the reader thread.
+    */
+    virtual int Read_Track(int handle, void* buffer, int size) = 0;
+
+    /*
+    ** Close a track. Always called from the thread using the stream, never while it is being
+    ** read from.
+    */
+    virtual void Close_Track(int handle) = 0;
+
+private:
+    MusicStreamClass(MusicStreamClass const&);
+    MusicStreamClass& operator=(MusicStreamClass const&);
+
+    typedef struct
+    {
+        std::string Name;
+        int Handle;
+        char* Data;
+        int* Sizes;
+        unsigned Head; // Chunks handed out.
+        unsigned Tail; // Chunks read.
+        bool End;      // The last chunk has been read.
+        bool Busy;     // The reader is reading into this ring.
+        std::chrono::steady_clock::time_point Prefetched;
+    } SlotType;
+
+    bool Open_Slot(SlotType& slot, char const* name);
+    void Close_Slot(SlotType& slot, std::unique_lock<std::mutex>& lock);
+    void Reader();
+
+    int ChunkSize;
+    int Chunks;
+    int Current; // Slot of the track being played, the other holds the prefetch.
+    SlotType Slots[2];
+    std::thread Thread;
+    std::mutex Mutex;
+    std::condition_variable WakeCond; // Signals the reader there is room to fill.
+    std::condition_variable ReadCond; // Signals the player a chunk was read.
+    bool Quit;
+    MusicStreamStatsType Stats;
+};
+
+#endif /* MUSICSTREAM_H */
@@ -35,6 +35,10 @@
  *   Set_Palette -- sets the current palette											*
  *   Set_Palette_Color -- Set a color number in a palette to the data.     *
  *	  Fade_Palette_To -- Fades the current palette into another					*
+ *   Start_Palette_Fade -- Starts fading the palette without waiting on it *
+ *   Palette_Fade_Tick -- Takes the palette fade as far as it has got to   *
+ *   Palette_Fade_Active -- Is a palette fade still going?                 *
+ *   Cancel_Palette_Fade -- Stops the palette fade part way or at its end  *
  *   Determine_Bump_Rate -- determines desired bump rate for fading        *
  *   Bump_Palette -- increments the palette one step, for fading           *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -45,6 +49,7 @@
 #include "palette.h"
 #include "timer.h"
 #include "framelimit.h"
+#include "tickwait.h"
 
 #include <string.h>
 
@@ -57,12 +62,27 @@
 */
 extern unsigned char CurrentPalette[768]; /* in pal.asm */
 
+/*
+** The palette fade in progress, stepped along by Palette_Fade_Tick.
+*/
+static struct
+{
+    bool Active;                         // Is there a fade in progress?
+    unsigned char Target[PALETTE_BYTES]; // Palette being faded to.
+    int Start;                           // First gun byte being faded.
+    int End;                             // Gun byte after the last being faded.
+    short Jump;                          // Gun values to jump per step.
+    short TicksPer;                      // The ticks (fixed point) per step.
+    int TickAccum;                       // Roundoff bits of the step time.
+    int Timer;                           // Tick count the next step is due at.
+} PaletteFade;
+
 /*
 ******************************** Prototypes *********************************
 */
 
-static void Determine_Bump_Rate(void* palette, int delay, short* ticks, short* rate);
-static bool Bump_Palette(void* palette1, unsigned int step);
+static void Determine_Bump_Rate(void* palette, int delay, int start, int end, short* ticks, short* rate);
+static bool Bump_Palette(unsigned char* palette, void* palette1, int start, int end, unsigned int step);
 
 /*
 ******************************** Code *********************************
@@ -77,7 +97,8 @@ static bool Bump_Palette(void* palette1, unsigned int step);
  * OUTPUT:                                                                 *
  *		none																						*
  *                                                                         *
- * WARNINGS:                                                               *
+ * WARNINGS:   Cancels any palette fade in progress, so that it does not   *
+ *             carry on from the palette set here.                         *
  *                                                                         *
  * HISTORY:                                                                *
  *   04/25/1994 SKB : Created.                                             *
@@ -85,6 +106,7 @@ static bool Bump_Palette(void* palette1, unsigned int step);
  *=========================================================================*/
 void Set_Palette(void* palette)
 {
+    PaletteFade.Active = false;
     Set_Palette_Range(palette);
 } /* end of Set_Palette */
 
@@ -141,12 +163,6 @@ void Set_Palette_Color(void* palette, int color, void* data)
  *=========================================================================*/
 void Fade_Palette_To(void* palette1, unsigned int delay, void (*callback)())
 {
-    bool changed;       // Flag that palette has changed this tick.
-    short jump;         // Gun values to jump per palette set.
-    unsigned int timer; // Tick count timer used for timing.
-    short ticksper;     // The ticks (fixed point) per bit jump.
-    int tickaccum;
-
     extern void (*cb_ptr)(void); // callback function pointer
 
     //	(void *)cb_ptr = callback;
@@ -158,50 +174,191 @@ void Fade_Palette_To(void* palette1, unsigned int delay, void (*callback)())
     if (!palette1)
         return;
 
-    /*
-    --------------------------- Get the bump rate ----------------------------
-    */
-    Determine_Bump_Rate(palette1, delay, &ticksper, &jump);
-
-    tickaccum = 0;               // init accumulated elapsed time
-    timer = WinTickCount.Time(); // timer = current time
-    do {
-        changed = false;
+    Start_Palette_Fade(palette1, delay);
 
-        tickaccum += ticksper;     // tickaccum = time of next change * 256
-        timer += (tickaccum >> 8); // timer = time of next change (rounded)
-        tickaccum &= 0x0FF;        // shave off high byte, keep roundoff bits
-
-        changed = Bump_Palette(palette1, jump); // increment palette
+    while (Palette_Fade_Active()) {
+        Frame_Limiter();
 
         /*
         .................. Wait for time increment to elapse ..................
         */
-        if (changed) {
-            Frame_Limiter();
-            while (WinTickCount.Time() < (int)timer) {
-                /*
-                ................. Update callback while waiting .................
-                */
-                if (callback) {
-                    (*cb_ptr)();
-                }
+        while (WinTickCount.Time() < PaletteFade.Timer) {
+            /*
+            ................. Update callback while waiting .................
+            */
+            if (callback) {
+                (*cb_ptr)();
             }
+            Wait_For_Tick();
         }
 
+        Palette_Fade_Tick();
+
         if (callback) {
             (*cb_ptr)();
         }
-    } while (changed);
+    }
 
 } /* end of Fade_Palette_To */
 
+/***************************************************************************
+ * Start_Palette_Fade -- Starts fading the palette without waiting on it   *
+ *                                                                         *
+ * This sets up a fade from the current palette into another, which       *
+ * Palette_Fade_Tick then takes along from the game loop. It steps         *
+ * exactly as Fade_Palette_To does, the first step being taken straight    *
+ * away. Any fade already going is replaced.                               *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		void *palette1	- palette to fade to											*
+ *		unsigned int delay - time to fade over in 60ths of a second				*
+ *		int first		- first color index to fade										*
+ *		int count		- number of colors to fade, the rest are left alone		*
+ *		void *palette0	- palette to crossfade from, NULL to fade from the		*
+ *							  current palette												*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		none																						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		The palette faded to is copied, the one crossfaded from is set			*
+ *		straight away.																			*
+ *=========================================================================*/
+void Start_Palette_Fade(void* palette1, unsigned int delay, int first, int count, void* palette0)
+{
+    PaletteFade.Active = false;
+
+    if (!palette1 || first < 0 || count <= 0 || first + count > PALETTE_SIZE)
+        return;
+
+    memcpy(PaletteFade.Target, palette1, PALETTE_BYTES);
+    PaletteFade.Start = first * RGB_BYTES;
+    PaletteFade.End = (first + count) * RGB_BYTES;
+
+    if (palette0) {
+        unsigned char palette[PALETTE_BYTES];
+        memcpy(palette, CurrentPalette, PALETTE_BYTES);
+        memcpy(&palette[PaletteFade.Start],
+               &((unsigned char*)palette0)[PaletteFade.Start],
+               PaletteFade.End - PaletteFade.Start);
+        Set_Palette_Range(palette);
+    }
+
+    Determine_Bump_Rate(
+        PaletteFade.Target, delay, PaletteFade.Start, PaletteFade.End, &PaletteFade.TicksPer, &PaletteFade.Jump);
+
+    PaletteFade.TickAccum = 0;
+    PaletteFade.Timer = WinTickCount.Time();
+    PaletteFade.Active = true;
+
+    Palette_Fade_Tick();
+} /* end of Start_Palette_Fade */
+
+/***************************************************************************
+ * Palette_Fade_Tick -- Takes the palette fade as far as it has got to     *
+ *                                                                         *
+ * Call once a frame while a fade is going. Every step that has come due  *
+ * since the last call is taken and the palette set once with the result, *
+ * it never waits on the next step.                                       *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		true = the fade is still going, false = it has finished					*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *=========================================================================*/
+bool Palette_Fade_Tick(void)
+{
+    unsigned char palette[PALETTE_BYTES]; // copy of current palette
+    bool changed = false;                 // Flag that palette has changed this tick.
+
+    if (!PaletteFade.Active)
+        return (false);
+
+    memcpy(palette, CurrentPalette, PALETTE_BYTES);
+
+    while (PaletteFade.Active && WinTickCount.Time() >= PaletteFade.Timer) {
+        PaletteFade.TickAccum += PaletteFade.TicksPer;     // tickaccum = time of next change * 256
+        PaletteFade.Timer += (PaletteFade.TickAccum >> 8); // timer = time of next change (rounded)
+        PaletteFade.TickAccum &= 0x0FF;                    // shave off high byte, keep roundoff bits
+
+        if (Bump_Palette(palette, PaletteFade.Target, PaletteFade.Start, PaletteFade.End, PaletteFade.Jump)) {
+            changed = true;
+        }
+
+        /*
+        ............ Finished once the range matches, not a step later ..........
+        */
+        if (memcmp(&palette[PaletteFade.Start],
+                   &PaletteFade.Target[PaletteFade.Start],
+                   PaletteFade.End - PaletteFade.Start)
+            == 0) {
+            PaletteFade.Active = false;
+        }
+    }
+
+    if (changed) {
+        Set_Palette_Range(&palette[0]);
+    }
+
+    return (PaletteFade.Active);
+} /* end of Palette_Fade_Tick */
+
+/***************************************************************************
+ * Palette_Fade_Active -- Is a palette fade still going?                   *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		none																						*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		true = a fade started with Start_Palette_Fade hasn't finished			*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *=========================================================================*/
+bool Palette_Fade_Active(void)
+{
+    return (PaletteFade.Active);
+} /* end of Palette_Fade_Active */
+
+/***************************************************************************
+ * Cancel_Palette_Fade -- Stops the palette fade part way or at its end    *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		bool finish		- true to set the palette being faded to, false to		*
+ *							  leave it where the fade got to								*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		none																						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *=========================================================================*/
+void Cancel_Palette_Fade(bool finish)
+{
+    if (!PaletteFade.Active)
+        return;
+
+    PaletteFade.Active = false;
+
+    if (finish) {
+        unsigned char palette[PALETTE_BYTES];
+        memcpy(palette, CurrentPalette, PALETTE_BYTES);
+        memcpy(&palette[PaletteFade.Start],
+               &PaletteFade.Target[PaletteFade.Start],
+               PaletteFade.End - PaletteFade.Start);
+        Set_Palette_Range(palette);
+    }
+} /* end of Cancel_Palette_Fade */
+
 /***************************************************************************
  * Determine_Bump_Rate -- determines desired bump rate for fading          *
  *                                                                         *
  * INPUT:                                                                  *
  *		unsigned char *palette	- palette to fade to												*
  *		int delay		- desired time delay in 60ths of a second					*
+ *		int start		- first gun byte being faded										*
+ *		int end			- gun byte after the last being faded							*
  *		short *ticks		- output: loop ticks per color jump							*
  *		short *rate		- output: color gun increment rate							*
  *                                                                         *
@@ -214,7 +371,7 @@ void Fade_Palette_To(void* palette1, unsigned int delay, void (*callback)())
  *   04/27/1994 BR : Converted to 32-bit                                   *
  *   08/02/1994 SKB : Made private                                         *
  *=========================================================================*/
-static void Determine_Bump_Rate(void* palette, int delay, short* ticks, short* rate)
+static void Determine_Bump_Rate(void* palette, int delay, int start, int end, short* ticks, short* rate)
 {
     int gun1;  // Palette 1 gun value.
     int gun2;  // Palette 2 gun value.
@@ -228,7 +385,7 @@ static void Determine_Bump_Rate(void* palette, int delay, short* ticks, short* r
     ------------------------ Find max gun difference -------------------------
     */
     diff = 0;
-    for (index = 0; index < PALETTE_BYTES; index++) {
+    for (index = start; index < end; index++) {
         gun1 = ((unsigned char*)palette)[index];
         gun2 = CurrentPalette[index];
         adiff = ABS(gun1 - gun2);
@@ -268,24 +425,28 @@ static void Determine_Bump_Rate(void* palette, int delay, short* ticks, short* r
  * Bump_Palette -- increments the palette one step, for fading             *
  *                                                                         *
  * INPUT:                                                                  *
+ *		palette		- palette to step, changed in place							*
  *		palette1		- palette to fade towards											*
+ *		start			- first gun byte being faded										*
+ *		end			- gun byte after the last being faded							*
  *		step			- max step amount, determined by Determine_Bump_Rate		*
  *                                                                         *
  * OUTPUT:                                                                 *
  *		false = no change, true = changed												*
  *                                                                         *
  * WARNINGS:                                                               *
+ *		Doesn't set the palette, the caller does once it has taken all the	*
+ *		steps that are due.																	*
  *                                                                         *
  * HISTORY:                                                                *
  *   04/27/1994 BR : Created.                                              *
  *   08/02/1994 SKB : Made private                                         *
  *=========================================================================*/
-static bool Bump_Palette(void* palette1, unsigned int step)
+static bool Bump_Palette(unsigned char* palette, void* palette1, int start, int end, unsigned int step)
 {
-    bool changed = false;                 // Flag that palette has changed this tick.
-    int index;                            // Index to DAC register gun.
-    int gun1, gun2;                       // Palette 1 gun value.
-    unsigned char palette[PALETTE_BYTES]; // copy of current palette
+    bool changed = false; // Flag that palette has changed this tick.
+    int index;            // Index to DAC register gun.
+    int gun1, gun2;       // Palette 1 gun value.
 
     /*
     ---------------------- Return if 'palette1' is NULL ----------------------
@@ -293,15 +454,10 @@ static bool Bump_Palette(void* palette1, unsigned int step)
     if (!palette1)
         return (false);
 
-    /*
-    ------------------------ Copy the current palette ------------------------
-    */
-    memcpy(palette, CurrentPalette, 768);
-
     /*
     ----------------------- Loop through palette bytes -----------------------
     */
-    for (index = 0; index < PALETTE_BYTES; index++) {
+    for (index = start; index < end; index++) {
         gun1 = ((unsigned char*)palette1)[index];
         gun2 = palette[index];
 
@@ -331,13 +487,6 @@ static bool Bump_Palette(void* palette1, unsigned int step)
         palette[index] = (unsigned char)gun2;
     }
 
-    /*
-    ----------------- Set current palette to the new palette -----------------
-    */
-    if (changed) {
-        Set_Palette(&palette[0]);
-    }
-
     return (changed);
 
 } /* end of Bump_Palette */
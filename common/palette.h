@@ -50,6 +50,14 @@
 void Set_Palette(void* palette);
 void Set_Palette_Color(void* palette, int color, void* data);
 void Fade_Palette_To(void* palette1, unsigned int delay, void (*callback)());
+void Start_Palette_Fade(void* palette1,
+                        unsigned int delay,
+                        int first = 0,
+                        int count = PALETTE_SIZE,
+                        void* palette0 = nullptr);
+bool Palette_Fade_Tick(void);
+bool Palette_Fade_Active(void);
+void Cancel_Palette_Fade(bool finish);
 
 /*
 -------------------------------- loadpal.cpp --------------------------------
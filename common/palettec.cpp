@@ -34,6 +34,7 @@
  *   PaletteClass::Adjust -- Adjusts this palette toward black.                                *
  *   PaletteClass::Closest_Color -- Finds closest match to color specified.                    *
  *   PaletteClass::Set -- Fade the display palette to this palette.                            *
+ *   PaletteClass::Start_Fade -- Starts fading the display palette to this palette.            *
  *   PaletteClass::PaletteClass -- Constructor that fills palette with color specified.        *
  *   PaletteClass::operator = -- Assignment operator for palette objects.                      *
  *   PaletteClass::operator == -- Equality operator for palette objects.                       *
@@ -46,6 +47,7 @@ void Set_Palette(void* palette);
 #include "ftimer.h"
 #include "timer.h"
 #include "framelimit.h"
+#include "tickwait.h"
 
 #include <string.h>
 
@@ -343,6 +345,7 @@ void PaletteClass::Set(int time, void (*callback)(void)) const
         while (timer == holdtime && holdtime != 0) {
             if (callback)
                 callback();
+            Wait_For_Tick();
         }
 
         /*
@@ -364,3 +367,22 @@ void PaletteClass::Set(int time, void (*callback)(void)) const
         Frame_Limiter();
     }
 }
+
+/***********************************************************************************************
+ * PaletteClass::Start_Fade -- Starts fading the display palette to this palette.              *
+ *                                                                                             *
+ *    This starts the same fade as Fade_Palette_To but returns straight away. The fade is      *
+ *    stepped along by Palette_Fade_Tick, which the game callback calls, so it carries on      *
+ *    while the caller's loop runs.                                                            *
+ *                                                                                             *
+ * INPUT:   time  -- The time period (in system tick increments) to fade the display palette   *
+ *                   to match this palette.                                                    *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Setting the palette any other way cancels the fade.                             *
+ *=============================================================================================*/
+void PaletteClass::Start_Fade(int time) const
+{
+    Start_Palette_Fade((void*)&Palette[0], time);
+}
@@ -84,6 +84,7 @@ public:
     void Partial_Adjust(int ratio, char* lut);
     void Partial_Adjust(int ratio, PaletteClass const& palette, char* lut);
     void Set(int time = 0, void (*callback)(void) = 0) const;
+    void Start_Fade(int time) const;
     int Closest_Color(RGBClass const& rgb) const;
 
     static PaletteClass const& CurrentPalette;
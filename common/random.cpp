@@ -37,8 +37,9 @@
 
 #include "random.h"
 #ifdef RANDOM_COUNT
+#include "gamelocal.h"
 #include <stdio.h>
-extern int Frame;
+extern INSTANCE_LOCAL int Frame;
 #endif
 
 /***********************************************************************************************
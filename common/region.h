@@ -70,6 +70,10 @@ public:
         else
             Threat += threat;
     };
+    void Set_Threat(int threat)
+    {
+        Threat = threat;
+    };
     int Threat_Value(void) const
     {
         return Threat;
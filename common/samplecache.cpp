@@ -0,0 +1,186 @@
+#include "samplecache.h"
+
+#include <string.h>
+
+SampleCacheClass::SampleCacheClass(int sounds, int variants)
+    : Sounds(sounds)
+    , Variants(variants)
+    , Entries(new EntryType[sounds * variants])
+    , Head(-1)
+    , Tail(-1)
+    , Budget(4 * 1024 * 1024)
+{
+    memset(Entries, 0, sizeof(EntryType) * Sounds * Variants);
+    memset(&Stats, 0, sizeof(Stats));
+}
+
+SampleCacheClass::~SampleCacheClass()
+{
+    while (Head != -1) {
+        Drop(Head);
+    }
+    delete[] Entries;
+}
+
+/*
+** Samples still playing can't be freed yet. They stay as the only entries, to be dropped like
+** any other once they have finished.
+*/
+void SampleCacheClass::Clear()
+{
+    int index = Head;
+
+    while (index != -1) {
+        int next = Entries[index].Next;
+
+        if (!In_Use(Entries[index].Data)) {
+            Drop(index);
+        }
+
+        index = next;
+    }
+
+    for (int entry = 0; entry < Sounds * Variants; ++entry) {
+        if (Entries[entry].State != SAMPLE_OWNED) {
+            memset(&Entries[entry], 0, sizeof(EntryType));
+        }
+    }
+}
+
+void const* SampleCacheClass::Fetch(int sound, int variant)
+{
+    if (sound < 0 || sound >= Sounds || variant < 0 || variant >= Variants) {
+        return nullptr;
+    }
+    return Lookup(sound * Variants + variant, true);
+}
+
+void SampleCacheClass::Prewarm(int sound, int variant)
+{
+    if (sound >= 0 && sound < Sounds && variant >= 0 && variant < Variants) {
+        Lookup(sound * Variants + variant, false);
+    }
+}
+
+void const* SampleCacheClass::Lookup(int index, bool counted)
+{
+    EntryType& entry = Entries[index];
+
+    switch (entry.State) {
+    case SAMPLE_MISSING:
+        if (counted) {
+            Stats.Hits++;
+        }
+        return nullptr;
+
+    case SAMPLE_RESIDENT:
+        if (counted) {
+            Stats.Hits++;
+        }
+        return entry.Data;
+
+    case SAMPLE_OWNED:
+        if (counted) {
+            Stats.Hits++;
+        }
+        if (Head != index) {
+            Unlink(index);
+            Push_Front(index);
+        }
+        return entry.Data;
+
+    default:
+        break;
+    }
+
+    if (counted) {
+        Stats.Misses++;
+    }
+
+    size_t size = 0;
+    entry.Data = Load(index / Variants, index % Variants, size);
+    entry.Size = size;
+
+    if (entry.Data == nullptr) {
+        entry.State = SAMPLE_MISSING;
+    } else if (size == 0) {
+        entry.State = SAMPLE_RESIDENT;
+    } else {
+        entry.State = SAMPLE_OWNED;
+        Push_Front(index);
+        Stats.Entries++;
+        Stats.Bytes += size;
+        Trim(index);
+    }
+
+    return entry.Data;
+}
+
+void SampleCacheClass::Unlink(int index)
+{
+    EntryType& entry = Entries[index];
+
+    if (entry.Prev != -1) {
+        Entries[entry.Prev].Next = entry.Next;
+    } else {
+        Head = entry.Next;
+    }
+
+    if (entry.Next != -1) {
+        Entries[entry.Next].Prev = entry.Prev;
+    } else {
+        Tail = entry.Prev;
+    }
+
+    entry.Prev = -1;
+    entry.Next = -1;
+}
+
+void SampleCacheClass::Push_Front(int index)
+{
+    EntryType& entry = Entries[index];
+
+    entry.Prev = -1;
+    entry.Next = Head;
+
+    if (Head != -1) {
+        Entries[Head].Prev = index;
+    } else {
+        Tail = index;
+    }
+
+    Head = index;
+}
+
+void SampleCacheClass::Drop(int index)
+{
+    EntryType& entry = Entries[index];
+
+    Unlink(index);
+    Stats.Entries--;
+    Stats.Bytes -= entry.Size;
+    delete[] static_cast<char const*>(entry.Data);
+    entry.Data = nullptr;
+    entry.Size = 0;
+    entry.State = SAMPLE_UNKNOWN;
+}
+
+/*
+** Drop the least recently used samples until the cache is back within its budget. The sample
+** just loaded is always kept, as are any still playing.
+*/
+void SampleCacheClass::Trim(int keep)
+{
+    int index = Tail;
+
+    while (Stats.Bytes > Budget && index != -1) {
+        int prev = Entries[index].Prev;
+
+        if (index != keep && !In_Use(Entries[index].Data)) {
+            Drop(index);
+            Stats.Evictions++;
+        }
+
+        index = prev;
+    }
+}
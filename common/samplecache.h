@@ -0,0 +1,112 @@
+#ifndef SAMPLECACHE_H
+#define SAMPLECACHE_H
+
+#include <stddef.h>
+
+typedef struct
+{
+    unsigned Hits;
+    unsigned Misses;
+    unsigned Evictions;
+    unsigned Entries;
+    size_t Bytes;
+} SampleCacheStatsType;
+
+/*
+** Remembers where the data for each sound and variant of it was found, so playing a sound
+** the cache has seen before is a table lookup rather than building a file name and searching
+** the mixfiles for it. Sounds that could not be found are remembered too.
+**
+** Data that already stays in memory, such as that in a cached mixfile, is only pointed to.
+** Data that had to be read in is owned by the cache and counts against its budget, when the
+** budget is exceeded the samples used least recently are dropped first.
+*/
+class SampleCacheClass
+{
+public:
+    SampleCacheClass(int sounds, int variants);
+    virtual ~SampleCacheClass();
+
+    /*
+    ** Fetch the data for a variant of a sound, or NULL if there is none.
+    */
+    void const* Fetch(int sound, int variant);
+
+    /*
+    ** Look up a variant of a sound ahead of it being played, without counting towards the
+    ** hit and miss totals.
+    */
+    void Prewarm(int sound, int variant);
+
+    /*
+    ** Bytes of loaded sample data to keep. Samples already over the budget are dropped the
+    ** next time one is loaded.
+    */
+    void Set_Budget(size_t bytes)
+    {
+        Budget = bytes;
+    }
+
+    /*
+    ** Forget every sound and free the data owned by the cache, apart from any still playing.
+    */
+    void Clear();
+
+    void Get_Stats(SampleCacheStatsType& stats) const
+    {
+        stats = Stats;
+    }
+
+protected:
+    /*
+    ** Find the data for a variant of a sound. Data that stays in memory is returned with size
+    ** left at zero. Data read in for the cache is returned in a block allocated with new[], with
+    ** its size in bytes, and the cache takes ownership of it. Returns NULL if there is no data.
+    */
+    virtual void const* Load(int sound, int variant, size_t& size) = 0;
+
+    /*
+    ** Is data owned by the cache still being played from? Such data is never dropped.
+    */
+    virtual bool In_Use(void const* data)
+    {
+        return false;
+    }
+
+private:
+    SampleCacheClass(SampleCacheClass const&);
+    SampleCacheClass& operator=(SampleCacheClass const&);
+
+    typedef enum
+    {
+        SAMPLE_UNKNOWN,
+        SAMPLE_MISSING,
+        SAMPLE_RESIDENT,
+        SAMPLE_OWNED
+    } SampleStateType;
+
+    typedef struct
+    {
+        void const* Data;
+        size_t Size;
+        int Prev;
+        int Next;
+        unsigned char State;
+    } EntryType;
+
+    void const* Lookup(int index, bool counted);
+    void Unlink(int index);
+    void Push_Front(int index);
+    void Drop(int index);
+    void Trim(int keep);
+
+    int Sounds;
+    int Variants;
+    EntryType* Entries;
+    int Head; // Most recently used owned sample.
+    int Tail; // Least recently used owned sample.
+    size_t Budget;
+    SampleCacheStatsType Stats;
+};
+
+#endif /* SAMPLECACHE_H */
@@ -27,12 +27,21 @@ SettingsClass::SettingsClass()
     Video.Boxing = true;
     Video.BoxingAspectRatio = "16:10";
     Video.FrameLimit = 120;
+    Video.RenderThreads = 0;
+    Video.ShapeCacheSize = 14;
+    Video.TextRunCache = 64;
     Video.InterpolationMode = 2;
+    Video.InterpolationScale = 2;
     Video.HardwareCursor = false;
     Video.DOSMode = false;
     Video.Scaler = "nearest";
     Video.Driver = "default";
     Video.PixelFormat = "default";
+
+    /*
+    ** Audio settings
+    */
+    Audio.SampleCacheSize = 4;
 }
 
 void SettingsClass::Load(INIClass& ini)
@@ -63,6 +72,22 @@ void SettingsClass::Load(INIClass& ini)
     Video.Width = ini.Get_Int("Video", "Width", Video.Width);
     Video.Height = ini.Get_Int("Video", "Height", Video.Height);
     Video.FrameLimit = ini.Get_Int("Video", "FrameLimit", Video.FrameLimit);
+
+    /*
+    ** Threads used to draw the tactical map, 0 picks a count from the hardware and 1 draws on the main thread only.
+    */
+    Video.RenderThreads = ini.Get_Int("Video", "RenderThreads", Video.RenderThreads);
+
+    /*
+    ** Megabytes of uncompressed shape frames to keep, the least recently drawn are dropped first.
+    */
+    Video.ShapeCacheSize = ini.Get_Int("Video", "ShapeCacheSize", Video.ShapeCacheSize);
+
+    /*
+    ** Strings to keep ready drawn for text that is printed over and over, 0 draws each one every time.
+    */
+    Video.TextRunCache = ini.Get_Int("Video", "TextRunCache", Video.TextRunCache);
+
     Video.HardwareCursor = ini.Get_Bool("Video", "HardwareCursor", Video.HardwareCursor);
     Video.DOSMode = ini.Get_Bool("Video", "DOSMode", Video.DOSMode);
     Video.Scaler = ini.Get_String("Video", "Scaler", Video.Scaler);
@@ -74,6 +99,11 @@ void SettingsClass::Load(INIClass& ini)
     */
     Video.InterpolationMode = Bound(ini.Get_Int("Video", "InterpolationMode", Video.InterpolationMode), 0, 2);
 
+    /*
+    ** Factor VQA and WSA interpolation stretches by, 3 and 4 only apply where the picture has room for them.
+    */
+    Video.InterpolationScale = Bound(ini.Get_Int("Video", "InterpolationScale", Video.InterpolationScale), 2, 4);
+
     /*
     ** Boxing and raw input require software cursor.
     */
@@ -89,6 +119,11 @@ void SettingsClass::Load(INIClass& ini)
     } else {
         Video.ButtonStyle = -1;
     }
+
+    /*
+    ** Audio settings, megabytes of sound effect data read in from disk to keep, the least recently played are dropped first.
+    */
+    Audio.SampleCacheSize = ini.Get_Int("Audio", "SampleCacheSize", Audio.SampleCacheSize);
 }
 
 void SettingsClass::Save(INIClass& ini)
@@ -113,6 +148,9 @@ void SettingsClass::Save(INIClass& ini)
     ini.Put_Int("Video", "Width", Video.Width);
     ini.Put_Int("Video", "Height", Video.Height);
     ini.Put_Int("Video", "FrameLimit", Video.FrameLimit);
+    ini.Put_Int("Video", "RenderThreads", Video.RenderThreads);
+    ini.Put_Int("Video", "ShapeCacheSize", Video.ShapeCacheSize);
+    ini.Put_Int("Video", "TextRunCache", Video.TextRunCache);
     ini.Put_Bool("Video", "HardwareCursor", Video.HardwareCursor);
     ini.Put_Bool("Video", "DOSMode", Video.DOSMode);
     ini.Put_String("Video", "Scaler", Video.Scaler);
@@ -123,6 +161,12 @@ void SettingsClass::Save(INIClass& ini)
     ** VQA and WSA interpolation mode 0 = scanlines, 1 = vertical doubling, 2 = linear
     */
     ini.Put_Int("Video", "InterpolationMode", Video.InterpolationMode);
+    ini.Put_Int("Video", "InterpolationScale", Video.InterpolationScale);
+
+    /*
+    ** Audio settings
+    */
+    ini.Put_Int("Audio", "SampleCacheSize", Audio.SampleCacheSize);
 
     ini.Put_String(
         "Video", "ButtonStyle", Video.ButtonStyle == -1 ? "Default" : (Video.ButtonStyle == 1 ? "Gold" : "Classic"));
@@ -30,7 +30,11 @@ public:
         int Width;
         int Height;
         int FrameLimit;
+        int RenderThreads;
+        int ShapeCacheSize;
+        int TextRunCache;
         int InterpolationMode;
+        int InterpolationScale;
         bool HardwareCursor;
         bool DOSMode;
         int ButtonStyle;
@@ -39,6 +43,11 @@ public:
         std::string PixelFormat;
     } Video;
 
+    struct
+    {
+        int SampleCacheSize;
+    } Audio;
+
     struct
     {
         bool MouseWheelScrolling;
@@ -1,6 +1,7 @@
 #include "soscomp.h"
 #include <string.h>
 #include <assert.h>
+#include <algorithm>
 
 // index table for stepping into step table.
 static const short wCODECIndexTab[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
@@ -58,7 +59,14 @@ static struct
     short index;
 } SosDecompTable[NUM_INDEXES][NUM_NYBBLES];
 
-/* Flag if above table was initialized.  */
+/* Index after both nybbles of a byte.  Every sample depends on the chain of
+ * index lookups, taking a byte per lookup halves the length of that chain.
+ *
+ * This table consumes ~22kb.
+ */
+static unsigned char SosByteIndexTable[NUM_INDEXES][256];
+
+/* Flag if above tables were initialized.  */
 static bool SosDecompTableGenerated = false;
 
 /* Generate decompression table for samples.  Precompute every possible value
@@ -97,6 +105,13 @@ void sosCODECGenerateDecompressTable(void)
             SosDecompTable[index][nybble].index = next_index;
         }
     }
+
+    for (index = 0; index < NUM_INDEXES; index++) {
+        for (int code = 0; code < 256; code++) {
+            short mid_index = SosDecompTable[index][code & 0xF].index;
+            SosByteIndexTable[index][code] = (unsigned char)SosDecompTable[mid_index][code >> 4].index;
+        }
+    }
 }
 
 /* Template version of sosCODECDecompressData which generates a single version
@@ -175,17 +190,22 @@ template <bool BITS_8> static unsigned sosCODECDecompressDataTemplate(_SOS_COMPR
     return full_length;
 }
 
-//
-// decompress data from a 4:1 ADPCM compressed file.  the number of
-// bytes decompressed is returned.
-//
-//
-unsigned sosCODECDecompressData(_SOS_COMPRESS_INFO* stream, unsigned bytes)
+static void Sos_Generate_Tables()
 {
     if (SosDecompTableGenerated == false) {
         sosCODECGenerateDecompressTable();
         SosDecompTableGenerated = true;
     }
+}
+
+//
+// decompress data from a 4:1 ADPCM compressed file one nybble at a time.
+// this is the original decoder, sosCODECDecompressData must give exactly
+// the same samples.
+//
+unsigned sosCODECDecompressDataDirect(_SOS_COMPRESS_INFO* stream, unsigned bytes)
+{
+    Sos_Generate_Tables();
 
     if (stream->wBitSize == 16) {
         return sosCODECDecompressDataTemplate<false>(stream, bytes);
@@ -199,6 +219,186 @@ unsigned sosCODECDecompressData(_SOS_COMPRESS_INFO* stream, unsigned bytes)
     return 0;
 }
 
+/* One channel of one stream being decompressed, a lane of the decoder below.  */
+typedef struct
+{
+    const unsigned char* src;
+    short* dst;
+    int stride;
+    int index;
+    int sample;
+    unsigned bytes;
+} SosLaneType;
+
+/* Largest number of lanes decoded together.  */
+#define SOS_MAX_LANES 4
+
+static inline int Sos_Clamp_Sample(int sample)
+{
+    /* Both become conditional moves rather than branches.  */
+    sample = sample < -32768 ? -32768 : sample;
+    return sample > 32767 ? 32767 : sample;
+}
+
+/* Decompresses the next `bytes` bytes of LANES channels together.  The
+ * channels don't depend on each other, so interleaving them lets the table
+ * lookups of one overlap those of the others.  Each byte gives two samples
+ * and moves the index on with a single lookup.  */
+template <int LANES> static void Sos_Decode_Lanes(SosLaneType* const* lanes, unsigned bytes)
+{
+    const unsigned char* src[LANES];
+    short* dst[LANES];
+    int stride[LANES];
+    int index[LANES];
+    int sample[LANES];
+
+    for (int l = 0; l < LANES; l++) {
+        src[l] = lanes[l]->src;
+        dst[l] = lanes[l]->dst;
+        stride[l] = lanes[l]->stride;
+        index[l] = lanes[l]->index;
+        sample[l] = lanes[l]->sample;
+    }
+
+    for (unsigned j = 0; j < bytes; j++) {
+        /* Left rolled up GCC keeps the lanes in memory rather than registers.  */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 4
+#endif
+        for (int l = 0; l < LANES; l++) {
+            unsigned code = *src[l];
+            int mid_index = SosDecompTable[index[l]][code & 0xF].index;
+            int first = Sos_Clamp_Sample(sample[l] + SosDecompTable[index[l]][code & 0xF].diff);
+            int second = Sos_Clamp_Sample(first + SosDecompTable[mid_index][code >> 4].diff);
+
+            dst[l][0] = first;
+            dst[l][stride[l]] = second;
+            src[l] += stride[l];
+            dst[l] += 2 * stride[l];
+            index[l] = SosByteIndexTable[index[l]][code];
+            sample[l] = second;
+        }
+    }
+
+    for (int l = 0; l < LANES; l++) {
+        lanes[l]->src = src[l];
+        lanes[l]->dst = dst[l];
+        lanes[l]->index = index[l];
+        lanes[l]->sample = sample[l];
+        lanes[l]->bytes -= bytes;
+    }
+}
+
+/* Decompresses a group of up to SOS_MAX_LANES lanes to their ends, dropping
+ * each lane out of the group as it finishes.  */
+static void Sos_Decode_Group(SosLaneType** lanes, int count)
+{
+    while (count > 0) {
+        unsigned bytes = lanes[0]->bytes;
+        for (int l = 1; l < count; l++) {
+            bytes = std::min(bytes, lanes[l]->bytes);
+        }
+
+        switch (count) {
+        case 4:
+            Sos_Decode_Lanes<4>(lanes, bytes);
+            break;
+        case 3:
+            Sos_Decode_Lanes<3>(lanes, bytes);
+            break;
+        case 2:
+            Sos_Decode_Lanes<2>(lanes, bytes);
+            break;
+        default:
+            Sos_Decode_Lanes<1>(lanes, bytes);
+            break;
+        }
+
+        for (int l = 0; l < count;) {
+            if (lanes[l]->bytes == 0) {
+                lanes[l] = lanes[--count];
+            } else {
+                l++;
+            }
+        }
+    }
+}
+
+//
+// decompress data from a 4:1 ADPCM compressed file.  the number of
+// bytes decompressed is returned.
+//
+//
+unsigned sosCODECDecompressData(_SOS_COMPRESS_INFO* stream, unsigned bytes)
+{
+    if (stream->wBitSize != 16) {
+        assert(0 && "Unreachable");
+        return 0;
+    }
+
+    return sosCODECDecompressStreams(&stream, &bytes, 1);
+}
+
+//
+// decompress several 16 bit streams in one pass, bytes[i] bytes from
+// streams[i].  the total number of bytes decompressed is returned.
+//
+unsigned sosCODECDecompressStreams(_SOS_COMPRESS_INFO* const* streams, const unsigned* bytes, int count)
+{
+    SosLaneType lanes[SOS_MAX_LANES];
+    SosLaneType* group[SOS_MAX_LANES];
+    _SOS_COMPRESS_INFO* lane_stream[SOS_MAX_LANES];
+    int lane_channel[SOS_MAX_LANES];
+    unsigned total = 0;
+
+    Sos_Generate_Tables();
+
+    int i = 0;
+    int channel = 0;
+    while (i < count) {
+        /*
+        **  Gather the next group of channels, a stereo stream can be split
+        **  across two groups.
+        */
+        int lane_count = 0;
+        for (; i < count && lane_count < SOS_MAX_LANES; channel = 0, i++) {
+            _SOS_COMPRESS_INFO* stream = streams[i];
+            if (stream->wBitSize != 16) {
+                continue;
+            }
+            if (channel == 0) {
+                total += bytes[i];
+            }
+
+            int channels = stream->wChannels;
+            for (; channel < channels && lane_count < SOS_MAX_LANES; channel++, lane_count++) {
+                SosLaneType& lane = lanes[lane_count];
+                lane.src = (unsigned char*)stream->lpSource + channel;
+                lane.dst = (short*)(stream->lpDest) + channel;
+                lane.stride = channels;
+                lane.index = stream->Channels[channel].wIndex;
+                lane.sample = stream->Channels[channel].dwPredicted;
+                lane.bytes = bytes[i] / 4;
+                group[lane_count] = &lane;
+                lane_stream[lane_count] = stream;
+                lane_channel[lane_count] = channel;
+            }
+            if (channel < channels) {
+                break;
+            }
+        }
+
+        Sos_Decode_Group(group, lane_count);
+
+        for (int l = 0; l < lane_count; l++) {
+            lane_stream[l]->Channels[lane_channel[l]].dwPredicted = lanes[l].sample;
+            lane_stream[l]->Channels[lane_channel[l]].wIndex = lanes[l].index;
+        }
+    }
+
+    return total;
+}
+
 //
 // Compresses a data stream into 4:1 ADPCM.  16 bit data is compressed 4:1
 // 8 bit data is compressed 2:1.
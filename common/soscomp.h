@@ -71,5 +71,7 @@ typedef struct _tagCOMPRESS_HEADER
 void sosCODECInitStream(_SOS_COMPRESS_INFO*);
 unsigned int sosCODECCompressData(_SOS_COMPRESS_INFO*, unsigned int);
 unsigned int sosCODECDecompressData(_SOS_COMPRESS_INFO*, unsigned int);
+unsigned int sosCODECDecompressDataDirect(_SOS_COMPRESS_INFO*, unsigned int);
+unsigned int sosCODECDecompressStreams(_SOS_COMPRESS_INFO* const*, const unsigned int*, int);
 
 #endif
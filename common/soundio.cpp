@@ -520,6 +520,24 @@ int File_Stream_Sample_Vol(const char* filename, int volume, bool real_time_star
     return INVALID_AUDIO_HANDLE;
 }
 
+/*
+** Scores are read as they play here, there is nothing to read ahead or follow on with.
+*/
+bool File_Stream_Prefetch(char const* filename, bool follow_on)
+{
+    return false;
+}
+
+bool File_Stream_Handed_Off(int handle)
+{
+    return false;
+}
+
+void File_Stream_Get_Stats(MusicStreamStatsType& stats)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
 void Sound_Callback()
 {
     if (!AudioDone && LockedData.DigiHandle != INVALID_AUDIO_HANDLE) {
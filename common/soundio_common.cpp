@@ -14,6 +14,7 @@
 #include "endianness.h"
 #include "file.h"
 #include "memflag.h"
+#include "musicstream.h"
 #include "soscomp.h"
 #include "sound.h"
 #include "soundio_imp.h"
@@ -138,10 +139,11 @@ struct SampleTrackerType
     int QueueSize;       // Size of queue buffer attached.
 
     /*
-    **	The file variables are used when streaming directly off of the
-    **	hard drive.
+    **	The file variables are used when streaming a score, which ScoreStream
+    **	reads off of the hard drive in the background.
     */
-    int FileHandle; // Streaming file handle (INVALID_FILE_HANDLE = not in use).
+    bool FileStream; // Is there more of the score to come from ScoreStream?
+    bool HandedOff;  // Has the score carried on into the prefetched one since last asked?
     void* FileBuffer;
 
     /*
@@ -204,6 +206,42 @@ static bool StartingFileStream = false;
 static bool volatile AudioDone = false;
 extern bool GameInFocus;
 static uint8_t ChunkBuffer[BUFFER_CHUNK_SIZE];
+static bool ScoreFollowOn = false; // Carry on into the prefetched score when the one playing ends.
+
+/*
+** Reads scores through the file layer, one streaming buffer to a chunk.
+*/
+class ScoreStreamClass : public MusicStreamClass
+{
+public:
+    ScoreStreamClass()
+        : MusicStreamClass(BUFFER_CHUNK_SIZE + 128, STREAM_BUFFER_COUNT)
+    {
+    }
+
+    ~ScoreStreamClass()
+    {
+        Shutdown();
+    }
+
+protected:
+    virtual int Open_Track(char const* name)
+    {
+        return Open_File(name, 1);
+    }
+
+    virtual int Read_Track(int handle, void* buffer, int size)
+    {
+        return Read_File(handle, buffer, size);
+    }
+
+    virtual void Close_Track(int handle)
+    {
+        Close_File(handle);
+    }
+};
+
+static ScoreStreamClass ScoreStream;
 
 bool Any_Locked(); // From each games winstub.cpp at the moment.
 static int Get_Free_Sample_Handle(int priority);
@@ -379,6 +417,23 @@ Stream_Sample_Vol(void* buffer, int size, bool (*callback)(short, short*, void**
     return playid;
 }
 
+/*
+** Reads the next streaming buffer of the score. Returns STREAM_WAIT if the reader hasn't got to it
+** yet and waiting for it wasn't asked for. Once the end of the score is read the tracker stops
+** streaming.
+*/
+static int File_Stream_Read(SampleTrackerType* st, void* buffer, bool wait)
+{
+    int size = ScoreStream.Read(buffer, wait);
+
+    if (size != MusicStreamClass::STREAM_WAIT && size != LockedData.StreamBufferSize) {
+        st->FileStream = false;
+        ScoreStream.Stop();
+    }
+
+    return size;
+}
+
 static bool File_Callback(short id, short* odd, void** buffer, int* size)
 {
     if (id == INVALID_AUDIO_HANDLE) {
@@ -403,22 +458,22 @@ static bool File_Callback(short id, short* odd, void** buffer, int* size)
 
     int count = StreamLowImpact ? LockedData.StreamBufferCount / 2 : LockedData.StreamBufferCount - 3;
 
-    if (count > st->FilePending && st->FileHandle != INVALID_FILE_HANDLE) {
+    if (count > st->FilePending && st->FileStream) {
         if (LockedData.StreamBufferCount - 2 != st->FilePending) {
             // Fill empty buffers.
             for (int num_empty_buffers = LockedData.StreamBufferCount - 2 - st->FilePending;
-                 num_empty_buffers && st->FileHandle != INVALID_FILE_HANDLE;
+                 num_empty_buffers && st->FileStream;
                  --num_empty_buffers) {
                 // Buffer to fill with data.
                 void* tofill =
                     static_cast<char*>(st->FileBuffer)
                     + LockedData.StreamBufferSize * ((st->FilePending + *odd) % LockedData.StreamBufferCount);
 
-                int psize = Read_File(st->FileHandle, tofill, LockedData.StreamBufferSize);
+                // Only wait on the reader if everything it read so far has been played.
+                int psize = File_Stream_Read(st, tofill, st->FilePending == 0 && st->QueueBuffer == nullptr);
 
-                if (psize != LockedData.StreamBufferSize) {
-                    Close_File(st->FileHandle);
-                    st->FileHandle = INVALID_FILE_HANDLE;
+                if (psize == MusicStreamClass::STREAM_WAIT) {
+                    break;
                 }
 
                 if (psize > 0) {
@@ -451,14 +506,20 @@ static void File_Stream_Preload(int index)
 {
     SampleTrackerType* st = &LockedData.SampleTracker[index];
     int maxnum = (LockedData.StreamBufferCount / 2) + 4;
-    int num = st->Loading ? std::min<int>(st->FilePending + 2, maxnum) : maxnum;
 
     int i = 0;
 
-    for (i = st->FilePending; i < num; ++i) {
-        int size = Read_File(st->FileHandle,
-                             static_cast<char*>(st->FileBuffer) + i * LockedData.StreamBufferSize,
-                             LockedData.StreamBufferSize);
+    /*
+    ** A real time start takes whatever the reader has ready and tries again on the next callback
+    ** if that isn't enough, a prefetched score is normally all there and starts straight away.
+    */
+    for (i = st->FilePending; i < maxnum; ++i) {
+        int size = File_Stream_Read(
+            st, static_cast<char*>(st->FileBuffer) + i * LockedData.StreamBufferSize, !st->Loading);
+
+        if (size == MusicStreamClass::STREAM_WAIT) {
+            break;
+        }
 
         if (size > 0) {
             st->FilePendingSize = size;
@@ -472,7 +533,13 @@ static void File_Stream_Preload(int index)
 
     Maintenance_Callback();
 
-    if (LockedData.StreamBufferSize > st->FilePendingSize || i == maxnum) {
+    // Nothing could be read from the score, so there is nothing to play.
+    if (!st->FileStream && st->FilePending == 0) {
+        st->Loading = false;
+        return;
+    }
+
+    if (!st->FileStream || i == maxnum) {
         int old_vol = LockedData.SoundVolume;
 
         int stream_size = st->FilePending == 1 ? st->FilePendingSize : LockedData.StreamBufferSize;
@@ -493,16 +560,10 @@ static void File_Stream_Preload(int index)
             st->QueueSize = 0;
             st->FilePendingSize = 0;
             st->Callback = nullptr;
-            Close_File(st->FileHandle);
         } else {
             st->Odd = 2;
             --st->FilePending;
 
-            if (st->FilePendingSize != LockedData.StreamBufferSize) {
-                Close_File(st->FileHandle);
-                st->FileHandle = INVALID_FILE_HANDLE;
-            }
-
             st->QueueBuffer = static_cast<char*>(st->FileBuffer) + LockedData.StreamBufferSize;
             st->QueueSize = st->FilePending == 0 ? st->FilePendingSize : LockedData.StreamBufferSize;
         }
@@ -527,27 +588,130 @@ int File_Stream_Sample_Vol(char const* filename, int volume, bool real_time_star
         return INVALID_AUDIO_HANDLE;
     }
 
-    int fh = Open_File(filename, 1);
+    int handle = Get_Free_Sample_Handle(PRIORITY_MAX);
 
-    if (fh == INVALID_FILE_HANDLE) {
+    if (handle >= MAX_SAMPLE_TRACKERS) {
         return INVALID_AUDIO_HANDLE;
     }
 
-    int handle = Get_Free_Sample_Handle(PRIORITY_MAX);
+    /*
+    ** There is only the one score stream, any other score still reading from it plays out what
+    ** it has already read.
+    */
+    for (int i = 0; i < MAX_SAMPLE_TRACKERS; ++i) {
+        LockedData.SampleTracker[i].FileStream = false;
+    }
+    ScoreFollowOn = false;
 
-    if (handle < MAX_SAMPLE_TRACKERS) {
-        SampleTrackerType* st = &LockedData.SampleTracker[handle];
-        st->IsScore = true;
-        st->FilePending = 0;
-        st->FilePendingSize = 0;
-        st->Loading = real_time_start;
-        st->Volume = volume;
-        st->FileHandle = fh;
-        File_Stream_Preload(handle);
-        return handle;
+    if (!ScoreStream.Start(filename)) {
+        return INVALID_AUDIO_HANDLE;
     }
 
-    return INVALID_AUDIO_HANDLE;
+    SampleTrackerType* st = &LockedData.SampleTracker[handle];
+    st->IsScore = true;
+    st->FilePending = 0;
+    st->FilePendingSize = 0;
+    st->Loading = real_time_start;
+    st->Volume = volume;
+    st->FileStream = true;
+    st->HandedOff = false;
+    File_Stream_Preload(handle);
+    return handle;
+}
+
+bool File_Stream_Prefetch(char const* filename, bool follow_on)
+{
+    ScoreFollowOn = false;
+
+    if (LockedData.DigiHandle == INVALID_AUDIO_HANDLE || AudioDone) {
+        return false;
+    }
+
+    if (filename == nullptr || !Find_File(filename)) {
+        ScoreStream.Prefetch(nullptr);
+        return false;
+    }
+
+    if (!ScoreStream.Prefetch(filename)) {
+        return false;
+    }
+
+    ScoreFollowOn = follow_on;
+    return true;
+}
+
+bool File_Stream_Handed_Off(int handle)
+{
+    if (handle < 0 || handle >= MAX_SAMPLE_TRACKERS) {
+        return false;
+    }
+
+    bool handed_off = LockedData.SampleTracker[handle].HandedOff;
+    LockedData.SampleTracker[handle].HandedOff = false;
+    return handed_off;
+}
+
+void File_Stream_Get_Stats(MusicStreamStatsType& stats)
+{
+    ScoreStream.Get_Stats(stats);
+}
+
+/*
+** Carries a score that has just run out of data straight on into the prefetched one, in the same
+** tracker so the two play without a gap. Only done if the prefetch was meant to follow on, the
+** score wasn't being faded out and the two have the same format.
+*/
+static bool File_Stream_Handoff(int index)
+{
+    SampleTrackerType* st = &LockedData.SampleTracker[index];
+
+    if (!st->IsScore || !ScoreFollowOn || st->FileStream || st->FilePending != 0 || st->QueueBuffer != nullptr
+        || st->Reducer != 0 || !ScoreStream.Is_Prefetched()) {
+        return false;
+    }
+
+    ScoreFollowOn = false;
+    ScoreStream.Start_Next();
+    st->FileStream = true;
+
+    int size = File_Stream_Read(st, st->FileBuffer, true);
+
+    if (size <= int(sizeof(AUDHeaderType))) {
+        return false;
+    }
+
+    AUDHeaderType raw_header;
+    memcpy(&raw_header, st->FileBuffer, sizeof(raw_header));
+    raw_header.Rate = le16toh(raw_header.Rate);
+
+    if (raw_header.Rate < 24000 && raw_header.Rate > 20000) {
+        raw_header.Rate = 22050;
+    }
+
+    if (SCompressType(raw_header.Compression) != st->Compression || raw_header.Rate != st->Frequency
+        || ((raw_header.Flags & 2) ? 16 : 8) != st->BitsPerSample || ((raw_header.Flags & 1) != 0) != st->Stereo) {
+        if (st->FileStream) {
+            st->FileStream = false;
+            ScoreStream.Stop();
+        }
+        return false;
+    }
+
+    st->Source = Add_Long_To_Pointer(st->FileBuffer, sizeof(AUDHeaderType));
+    st->Remainder = size - sizeof(AUDHeaderType);
+    st->Odd = 1;
+    st->QueueSize = 0;
+    st->FilePendingSize = 0;
+    st->Callback = File_Callback;
+    st->HandedOff = true;
+
+    if (st->Compression == SCOMP_SOS) {
+        st->sosinfo.dwCompSize = size - sizeof(AUDHeaderType);
+        st->sosinfo.dwUnCompSize = st->sosinfo.dwCompSize * (st->sosinfo.wBitSize / 4);
+        sosCODECInitStream(&st->sosinfo);
+    }
+
+    return true;
 }
 
 void Sound_Callback()
@@ -567,10 +731,10 @@ void Sound_Callback()
 
             // Is this sample inactive?
             if (!st->Active) {
-                // If so, we close the handle.
-                if (st->FileHandle != INVALID_FILE_HANDLE) {
-                    Close_File(st->FileHandle);
-                    st->FileHandle = INVALID_FILE_HANDLE;
+                // If so, we stop streaming.
+                if (st->FileStream) {
+                    st->FileStream = false;
+                    ScoreStream.Stop();
                 }
                 // We are done with this sample.
                 continue;
@@ -587,7 +751,7 @@ void Sound_Callback()
 
             // Process pending files.
             if (st->QueueBuffer == nullptr
-                || st->FileHandle != INVALID_FILE_HANDLE && LockedData.StreamBufferCount - 3 > st->FilePending) {
+                || st->FileStream && LockedData.StreamBufferCount - 3 > st->FilePending) {
                 if (st->Callback != nullptr) {
                     if (!st->Callback(i, &st->Odd, &st->QueueBuffer, &st->QueueSize)) {
                         // No files are pending so pending file callback not needed anymore.
@@ -633,7 +797,7 @@ static void Maintenance_Callback()
                                                        nullptr);
 
                         if (bytes_copied != BUFFER_CHUNK_SIZE) {
-                            st->MoreSource = false;
+                            st->MoreSource = File_Stream_Handoff(i);
                         }
 
                         if (bytes_copied > 0) {
@@ -789,6 +953,9 @@ void Sound_End()
         SoundImp_Shutdown_Sample(LockedData.SampleTracker[i].Imp);
     }
 
+    ScoreFollowOn = false;
+    ScoreStream.Shutdown();
+
     if (FileStreamBuffer != nullptr) {
         free((void*)FileStreamBuffer);
         FileStreamBuffer = nullptr;
@@ -824,9 +991,9 @@ void Stop_Sample(int index)
 
             st->Loading = false;
 
-            if (st->FileHandle != INVALID_FILE_HANDLE) {
-                Close_File(st->FileHandle);
-                st->FileHandle = INVALID_FILE_HANDLE;
+            if (st->FileStream) {
+                st->FileStream = false;
+                ScoreStream.Stop();
             }
 
             st->QueueBuffer = nullptr;
@@ -1084,9 +1251,9 @@ static int Get_Free_Sample_Handle(int priority)
         return INVALID_AUDIO_HANDLE;
     }
 
-    if (LockedData.SampleTracker[index].FileHandle != INVALID_FILE_HANDLE) {
-        Close_File(LockedData.SampleTracker[index].FileHandle);
-        LockedData.SampleTracker[index].FileHandle = INVALID_FILE_HANDLE;
+    if (LockedData.SampleTracker[index].FileStream) {
+        LockedData.SampleTracker[index].FileStream = false;
+        ScoreStream.Stop();
     }
 
     if (LockedData.SampleTracker[index].Original) {
@@ -1,5 +1,7 @@
 #include "audio.h"
 
+#include <string.h>
+
 void (*Audio_Focus_Loss_Function)(void) = nullptr;
 bool StreamLowImpact = false;
 
@@ -10,6 +12,18 @@ int File_Stream_Sample_Vol(char const* filename, int volume, bool real_time_star
 {
     return 1;
 }
+bool File_Stream_Prefetch(char const* filename, bool follow_on)
+{
+    return false;
+}
+bool File_Stream_Handed_Off(int handle)
+{
+    return false;
+}
+void File_Stream_Get_Stats(MusicStreamStatsType& stats)
+{
+    memset(&stats, 0, sizeof(stats));
+}
 void Sound_Callback(void)
 {
 }
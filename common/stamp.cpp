@@ -81,25 +81,54 @@ int IconHeight;
 int IconSize;
 int IconCount;
 
+/*
+** Decoded tileset header. Filled per call so that clipped stamp drawing does not depend on the
+** shared Init_Stamps state and can be used from several threads at once.
+*/
+struct StampInfoType
+{
+    const uint8_t* Stamps;
+    const uint8_t* TransFlags;
+    const uint8_t* Map;
+    int Width;
+    int Height;
+    int Size;
+    int Count;
+};
+
+static void Get_Stamp_Info(const IconControlType* iconset, StampInfoType& info)
+{
+    info.Count = le16toh(iconset->Count);
+    info.Width = le16toh(iconset->Width);
+    info.Height = le16toh(iconset->Height);
+    info.Size = info.Width * info.Height;
+
+    // TD and RA tileset headers are slightly different, so check a constant that only exists in one type.
+    if (le32toh(iconset->TD.Icons) == TD_TILESET_CHECK) {
+        info.Map = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->TD.Map);
+        info.Stamps = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->TD.Icons);
+        info.TransFlags = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->TD.TransFlag);
+    } else {
+        info.Map = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->RA.Map);
+        info.Stamps = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->RA.Icons);
+        info.TransFlags = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->RA.TransFlag);
+    }
+}
+
 void Init_Stamps(const IconControlType* iconset)
 {
     if (iconset && LastIconset != iconset) {
-        IconCount = le16toh(iconset->Count);
-        IconWidth = le16toh(iconset->Width);
-        IconHeight = le16toh(iconset->Height);
-        LastIconset = iconset;
-        IconSize = IconWidth * IconHeight;
+        StampInfoType info;
+        Get_Stamp_Info(iconset, info);
 
-        // TD and RA tileset headers are slightly different, so check a constant that only exists in one type.
-        if (le32toh(iconset->TD.Icons) == TD_TILESET_CHECK) {
-            MapPtr = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->TD.Map);
-            StampPtr = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->TD.Icons);
-            TransFlagPtr = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->TD.TransFlag);
-        } else {
-            MapPtr = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->RA.Map);
-            StampPtr = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->RA.Icons);
-            TransFlagPtr = reinterpret_cast<const uint8_t*>(iconset) + le32toh(iconset->RA.TransFlag);
-        }
+        IconCount = info.Count;
+        IconWidth = info.Width;
+        IconHeight = info.Height;
+        IconSize = info.Size;
+        LastIconset = iconset;
+        MapPtr = info.Map;
+        StampPtr = info.Stamps;
+        TransFlagPtr = info.TransFlags;
     }
 }
 
@@ -183,29 +212,28 @@ void Buffer_Draw_Stamp_Clip(void const* thisptr,
         return;
     }
 
-    if (LastIconset != tileset) {
-        Init_Stamps(tileset);
-    }
+    StampInfoType info;
+    Get_Stamp_Info(tileset, info);
 
-    int icon_index = MapPtr != nullptr ? MapPtr[icon] : icon;
+    int icon_index = info.Map != nullptr ? info.Map[icon] : icon;
 
-    if (icon_index < IconCount) {
-        int blit_height = IconHeight;
-        int blit_width = IconWidth;
-        const uint8_t* src = &StampPtr[IconSize * icon_index];
+    if (icon_index < info.Count) {
+        int blit_height = info.Height;
+        int blit_width = info.Width;
+        const uint8_t* src = &info.Stamps[info.Size * icon_index];
         int width = left + right;
         int xstart = left + x;
         int height = top + bottom;
         int ystart = top + y;
 
-        if (xstart < width && ystart < height && IconHeight + ystart > top && IconWidth + xstart > left) {
+        if (xstart < width && ystart < height && info.Height + ystart > top && info.Width + xstart > left) {
             if (xstart < left) {
                 src += left - xstart;
                 blit_width -= left - xstart;
                 xstart = left;
             }
 
-            int src_pitch = IconWidth - blit_width;
+            int src_pitch = info.Width - blit_width;
 
             if (blit_width + xstart > width) {
                 src_pitch += blit_width - (width - xstart);
@@ -213,8 +241,8 @@ void Buffer_Draw_Stamp_Clip(void const* thisptr,
             }
 
             if (top > ystart) {
-                blit_height = IconHeight - (top - ystart);
-                src += IconWidth * (top - ystart);
+                blit_height = info.Height - (top - ystart);
+                src += info.Width * (top - ystart);
                 ystart = top;
             }
 
@@ -240,7 +268,7 @@ void Buffer_Draw_Stamp_Clip(void const* thisptr,
                     dst += dst_pitch;
                 }
 
-            } else if (TransFlagPtr[icon_index]) {
+            } else if (info.TransFlags[icon_index]) {
                 for (int i = 0; i < blit_height; ++i) {
                     for (int j = 0; j < blit_width; ++j) {
                         uint8_t cur_byte = *src++;
@@ -258,7 +286,7 @@ void Buffer_Draw_Stamp_Clip(void const* thisptr,
                 for (int i = 0; i < blit_height; ++i) {
                     memcpy(dst, src, blit_width);
                     dst += full_pitch;
-                    src += IconWidth;
+                    src += info.Width;
                 }
             }
         }
@@ -0,0 +1,217 @@
+#ifndef THREATFIELD_H
+#define THREATFIELD_H
+
+#include <string.h>
+
+/*
+** Per house threat kept on a grid of map regions. Besides the threat of each region it can
+** answer for the total threat of any block of regions in constant time, from summed-area
+** tables that are brought up to date lazily. Only the rows at and below the highest row
+** changed since the last query are rebuilt.
+**
+** A second, decayed layer follows the threat with a lag. Each call to Decay moves it a fixed
+** fraction of the way toward the current threat, so it remembers where threat has been as
+** well as where it is. It is held in 24.8 fixed point and only uses integer arithmetic, so
+** every machine in a multiplayer game computes the same values.
+**
+** The class holds no pointers. Only the region values of the decayed layer need saving, the
+** rest of the field can be rebuilt from the current threat with Set.
+*/
+template <int W, int H> class ThreatFieldClass
+{
+public:
+    enum
+    {
+        HEAT_SHIFT = 8
+    };
+
+    void Clear()
+    {
+        memset(this, 0, sizeof(*this));
+        Current.Dirty = H;
+        Decayed.Dirty = H;
+    }
+
+    /*
+    ** Threat of a single region, by region index (x + y * W).
+    */
+    int Value(int region) const
+    {
+        return Current.Value[region];
+    }
+
+    /*
+    ** Decayed threat of a single region, rounded down to whole threat points.
+    */
+    int Heat(int region) const
+    {
+        return Decayed.Value[region] >> HEAT_SHIFT;
+    }
+
+    /*
+    ** Set the threat of one region outright.
+    */
+    void Set(int region, int threat)
+    {
+        Current.Value[region] = threat;
+        Current.Touch(region / W);
+    }
+
+    /*
+    ** Add threat to one region.
+    */
+    void Adjust(int region, int threat)
+    {
+        Current.Value[region] += threat;
+        Current.Touch(region / W);
+    }
+
+    /*
+    ** Add threat to a region and, at reduced strength, to the eight around it. Neighbours
+    ** across an edge get half and those across a corner a quarter. A removal takes away
+    ** exactly what the matching addition put in. The region must not be on the grid border.
+    */
+    void Spread(int region, int threat)
+    {
+        static const int _offset[9] = {-W - 1, -W, -W + 1, -1, 0, 1, W - 1, W, W + 1};
+        static const int _shift[9] = {2, 1, 2, 1, 0, 1, 2, 1, 2};
+
+        bool neg = threat < 0;
+        if (neg) {
+            threat = -threat;
+        }
+
+        for (int index = 0; index < 9; ++index) {
+            int amount = threat >> _shift[index];
+            Current.Value[region + _offset[index]] += neg ? -amount : amount;
+        }
+        Current.Touch(region / W - 1);
+    }
+
+    /*
+    ** Total threat in the block of regions w wide and h high with x, y at the top left. The
+    ** block is clipped to the grid.
+    */
+    int Rect_Sum(int x, int y, int w, int h)
+    {
+        return Current.Rect_Sum(x, y, w, h);
+    }
+
+    /*
+    ** Total threat of the regions no more than radius steps from x, y, the regions being
+    ** 8 connected. This is the square of side radius * 2 + 1 around it.
+    */
+    int Radius_Sum(int x, int y, int radius)
+    {
+        return Current.Rect_Sum(x - radius, y - radius, radius * 2 + 1, radius * 2 + 1);
+    }
+
+    /*
+    ** As Rect_Sum and Radius_Sum for the decayed layer, in whole threat points.
+    */
+    int Heat_Rect_Sum(int x, int y, int w, int h)
+    {
+        return int(Decayed.Rect_Sum(x, y, w, h) >> HEAT_SHIFT);
+    }
+    int Heat_Radius_Sum(int x, int y, int radius)
+    {
+        return Heat_Rect_Sum(x - radius, y - radius, radius * 2 + 1, radius * 2 + 1);
+    }
+
+    /*
+    ** Move the decayed layer toward the current threat. Keep is how much of the old value
+    ** stays, out of 256.
+    */
+    void Decay(int keep)
+    {
+        long long gain = 256 - keep;
+
+        for (int region = 0; region < W * H; ++region) {
+            long long target = (long long)Current.Value[region] << HEAT_SHIFT;
+            long long heat = Decayed.Value[region];
+            Decayed.Value[region] = int((heat * keep + target * gain) >> 8);
+        }
+        Decayed.Dirty = 0;
+    }
+
+    /*
+    ** Copy the decayed layer out to, or back in from, W * H values in 24.8 fixed point.
+    */
+    void Get_Heat(int* values) const
+    {
+        memcpy(values, Decayed.Value, sizeof(Decayed.Value));
+    }
+    void Set_Heat(int const* values)
+    {
+        memcpy(Decayed.Value, values, sizeof(Decayed.Value));
+        Decayed.Dirty = 0;
+    }
+
+private:
+    struct LayerStruct
+    {
+        int Value[W * H];
+
+        /*
+        ** Sum[(y + 1) * (W + 1) + x + 1] holds the total of every region above and left of
+        ** x, y inclusive. The first row and column are left as zero.
+        */
+        long long Sum[(W + 1) * (H + 1)];
+
+        /*
+        ** First grid row whose sums may be out of date, H when they are all current.
+        */
+        int Dirty;
+
+        void Touch(int row)
+        {
+            if (row < 0) {
+                row = 0;
+            }
+            if (row < Dirty) {
+                Dirty = row;
+            }
+        }
+
+        void Update()
+        {
+            for (int y = Dirty; y < H; ++y) {
+                long long const* above = &Sum[y * (W + 1)];
+                long long* sum = &Sum[(y + 1) * (W + 1)];
+                int const* value = &Value[y * W];
+                long long run = 0;
+
+                for (int x = 0; x < W; ++x) {
+                    run += value[x];
+                    sum[x + 1] = above[x + 1] + run;
+                }
+            }
+            Dirty = H;
+        }
+
+        long long Rect_Sum(int x, int y, int w, int h)
+        {
+            int x1 = x + w;
+            int y1 = y + h;
+
+            x = x < 0 ? 0 : x;
+            y = y < 0 ? 0 : y;
+            x1 = x1 > W ? W : x1;
+            y1 = y1 > H ? H : y1;
+            if (x >= x1 || y >= y1) {
+                return 0;
+            }
+
+            if (Dirty < y1) {
+                Update();
+            }
+
+            return Sum[y1 * (W + 1) + x1] - Sum[y * (W + 1) + x1] - Sum[y1 * (W + 1) + x] + Sum[y * (W + 1) + x];
+        }
+    };
+
+    LayerStruct Current;
+    LayerStruct Decayed;
+};
+
+#endif /* THREATFIELD_H */
@@ -0,0 +1,68 @@
+#include "tickwait.h"
+#include "timer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+/*
+** Time between waits longer than this is the game doing something other than waiting in a loop,
+** so isn't counted as work done by one.
+*/
+#define WORK_GAP_MS 100
+
+static std::mutex Mutex;
+static std::condition_variable WakeCond;
+static int Signalled; // Events signalled and not yet waited for.
+static TickWaitStatsType Stats;
+static std::chrono::steady_clock::time_point LastWake;
+
+int Wait_For_Tick(int events)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    auto start = std::chrono::steady_clock::now();
+
+    if (Stats.Waits != 0 && start - LastWake < std::chrono::milliseconds(WORK_GAP_MS)) {
+        Stats.WorkTime += std::chrono::duration_cast<std::chrono::microseconds>(start - LastWake).count();
+    }
+
+    /*
+    ** Sleep a tick at a time on the condition, a wake for events not asked for or a spurious one
+    ** just goes back to sleep for what is left of the tick. A stopped timer never ticks, so
+    ** there is nothing to wait for.
+    */
+    unsigned int tick = WindowsTimer.Get_System_Tick_Count();
+    unsigned int remaining = WindowsTimer.Get_Tick_Remaining();
+    int woken = Signalled & events;
+
+    while (woken == 0 && remaining != 0 && WindowsTimer.Get_System_Tick_Count() == tick) {
+        WakeCond.wait_for(lock, std::chrono::milliseconds(remaining));
+        woken = Signalled & events;
+        remaining = WindowsTimer.Get_Tick_Remaining();
+    }
+    Signalled &= ~events;
+
+    LastWake = std::chrono::steady_clock::now();
+    Stats.WaitTime += std::chrono::duration_cast<std::chrono::microseconds>(LastWake - start).count();
+    Stats.Waits++;
+    if (woken != 0) {
+        Stats.Wakeups++;
+    }
+
+    return woken;
+}
+
+void Wake_Tick_Wait(int events)
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Signalled |= events;
+    }
+    WakeCond.notify_all();
+}
+
+void Get_Tick_Wait_Stats(TickWaitStatsType& stats)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    stats = Stats;
+}
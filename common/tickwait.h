@@ -0,0 +1,35 @@
+#ifndef TICKWAIT_H
+#define TICKWAIT_H
+
+#include <stdint.h>
+
+enum TickWakeFlags
+{
+    WAKE_TICK = 0,
+    WAKE_INPUT = 1 << 0,
+    WAKE_NETWORK = 1 << 1,
+};
+
+typedef struct
+{
+    unsigned Waits;    // Calls to Wait_For_Tick.
+    unsigned Wakeups;  // Waits ended early by input or the network.
+    uint64_t WaitTime; // Microseconds spent asleep in Wait_For_Tick.
+    uint64_t WorkTime; // Microseconds spent between waits by the loops calling it.
+} TickWaitStatsType;
+
+/*
+** Sleep until the 60Hz system tick moves on, or until one of the given events is signalled if that
+** comes first. An event signalled since the last wait for it ends the wait straight away. Returns
+** the events that ended the wait, or WAKE_TICK if it was the tick.
+*/
+int Wait_For_Tick(int events = WAKE_TICK);
+
+/*
+** Signal events to anything waiting on them, safe to call from any thread.
+*/
+void Wake_Tick_Wait(int events);
+
+void Get_Tick_Wait_Stats(TickWaitStatsType& stats);
+
+#endif /* TICKWAIT_H */
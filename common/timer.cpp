@@ -297,6 +297,25 @@ unsigned int WinTimerClass::Get_User_Tick_Count()
     return (unsigned int)(delta / (1000 / Frequency));
 }
 
+/***********************************************************************************************
+ * WinTimerClass::Get_Tick_Remaining -- returns the milliseconds until the next tick           *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   milliseconds, at least one, or zero if the timer is stopped and never ticks       *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *=============================================================================================*/
+
+unsigned int WinTimerClass::Get_Tick_Remaining()
+{
+    if (Frequency == 0) {
+        return 0;
+    }
+    unsigned long long delta = Now() - Start;
+    return (unsigned int)((1000 / Frequency) - delta % (1000 / Frequency));
+}
+
 unsigned long long WinTimerClass::Now()
 {
     return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
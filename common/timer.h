@@ -34,6 +34,8 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include "gamelocal.h"
+
 /*=========================================================================*/
 /* The following prototypes are for the file: TIMERA.ASM                   */
 /*=========================================================================*/
@@ -136,7 +138,7 @@ public:
 **	Timer objects that fetch the appropriate timer value according to
 **	the type of timer they are.
 */
-extern int Frame;
+extern INSTANCE_LOCAL int Frame;
 class FrameTimerClass
 {
 public:
@@ -162,6 +164,7 @@ public:
 
     unsigned int Get_System_Tick_Count();
     unsigned int Get_User_Tick_Count();
+    unsigned int Get_Tick_Remaining();
 
 private:
     unsigned int Frequency; // Frequency of our windows timer in ticks per second
@@ -173,6 +176,7 @@ private:
 //////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////// externs  //////////////////////////////////////////
 extern TimerClass WinTickCount;
+extern WinTimerClass WindowsTimer;
 extern CountDownTimerClass CountDown;
 
 #endif // TIMER_H
@@ -0,0 +1,154 @@
+#include "workerpool.h"
+
+/*
+** Keep the pool small, the work it is given is memory bound and the game thread is still the
+** one doing most of the frame.
+*/
+#define MAX_POOL_THREADS 8
+
+WorkerPoolClass::WorkerPoolClass()
+    : Job(nullptr)
+    , JobCount(0)
+    , NextIndex(0)
+    , Generation(0)
+    , Active(0)
+    , Quit(false)
+    , IsInitialized(false)
+{
+}
+
+WorkerPoolClass::~WorkerPoolClass()
+{
+    Shutdown();
+}
+
+void WorkerPoolClass::Init(int threads)
+{
+    Shutdown();
+
+    if (threads <= 0) {
+        threads = int(std::thread::hardware_concurrency());
+    }
+
+    if (threads > MAX_POOL_THREADS) {
+        threads = MAX_POOL_THREADS;
+    }
+
+    Quit = false;
+    IsInitialized = true;
+
+    for (int i = 1; i < threads; ++i) {
+        Workers.emplace_back(&WorkerPoolClass::Worker_Loop, this);
+    }
+}
+
+void WorkerPoolClass::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Quit = true;
+    }
+
+    WakeCond.notify_all();
+
+    for (auto& worker : Workers) {
+        worker.join();
+    }
+
+    Workers.clear();
+}
+
+void WorkerPoolClass::Run(int count, const std::function<void(int)>& job)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    if (!IsInitialized) {
+        Init();
+    }
+
+    /*
+    ** Nothing to gain from waking the workers for a single job.
+    */
+    if (Workers.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Job = &job;
+        JobCount = count;
+        NextIndex.store(0);
+        ++Generation;
+    }
+
+    WakeCond.notify_all();
+
+    Drain(&job, count);
+
+    /*
+    ** Every index has been claimed once Drain returns, wait for any worker still running one.
+    */
+    std::unique_lock<std::mutex> lock(Mutex);
+    DoneCond.wait(lock, [this] { return Active == 0; });
+    Job = nullptr;
+}
+
+void WorkerPoolClass::Drain(const std::function<void(int)>* job, int count)
+{
+    for (;;) {
+        int index = NextIndex.fetch_add(1);
+
+        if (index >= count) {
+            break;
+        }
+
+        (*job)(index);
+    }
+}
+
+void WorkerPoolClass::Worker_Loop()
+{
+    unsigned seen = 0;
+
+    for (;;) {
+        std::unique_lock<std::mutex> lock(Mutex);
+        WakeCond.wait(lock, [&] { return Quit || Generation != seen; });
+
+        if (Quit) {
+            return;
+        }
+
+        seen = Generation;
+
+        /*
+        ** The job may already have completed if we woke up late.
+        */
+        const std::function<void(int)>* job = Job;
+        int count = JobCount;
+
+        if (job == nullptr) {
+            continue;
+        }
+
+        ++Active;
+        lock.unlock();
+
+        Drain(job, count);
+
+        lock.lock();
+        if (--Active == 0) {
+            DoneCond.notify_all();
+        }
+    }
+}
+
+WorkerPoolClass& Worker_Pool()
+{
+    static WorkerPoolClass _pool;
+    return _pool;
+}
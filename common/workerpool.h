@@ -0,0 +1,65 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small fixed size pool of worker threads used to split independent pieces of work, such as
+ * horizontal bands of the tactical map, across cores. The calling thread always takes part in
+ * the work so a pool of one thread runs everything inline.
+ */
+class WorkerPoolClass
+{
+public:
+    WorkerPoolClass();
+    ~WorkerPoolClass();
+
+    /**
+     * (Re)create the pool with the given number of threads including the caller. Zero picks a
+     * count based on the number of hardware threads.
+     */
+    void Init(int threads = 0);
+
+    /**
+     * Total number of threads that take part in a Run call.
+     */
+    int Thread_Count() const
+    {
+        return int(Workers.size()) + 1;
+    }
+
+    /**
+     * Call job(index) for every index in [0, count) and wait for all of them to finish. Jobs
+     * may run in any order and on any thread so they must not touch shared state.
+     */
+    void Run(int count, const std::function<void(int)>& job);
+
+private:
+    void Shutdown();
+    void Worker_Loop();
+    void Drain(const std::function<void(int)>* job, int count);
+
+    std::vector<std::thread> Workers;
+    std::mutex Mutex;
+    std::condition_variable WakeCond;
+    std::condition_variable DoneCond;
+    const std::function<void(int)>* Job;
+    int JobCount;
+    std::atomic<int> NextIndex;
+    unsigned Generation;
+    int Active;
+    bool Quit;
+    bool IsInitialized;
+};
+
+/**
+ * Shared pool used by the renderers, created on first use.
+ */
+WorkerPoolClass& Worker_Pool();
+
+#endif /* WORKERPOOL_H */
@@ -38,6 +38,9 @@
  *                                                                                             *
  * WIC::WinsockInterfaceClass -- constructor for the WinsockInterfaceClass                     *
  * WIC::~WinsockInterfaceClass -- destructor for the WinsockInterfaceClass                     *
+ * WIC::Arrival_Clock -- Millisecond clock used to timestamp incoming packets                  *
+ * WIC::Get_Buffer -- Fetch a packet buffer from the free list                                 *
+ * WIC::Release_Buffer -- Return a packet buffer to the free list                              *
  * WIC::Close -- Releases any currently in use Winsock resources.                              *
  * WIC::Close_Socket -- Close the communication socket if its open                             *
  * WIC::Start_Listening -- Enable callbacks for read/write events on our socket                *
@@ -60,6 +63,7 @@ extern WWKeyboardClass* Keyboard;
 
 #include <stdio.h>
 #include <assert.h>
+#include <chrono>
 
 WinsockInterfaceClass* PacketTransport = nullptr; // The object for interfacing with Winsock
 
@@ -98,6 +102,7 @@ WinsockInterfaceClass::WinsockInterfaceClass(void)
     FD_ZERO(&WriteSockets);
 #endif
     Socket = INVALID_SOCKET;
+    LastArrivalTime = 0;
 }
 
 /***********************************************************************************************
@@ -117,6 +122,75 @@ WinsockInterfaceClass::WinsockInterfaceClass(void)
 WinsockInterfaceClass::~WinsockInterfaceClass(void)
 {
     Close();
+
+    Discard_In_Buffers();
+    Discard_Out_Buffers();
+
+    while (FreeBuffers.Count()) {
+        delete FreeBuffers[0];
+        FreeBuffers.Delete(0);
+    }
+}
+
+/***********************************************************************************************
+ * WIC::Arrival_Clock -- Millisecond clock used to timestamp incoming packets                  *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Milliseconds since the clock was first read                                       *
+ *                                                                                             *
+ * WARNINGS: Safe to call from the network thread.                                             *
+ *                                                                                             *
+ *=============================================================================================*/
+unsigned int WinsockInterfaceClass::Arrival_Clock(void)
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+    auto now = std::chrono::steady_clock::now();
+    return unsigned(std::chrono::duration_cast<std::chrono::milliseconds>(now - epoch).count());
+}
+
+/***********************************************************************************************
+ * WIC::Get_Buffer -- Fetch a packet buffer from the free list                                 *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   ptr to packet buffer                                                              *
+ *                                                                                             *
+ * WARNINGS: Buffers must be returned with Release_Buffer.                                     *
+ *                                                                                             *
+ *=============================================================================================*/
+WinsockInterfaceClass::WinsockBufferType* WinsockInterfaceClass::Get_Buffer(void)
+{
+    int count = FreeBuffers.Count();
+
+    if (count == 0) {
+        return new WinsockBufferType;
+    }
+
+    WinsockBufferType* packet = FreeBuffers[count - 1];
+    FreeBuffers.Delete(count - 1);
+    return packet;
+}
+
+/***********************************************************************************************
+ * WIC::Release_Buffer -- Return a packet buffer to the free list                              *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    ptr to packet buffer                                                              *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+void WinsockInterfaceClass::Release_Buffer(WinsockBufferType* packet)
+{
+    FreeBuffers.Add(packet);
 }
 
 /***********************************************************************************************
@@ -271,7 +345,7 @@ void WinsockInterfaceClass::Discard_In_Buffers(void)
 
     while (InBuffers.Count()) {
         packet = InBuffers[0];
-        delete packet;
+        Release_Buffer(packet);
         InBuffers.Delete(0);
     }
 }
@@ -296,7 +370,7 @@ void WinsockInterfaceClass::Discard_Out_Buffers(void)
 
     while (OutBuffers.Count()) {
         packet = OutBuffers[0];
-        delete packet;
+        Release_Buffer(packet);
         OutBuffers.Delete(0);
     }
 }
@@ -410,12 +484,13 @@ int WinsockInterfaceClass::Read(void* buffer, int& buffer_len, void* address, in
     ** Return the length of the packet in buffer_len.
     */
     buffer_len = packet->BufferLen;
+    LastArrivalTime = packet->ArrivalTime;
 
     /*
-    ** Delete the temporary storage for the packet now that it is being passed to the game.
+    ** Recycle the temporary storage for the packet now that it is being passed to the game.
     */
     InBuffers.Delete(packetnum);
-    delete packet;
+    Release_Buffer(packet);
 
     return (buffer_len);
 }
@@ -441,7 +516,7 @@ void WinsockInterfaceClass::WriteTo(void* buffer, int buffer_len, void* address)
     /*
     ** Create a temporary holding area for the packet.
     */
-    WinsockBufferType* packet = new WinsockBufferType;
+    WinsockBufferType* packet = Get_Buffer();
 
     /*
     ** Copy the packet into the holding buffer.
@@ -491,7 +566,7 @@ void WinsockInterfaceClass::Broadcast(void* buffer, int buffer_len)
     /*
     ** Create a temporary holding area for the packet.
     */
-    WinsockBufferType* packet = new WinsockBufferType;
+    WinsockBufferType* packet = Get_Buffer();
 
     /*
     ** Copy the packet into the holding buffer.
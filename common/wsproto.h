@@ -159,6 +159,16 @@ public:
         return (ConnectStatus);
     }
 
+    /*
+    ** Time in milliseconds that the packet last returned by Read arrived from the network.
+    */
+    inline unsigned int Get_Last_Arrival_Time(void)
+    {
+        return (LastArrivalTime);
+    }
+
+    static unsigned int Arrival_Clock(void);
+
 #if !defined _WIN32 || defined SDL_BUILD
     fd_set* Get_Readset(void)
     {
@@ -183,14 +193,27 @@ protected:
         unsigned char Address[64];  // Address. IN_ADDR, IPXAddressClass etc.
         int BufferLen;              // Length of data in buffer
         bool IsBroadcast;           // Flag to broadcast this packet
+        unsigned int ArrivalTime;   // Arrival_Clock time an incoming packet was received
         unsigned char Buffer[1024]; // Buffer to store packet in.
     } WinsockBufferType;
 
+    /*
+    ** Packet buffers are recycled through a free list rather than allocated per packet.
+    */
+    WinsockBufferType* Get_Buffer(void);
+    void Release_Buffer(WinsockBufferType* packet);
+
     /*
     ** Array of buffers to temporarily store incoming and outgoing packets.
     */
     DynamicVectorClass<WinsockBufferType*> InBuffers;
     DynamicVectorClass<WinsockBufferType*> OutBuffers;
+    DynamicVectorClass<WinsockBufferType*> FreeBuffers;
+
+    /*
+    ** Arrival time of the last packet handed to the game.
+    */
+    unsigned int LastArrivalTime;
 
     /*
     ** Is Winsock present and initialised?
@@ -39,6 +39,13 @@
  * UDPInterfaceClass::Set_Broadcast_Address -- Sets the address to send broadcast packets to   *
  * UDPInterfaceClass::Open_Socket -- Opens a socket for communications via the UDP protocol    *
  * TMC::Message_Handler -- Message handler function for Winsock related messages               *
+ * UDPIC::Start_Listening -- Start the network thread receiving on our socket                  *
+ * UDPIC::Stop_Listening -- Stop the network thread and drop anything it had queued            *
+ * UDPIC::Close_Socket -- Stop the network thread then close the socket                        *
+ * UDPIC::Receive_Thread -- Network thread, blocks on the socket and fills the receive ring    *
+ * UDPIC::Receive_Batch -- Receive as many waiting datagrams as will fit into the ring         *
+ * UDPIC::Drain_Receive_Ring -- Move packets from the network thread into our in buffers       *
+ * UDPIC::Flush_Out_Buffers -- Send queued packets, several per system call where possible     *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "internet.h"
@@ -47,14 +54,58 @@
 #include "wspudp.h"
 #include "misc.h"
 #include "wwkeyboard.h"
+#include "tickwait.h"
 extern WWKeyboardClass* Keyboard;
 
 #include <assert.h>
 #include <stdio.h>
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #ifndef _WIN32
 #include <ifaddrs.h>
+#include <poll.h>
+#else
+#define poll WSAPoll
+#endif
+
+/*
+** How long the network thread blocks before checking if it has been asked to stop.
+*/
+#define UDP_POLL_TIMEOUT 20
+
+/*
+** Packets the network thread can hold before the game picks them up, must be a power of two.
+*/
+#define UDP_RECEIVE_RING_SIZE 256
+
+/*
+** Most datagrams moved by a single recvmmsg or sendmmsg call.
+*/
+#define UDP_IO_BATCH 16
+
+#if !defined _WIN32 || defined SDL_BUILD
+/*
+** Datagrams are received straight into this ring by the network thread and copied out by the
+** game thread. Each side only ever writes its own index so no locks are needed.
+*/
+struct UDPReceiverType
+{
+    struct
+    {
+        unsigned char Address[4];
+        int BufferLen;
+        unsigned int ArrivalTime;
+        unsigned char Buffer[WS_RECEIVE_BUFFER_LEN];
+    } Ring[UDP_RECEIVE_RING_SIZE];
+
+    std::atomic<unsigned int> Head{0};
+    std::atomic<unsigned int> Tail{0};
+    std::atomic<bool> Quit{false};
+    std::thread Thread;
+};
 #endif
 
 #ifdef NETWORKING
@@ -75,6 +126,9 @@ extern WWKeyboardClass* Keyboard;
  *=============================================================================================*/
 UDPInterfaceClass::UDPInterfaceClass(void)
     : WinsockInterfaceClass()
+#if !defined _WIN32 || defined SDL_BUILD
+    , Receiver(nullptr)
+#endif
 {
 }
 
@@ -314,7 +368,7 @@ void UDPInterfaceClass::Broadcast(void* buffer, int buffer_len)
         /*
         ** Create a temporary holding area for the packet.
         */
-        WinsockBufferType* packet = new WinsockBufferType;
+        WinsockBufferType* packet = Get_Buffer();
 
         /*
         ** Copy the packet into the holding buffer.
@@ -425,8 +479,9 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
             /*
             ** Create a new buffer and store this packet in it.
             */
-            packet = new WinsockBufferType;
+            packet = Get_Buffer();
             packet->BufferLen = rc;
+            packet->ArrivalTime = Arrival_Clock();
             memcpy(packet->Buffer, ReceiveBuffer, rc);
             memset(packet->Address, 0, sizeof(packet->Address));
             memcpy(packet->Address + 4, &addr.sin_addr.s_addr, 4);
@@ -487,7 +542,7 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
         ** Delete the sent packet.
         */
         OutBuffers.Delete(packetnum);
-        delete packet;
+        Release_Buffer(packet);
         return (0);
     }
 
@@ -496,112 +551,337 @@ int UDPInterfaceClass::Message_Handler(HWND, UINT message, UINT, LONG lParam)
 #else
 int UDPInterfaceClass::Message_Handler()
 {
-    struct sockaddr_in addr;
-    int rc;
-    socklen_t addr_len;
-    WinsockBufferType* packet;
-    struct timeval tv;
+    Drain_Receive_Ring();
+    Flush_Out_Buffers();
 
-    tv.tv_sec = 0;
-    tv.tv_usec = 0;
+    return 0;
+}
 
-    /*
-    ** Check if socket has data it would like to give us or can accept any data
-    */
-    fd_set* read_set = Get_Readset();
-    fd_set* write_set = Get_Writeset();
-    rc = select(Socket + 1, read_set, write_set, nullptr, &tv);
-
-    if (rc >= 0) {
-        if (FD_ISSET(Socket, read_set)) {
-            while (true) {
-                addr_len = sizeof(addr);
-                rc = recvfrom(Socket, (char*)ReceiveBuffer, sizeof(ReceiveBuffer), 0, (sockaddr*)&addr, &addr_len);
-
-                /*
-                ** rc is the number of bytes received.
-                */
-                if (rc <= 0) {
-                    if (rc < 0 && LastSocketError != WSAEWOULDBLOCK) {
-                        Clear_Socket_Error(Socket);
-                    }
-
-                    break;
-                } else {
-                    bool remote = true;
-
-                    /*
-                    ** Make sure this packet didn't come from us. If it did then throw it away.
-                    */
-                    for (int i = 0; i < LocalAddresses.Count(); i++) {
-                        if (!memcmp(LocalAddresses[i], &addr.sin_addr.s_addr, 4)) {
-                            remote = false;
-                            break;
-                        }
-                    }
-
-                    if (remote) {
-                        /*
-                        ** Create a new buffer and store this packet in it.
-                        */
-                        packet = new WinsockBufferType;
-                        packet->BufferLen = rc;
-                        memcpy(packet->Buffer, ReceiveBuffer, rc);
-                        memset(packet->Address, 0, sizeof(packet->Address));
-                        memcpy(packet->Address + 4, &addr.sin_addr.s_addr, 4);
-                        InBuffers.Add(packet);
-                    }
-                }
-            }
+/***********************************************************************************************
+ * UDPIC::Start_Listening -- Start the network thread receiving on our socket                  *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   True if the thread is running                                                     *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+bool UDPInterfaceClass::Start_Listening(void)
+{
+    if (Socket == INVALID_SOCKET) {
+        return (false);
+    }
+
+    if (Receiver == nullptr) {
+        Receiver = new UDPReceiverType;
+        Receiver->Thread = std::thread(&UDPInterfaceClass::Receive_Thread, this);
+    }
+
+    return (true);
+}
+
+/***********************************************************************************************
+ * UDPIC::Stop_Listening -- Stop the network thread and drop anything it had queued            *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+void UDPInterfaceClass::Stop_Listening(void)
+{
+    if (Receiver != nullptr) {
+        Receiver->Quit.store(true);
+        Receiver->Thread.join();
+        delete Receiver;
+        Receiver = nullptr;
+    }
+}
+
+/***********************************************************************************************
+ * UDPIC::Close_Socket -- Stop the network thread then close the socket                        *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+void UDPInterfaceClass::Close_Socket(void)
+{
+    Stop_Listening();
+    WinsockInterfaceClass::Close_Socket();
+}
+
+/***********************************************************************************************
+ * UDPIC::Receive_Thread -- Network thread, blocks on the socket and fills the receive ring    *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: Runs on its own thread, must only touch the ring and the socket.                  *
+ *                                                                                             *
+ *=============================================================================================*/
+void UDPInterfaceClass::Receive_Thread(void)
+{
+    struct pollfd fd;
+    fd.fd = Socket;
+    fd.events = POLLIN;
+
+    while (!Receiver->Quit.load(std::memory_order_relaxed)) {
+        fd.revents = 0;
+
+        if (poll(&fd, 1, UDP_POLL_TIMEOUT) <= 0) {
+            continue;
         }
 
-        if (FD_ISSET(Socket, write_set)) {
+        for (;;) {
+            unsigned int head = Receiver->Head.load(std::memory_order_relaxed);
+            unsigned int space = UDP_RECEIVE_RING_SIZE - (head - Receiver->Tail.load(std::memory_order_acquire));
+
             /*
-            ** If there are no packets waiting to be sent then bail.
+            ** The game has fallen behind, leave the rest in the socket buffer for now.
             */
-            while (OutBuffers.Count() != 0) {
-                int packetnum = 0;
-
-                /*
-                ** Get a pointer to the packet.
-                */
-                packet = OutBuffers[packetnum];
-
-                /*
-                ** Set up the address structure of the outgoing packet
-                */
-                memset(&addr, 0, sizeof(addr));
-                addr.sin_family = AF_INET;
-                addr.sin_port = hton16(PlanetWestwoodPortNumber);
-                memcpy(&addr.sin_addr.s_addr, packet->Address + 4, 4);
-
-                /*
-                ** Send it.
-                ** If we get a WSAWOULDBLOCK error it means that Winsock is unable to accept the packet
-                ** at this time. In this case, we clear the socket error and just exit. 
-                */
-                rc = sendto(Socket, (const char*)packet->Buffer, packet->BufferLen, 0, (sockaddr*)&addr, sizeof(addr));
-
-                if (rc == SOCKET_ERROR) {
-                    if (LastSocketError != WSAEWOULDBLOCK) {
-                        Clear_Socket_Error(Socket);
-                    }
-
-                    break;
-                } else {
-                    /*
-                    ** Delete the sent packet.
-                    */
-                    OutBuffers.Delete(packetnum);
-                    delete packet;
-                }
+            if (space == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                break;
+            }
+
+            int received = Receive_Batch(head, space < UDP_IO_BATCH ? space : UDP_IO_BATCH);
+
+            if (received <= 0) {
+                break;
             }
+
+            Receiver->Head.store(head + received, std::memory_order_release);
+            Wake_Tick_Wait(WAKE_NETWORK);
         }
-    } else {
-        Clear_Socket_Error(Socket);
     }
+}
 
-    return 0;
+/***********************************************************************************************
+ * UDPIC::Receive_Batch -- Receive as many waiting datagrams as will fit into the ring         *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Ring index to start at                                                            *
+ *           Maximum number of datagrams to receive                                            *
+ *                                                                                             *
+ * OUTPUT:   Number of datagrams received                                                      *
+ *                                                                                             *
+ * WARNINGS: Called on the network thread.                                                     *
+ *                                                                                             *
+ *=============================================================================================*/
+int UDPInterfaceClass::Receive_Batch(unsigned int head, int count)
+{
+    struct sockaddr_in addrs[UDP_IO_BATCH];
+    int received = 0;
+
+#ifdef __linux__
+    struct mmsghdr msgs[UDP_IO_BATCH];
+    struct iovec iovs[UDP_IO_BATCH];
+
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+
+    for (int i = 0; i < count; i++) {
+        auto& slot = Receiver->Ring[(head + i) & (UDP_RECEIVE_RING_SIZE - 1)];
+        iovs[i].iov_base = slot.Buffer;
+        iovs[i].iov_len = sizeof(slot.Buffer);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &addrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    }
+
+    received = recvmmsg(Socket, msgs, count, MSG_DONTWAIT, nullptr);
+
+    if (received < 0) {
+        if (LastSocketError != WSAEWOULDBLOCK) {
+            Clear_Socket_Error(Socket);
+        }
+
+        return 0;
+    }
+
+    for (int i = 0; i < received; i++) {
+        Receiver->Ring[(head + i) & (UDP_RECEIVE_RING_SIZE - 1)].BufferLen = msgs[i].msg_len;
+    }
+#else
+    for (; received < count; received++) {
+        auto& slot = Receiver->Ring[(head + received) & (UDP_RECEIVE_RING_SIZE - 1)];
+        socklen_t addr_len = sizeof(addrs[received]);
+        int rc = recvfrom(
+            Socket, (char*)slot.Buffer, sizeof(slot.Buffer), 0, (sockaddr*)&addrs[received], &addr_len);
+
+        if (rc <= 0) {
+            if (rc < 0 && LastSocketError != WSAEWOULDBLOCK) {
+                Clear_Socket_Error(Socket);
+            }
+
+            break;
+        }
+
+        slot.BufferLen = rc;
+    }
+#endif
+
+    unsigned int now = Arrival_Clock();
+
+    for (int i = 0; i < received; i++) {
+        auto& slot = Receiver->Ring[(head + i) & (UDP_RECEIVE_RING_SIZE - 1)];
+        memcpy(slot.Address, &addrs[i].sin_addr.s_addr, 4);
+        slot.ArrivalTime = now;
+    }
+
+    return received;
+}
+
+/***********************************************************************************************
+ * UDPIC::Drain_Receive_Ring -- Move packets from the network thread into our in buffers       *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: None                                                                              *
+ *                                                                                             *
+ *=============================================================================================*/
+void UDPInterfaceClass::Drain_Receive_Ring(void)
+{
+    if (Receiver == nullptr) {
+        return;
+    }
+
+    unsigned int tail = Receiver->Tail.load(std::memory_order_relaxed);
+    unsigned int head = Receiver->Head.load(std::memory_order_acquire);
+
+    for (; tail != head; tail++) {
+        auto& slot = Receiver->Ring[tail & (UDP_RECEIVE_RING_SIZE - 1)];
+        bool remote = slot.BufferLen > 0;
+
+        /*
+        ** Make sure this packet didn't come from us. If it did then throw it away.
+        */
+        for (int i = 0; remote && i < LocalAddresses.Count(); i++) {
+            if (!memcmp(LocalAddresses[i], slot.Address, 4)) {
+                remote = false;
+            }
+        }
+
+        if (remote) {
+            WinsockBufferType* packet = Get_Buffer();
+            packet->BufferLen = slot.BufferLen;
+            packet->ArrivalTime = slot.ArrivalTime;
+            memcpy(packet->Buffer, slot.Buffer, slot.BufferLen);
+            memset(packet->Address, 0, sizeof(packet->Address));
+            memcpy(packet->Address + 4, slot.Address, 4);
+            InBuffers.Add(packet);
+        }
+    }
+
+    Receiver->Tail.store(tail, std::memory_order_release);
+}
+
+/***********************************************************************************************
+ * UDPIC::Flush_Out_Buffers -- Send queued packets, several per system call where possible     *
+ *                                                                                             *
+ *                                                                                             *
+ *                                                                                             *
+ * INPUT:    Nothing                                                                           *
+ *                                                                                             *
+ * OUTPUT:   Nothing                                                                           *
+ *                                                                                             *
+ * WARNINGS: Packets the socket cannot take right now stay queued for the next call.           *
+ *                                                                                             *
+ *=============================================================================================*/
+void UDPInterfaceClass::Flush_Out_Buffers(void)
+{
+    struct sockaddr_in addrs[UDP_IO_BATCH];
+
+    while (OutBuffers.Count() != 0) {
+        int count = OutBuffers.Count() < UDP_IO_BATCH ? OutBuffers.Count() : UDP_IO_BATCH;
+        int sent = 0;
+
+        /*
+        ** Set up the address structures of the outgoing packets
+        */
+        for (int i = 0; i < count; i++) {
+            memset(&addrs[i], 0, sizeof(addrs[i]));
+            addrs[i].sin_family = AF_INET;
+            addrs[i].sin_port = hton16(PlanetWestwoodPortNumber);
+            memcpy(&addrs[i].sin_addr.s_addr, OutBuffers[i]->Address + 4, 4);
+        }
+
+#ifdef __linux__
+        struct mmsghdr msgs[UDP_IO_BATCH];
+        struct iovec iovs[UDP_IO_BATCH];
+
+        memset(msgs, 0, sizeof(msgs[0]) * count);
+
+        for (int i = 0; i < count; i++) {
+            iovs[i].iov_base = OutBuffers[i]->Buffer;
+            iovs[i].iov_len = OutBuffers[i]->BufferLen;
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+        }
+
+        sent = sendmmsg(Socket, msgs, count, 0);
+        if (sent < 0) {
+            sent = 0;
+        }
+#else
+        for (; sent < count; sent++) {
+            WinsockBufferType* packet = OutBuffers[sent];
+            int rc = sendto(Socket,
+                            (const char*)packet->Buffer,
+                            packet->BufferLen,
+                            0,
+                            (sockaddr*)&addrs[sent],
+                            sizeof(addrs[sent]));
+
+            if (rc == SOCKET_ERROR) {
+                break;
+            }
+        }
+#endif
+
+        /*
+        ** Recycle the sent packets.
+        */
+        for (int i = 0; i < sent; i++) {
+            Release_Buffer(OutBuffers[0]);
+            OutBuffers.Delete(0);
+        }
+
+        /*
+        ** If we get a WSAWOULDBLOCK error it means that the socket is unable to accept the packet
+        ** at this time. In this case, we clear the socket error and just exit.
+        */
+        if (sent < count) {
+            if (LastSocketError != WSAEWOULDBLOCK) {
+                Clear_Socket_Error(Socket);
+            }
+
+            break;
+        }
+    }
 }
 #endif
 
@@ -56,6 +56,11 @@ public:
     virtual bool Open_Socket(SOCKET socketnum);
     virtual void Set_Broadcast_Address(void* address);
     virtual void Broadcast(void* buffer, int buffer_len);
+#if !defined _WIN32 || defined SDL_BUILD
+    virtual void Close_Socket(void);
+    virtual bool Start_Listening(void);
+    virtual void Stop_Listening(void);
+#endif
 
     virtual ProtocolEnum Get_Protocol(void)
     {
@@ -68,6 +73,19 @@ public:
     };
 
 private:
+#if !defined _WIN32 || defined SDL_BUILD
+    void Receive_Thread(void);
+    int Receive_Batch(unsigned int head, int count);
+    void Drain_Receive_Ring(void);
+    void Flush_Out_Buffers(void);
+
+    /*
+    ** Receive ring and thread state, kept out of the header so the game code including it does
+    ** not have to pull in the threading headers.
+    */
+    struct UDPReceiverType* Receiver;
+#endif
+
     /*
     ** Address to use when broadcasting a packet.
     */
@@ -57,6 +57,7 @@
 #include <string.h>
 #include <cstdlib>
 #include "settings.h"
+#include "tickwait.h"
 
 #define ARRAY_SIZE(x) int(sizeof(x) / sizeof(x[0]))
 
@@ -191,6 +192,7 @@ bool WWKeyboardClass::Put(unsigned short key)
 {
     if (!Is_Buffer_Full()) {
         Put_Element(key);
+        Wake_Tick_Wait(WAKE_INPUT);
         return (true);
     }
     return (false);
@@ -30,9 +30,15 @@
  *                                                                                             *
  *---------------------------------------------------------------------------------------------*
  * Functions:                                                                                  *
+ *   Clear_Sound_Effects -- Forgets the sound effects looked up so far.                        *
+ *   Get_Sound_Effect_Stats -- Fetches the sound effect cache counters.                        *
  *   Is_Speaking -- Checks to see if the eva voice is still playing.                           *
+ *   Prewarm_Sound_Effects -- Looks up the sound effects the scenario is likely to need.       *
+ *   Prewarm_Techno -- Looks up the sound effects an object is likely to make.                 *
+ *   SoundEffectCacheClass::Load -- Finds the data for a sound effect variant.                 *
  *   Sound_Effect -- General purpose sound player.                                             *
  *   Sound_Effect -- Plays a sound effect in the tactical map.                                 *
+ *   Sound_Effect_Variant -- Fetches which variant of a sound effect to play.                  *
  *   Speak -- Computer speaks to the player.                                                   *
  *   Speak_AI -- Handles starting the EVA voices.                                              *
  *   Speech_Name -- Fetches the name for the voice specified.                                  *
@@ -42,6 +48,7 @@
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
 #include "function.h"
+#include "common/settings.h"
 
 /***************************************************************************
 **	Controls what special effects may occur on the sound effect.
@@ -256,6 +263,242 @@ extern void On_Sound_Effect(int sound_index, int variation, COORDINATE coord, in
 extern void On_Speech(int speech_index, HouseClass* house);
 extern void On_Ping(const HouseClass* player_ptr, COORDINATE coord);
 
+#ifndef REMASTER_BUILD
+/*
+**	File extensions of the sound effect variants. The plain sample is first, followed by the
+**	four allied and the four soviet accents of the infantry and vehicle responses.
+*/
+static char const* const SoundEffectExt[] = {".AUD", ".V00", ".V01", ".V02", ".V03", ".R00", ".R01", ".R02", ".R03"};
+
+/*
+**	Keeps the sample data of every sound effect variant played so far, so that playing one again
+**	doesn't need its file name built and looked up in the mixfiles.
+*/
+class SoundEffectCacheClass : public SampleCacheClass
+{
+public:
+    SoundEffectCacheClass(void)
+        : SampleCacheClass(VOC_COUNT, ARRAY_SIZE(SoundEffectExt))
+    {
+    }
+
+protected:
+    virtual void const* Load(int sound, int variant, size_t& size);
+    virtual bool In_Use(void const* data)
+    {
+        return (Is_Sample_Playing(data));
+    }
+};
+
+static INSTANCE_LOCAL SoundEffectCacheClass SoundEffectCache;
+
+/***********************************************************************************************
+ * SoundEffectCacheClass::Load -- Finds the data for a sound effect variant.                   *
+ *                                                                                             *
+ *    Samples in a cached mixfile are used where they lie. Any others are read into memory     *
+ *    for the cache to keep.                                                                   *
+ *                                                                                             *
+ * INPUT:   sound    -- The VocType of the sound effect.                                       *
+ *                                                                                             *
+ *          variant  -- The variant of the sound, an index into SoundEffectExt.                *
+ *                                                                                             *
+ *          size     -- Set to the size of the data if it was read in for the cache.           *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the sample data, or NULL if it couldn't be found.        *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void const* SoundEffectCacheClass::Load(int sound, int variant, size_t& size)
+{
+    char name[_MAX_FNAME + _MAX_EXT];
+
+    _makepath(name, NULL, NULL, SoundEffectName[sound].Name, SoundEffectExt[variant]);
+    void const* ptr = MFCD::Retrieve(name);
+    if (ptr != NULL) {
+        return (ptr);
+    }
+
+    CCFileClass file(name);
+    if (!file.Is_Available() || file.Size() <= 0) {
+        return (NULL);
+    }
+
+    char* data = new char[file.Size()];
+    if (file.Read(data, file.Size()) != file.Size()) {
+        delete[] data;
+        return (NULL);
+    }
+    size = file.Size();
+    return (data);
+}
+
+/***********************************************************************************************
+ * Sound_Effect_Variant -- Fetches which variant of a sound effect to play.                    *
+ *                                                                                             *
+ *    Infantry and vehicle responses come in several variations and with an allied or a        *
+ *    soviet accent. All other sound effects have only the one variant.                        *
+ *                                                                                             *
+ * INPUT:   voc         -- The sound effect to play.                                           *
+ *                                                                                             *
+ *          variation   -- The variation number requested, as passed to Sound_Effect.          *
+ *                                                                                             *
+ *          house       -- The house whose accent to use, HOUSE_NONE for the player's.         *
+ *                                                                                             *
+ * OUTPUT:  Returns with the variant to play, an index into SoundEffectExt.                    *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static int Sound_Effect_Variant(VocType voc, int variation, HousesType house)
+{
+    if (SoundEffectName[voc].Where != IN_VAR) {
+        return (0);
+    }
+
+    /*
+    **	If there is no forced house, then use the current player
+    **	act like house.
+    */
+    if (house == HOUSE_NONE) {
+        house = PlayerPtr->ActLike;
+    }
+
+    /*
+    **	For infantry, use a variation on the response. For vehicles, always
+    **	use the vehicle response table.
+    */
+    int variant;
+    if (variation < 0) {
+        variant = (ABS(variation) % 2) ? 0 : 2;
+    } else {
+        variant = (variation % 2) ? 1 : 3;
+    }
+
+    /*
+    **	Pick the accent for the house.
+    */
+    if (((1 << house) & HOUSEF_ALLIES) != 0) {
+        return (1 + variant);
+    }
+    return (5 + variant);
+}
+
+/***********************************************************************************************
+ * Prewarm_Techno -- Looks up the sound effects an object is likely to make.                   *
+ *                                                                                             *
+ * INPUT:   techno   -- The object to look up the sounds for.                                  *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static void Prewarm_Techno(TechnoClass const* techno)
+{
+    TechnoTypeClass const* type = techno->Techno_Type_Class();
+
+    if (type->PrimaryWeapon != NULL && type->PrimaryWeapon->Sound != VOC_NONE) {
+        SoundEffectCache.Prewarm(type->PrimaryWeapon->Sound, 0);
+    }
+    if (type->SecondaryWeapon != NULL && type->SecondaryWeapon->Sound != VOC_NONE) {
+        SoundEffectCache.Prewarm(type->SecondaryWeapon->Sound, 0);
+    }
+}
+#endif
+
+/***********************************************************************************************
+ * Prewarm_Sound_Effects -- Looks up the sound effects the scenario is likely to need.         *
+ *                                                                                             *
+ *    Call once the scenario has been read. This looks up the weapon sounds of every object    *
+ *    in it and all the responses in the player's accent, so that the first time each is       *
+ *    played costs no more than any other.                                                     *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void Prewarm_Sound_Effects(void)
+{
+#ifndef REMASTER_BUILD
+    if (!SoundOn || SampleType == SAMPLE_NONE || PlayerPtr == NULL) {
+        return;
+    }
+
+    SoundEffectCache.Set_Budget(size_t(max(Settings.Audio.SampleCacheSize, 1)) * 1024 * 1024);
+
+    for (int index = 0; index < Units.Count(); index++) {
+        Prewarm_Techno(Units.Ptr(index));
+    }
+    for (int index = 0; index < Infantry.Count(); index++) {
+        Prewarm_Techno(Infantry.Ptr(index));
+    }
+    for (int index = 0; index < Vessels.Count(); index++) {
+        Prewarm_Techno(Vessels.Ptr(index));
+    }
+    for (int index = 0; index < Aircraft.Count(); index++) {
+        Prewarm_Techno(Aircraft.Ptr(index));
+    }
+    for (int index = 0; index < Buildings.Count(); index++) {
+        Prewarm_Techno(Buildings.Ptr(index));
+    }
+
+    for (VocType voc = VOC_FIRST; voc < VOC_COUNT; voc++) {
+        if (SoundEffectName[voc].Where == IN_VAR) {
+            for (int variation = -2; variation < 2; variation++) {
+                SoundEffectCache.Prewarm(voc, Sound_Effect_Variant(voc, variation, HOUSE_NONE));
+            }
+        }
+    }
+#endif
+}
+
+/***********************************************************************************************
+ * Clear_Sound_Effects -- Forgets the sound effects looked up so far.                          *
+ *                                                                                             *
+ *    Call when a scenario starts and whenever the mixfiles change. The cache points into the  *
+ *    cached mixfiles, and a sound may now be found in a different one. The counters so far    *
+ *    are logged first.                                                                        *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void Clear_Sound_Effects(void)
+{
+#ifndef REMASTER_BUILD
+    SampleCacheStatsType stats;
+    SoundEffectCache.Get_Stats(stats);
+    DBG_INFO("Sound effect cache: %u hits, %u misses, %u evictions, %u samples in %u bytes",
+             stats.Hits,
+             stats.Misses,
+             stats.Evictions,
+             stats.Entries,
+             (unsigned)stats.Bytes);
+
+    SoundEffectCache.Clear();
+#endif
+}
+
+/***********************************************************************************************
+ * Get_Sound_Effect_Stats -- Fetches the sound effect cache counters.                          *
+ *                                                                                             *
+ * INPUT:   stats -- Where to store the counters.                                              *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The counters are all zero in builds that hand sound effects to the host.        *
+ *=============================================================================================*/
+void Get_Sound_Effect_Stats(SampleCacheStatsType& stats)
+{
+#ifndef REMASTER_BUILD
+    SoundEffectCache.Get_Stats(stats);
+#else
+    memset(&stats, 0, sizeof(stats));
+#endif
+}
+
 /***********************************************************************************************
  * Voc_From_Name -- Fetch VocType from ASCII name specified.                                   *
  *                                                                                             *
@@ -416,8 +659,6 @@ int Sound_Effect(VocType voc, fixed volume, int variation, signed short pan_valu
     COORDINATE coord = 0;
     On_Sound_Effect((int)voc, variation, coord, (int)house);
 #else
-    char name[_MAX_FNAME + _MAX_EXT]; // Working filename of sound effect.
-
     if (Debug_Quiet || Options.Volume == 0 || voc == VOC_NONE || !SoundOn || SampleType == SAMPLE_NONE) {
         return (-1);
     }
@@ -430,57 +671,7 @@ int Sound_Effect(VocType voc, fixed volume, int variation, signed short pan_valu
     /*
 	**	Fetch a pointer to the sound effect data. Modify the sound as appropriate and desired.
 	*/
-    char const* ext = ".AUD";
-    if (SoundEffectName[voc].Where == IN_VAR) {
-
-        /*
-		**	If there is no forced house, then use the current player
-		**	act like house.
-		*/
-        if (house == HOUSE_NONE) {
-            house = PlayerPtr->ActLike;
-        }
-
-        /*
-		**	Change the extension based on the variation and house accent requested.
-		*/
-        if (((1 << house) & HOUSEF_ALLIES) != 0) {
-
-            /*
-			**	For infantry, use a variation on the response. For vehicles, always
-			**	use the vehicle response table.
-			*/
-            if (variation < 0) {
-                if (ABS(variation) % 2) {
-                    ext = ".V00";
-                } else {
-                    ext = ".V02";
-                }
-            } else {
-                if (variation % 2) {
-                    ext = ".V01";
-                } else {
-                    ext = ".V03";
-                }
-            }
-        } else {
-            if (variation < 0) {
-                if (ABS(variation) % 2) {
-                    ext = ".R00";
-                } else {
-                    ext = ".R02";
-                }
-            } else {
-                if (variation % 2) {
-                    ext = ".R01";
-                } else {
-                    ext = ".R03";
-                }
-            }
-        }
-    }
-    _makepath(name, NULL, NULL, SoundEffectName[voc].Name, ext);
-    void const* ptr = MFCD::Retrieve(name);
+    void const* ptr = SoundEffectCache.Fetch(voc, Sound_Effect_Variant(voc, variation, house));
 
     /*
 	**	If the sound data pointer is not null, then presume that it is valid.
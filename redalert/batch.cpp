@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "function.h"
+#include "instance.h"
+#include "common/batchwave.h"
+#include "common/utfargs.h"
+
+/*
+**	Plays a list of AI skirmish matches, spread over every core, and writes the outcome of
+**	each one for balance and regression testing.
+**
+**	BatchRA -jobs=FILE [-threads=N] [-frames=N] [-ai=N] [-csv=FILE] [-json=FILE]
+**
+**	Each line of the jobs file is one match:
+**
+**		<scenario> <house> <seed> [rules]
+**
+**	where house is the country the first player plays as and rules is an optional INI of rule
+**	overrides. Blank lines and lines starting with ';' or '#' are skipped. Every player is run
+**	by the AI and each match only depends on its own seed, so any line can be run again to
+**	reproduce its result.
+*/
+
+struct BatchOptionsType
+{
+    char const* Jobs;
+    char const* CSV;
+    char const* JSON;
+    int Threads;
+    int Frames;
+    int AIPlayers;
+};
+
+struct BatchJobType
+{
+    char Scenario[64];
+    char Rules[260];
+    HousesType House;
+    int Seed;
+};
+
+/*
+**	The same tallies Tally_Score keeps for a human player, plus what the house lost.
+*/
+struct BatchHouseType
+{
+    HousesType ActLike;
+    bool IsDefeated;
+    int Kills;
+    int UnitsLost;
+    int BuildingsLost;
+    int Harvested;
+    int Credits;
+};
+
+struct BatchResultType
+{
+    char const* Outcome;
+    int Frames;
+    double Seconds;
+    int HouseCount;
+    BatchHouseType Houses[MAX_PLAYERS];
+};
+
+static void Parse_Batch_Args(int argc, char** argv, BatchOptionsType& options)
+{
+    options.Jobs = NULL;
+    options.CSV = NULL;
+    options.JSON = NULL;
+    options.Threads = int(std::thread::hardware_concurrency());
+    options.Frames = TICKS_PER_MINUTE * 60;
+    options.AIPlayers = 1;
+
+    for (int index = 1; index < argc; ++index) {
+        char const* arg = argv[index];
+
+        if (strnicmp(arg, "-jobs=", 6) == 0) {
+            options.Jobs = arg + 6;
+        } else if (strnicmp(arg, "-csv=", 5) == 0) {
+            options.CSV = arg + 5;
+        } else if (strnicmp(arg, "-json=", 6) == 0) {
+            options.JSON = arg + 6;
+        } else if (strnicmp(arg, "-threads=", 9) == 0) {
+            options.Threads = atoi(arg + 9);
+        } else if (strnicmp(arg, "-frames=", 8) == 0) {
+            options.Frames = atoi(arg + 8);
+        } else if (strnicmp(arg, "-ai=", 4) == 0) {
+            options.AIPlayers = atoi(arg + 4);
+        }
+    }
+
+    if (options.Threads < 1) {
+        options.Threads = 1;
+    }
+    options.AIPlayers = Bound(options.AIPlayers, 1, MAX_PLAYERS - 1);
+}
+
+static bool Read_Jobs(char const* filename, std::vector<BatchJobType>& jobs)
+{
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        printf("Unable to open %s.\n", filename);
+        return (false);
+    }
+
+    char line[512];
+    int number = 0;
+    bool ok = true;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        number++;
+
+        char scenario[sizeof(BatchJobType::Scenario)];
+        char house[32];
+        BatchJobType job;
+        job.Rules[0] = '\0';
+
+        char* start = line;
+        while (isspace((unsigned char)*start)) {
+            start++;
+        }
+        if (*start == '\0' || *start == ';' || *start == '#') {
+            continue;
+        }
+
+        if (sscanf(start, "%63s %31s %d %259s", scenario, house, &job.Seed, job.Rules) < 3) {
+            printf("%s(%d): expected <scenario> <house> <seed> [rules].\n", filename, number);
+            ok = false;
+            continue;
+        }
+
+        job.House = HouseTypeClass::From_Name(house);
+        if (job.House == HOUSE_NONE) {
+            printf("%s(%d): unknown house %s.\n", filename, number, house);
+            ok = false;
+            continue;
+        }
+
+        strcpy(job.Scenario, scenario);
+        jobs.push_back(job);
+    }
+
+    fclose(file);
+    return (ok);
+}
+
+/*
+**	Plays one match to the end, or until the frame limit, on the calling thread. Once loaded it
+**	calls ready and only starts playing when that returns.
+*/
+static void Run_Job(BatchJobType const& job,
+                    BatchResultType& result,
+                    BatchOptionsType const& options,
+                    int id,
+                    const std::function<void()>& ready)
+{
+    GameInstanceClass instance(id);
+
+    result.Frames = 0;
+    result.Seconds = 0;
+    result.HouseCount = 0;
+
+    if (!instance.Start(job.Scenario, options.AIPlayers, job.Seed, job.House, job.Rules)) {
+        result.Outcome = "error";
+        instance.Stop();
+        return;
+    }
+
+    ready();
+
+    auto begin = std::chrono::steady_clock::now();
+    while (instance.Is_Running() && instance.Frames() < options.Frames) {
+        instance.Step();
+    }
+    result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    result.Frames = instance.Frames();
+
+    if (PlayerWins) {
+        result.Outcome = "win";
+    } else if (PlayerLoses) {
+        result.Outcome = "loss";
+    } else {
+        result.Outcome = "timeout";
+    }
+
+    for (int index = 0; index <= options.AIPlayers; index++) {
+        HouseClass* house = HouseClass::As_Pointer(HousesType(HOUSE_MULTI1 + index));
+        if (house == NULL) {
+            continue;
+        }
+
+        BatchHouseType& tally = result.Houses[result.HouseCount++];
+        tally.ActLike = house->ActLike;
+        tally.IsDefeated = house->IsDefeated;
+        tally.Kills = 0;
+        for (HousesType other = HOUSE_FIRST; other < HOUSE_COUNT; other++) {
+            tally.Kills += house->UnitsKilled[other] + house->BuildingsKilled[other];
+        }
+        tally.UnitsLost = house->UnitsLost;
+        tally.BuildingsLost = house->BuildingsLost;
+        tally.Harvested = house->HarvestedCredits;
+        tally.Credits = house->Available_Money();
+    }
+
+    instance.Stop();
+}
+
+/*
+**	The rules are shared by every instance and each scenario load rewrites them, so only jobs
+**	with the same scenario and overrides may run side by side, and none may load while another
+**	is playing. The jobs are played in waves of one group, each wave loading every match before
+**	any of them step.
+*/
+static void Run_Jobs(std::vector<BatchJobType> const& jobs, std::vector<BatchResultType>& results, BatchOptionsType const& options)
+{
+    std::vector<int> groups(jobs.size());
+    for (int index = 0; index < int(jobs.size()); index++) {
+        groups[index] = index;
+        for (int other = 0; other < index; other++) {
+            if (stricmp(jobs[other].Scenario, jobs[index].Scenario) == 0
+                && strcmp(jobs[other].Rules, jobs[index].Rules) == 0) {
+                groups[index] = groups[other];
+                break;
+            }
+        }
+    }
+
+    std::mutex print;
+    Run_In_Waves(groups, options.Threads, [&](int job, const std::function<void()>& ready) {
+        Run_Job(jobs[job], results[job], options, job, ready);
+
+        std::lock_guard<std::mutex> lock(print);
+        printf("%d: %s %s seed %d, %s after %d frames.\n",
+               job + 1,
+               jobs[job].Scenario,
+               HouseTypeClass::As_Reference(jobs[job].House).IniName,
+               jobs[job].Seed,
+               results[job].Outcome,
+               results[job].Frames);
+    });
+}
+
+static double Ticks_Per_Second(BatchResultType const& result)
+{
+    return (result.Seconds > 0 ? result.Frames / result.Seconds : 0.0);
+}
+
+/*
+**	One row per house per match, so the file loads straight into a spreadsheet.
+*/
+static void Write_CSV(FILE* file, std::vector<BatchJobType> const& jobs, std::vector<BatchResultType> const& results)
+{
+    fprintf(file,
+            "job,scenario,house,seed,rules,outcome,frames,seconds,ticks_per_second,player,country,defeated,kills,"
+            "units_lost,buildings_lost,harvested,credits\n");
+
+    for (int index = 0; index < int(jobs.size()); index++) {
+        BatchJobType const& job = jobs[index];
+        BatchResultType const& result = results[index];
+
+        for (int player = 0; player < std::max(result.HouseCount, 1); player++) {
+            fprintf(file,
+                    "%d,%s,%s,%d,%s,%s,%d,%.3f,%.1f,",
+                    index + 1,
+                    job.Scenario,
+                    HouseTypeClass::As_Reference(job.House).IniName,
+                    job.Seed,
+                    job.Rules,
+                    result.Outcome,
+                    result.Frames,
+                    result.Seconds,
+                    Ticks_Per_Second(result));
+
+            if (player < result.HouseCount) {
+                BatchHouseType const& house = result.Houses[player];
+                fprintf(file,
+                        "%d,%s,%d,%d,%d,%d,%d,%d\n",
+                        player + 1,
+                        HouseTypeClass::As_Reference(house.ActLike).IniName,
+                        house.IsDefeated ? 1 : 0,
+                        house.Kills,
+                        house.UnitsLost,
+                        house.BuildingsLost,
+                        house.Harvested,
+                        house.Credits);
+            } else {
+                fprintf(file, ",,,,,,,\n");
+            }
+        }
+    }
+}
+
+static void Write_JSON(FILE* file, std::vector<BatchJobType> const& jobs, std::vector<BatchResultType> const& results)
+{
+    fprintf(file, "[\n");
+
+    for (int index = 0; index < int(jobs.size()); index++) {
+        BatchJobType const& job = jobs[index];
+        BatchResultType const& result = results[index];
+
+        fprintf(file,
+                "  {\"job\": %d, \"scenario\": \"%s\", \"house\": \"%s\", \"seed\": %d, \"rules\": \"%s\", "
+                "\"outcome\": \"%s\", \"frames\": %d, \"seconds\": %.3f, \"ticks_per_second\": %.1f, \"players\": [",
+                index + 1,
+                job.Scenario,
+                HouseTypeClass::As_Reference(job.House).IniName,
+                job.Seed,
+                job.Rules,
+                result.Outcome,
+                result.Frames,
+                result.Seconds,
+                Ticks_Per_Second(result));
+
+        for (int player = 0; player < result.HouseCount; player++) {
+            BatchHouseType const& house = result.Houses[player];
+            fprintf(file,
+                    "%s\n    {\"country\": \"%s\", \"defeated\": %s, \"kills\": %d, \"units_lost\": %d, "
+                    "\"buildings_lost\": %d, \"harvested\": %d, \"credits\": %d}",
+                    player ? "," : "",
+                    HouseTypeClass::As_Reference(house.ActLike).IniName,
+                    house.IsDefeated ? "true" : "false",
+                    house.Kills,
+                    house.UnitsLost,
+                    house.BuildingsLost,
+                    house.Harvested,
+                    house.Credits);
+        }
+
+        fprintf(file, "%s]}%s\n", result.HouseCount ? "\n  " : "", index + 1 < int(jobs.size()) ? "," : "");
+    }
+
+    fprintf(file, "]\n");
+}
+
+static bool Write_Results(char const* filename,
+                          void (*writer)(FILE*, std::vector<BatchJobType> const&, std::vector<BatchResultType> const&),
+                          std::vector<BatchJobType> const& jobs,
+                          std::vector<BatchResultType> const& results)
+{
+    FILE* file = fopen(filename, "w");
+    if (file == NULL) {
+        printf("Unable to create %s.\n", filename);
+        return (false);
+    }
+    writer(file, jobs, results);
+    fclose(file);
+    return (true);
+}
+
+int main(int argc, char* argv[])
+{
+    UtfArgs args(argc, argv);
+    BatchOptionsType options;
+
+    Parse_Batch_Args(args.ArgC, args.ArgV, options);
+
+    if (options.Jobs == NULL) {
+        printf("Usage: %s -jobs=FILE [-threads=N] [-frames=N] [-ai=N] [-csv=FILE] [-json=FILE]\n", args.ArgV[0]);
+        return (EXIT_FAILURE);
+    }
+
+    if (!GameInstanceClass::Init(args.ArgV[0])) {
+        printf("Unable to load the game data.\n");
+        return (EXIT_FAILURE);
+    }
+
+    std::vector<BatchJobType> jobs;
+    if (!Read_Jobs(options.Jobs, jobs)) {
+        return (EXIT_FAILURE);
+    }
+
+    std::vector<BatchResultType> results(jobs.size());
+
+    auto begin = std::chrono::steady_clock::now();
+    Run_Jobs(jobs, results, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    bool ok = true;
+    if (options.CSV != NULL) {
+        ok = Write_Results(options.CSV, Write_CSV, jobs, results) && ok;
+    }
+    if (options.JSON != NULL) {
+        ok = Write_Results(options.JSON, Write_JSON, jobs, results) && ok;
+    }
+    if (options.CSV == NULL && options.JSON == NULL) {
+        Write_CSV(stdout, jobs, results);
+    }
+
+    printf("%d matches on %d threads in %.2fs.\n", int(jobs.size()), options.Threads, seconds);
+    return (ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
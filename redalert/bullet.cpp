@@ -423,9 +423,7 @@ void BulletClass::AI(void)
                 if (!Map.Is_Radar_Active()) {
                     Map.Radar_Activate(1);
                 }
-                for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
-                    Map.Map_Cell(cell, Payback->House);
-                }
+                Map.Map_All(Payback->House);
                 Map.RadarClass::Flag_To_Redraw(true);
             }
             Payback->House->IsGPSActive = true;
@@ -1135,9 +1133,7 @@ void BulletClass::Bullet_Explodes(bool forced)
             if (!Map.Is_Radar_Active()) {
                 Map.Radar_Activate(1);
             }
-            for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
-                Map.Map_Cell(cell, Payback->House);
-            }
+            Map.Map_All(Payback->House);
             Map.RadarClass::Flag_To_Redraw(true);
         }
         //					Sound_Effect(VOC_SATTACT2);
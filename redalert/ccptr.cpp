@@ -98,7 +98,7 @@ template CCPtr<WarheadTypeClass>::CCPtr(WarheadTypeClass*);
 template class CCPtr<WeaponTypeClass>;
 template CCPtr<WeaponTypeClass>::CCPtr(WeaponTypeClass*);
 
-template <class T> FixedIHeapClass* CCPtr<T>::Heap = NULL;
+template <class T> INSTANCE_LOCAL FixedIHeapClass* CCPtr<T>::Heap = NULL;
 
 /*
 **	These member functions for the CCPtr class cannot be declared inside the
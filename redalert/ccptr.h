@@ -110,7 +110,7 @@ public:
     }
 
 private:
-    static FixedIHeapClass* Heap;
+    static INSTANCE_LOCAL FixedIHeapClass* Heap;
 
     /*
     **	This is the ID number of the object it refers to. By using an ID number, this class can
@@ -72,7 +72,9 @@
  *   CellClass::Shimmer -- Causes all objects in the cell to shimmer.                          *
  *   CellClass::Spot_Index -- returns cell sub-coord index for given COORDINATE                *
  *   CellClass::Spread_Tiberium -- Spread Tiberium from this cell to an adjacent cell.         *
+ *   CellClass::Template_Image -- Fetches the template image and icon drawn for this cell.     *
  *   CellClass::Tiberium_Adjust -- Adjust the look of the Tiberium for smooth.                 *
+ *   CellClass::Update_Cell_Tables -- Copies the movement fields to the cell tables.           *
  *   CellClass::Wall_Update -- Updates the imagery for wall objects in cell.                   *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
@@ -542,6 +544,7 @@ void CellClass::Recalc_Attributes(void)
     if (LastTheater == THEATER_INTERIOR) {
         if (TType == TEMPLATE_NONE || TType == TEMPLATE_CLEAR1) {
             Land = LAND_ROCK;
+            Update_Cell_Tables();
             return;
         }
     }
@@ -551,8 +554,10 @@ void CellClass::Recalc_Attributes(void)
     */
     if (Overlay != OVERLAY_NONE) {
         Land = OverlayTypeClass::As_Reference(Overlay).Land;
-        if (Land != LAND_CLEAR)
+        if (Land != LAND_CLEAR) {
+            Update_Cell_Tables();
             return;
+        }
     }
 
     /*
@@ -562,6 +567,7 @@ void CellClass::Recalc_Attributes(void)
     if (TType != TEMPLATE_NONE && TType != 255) {
         TemplateTypeClass const* ttype = &TemplateTypeClass::As_Reference(TType);
         Land = ttype->Land_Type(TIcon);
+        Update_Cell_Tables();
         return;
     }
 
@@ -569,6 +575,7 @@ void CellClass::Recalc_Attributes(void)
     **	No template is the same as clear terrain.
     */
     Land = LAND_CLEAR;
+    Update_Cell_Tables();
 }
 
 /***********************************************************************************************
@@ -661,6 +668,7 @@ void CellClass::Occupy_Down(ObjectClass* object)
     default:
         break;
     }
+    CellTables.Set_Composite(Cell_Number(), Flag.Composite);
 }
 
 /***********************************************************************************************
@@ -729,6 +737,7 @@ void CellClass::Occupy_Up(ObjectClass* object)
     default:
         break;
     }
+    CellTables.Set_Composite(Cell_Number(), Flag.Composite);
 }
 
 /***********************************************************************************************
@@ -992,6 +1001,30 @@ bool CellClass::Get_Template_Info(char* template_name, int& icon, void*& image_d
     return false;
 }
 
+/***********************************************************************************************
+ * CellClass::Template_Image -- Fetches the template image and icon drawn for this cell.       *
+ *                                                                                             *
+ * INPUT:   icon  -- Reference to the icon number within the template image.                   *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the template image data (may be NULL).                   *
+ *                                                                                             *
+ * WARNINGS:   This only reads the cell, so it is safe to call from the banded redraw jobs.    *
+ *=============================================================================================*/
+void const* CellClass::Template_Image(int& icon) const
+{
+    TemplateTypeClass const* ttype;
+
+    if (TType != TEMPLATE_NONE && TType != TEMPLATE_CLEAR1 && TType != 255) {
+        ttype = &TemplateTypeClass::As_Reference(TType);
+        icon = TIcon;
+    } else {
+        ttype = &TemplateTypeClass::As_Reference(TEMPLATE_CLEAR1);
+        icon = Clear_Icon();
+    }
+
+    return ttype->Get_Image_Data();
+}
+
 /***********************************************************************************************
  * CellClass::Draw_It -- Draws the cell imagery at the location specified.                     *
  *                                                                                             *
@@ -1001,6 +1034,10 @@ bool CellClass::Get_Template_Info(char* template_name, int& icon, void*& image_d
  *                                                                                             *
  * INPUT:   x,y   -- The screen coordinates to render the cell imagery at.                     *
  *                                                                                             *
+ *          objects -- Draw the objects in the cell rather than the cell imagery.              *
+ *                                                                                             *
+ *          skip_template -- The template icon has already been drawn (banded redraw).         *
+ *                                                                                             *
  * OUTPUT:  none                                                                               *
  *                                                                                             *
  * WARNINGS:   none                                                                            *
@@ -1015,15 +1052,15 @@ bool CellClass::Get_Template_Info(char* template_name, int& icon, void*& image_d
  *   04/25/1995 JLB : Smudges drawn BELOW overlays.                                            *
  *   07/22/1996 JLB : Objects added to draw process.                                           *
  *=============================================================================================*/
-void CellClass::Draw_It(int x, int y, bool objects) const
+void CellClass::Draw_It(int x, int y, bool objects, bool skip_template) const
 {
     assert((unsigned)Cell_Number() <= MAP_CELL_TOTAL);
 
     if (!objects) {
         BStart(BENCH_CELL);
 
-        TemplateTypeClass const* ttype = 0;
         int icon; // The icon number to use from the template set.
+        void const* image = Template_Image(icon);
         CELL cell = Cell_Number();
         void* remap = NULL;
 #ifdef SCENARIO_EDITOR
@@ -1035,17 +1072,6 @@ void CellClass::Draw_It(int x, int y, bool objects) const
 
         CellCount++;
 
-        /*
-        **	Fetch a pointer to the template type associated with this cell.
-        */
-        if (TType != TEMPLATE_NONE && TType != TEMPLATE_CLEAR1 && TType != 255) {
-            ttype = &TemplateTypeClass::As_Reference(TType);
-            icon = TIcon;
-        } else {
-            ttype = &TemplateTypeClass::As_Reference(TEMPLATE_CLEAR1);
-            icon = Clear_Icon();
-        }
-
 #ifdef CHEAT_KEYS
         /*
         **	Draw the stamp of the template.
@@ -1097,8 +1123,8 @@ void CellClass::Draw_It(int x, int y, bool objects) const
             /*
             **	This is the underlying terrain icon.
             */
-            if (ttype->Get_Image_Data()) {
-                LogicPage->Draw_Stamp(ttype->Get_Image_Data(), icon, x, y, NULL, WINDOW_TACTICAL);
+            if (image && !skip_template) {
+                LogicPage->Draw_Stamp(image, icon, x, y, NULL, WINDOW_TACTICAL);
                 if (remap) {
                     LogicPage->Remap(x + Map.TacPixelX, y + Map.TacPixelY, ICON_PIXEL_W, ICON_PIXEL_H, remap);
                 }
@@ -1619,6 +1645,11 @@ void CellClass::Concrete_Calc(void)
  *=============================================================================================*/
 void CellClass::Wall_Update(void)
 {
+    /*
+    **	The wall here may have just been removed, which leaves the land type alone.
+    */
+    Update_Cell_Tables();
+
     if (Overlay == OVERLAY_NONE) {
         return;
     }
@@ -2489,9 +2520,7 @@ bool CellClass::Goodie_Check(FootClass* object)
             */
             object->House->IsVisionary = true;
             if (object->House->IsHuman) {
-                for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
-                    Map.Map_Cell(cell, object->House);
-                }
+                Map.Map_All(object->House);
                 Map.Flag_To_Redraw(true);
             }
             break;
@@ -2952,12 +2981,18 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
         return (true);
     }
 
+    /*
+    **	The checks below read the dense cell tables rather than the cell itself, they hold
+    **	the same zone, occupation, land and wall values.
+    */
+    CELL cell = Cell_Number();
+
     /*
     **	If a zone was specified, then see if the cell is in a legal
     **	zone to allow movement.
     */
     if (zone != -1) {
-        if (zone != Zones[check]) {
+        if (zone != CellTables.Zone(cell, check)) {
             return (false);
         }
     }
@@ -2966,7 +3001,7 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
     **	Check the occupy bits for passable legality. If ignore infantry is true, then
     **	don't consider infnatry.
     */
-    int composite = Flag.Composite;
+    int composite = CellTables.Composite(cell);
     if (ignoreinfantry) {
         composite &= 0xE0; // Drop the infantry occupation bits.
     }
@@ -2977,37 +3012,24 @@ bool CellClass::Is_Clear_To_Move(SpeedType loco,
         return (false);
     }
 
-    /*
-    **	Fetch the land type of the cell -- to be modified and used later.
-    */
-    LandType land = Land_Type();
-
     /*
     **	Walls are always considered to block the terrain for general passability
     **	purposes unless this is a wall crushing check or if the checking object
-    **	can destroy walls.
+    **	can destroy walls. The tables record the land under a wall as clear.
     */
-    OverlayTypeClass const* overlay = NULL;
-    if (Overlay != OVERLAY_NONE) {
-        overlay = &OverlayTypeClass::As_Reference(Overlay);
+    int wall = CellTables.Wall(cell);
+    if (wall == CELLWALL_SOLID && check != MZONE_DESTROYER) {
+        return (false);
     }
-    if (overlay != NULL && overlay->IsWall) {
-        if (check != MZONE_DESTROYER && (check != MZONE_CRUSHER || !overlay->IsCrushable)) {
-            return (false);
-        }
-
-        /*
-        **	Crushing objects consider crushable walls as clear rather than the
-        **	typical LAND_WALL setting.
-        */
-        land = LAND_CLEAR;
+    if (wall == CELLWALL_CRUSHABLE && check != MZONE_DESTROYER && check != MZONE_CRUSHER) {
+        return (false);
     }
 
     /*
     **	See if the ground type is impassable to this locomotion type and if
     **	so, return the error condition.
     */
-    if (::Ground[land].Cost[loco] == 0) {
+    if (::Ground[CellTables.Land(cell)].Cost[loco] == 0) {
         return (false);
     }
 
@@ -3389,4 +3411,39 @@ bool CellClass::Is_Jamming(HouseClass* player) const
 void CellClass::Override_Land_Type(LandType type)
 {
     OverrideLand = type;
+    Update_Cell_Tables();
+}
+
+/***********************************************************************************************
+ * CellClass::Update_Cell_Tables -- Copies the movement fields to the cell tables.             *
+ *                                                                                             *
+ *    The CellTables hold dense copies of the cell fields that passability checks read. This   *
+ *    must be called whenever the occupation bits, land type or wall overlay of the cell       *
+ *    change. The zones are copied separately by the zone calculation.                         *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void CellClass::Update_Cell_Tables(void) const
+{
+    LandType land = Land_Type();
+    CellWallType wall = CELLWALL_NONE;
+
+    /*
+    **	Walls are recorded as clear land, a unit that may cross the wall drives over it as
+    **	Is_Clear_To_Move does.
+    */
+    if (Overlay != OVERLAY_NONE) {
+        OverlayTypeClass const& overlay = OverlayTypeClass::As_Reference(Overlay);
+        if (overlay.IsWall) {
+            wall = overlay.IsCrushable ? CELLWALL_CRUSHABLE : CELLWALL_SOLID;
+            land = LAND_CLEAR;
+        }
+    }
+
+    CellTables.Set_Composite(Cell_Number(), Flag.Composite);
+    CellTables.Set_Terrain(Cell_Number(), land, wall);
 }
@@ -335,7 +335,8 @@ public:
     /*
     **	Display and rendering controls.
     */
-    void Draw_It(int x, int y, bool objects = false) const;
+    void Draw_It(int x, int y, bool objects = false, bool skip_template = false) const;
+    void const* Template_Image(int& icon) const;
     void Redraw_Objects(bool forced = false);
     void Shimmer(void);
 
@@ -348,6 +349,7 @@ public:
     void Wall_Update(void);
     void Concrete_Calc(void);
     void Recalc_Attributes(void);
+    void Update_Cell_Tables(void) const;
     int Reduce_Tiberium(int levels);
     int Reduce_Wall(int damage);
     void Incoming(COORDINATE threat = 0, bool forced = false, bool nokidding = false);
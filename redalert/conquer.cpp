@@ -52,6 +52,8 @@
  *   Name_From_Source -- retrieves the name for the given SourceType                           *
  *   Owner_From_Name -- Convert an owner name into a bitfield.                                 *
  *   Play_Movie -- Plays a VQ movie.                                                           *
+ *   Playback_Fast_Frame -- Simulate one playback frame without drawing it.                    *
+ *   Playback_Snapshot_AI -- Take replay snapshots and carry out seek requests.                *
  *   Shake_The_Screen -- Dispatcher that shakes the screen.                                    *
  *   Shape_Dimensions -- Determine the minimum rectangle for the shape.                        *
  *   Source_From_Name -- Converts ASCII name into SourceType.                                  *
@@ -138,6 +140,8 @@ void Dump_Heap_Pointers(void);
 void Error_In_Heap_Pointers(char* string);
 #endif
 static void Do_Record_Playback(void);
+static void Playback_Snapshot_AI(void);
+static void Playback_Fast_Frame(void);
 
 void Toggle_Formation(void);
 
@@ -149,6 +153,7 @@ extern char* __nheapbeg;
 char TeamEvent = 0;      // 0 = no event, 1,2,3 = team event type
 char TeamNumber = 0;     // which team was selected? (1-9)
 char FormationEvent = 0; // 0 = no event, 1 = formation was toggled
+static bool PlaybackSeeking = false; // Fast forwarding to a seek target, nothing is drawn
 
 /* -----------------10/14/96 7:29PM------------------
 
@@ -219,13 +224,14 @@ void Main_Game(int argc, char* argv[])
         **	values, and then show the mouse.  This PRESUMES that Select_Game() has
         **	told the map to draw itself.
         */
-        GamePalette.Set(FADE_PALETTE_MEDIUM);
+        GamePalette.Start_Fade(FADE_PALETTE_MEDIUM);
         Keyboard->Clear();
         /*
         ** Only show the mouse if we're not playing back a recording.
         */
         if (Session.Play) {
             Hide_Mouse();
+            Snapshots.Clear();
             TeamEvent = 0;
             TeamNumber = 0;
             FormationEvent = 0;
@@ -403,6 +409,7 @@ void Main_Game(int argc, char* argv[])
         ** been initialized in that case.)
         */
         if (Session.Record || Session.Play) {
+            Session.Recording.End();
             Session.RecordFile.Close();
         }
 
@@ -1335,9 +1342,10 @@ void Color_Cycle(void)
 
         /*
         **	If any of the processing functions changed the palette, then this palette must be
-        **	passed to the system.
+        **	passed to the system. Leave it until any fade in progress is done, setting it now
+        **	would cancel the fade.
         */
-        if (changed) {
+        if (changed && !Palette_Fade_Active()) {
             BStart(BENCH_PALETTE);
             InGamePalette.Set();
             //			Set_Palette(InGamePalette);
@@ -1364,6 +1372,11 @@ void Color_Cycle(void)
  *=============================================================================================*/
 void Call_Back(void)
 {
+    /*
+    **	Step along any palette fade that was started without waiting for it.
+    */
+    Palette_Fade_Tick();
+
     /*
     **	Music and speech maintenance
     */
@@ -1731,7 +1744,7 @@ bool Main_Loop()
     Check_For_Focus_Loss();
 
     /*
-    ** Allocate extra memory for uncompressed shapes as needed
+    ** Trim the uncompressed shape cache as needed
     */
     Reallocate_Big_Shape_Buffer();
 
@@ -1813,6 +1826,16 @@ bool Main_Loop()
         }
     }
 
+    /*
+    **	Snapshots and seeks have to happen before this frame's recorded data is read.
+    */
+    if (Session.Play) {
+        Playback_Snapshot_AI();
+        if (!GameActive) {
+            return (!GameActive);
+        }
+    }
+
     /*
     ** Save map's position & selected objects, if we're recording the game.
     */
@@ -3796,6 +3819,7 @@ bool Force_CD_Available(int cd)
             MainMix = 0;
         }
 
+        Clear_Sound_Effects();
         MainMix = new MFCD("MAIN.MIX", &FastKey);
         assert(MainMix != NULL);
         //		ConquerMix = new MFCD("CONQUER.MIX", &FastKey);
@@ -3847,6 +3871,7 @@ static void Reinit_Secondary_Mixfiles()
         delete ScoreMix;
         delete MainMix;
 
+        Clear_Sound_Effects();
         MainMix = new MFCD("MAIN.MIX", &FastKey);
         assert(MainMix != NULL);
         //		ConquerMix = new MFCD("CONQUER.MIX", &FastKey);
@@ -4347,6 +4372,7 @@ bool Force_CD_Available(int cd)
         if (MainMix)
             delete MainMix;
 
+        Clear_Sound_Effects();
         MainMix = new MFCD("MAIN.MIX", &FastKey);
 
         assert(MainMix != NULL);
@@ -4431,13 +4457,13 @@ static void Do_Record_Playback(void)
         /*
         **	Save the map's location
         */
-        Session.RecordFile.Write(&Map.DesiredTacticalCoord, sizeof(Map.DesiredTacticalCoord));
+        Session.Recording.Write(&Map.DesiredTacticalCoord, sizeof(Map.DesiredTacticalCoord));
 
         /*
         **	Save the current object list count
         */
         count = CurrentObject.Count();
-        Session.RecordFile.Write(&count, sizeof(count));
+        Session.Recording.Write(&count, sizeof(count));
 
         /*
         **	Save a CRC of the selected-object list.
@@ -4447,26 +4473,26 @@ static void Do_Record_Playback(void)
             ltgt = (unsigned int)(CurrentObject[i]->As_Target());
             sum += ltgt;
         }
-        Session.RecordFile.Write(&sum, sizeof(sum));
+        Session.Recording.Write(&sum, sizeof(sum));
 
         /*
         **	Save all selected objects.
         */
         for (i = 0; i < count; i++) {
             tgt = CurrentObject[i]->As_Target();
-            Session.RecordFile.Write(&tgt, sizeof(tgt));
+            Session.Recording.Write(&tgt, sizeof(tgt));
         }
 
         //
         // Save team-selection and formation events
         //
-        Session.RecordFile.Write(&TeamEvent, sizeof(TeamEvent));
-        Session.RecordFile.Write(&TeamNumber, sizeof(TeamNumber));
-        Session.RecordFile.Write(&FormationEvent, sizeof(FormationEvent));
-        Session.RecordFile.Write(TeamFormData, sizeof(TeamFormData));
-        Session.RecordFile.Write(&FormMove, sizeof(FormMove));
-        Session.RecordFile.Write(&FormSpeed, sizeof(FormSpeed));
-        Session.RecordFile.Write(&FormMaxSpeed, sizeof(FormMaxSpeed));
+        Session.Recording.Write(&TeamEvent, sizeof(TeamEvent));
+        Session.Recording.Write(&TeamNumber, sizeof(TeamNumber));
+        Session.Recording.Write(&FormationEvent, sizeof(FormationEvent));
+        Session.Recording.Write(TeamFormData, sizeof(TeamFormData));
+        Session.Recording.Write(&FormMove, sizeof(FormMove));
+        Session.Recording.Write(&FormSpeed, sizeof(FormSpeed));
+        Session.Recording.Write(&FormMaxSpeed, sizeof(FormMaxSpeed));
         TeamEvent = 0;
         TeamNumber = 0;
         FormationEvent = 0;
@@ -4480,13 +4506,13 @@ static void Do_Record_Playback(void)
         /*
         **	Read & set the map's location.
         */
-        if (Session.RecordFile.Read(&coord, sizeof(coord)) == sizeof(coord)) {
+        if (Session.Recording.Read(&coord, sizeof(coord)) == sizeof(coord)) {
             if (coord != Map.DesiredTacticalCoord) {
                 Map.Set_Tactical_Position(coord);
             }
         }
 
-        if (Session.RecordFile.Read(&count, sizeof(count)) == sizeof(count)) {
+        if (Session.Recording.Read(&count, sizeof(count)) == sizeof(count)) {
             /*
             **	Compute a CRC of the current object-selection list.
             */
@@ -4500,7 +4526,7 @@ static void Do_Record_Playback(void)
             **	Load the CRC of the objects on disk; if it doesn't match, select
             **	all objects as they're loaded.
             */
-            Session.RecordFile.Read(&sum2, sizeof(sum2));
+            Session.Recording.Read(&sum2, sizeof(sum2));
             if (sum2 != sum) {
                 Unselect_All();
             }
@@ -4508,7 +4534,7 @@ static void Do_Record_Playback(void)
             AllowVoice = true;
 
             for (i = 0; i < count; i++) {
-                if (Session.RecordFile.Read(&tgt, sizeof(tgt)) == sizeof(tgt)) {
+                if (Session.Recording.Read(&tgt, sizeof(tgt)) == sizeof(tgt)) {
                     obj = As_Object(tgt);
                     if (obj && (sum2 != sum)) {
                         obj->Select();
@@ -4523,9 +4549,9 @@ static void Do_Record_Playback(void)
         //
         // Save team-selection and formation events
         //
-        Session.RecordFile.Read(&TeamEvent, sizeof(TeamEvent));
-        Session.RecordFile.Read(&TeamNumber, sizeof(TeamNumber));
-        Session.RecordFile.Read(&FormationEvent, sizeof(FormationEvent));
+        Session.Recording.Read(&TeamEvent, sizeof(TeamEvent));
+        Session.Recording.Read(&TeamNumber, sizeof(TeamNumber));
+        Session.Recording.Read(&FormationEvent, sizeof(FormationEvent));
         if (TeamEvent) {
             Handle_Team(TeamNumber, TeamEvent - 1);
         }
@@ -4533,16 +4559,109 @@ static void Do_Record_Playback(void)
             Toggle_Formation();
         }
 
-        Session.RecordFile.Read(TeamFormData, sizeof(TeamFormData));
-        Session.RecordFile.Read(&FormMove, sizeof(FormMove));
-        Session.RecordFile.Read(&FormSpeed, sizeof(FormSpeed));
-        Session.RecordFile.Read(&FormMaxSpeed, sizeof(FormMaxSpeed));
+        Session.Recording.Read(TeamFormData, sizeof(TeamFormData));
+        Session.Recording.Read(&FormMove, sizeof(FormMove));
+        Session.Recording.Read(&FormSpeed, sizeof(FormSpeed));
+        Session.Recording.Read(&FormMaxSpeed, sizeof(FormMaxSpeed));
 
         /*
         **	The map isn't drawn in playback mode, so draw it here.
         */
-        Map.Render();
+        if (!PlaybackSeeking) {
+            Map.Render();
+        }
+    }
+}
+
+/***********************************************************************************************
+ * Playback_Snapshot_AI -- Take replay snapshots and carry out seek requests.                  *
+ *                                                                                             *
+ *    Called at the start of each playback frame. A snapshot is taken every snapshot          *
+ *    interval. A pending seek restores the closest snapshot at or before the target and then  *
+ *    simulates forward, without drawing, until the target frame is reached.                   *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static void Playback_Snapshot_AI(void)
+{
+    int target = Snapshots.Pending_Seek();
+
+    if (target != SnapshotRingClass::NO_SEEK) {
+        Snapshots.Clear_Seek();
+
+        /*
+        **	Going back always needs a snapshot. Going forward only uses one if it is ahead
+        **	of where we are now, which happens after an earlier rewind.
+        */
+        if (target < Frame || Snapshots.Nearest(target) > Frame) {
+            int record_pos = 0;
+            if (Snapshots.Restore(target, record_pos) >= 0) {
+                Session.Recording.Seek(record_pos);
+            }
+        }
+
+        bool quiet = Debug_Quiet;
+        Debug_Quiet = true;
+        PlaybackSeeking = true;
+
+        while (GameActive && Frame < target && !PlayerWins && !PlayerLoses && !PlayerRestarts) {
+            if (Snapshots.Is_Due(Frame)) {
+                Snapshots.Capture(Frame, Session.Recording.Tell());
+            }
+            Playback_Fast_Frame();
+        }
+
+        PlaybackSeeking = false;
+        Debug_Quiet = quiet;
+        Map.Flag_To_Redraw(true);
+    }
+
+    if (Snapshots.Is_Due(Frame)) {
+        Snapshots.Capture(Frame, Session.Recording.Tell());
+    }
+}
+
+/***********************************************************************************************
+ * Playback_Fast_Frame -- Simulate one playback frame without drawing it.                      *
+ *                                                                                             *
+ *    This is the logic half of Main_Loop, used to fast forward to a seek target.              *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static void Playback_Fast_Frame(void)
+{
+    Do_Record_Playback();
+
+#ifndef SORTDRAW
+    DisplayClass::Layer[LAYER_GROUND].Sort();
+#endif
+
+    Logic.AI();
+    TimeQuake = false;
+#ifdef FIXIT_CSII //	checked - ajw 9/28/98
+    if (!PendingTimeQuake) {
+        TimeQuakeCenter = 0;
     }
+#endif
+
+    Queue_AI();
+    Score.ElapsedTime += TIMER_SECOND / TICKS_PER_SECOND;
+    Frame++;
+
+#ifdef FIXIT_CSII //	checked - ajw 9/28/98
+    TimeQuake = PendingTimeQuake;
+    PendingTimeQuake = false;
+#else
+    TimeQuake = false;
+#endif
 }
 
 /***********************************************************************************************
@@ -36,7 +36,7 @@
 #define CREDITS_H
 
 class HouseClass;
-extern HouseClass* PlayerPtr;
+extern INSTANCE_LOCAL HouseClass* PlayerPtr;
 
 /****************************************************************************
 **	The animating credit counter display is controlled by this class.
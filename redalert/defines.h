@@ -613,6 +613,13 @@ inline TARGET Build_Target(RTTIType kind, int value)
 #define MAP_REGION_HEIGHT (((MAP_CELL_H + (REGION_WIDTH - 1)) / REGION_HEIGHT) + 2)
 #define MAP_TOTAL_REGIONS (MAP_REGION_WIDTH * MAP_REGION_HEIGHT)
 
+/*
+**	How often the decayed region threat moves toward the current threat, and how much of its
+**	old value it keeps each time, out of 256.
+*/
+#define THREAT_DECAY_DELAY TICKS_PER_SECOND
+#define THREAT_DECAY_KEEP  240
+
 /**********************************************************************
 **	This enumerates the various known fear states for infantry units.
 **	At these stages, certain events or recovery actions are performed.
@@ -46,6 +46,7 @@
  *   DisplayClass::Encroach_Shadow -- Causes the shadow to creep back by one cell.             *
  *   DisplayClass::Flag_Cell -- Flag the specified cell to be redrawn.                         *
  *   DisplayClass::Flag_To_Redraw -- Flags the display so that it will be redrawn as soon as poss*
+ *   DisplayClass::Gather_Tactical_Cells -- Collects the cells a tactical redraw will visit.   *
  *   DisplayClass::Get_Occupy_Dimensions -- computes width & height of the given occupy list   *
  *   DisplayClass::Good_Reinforcement_Cell -- Checks cell for renforcement legality.           *
  *   DisplayClass::In_View -- Determines if cell is visible on screen.                         *
@@ -54,6 +55,9 @@
  *   DisplayClass::Init_Theater -- Theater-specific initialization                             *
  *   DisplayClass::Is_Spot_Free -- Determines if cell sub spot is free of occupation.          *
  *   DisplayClass::Map_Cell -- Mark specified cell as having been mapped.                      *
+ *   DisplayClass::Map_All -- Maps the whole map for a player.                                 *
+ *   DisplayClass::Map_Cells -- Maps every cell in a bitmap for one player.                    *
+ *   DisplayClass::Map_Region -- Maps a block of cells in one pass.                            *
  *   DisplayClass::Mouse_Left_Held -- Handles the left button held down.                       *
  *   DisplayClass::Mouse_Left_Press -- Handles the left mouse button press.                    *
  *   DisplayClass::Mouse_Left_Release -- Handles the left mouse button release.                *
@@ -66,7 +70,9 @@
  *   DisplayClass::Prev_Object -- Searches for the previous object on the map.                 *
  *   DisplayClass::Read_INI -- Reads map control data from INI file.                           *
  *   DisplayClass::Redraw_Icons -- Draws all terrain icons necessary.                          *
+ *   DisplayClass::Redraw_Icons_Banded -- Draws flagged terrain icons using the worker pool.   *
  *   DisplayClass::Redraw_Shadow -- Draw the shadow overlay.                                   *
+ *   DisplayClass::Redraw_Shadow_Banded -- Draws the shadow overlay using the worker pool.     *
  *   DisplayClass::Refresh_Band -- Causes all cells under the rubber band to be redrawn.       *
  *   DisplayClass::Refresh_Cells -- Redraws all cells in list.                                 *
  *   DisplayClass::Remove -- Removes a game object from the rendering system.                  *
@@ -83,18 +89,26 @@
  *   DisplayClass::TacticalClass::Action -- Processes input for the tactical map.              *
  *   DisplayClass::Text_Overlap_List -- Creates cell overlap list for specified text string.   *
  *   DisplayClass::Write_INI -- Write the map data to the INI file specified.                  *
+ *   Fits_In_Cell -- Determines if a shape image stays within the cell it is drawn for.        *
+ *   Set_Cell_Bits -- Sets the bits for a run of cells in a cell bitmap.                       *
+ *   Tactical_Band_Count -- Fetches the number of bands to split the tactical redraw into.     *
+ *   Tactical_Band_Rows -- Fetches the rows and screen lines covered by a band.                *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
+#include <bit>
+
+#include "common/workerpool.h"
 #include "function.h"
 #include "vortex.h"
 #include "xpipe.h"
 #include "common/fading.h"
+#include "common/settings.h"
 
 /*
 **	These layer control elements are used to group the displayable objects
 **	so that proper overlap can be obtained.
 */
-LayerClass DisplayClass::Layer[LAYER_COUNT];
+INSTANCE_LOCAL LayerClass DisplayClass::Layer[LAYER_COUNT];
 
 /*
 ** Fading tables
@@ -120,7 +134,7 @@ unsigned char DisplayClass::ShadowTrans[(SHADOW_COL_COUNT + 1) * 256];
 /*
 ** Bit array of cell redraw flags
 */
-BooleanVectorClass DisplayClass::CellRedraw;
+INSTANCE_LOCAL BooleanVectorClass DisplayClass::CellRedraw;
 
 /*
 ** The main button that intercepts user input to the map
@@ -370,7 +384,20 @@ void DisplayClass::Init_Theater(TheaterType theater)
     */
     sprintf(fullname, "%s.MIX", Theaters[theater].Root);
 
-    if (Scen.Theater != LastTheater) {
+#ifdef GAME_INSTANCES
+    /*
+    **	The theater data is shared by every game instance in the process, so it can only be
+    **	swapped out when the theater really changes. Instances that run at the same time
+    **	must all play in the same theater.
+    */
+    static TheaterType _loaded = THEATER_NONE;
+    bool reload = (theater != _loaded);
+    _loaded = theater;
+#else
+    bool reload = (Scen.Theater != LastTheater);
+#endif
+
+    if (reload) {
         if (TheaterData != NULL) {
             delete TheaterData;
         }
@@ -1704,6 +1731,261 @@ bool DisplayClass::Map_Cell(CELL cell, HouseClass* house, bool check_radar_spied
     return (true);
 }
 
+/*
+**	Bitmaps of map cells, a bit per cell.
+*/
+#define MAP_CELL_WORDS (MAP_CELL_TOTAL / 32)
+
+/***********************************************************************************************
+ * Set_Cell_Bits -- Sets the bits for a run of cells in a cell bitmap.                         *
+ *                                                                                             *
+ * INPUT:   bits  -- The bitmap to set the bits in.                                            *
+ *                                                                                             *
+ *          cell  -- The first cell of the run.                                                *
+ *                                                                                             *
+ *          count -- The number of cells in the run.                                           *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static void Set_Cell_Bits(unsigned* bits, CELL cell, int count)
+{
+    int first = cell;
+    int last = cell + count;
+
+    while (first < last) {
+        int bit = first % 32;
+        int span = min(32 - bit, last - first);
+        unsigned mask = (span == 32) ? ~0U : (((1U << span) - 1) << bit);
+        bits[first / 32] |= mask;
+        first += span;
+    }
+}
+
+/***********************************************************************************************
+ * DisplayClass::Map_Region -- Maps a block of cells in one pass.                              *
+ *                                                                                             *
+ *    This does what calling Map_Cell on every cell of the block would, and leaves the cells   *
+ *    in exactly the state that would, but works from bitmaps of the cells involved instead    *
+ *    of one cell at a time. The adjacent cell fixups, the shadow visibility checks and the    *
+ *    tactical redraw are each done once for the whole block rather than once per cell, which  *
+ *    keeps a whole map reveal from stalling the frame it happens on.                          *
+ *                                                                                             *
+ * INPUT:   x,y   -- The cell coordinates of the upper left corner of the block.               *
+ *                                                                                             *
+ *          w,h   -- The width and height of the block in cells.                               *
+ *                                                                                             *
+ *          house -- The player that is doing the mapping.                                     *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of cells that became mapped, for any player.               *
+ *                                                                                             *
+ * WARNINGS:   The block is clipped to the radar area, as Map_Cell ignores cells outside it.   *
+ *=============================================================================================*/
+int DisplayClass::Map_Region(int x, int y, int w, int h, HouseClass* house, bool check_radar_spied, bool and_for_allies)
+{
+    if (house == NULL)
+        return (0);
+#ifdef REMASTER_BUILD
+    if (!house->IsHuman) {
+        if (!ShareAllyVisibility || !and_for_allies && !check_radar_spied) {
+            return 0;
+        }
+    }
+#endif
+
+    int x1 = min(x + w, MapCellX + MapCellWidth);
+    int y1 = min(y + h, MapCellY + MapCellHeight);
+    x = max(x, MapCellX);
+    y = max(y, MapCellY);
+    if (x >= x1 || y >= y1)
+        return (0);
+
+    unsigned cells[MAP_CELL_WORDS];
+    memset(cells, 0, sizeof(cells));
+    for (int row = y; row < y1; row++) {
+        Set_Cell_Bits(cells, XY_Cell(x, row), x1 - x);
+    }
+
+    /*
+    **	Work out who the mapping is really for, as Map_Cell does.
+    */
+    bool spied = false;
+    if (Session.Type != GAME_GLYPHX_MULTIPLAYER) {
+        if (house != PlayerPtr) {
+            if (house->RadarSpied & (1 << (PlayerPtr->Class->House)))
+                house = PlayerPtr;
+            if (Session.Type == GAME_NORMAL && house->Is_Ally(PlayerPtr))
+                house = PlayerPtr;
+        }
+    } else {
+        spied = check_radar_spied;
+    }
+
+    int count = 0;
+#ifdef REMASTER_BUILD
+    if (ShareAllyVisibility && and_for_allies && Session.Type == GAME_GLYPHX_MULTIPLAYER) {
+        for (int i = 0; i < Session.Players.Count(); i++) {
+            HouseClass* player_ptr = HouseClass::As_Pointer(Session.Players[i]->Player.ID);
+            if (player_ptr && player_ptr->IsActive && player_ptr->IsHuman) {
+                if (player_ptr != house && house->Is_Ally(player_ptr)) {
+                    count += Map_Region(x, y, x1 - x, y1 - y, player_ptr, check_radar_spied, false);
+                }
+            }
+        }
+    }
+#endif
+
+    /*
+    **	Cells mapped for this house are mapped for every player spying on its radar too,
+    **	including any it maps because they are next to the block.
+    */
+    count += Map_Cells(cells, house);
+    if (spied) {
+        for (int i = 0; i < Session.Players.Count(); i++) {
+            HouseClass* player_ptr = HouseClass::As_Pointer(Session.Players[i]->Player.ID);
+            if (player_ptr->IsHuman && (house->RadarSpied & (1 << (player_ptr->Class->House)))) {
+                unsigned copy[MAP_CELL_WORDS];
+                memcpy(copy, cells, sizeof(copy));
+                count += Map_Cells(copy, player_ptr);
+            }
+        }
+    }
+
+    return (count);
+}
+
+/***********************************************************************************************
+ * DisplayClass::Map_All -- Maps the whole map for a player.                                   *
+ *                                                                                             *
+ *    This is the same as calling Map_Cell on every cell of the map, see Map_Region.           *
+ *                                                                                             *
+ * INPUT:   house -- The player that is doing the mapping.                                     *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of cells that became mapped, for any player.               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int DisplayClass::Map_All(HouseClass* house)
+{
+    return (Map_Region(0, 0, MAP_CELL_W, MAP_CELL_H, house));
+}
+
+/***********************************************************************************************
+ * DisplayClass::Map_Cells -- Maps every cell in a bitmap for one player.                      *
+ *                                                                                             *
+ *    The bitmap holds a bit per cell, set for the cells to map. The adjacent cells that       *
+ *    Map_Cell would go on to map are added to it as they are found. The mapping itself never  *
+ *    depends on the order the cells are taken in, since a cell only ever gains mapped         *
+ *    neighbours, so the cells are taken a word of the bitmap at a time and the visibility of  *
+ *    each affected cell is settled once all the mapping is done.                              *
+ *                                                                                             *
+ * INPUT:   cells -- Bitmap of the cells to map, all of them within the radar area.            *
+ *                                                                                             *
+ *          house -- The player the cells are mapped for.                                      *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of cells that became mapped.                               *
+ *                                                                                             *
+ * WARNINGS:   Doesn't redirect the mapping to spying or allied players, see Map_Region.       *
+ *=============================================================================================*/
+int DisplayClass::Map_Cells(unsigned* cells, HouseClass* house)
+{
+    unsigned done[MAP_CELL_WORDS];
+    unsigned mapped[MAP_CELL_WORDS];
+    unsigned touched[MAP_CELL_WORDS];
+    memset(done, 0, sizeof(done));
+    memset(mapped, 0, sizeof(mapped));
+    memset(touched, 0, sizeof(touched));
+
+    /*
+    **	Map every cell asked for. Map_Cell carries on to the cells around one it maps that
+    **	would otherwise be left with a shadow that can't be drawn, they are added to the cells
+    **	still to do and picked up by the next sweep.
+    */
+    int count = 0;
+    bool redraw = false;
+    bool more = true;
+    while (more) {
+        more = false;
+        for (int word = 0; word < MAP_CELL_WORDS; word++) {
+            unsigned bits = cells[word] & ~done[word];
+            done[word] |= bits;
+
+            while (bits != 0) {
+                CELL cell = (CELL)(word * 32 + std::countr_zero(bits));
+                bits &= bits - 1;
+
+                CellClass* cellptr = &(*this)[cell];
+                if (cellptr->Is_Mapped(house)) {
+                    redraw |= !cellptr->Is_Visible(house);
+                    continue;
+                }
+
+                cellptr->Set_Mapped(house);
+                mapped[word] |= 1U << (cell % 32);
+                touched[word] |= 1U << (cell % 32);
+                redraw = true;
+                count++;
+
+                int xx = Cell_X(cell);
+                for (FacingType dir = FACING_FIRST; dir < FACING_COUNT; dir++) {
+                    CELL c = Adjacent_Cell(cell, dir);
+                    if ((unsigned)c >= MAP_CELL_TOTAL || ABS(Cell_X(c) - xx) > 1)
+                        continue;
+
+                    touched[c / 32] |= 1U << (c % 32);
+                    CellClass const* cptr = &(*this)[c];
+                    if (!cptr->Is_Visible(house) && !cptr->Is_Mapped(house) && Cell_Shadow(c, house) != -2
+                        && In_Radar(c)) {
+                        cells[c / 32] |= 1U << (c % 32);
+                        more = true;
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+    **	A mapped cell shows without any shadow once every cell around it is mapped too, which
+    **	can only have changed for the cells just mapped and the ones next to them.
+    */
+    for (int word = 0; word < MAP_CELL_WORDS; word++) {
+        unsigned bits = touched[word];
+        while (bits != 0) {
+            CELL cell = (CELL)(word * 32 + std::countr_zero(bits));
+            bits &= bits - 1;
+
+            CellClass* cellptr = &(*this)[cell];
+            if (cellptr->Is_Mapped(house) && !cellptr->Is_Visible(house) && Cell_Shadow(cell, house) == -1) {
+                cellptr->Set_Visible(house);
+            }
+        }
+    }
+
+    /*
+    **	Rather than flag each affected cell and the objects in it, redraw the whole tactical
+    **	map once.
+    */
+    if (redraw) {
+        Flag_To_Redraw(true);
+    }
+
+    for (int word = 0; word < MAP_CELL_WORDS; word++) {
+        unsigned bits = mapped[word];
+        while (bits != 0) {
+            CELL cell = (CELL)(word * 32 + std::countr_zero(bits));
+            bits &= bits - 1;
+
+            TechnoClass* tech = (*this)[cell].Cell_Techno();
+            if (tech) {
+                tech->Revealed(house);
+            }
+        }
+    }
+
+    return (count);
+}
+
 /***********************************************************************************************
  * DisplayClass::Coord_To_Pixel -- Determines X and Y pixel coordinates.                       *
  *                                                                                             *
@@ -2270,6 +2552,256 @@ void DisplayClass::Draw_It(bool forced)
     }
 }
 
+/*
+**	Cells gathered for a banded redraw of the tactical map. Cells are stored in the order the
+**	serial loops visit them and grouped into rows of identical screen Y so that the rows can
+**	be handed out to the worker pool in contiguous bands.
+*/
+struct TacticalCellType
+{
+    CellClass* Cell;
+    int X;
+    int Y;
+    int Shadow;
+};
+
+#define MAX_TACTICAL_BANDS 16
+#define MAX_SHADOW_FRAMES  256
+
+// Copied from conquer.cpp
+#define SHAPE_TRANS 0x40
+
+static TacticalCellType TacticalCells[MAP_CELL_TOTAL];
+static int TacticalCellCount;
+static int TacticalRowStart[MAP_CELL_TOTAL + 1];
+static int TacticalRowY[MAP_CELL_TOTAL];
+static int TacticalRowCount;
+
+/***********************************************************************************************
+ * Tactical_Band_Count -- Fetches the number of bands to split the tactical redraw into.       *
+ *                                                                                             *
+ * INPUT:   rows  -- The number of cell rows that have something to draw.                      *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of bands. A value of 1 means draw serially.                *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static int Tactical_Band_Count(int rows)
+{
+    int bands = Worker_Pool().Thread_Count();
+
+    if (Settings.Video.RenderThreads > 0 && Settings.Video.RenderThreads < bands) {
+        bands = Settings.Video.RenderThreads;
+    }
+
+    if (bands > MAX_TACTICAL_BANDS) {
+        bands = MAX_TACTICAL_BANDS;
+    }
+
+    if (bands > rows) {
+        bands = rows;
+    }
+
+    return bands;
+}
+
+/***********************************************************************************************
+ * Tactical_Band_Rows -- Fetches the rows and screen lines covered by a band.                  *
+ *                                                                                             *
+ *    The first band starts at the top of the tactical window and the last band ends at the    *
+ *    bottom of it. All others start on the first line of their first row. Since every cell    *
+ *    image is one cell high, no draw ever crosses from one band into another and clipping to  *
+ *    the band gives exactly the same pixels as clipping to the whole window.                  *
+ *                                                                                             *
+ * INPUT:   band     -- The band number.                                                       *
+ *                                                                                             *
+ *          bands    -- The total number of bands.                                             *
+ *                                                                                             *
+ *          height   -- The height of the tactical window in pixels.                           *
+ *                                                                                             *
+ *          first    -- Reference to the first row in the band.                                *
+ *                                                                                             *
+ *          last     -- Reference to the row following the band.                               *
+ *                                                                                             *
+ *          top      -- Reference to the top line of the band (window relative).               *
+ *                                                                                             *
+ *          bottom   -- Reference to the line following the band (window relative).            *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static void Tactical_Band_Rows(int band, int bands, int height, int& first, int& last, int& top, int& bottom)
+{
+    first = band * TacticalRowCount / bands;
+    last = (band + 1) * TacticalRowCount / bands;
+    top = (band == 0) ? 0 : TacticalRowY[first];
+    bottom = (band == bands - 1) ? height : TacticalRowY[last];
+}
+
+/***********************************************************************************************
+ * DisplayClass::Gather_Tactical_Cells -- Collects the cells a tactical redraw will visit.    *
+ *                                                                                             *
+ *    This walks the visible cells in exactly the same order as Redraw_Icons and               *
+ *    Redraw_Shadow and records every cell flagged for redraw along with its screen position.  *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Were the cells gathered such that a banded redraw is possible?               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool DisplayClass::Gather_Tactical_Cells(void)
+{
+    TacticalCellCount = 0;
+    TacticalRowCount = 0;
+
+    for (int y = -Coord_YLepton(TacticalCoord); y <= TacLeptonHeight; y += CELL_LEPTON_H) {
+        int row_start = TacticalCellCount;
+
+        for (int x = -Coord_XLepton(TacticalCoord); x <= TacLeptonWidth; x += CELL_LEPTON_W) {
+            COORDINATE coord = Coord_Add(TacticalCoord, XY_Coord(x, y));
+            CELL cell = Coord_Cell(coord);
+            coord = Coord_Whole(Cell_Coord(cell));
+
+            if (In_View(cell) && Is_Cell_Flagged(cell)) {
+                int xpixel;
+                int ypixel;
+
+                if (Coord_To_Pixel(coord, xpixel, ypixel)) {
+                    if (TacticalCellCount >= ARRAY_SIZE(TacticalCells)) {
+                        return false;
+                    }
+
+                    /*
+                    **	Every cell of a row must land on the same screen line, and rows must not
+                    **	overlap, otherwise the bands would not be independent.
+                    */
+                    if (TacticalCellCount > row_start) {
+                        if (TacticalRowY[TacticalRowCount] != ypixel) {
+                            return false;
+                        }
+                    } else {
+                        if (TacticalRowCount > 0 && ypixel < TacticalRowY[TacticalRowCount - 1] + CELL_PIXEL_H) {
+                            return false;
+                        }
+                        TacticalRowStart[TacticalRowCount] = row_start;
+                        TacticalRowY[TacticalRowCount] = ypixel;
+                    }
+
+                    TacticalCellType& entry = TacticalCells[TacticalCellCount++];
+                    entry.Cell = &(*this)[cell];
+                    entry.X = xpixel;
+                    entry.Y = ypixel;
+                    entry.Shadow = -1;
+                }
+            }
+        }
+
+        if (TacticalCellCount > row_start) {
+            TacticalRowCount++;
+        }
+    }
+
+    TacticalRowStart[TacticalRowCount] = TacticalCellCount;
+    return true;
+}
+
+/***********************************************************************************************
+ * Fits_In_Cell -- Determines if a shape image stays within the cell it is drawn for.          *
+ *                                                                                             *
+ * INPUT:   shapes   -- Pointer to the shape file to check.                                    *
+ *                                                                                             *
+ * OUTPUT:  bool; Is every frame of the shape no larger than a cell?                           *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+static bool Fits_In_Cell(void const* shapes)
+{
+    return shapes == NULL
+           || (Get_Build_Frame_Width(shapes) <= CELL_PIXEL_W && Get_Build_Frame_Height(shapes) <= CELL_PIXEL_H);
+}
+
+/***********************************************************************************************
+ * DisplayClass::Redraw_Icons_Banded -- Draws flagged terrain icons using the worker pool.     *
+ *                                                                                             *
+ *    The template stamps are drawn by the worker pool, one horizontal band of the tactical    *
+ *    window per job, with each band clipped to its own lines. The remainder of the cell       *
+ *    imagery (smudges, overlays and cursors) goes through the shape cache so it is then       *
+ *    drawn on this thread in the original order. This only happens when none of that          *
+ *    imagery is larger than a cell, which makes the result identical to Redraw_Icons.         *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the redraw performed? If not, nothing has been drawn.                    *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool DisplayClass::Redraw_Icons_Banded(void)
+{
+    if (Debug_Icon || Debug_Map || !Gather_Tactical_Cells()) {
+        return false;
+    }
+
+    int bands = Tactical_Band_Count(TacticalRowCount);
+    if (bands < 2) {
+        return false;
+    }
+
+    for (int index = 0; index < TacticalCellCount; index++) {
+        CellClass const* cellptr = TacticalCells[index].Cell;
+
+        if (cellptr->Smudge != SMUDGE_NONE
+            && !Fits_In_Cell(SmudgeTypeClass::As_Reference(cellptr->Smudge).Get_Image_Data())) {
+            return false;
+        }
+
+        if (cellptr->Overlay != OVERLAY_NONE
+            && !Fits_In_Cell(OverlayTypeClass::As_Reference(cellptr->Overlay).Get_Image_Data())) {
+            return false;
+        }
+    }
+
+    int win_x = WindowList[WINDOW_TACTICAL][WINDOWX];
+    int win_y = WindowList[WINDOW_TACTICAL][WINDOWY];
+    int win_w = WindowList[WINDOW_TACTICAL][WINDOWWIDTH];
+    int win_h = WindowList[WINDOW_TACTICAL][WINDOWHEIGHT];
+    GraphicViewPortClass* page = LogicPage;
+
+    Worker_Pool().Run(bands, [&](int band) {
+        int first, last, top, bottom;
+        Tactical_Band_Rows(band, bands, win_h, first, last, top, bottom);
+
+        for (int index = TacticalRowStart[first]; index < TacticalRowStart[last]; index++) {
+            TacticalCellType const& entry = TacticalCells[index];
+
+            if (entry.Cell->Is_Mapped(PlayerPtr) || Debug_Unshroud) {
+                int icon;
+                void const* image = entry.Cell->Template_Image(icon);
+
+                if (image != NULL) {
+                    Buffer_Draw_Stamp_Clip(
+                        page, image, icon, entry.X, entry.Y - top, NULL, win_x, win_y + top, win_w, bottom - top);
+                }
+            }
+        }
+    });
+
+    for (int index = 0; index < TacticalCellCount; index++) {
+        TacticalCellType const& entry = TacticalCells[index];
+
+        if (entry.Cell->Is_Mapped(PlayerPtr) || Debug_Unshroud) {
+            entry.Cell->Draw_It(entry.X, entry.Y, false, true);
+        }
+
+        if (!entry.Cell->Is_Visible(PlayerPtr) && !Debug_Unshroud) {
+            IsShadowPresent = true;
+        }
+    }
+
+    return true;
+}
+
 /***********************************************************************************************
  * DisplayClass::Redraw_Icons -- Draws all terrain icons necessary.                            *
  *                                                                                             *
@@ -2292,6 +2824,11 @@ void DisplayClass::Draw_It(bool forced)
 void DisplayClass::Redraw_Icons(void)
 {
     IsShadowPresent = false;
+
+    if (Redraw_Icons_Banded()) {
+        return;
+    }
+
     for (int y = -Coord_YLepton(TacticalCoord); y <= TacLeptonHeight; y += CELL_LEPTON_H) {
         for (int x = -Coord_XLepton(TacticalCoord); x <= TacLeptonWidth; x += CELL_LEPTON_W) {
             COORDINATE coord = Coord_Add(TacticalCoord, XY_Coord(x, y));
@@ -2368,6 +2905,128 @@ void DisplayClass::Redraw_OIcons(void)
 }
 #endif
 
+/***********************************************************************************************
+ * DisplayClass::Redraw_Shadow_Banded -- Draws the shadow overlay using the worker pool.       *
+ *                                                                                             *
+ *    The shadow frame of every cell is worked out and decoded on this thread, since that      *
+ *    goes through the shared shape cache. The decoded frames and black fills are then drawn   *
+ *    by the worker pool one band per job. If any frame could not be kept in the shape cache   *
+ *    then nothing is drawn and the caller falls back to the serial path.                      *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the redraw performed?                                                    *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool DisplayClass::Redraw_Shadow_Banded(void)
+{
+    static void const* _frames[MAX_SHADOW_FRAMES];
+
+    int width = Get_Build_Frame_Width(ShadowShapes);
+    int height = Get_Build_Frame_Height(ShadowShapes);
+    int count = Get_Build_Frame_Count(ShadowShapes);
+
+    if (!UseBigShapeBuffer || IsTheaterShape || width > CELL_PIXEL_W || height > CELL_PIXEL_H
+        || count > MAX_SHADOW_FRAMES || !Gather_Tactical_Cells()) {
+        return false;
+    }
+
+    int bands = Tactical_Band_Count(TacticalRowCount);
+    if (bands < 2) {
+        return false;
+    }
+
+    memset(_frames, 0, sizeof(_frames));
+
+    for (int index = 0; index < TacticalCellCount; index++) {
+        TacticalCellType& entry = TacticalCells[index];
+        CellClass const* cellptr = entry.Cell;
+
+        if (cellptr->Is_Visible(PlayerPtr)) {
+            entry.Shadow = -1;
+            continue;
+        }
+
+        entry.Shadow = -2;
+        if (cellptr->Is_Mapped(PlayerPtr)) {
+            entry.Shadow = Cell_Shadow(cellptr->Cell_Number(), PlayerPtr);
+        }
+
+        if (entry.Shadow >= 0 && _frames[entry.Shadow] == NULL) {
+            uintptr_t frame = Build_Frame(ShadowShapes, entry.Shadow, _ShapeBuffer);
+
+            /*
+            **	A frame left in the scratch buffer would be overwritten by the next one.
+            */
+            if (frame == 0 || frame == (uintptr_t)_ShapeBuffer || !UseBigShapeBuffer) {
+                return false;
+            }
+            _frames[entry.Shadow] = (void const*)frame;
+        }
+    }
+
+    int win_x = WindowList[WINDOW_TACTICAL][WINDOWX];
+    int win_y = WindowList[WINDOW_TACTICAL][WINDOWY];
+    int win_w = WindowList[WINDOW_TACTICAL][WINDOWWIDTH];
+    int win_h = WindowList[WINDOW_TACTICAL][WINDOWHEIGHT];
+    int tac_w = Lepton_To_Pixel(TacLeptonWidth);
+    int tac_h = Lepton_To_Pixel(TacLeptonHeight);
+    GraphicViewPortClass* page = LogicPage;
+
+    /*
+    **	The band windows are attached here as attaching depends on the page lock.
+    */
+    GraphicViewPortClass windows[MAX_TACTICAL_BANDS];
+    for (int band = 0; band < bands; band++) {
+        int first, last, top, bottom;
+        Tactical_Band_Rows(band, bands, win_h, first, last, top, bottom);
+        windows[band].Attach(page->Get_Graphic_Buffer(),
+                             win_x + page->Get_XPos(),
+                             win_y + top + page->Get_YPos(),
+                             win_w,
+                             bottom - top);
+    }
+
+    Worker_Pool().Run(bands, [&](int band) {
+        int first, last, top, bottom;
+        Tactical_Band_Rows(band, bands, win_h, first, last, top, bottom);
+
+        for (int index = TacticalRowStart[first]; index < TacticalRowStart[last]; index++) {
+            TacticalCellType const& entry = TacticalCells[index];
+
+            if (entry.Shadow >= 0) {
+                int predoffset = (entry.X > win_w >> 1) ? -Frame : Frame;
+                Buffer_Frame_To_Page(entry.X,
+                                     entry.Y - top,
+                                     width,
+                                     height,
+                                     (void*)_frames[entry.Shadow],
+                                     windows[band],
+                                     SHAPE_GHOST | SHAPE_TRANS,
+                                     ShadowTrans,
+                                     predoffset);
+            } else if (entry.Shadow == -2) {
+                int xpixel = entry.X;
+                int ypixel = entry.Y;
+                int ww = CELL_PIXEL_W;
+                int hh = CELL_PIXEL_H;
+
+                if (Clip_Rect(&xpixel, &ypixel, &ww, &hh, tac_w, tac_h) >= 0) {
+                    Buffer_Fill_Rect(page,
+                                     TacPixelX + xpixel,
+                                     TacPixelY + ypixel,
+                                     TacPixelX + xpixel + ww - 1,
+                                     TacPixelY + ypixel + hh - 1,
+                                     BLACK);
+                }
+            }
+        }
+    });
+
+    return true;
+}
+
 /***********************************************************************************************
  * DisplayClass::Redraw_Shadow -- Draw the shadow overlay.                                     *
  *                                                                                             *
@@ -2386,7 +3045,7 @@ void DisplayClass::Redraw_OIcons(void)
  *=============================================================================================*/
 void DisplayClass::Redraw_Shadow(void)
 {
-    if (IsShadowPresent) {
+    if (IsShadowPresent && !Redraw_Shadow_Banded()) {
         for (int y = -Coord_YLepton(TacticalCoord); y <= TacLeptonHeight; y += CELL_LEPTON_H) {
             for (int x = -Coord_XLepton(TacticalCoord); x <= TacLeptonWidth; x += CELL_LEPTON_W) {
                 COORDINATE coord = Coord_Add(TacticalCoord, XY_Coord(x, y));
@@ -80,7 +80,7 @@ public:
     **	These layer control elements are used to group the displayable objects
     **	so that proper overlap can be obtained.
     */
-    static LayerClass Layer[LAYER_COUNT];
+    static INSTANCE_LOCAL LayerClass Layer[LAYER_COUNT];
 
     /*
     **	This records the position and shape of a placement cursor to display
@@ -161,6 +161,14 @@ public:
                           bool check_radar_spied = true,
                           bool and_for_allies = true); // Added check_radar_spied parameter to prevent recursion. ST -
                                                        // 8/6/2019 10:16AM. Added and_for_allies ST - 10/31/2019 1:18PM
+    virtual int Map_Region(int x,
+                           int y,
+                           int w,
+                           int h,
+                           HouseClass* house,
+                           bool check_radar_spied = true,
+                           bool and_for_allies = true);
+    int Map_All(HouseClass* house);
     virtual CELL Click_Cell_Calc(int x, int y) const;
     virtual void Help_Text(int, int = -1, int = -1, int = YELLOW, bool = false){};
     virtual MouseType Get_Mouse_Shape(void) const = 0;
@@ -230,6 +238,7 @@ protected:
     virtual void Mouse_Left_Held(int x, int y);
     virtual void
     Mouse_Left_Release(CELL cell, int x, int y, ObjectClass* object, ActionType action, bool wsmall = false);
+    int Map_Cells(unsigned* cells, HouseClass* house);
 
 public:
     /*
@@ -332,12 +341,15 @@ private:
     void Redraw_Icons(void);
     void Redraw_OIcons(void);
     void Redraw_Shadow(void);
+    bool Gather_Tactical_Cells(void);
+    bool Redraw_Icons_Banded(void);
+    bool Redraw_Shadow_Banded(void);
 
     /*
     **	This bit array is used to flag cells to be redrawn. If the icon needs to
     **	be redrawn for a cell, then the corresponding flag will be true.
     */
-    static BooleanVectorClass CellRedraw;
+    static INSTANCE_LOCAL BooleanVectorClass CellRedraw;
 
     bool Good_Reinforcement_Cell(CELL outcell, CELL incell, SpeedType loco, int zone, MZoneType mzone) const;
 
@@ -41,7 +41,7 @@ class EgoClass;
 
 #include "function.h"
 #include "egos.h"
-#include "common/mssleep.h"
+#include "common/tickwait.h"
 #include "common/framelimit.h"
 
 /*
@@ -817,7 +817,7 @@ void Show_Who_Was_Responsible(void)
         ** Kill any spare time before blitting the hid page forward.
         */
         while (TickCount - time < unsigned(frame * speed) && !Keyboard->Check()) {
-            ms_sleep(1);
+            Wait_For_Tick(WAKE_INPUT);
         }
 
         /*
@@ -897,7 +897,7 @@ void Show_Who_Was_Responsible(void)
             ** Kill any spare time
             */
             while (TickCount - time < unsigned(frame * speed) && !Keyboard->Check()) {
-                ms_sleep(1);
+                Wait_For_Tick(WAKE_INPUT);
             }
         }
     }
@@ -92,6 +92,7 @@ unsigned char EventClass::EventLength[EventClass::LAST_EVENT] = {
     0,                                         //	PROPOSE_DRAW
     0,                                         //	RETRACT_DRAW
 #endif
+    size_of(EventClass, Data.StateHash),       // STATEHASH
 };
 
 const char* EventClass::EventNames[EventClass::LAST_EVENT] = {
@@ -103,6 +104,7 @@ const char* EventClass::EventNames[EventClass::LAST_EVENT] = {
 #ifdef FIXIT_VERSION_3 //	Stalemate games.
     "PROPOSE_DRAW", "RETRACT_DRAW",
 #endif
+    "STATEHASH",
 };
 
 /***********************************************************************************************
@@ -1007,6 +1009,14 @@ void EventClass::Execute(void)
         break;
 #endif
 
+    //
+    // Another system's state hashes, compare them with ours to narrow down
+    // where the games went out of sync.
+    //
+    case STATEHASH:
+        StateHash.Receive(*this);
+        break;
+
     /*
     **	Default: do nothing.
     */
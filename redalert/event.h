@@ -100,6 +100,8 @@ public:
         RETRACT_DRAW,  //	Player retracts proposed draw offer.
 #endif
 
+        STATEHASH, // State hashes traded to find where games went out of sync
+
         LAST_EVENT, // one past the last event
     } EventType;
 
@@ -244,6 +246,24 @@ public:
             unsigned short AverageTicks;
         } ProcessTime;
 
+        //
+        // This structure carries up to two hashes of the children of one node of
+        // the state hash tree, for finding where two systems went out of sync.
+        // HashFrame: low 16 bits of the frame the tree was built for
+        // Level, Branch, Index: the node whose children these are
+        // First, Count: the children carried
+        //
+        struct
+        {
+            unsigned short HashFrame;
+            unsigned char Level : 4;
+            unsigned char Count : 4;
+            unsigned char Branch;
+            unsigned short Index;
+            unsigned char First;
+            unsigned int Hash[2];
+        } StateHash;
+
     } Data;
 
     //-------------- Constructors ---------------------
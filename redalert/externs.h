@@ -152,17 +152,18 @@ extern CCINIClass RuleINI;
 #ifdef FIXIT_CSII //	checked - ajw 9/28/98
 extern CCINIClass AftermathINI;
 #endif
+extern INSTANCE_LOCAL CCINIClass* RuleOverrideINI;
 // extern Benchmark *				Benches;
-extern int MapTriggerID;
-extern int LogicTriggerID;
+extern INSTANCE_LOCAL int MapTriggerID;
+extern INSTANCE_LOCAL int LogicTriggerID;
 extern PKey FastKey;
 extern PKey SlowKey;
 extern RulesClass Rule;
 extern WWKeyboardClass* Keyboard;
 extern RandomStraw CryptRandom;
-extern RandomClass NonCriticalRandomNumber;
-extern CarryoverClass* Carryover;
-extern ScenarioClass Scen;
+extern INSTANCE_LOCAL RandomClass NonCriticalRandomNumber;
+extern INSTANCE_LOCAL CarryoverClass* Carryover;
+extern INSTANCE_LOCAL ScenarioClass Scen;
 extern RemapControlType ColorRemaps[PCOLOR_COUNT];
 extern RemapControlType MetalScheme;
 extern RemapControlType GreyScheme;
@@ -172,10 +173,10 @@ extern bool ScoresPresent;
 extern bool AllowVoice;
 extern NewConfigType NewConfig;
 extern VoxType SpeakQueue;
-extern bool PlayerWins;
-extern bool PlayerLoses;
-extern bool PlayerRestarts;
-extern int Frame;
+extern INSTANCE_LOCAL bool PlayerWins;
+extern INSTANCE_LOCAL bool PlayerLoses;
+extern INSTANCE_LOCAL bool PlayerRestarts;
+extern INSTANCE_LOCAL int Frame;
 extern VoxType SpeechRecord[2];
 extern void* SpeechBuffer[2];
 extern int PreserveVQAScreen;
@@ -184,13 +185,14 @@ extern bool Brokeout;
 
 extern GameOptionsClass Options;
 
-extern LogicClass Logic;
+extern INSTANCE_LOCAL LogicClass Logic;
+extern INSTANCE_LOCAL CellTableClass CellTables;
 #ifdef SCENARIO_EDITOR
-extern MapEditClass Map;
+extern INSTANCE_LOCAL MapEditClass Map;
 #else
-extern MouseClass Map;
+extern INSTANCE_LOCAL MouseClass Map;
 #endif
-extern ScoreClass Score;
+extern INSTANCE_LOCAL ScoreClass Score;
 extern MonoClass MonoArray[DMONO_COUNT];
 extern MFCD* TheaterData;
 extern MFCD* MoviesMix;
@@ -200,28 +202,28 @@ extern MFCD* ScoreMix;
 extern MFCD* MainMix;
 extern MFCD* ConquerMix;
 extern ThemeClass Theme;
-extern SpecialClass Special;
+extern INSTANCE_LOCAL SpecialClass Special;
 
 /*
 **	Game object allocation and tracking classes.
 */
-extern TFixedIHeapClass<AircraftClass> Aircraft;
-extern TFixedIHeapClass<AnimClass> Anims;
-extern TFixedIHeapClass<BuildingClass> Buildings;
-extern TFixedIHeapClass<BulletClass> Bullets;
-extern TFixedIHeapClass<FactoryClass> Factories;
-extern TFixedIHeapClass<HouseClass> Houses;
-extern TFixedIHeapClass<InfantryClass> Infantry;
-extern TFixedIHeapClass<OverlayClass> Overlays;
-extern TFixedIHeapClass<SmudgeClass> Smudges;
-extern TFixedIHeapClass<TeamClass> Teams;
-extern TFixedIHeapClass<TeamTypeClass> TeamTypes;
-extern TFixedIHeapClass<TemplateClass> Templates;
-extern TFixedIHeapClass<TerrainClass> Terrains;
-extern TFixedIHeapClass<TriggerClass> Triggers;
-extern TFixedIHeapClass<UnitClass> Units;
-extern TFixedIHeapClass<VesselClass> Vessels;
-extern TFixedIHeapClass<TriggerTypeClass> TriggerTypes;
+extern INSTANCE_LOCAL TFixedIHeapClass<AircraftClass> Aircraft;
+extern INSTANCE_LOCAL TFixedIHeapClass<AnimClass> Anims;
+extern INSTANCE_LOCAL TFixedIHeapClass<BuildingClass> Buildings;
+extern INSTANCE_LOCAL TFixedIHeapClass<BulletClass> Bullets;
+extern INSTANCE_LOCAL TFixedIHeapClass<FactoryClass> Factories;
+extern INSTANCE_LOCAL TFixedIHeapClass<HouseClass> Houses;
+extern INSTANCE_LOCAL TFixedIHeapClass<InfantryClass> Infantry;
+extern INSTANCE_LOCAL TFixedIHeapClass<OverlayClass> Overlays;
+extern INSTANCE_LOCAL TFixedIHeapClass<SmudgeClass> Smudges;
+extern INSTANCE_LOCAL TFixedIHeapClass<TeamClass> Teams;
+extern INSTANCE_LOCAL TFixedIHeapClass<TeamTypeClass> TeamTypes;
+extern INSTANCE_LOCAL TFixedIHeapClass<TemplateClass> Templates;
+extern INSTANCE_LOCAL TFixedIHeapClass<TerrainClass> Terrains;
+extern INSTANCE_LOCAL TFixedIHeapClass<TriggerClass> Triggers;
+extern INSTANCE_LOCAL TFixedIHeapClass<UnitClass> Units;
+extern INSTANCE_LOCAL TFixedIHeapClass<VesselClass> Vessels;
+extern INSTANCE_LOCAL TFixedIHeapClass<TriggerTypeClass> TriggerTypes;
 
 extern TFixedIHeapClass<HouseTypeClass> HouseTypes;
 extern TFixedIHeapClass<BuildingTypeClass> BuildingTypes;
@@ -241,39 +243,39 @@ extern FixedIHeapClass* HeapPointers[RTTI_COUNT];
 extern TFixedIHeapClass<WeaponTypeClass> Weapons;
 extern TFixedIHeapClass<WarheadTypeClass> Warheads;
 
-extern QueueClass<EventClass, MAX_EVENTS> OutList;
-extern QueueClass<EventClass, (MAX_EVENTS * 64)> DoList;
+extern INSTANCE_LOCAL QueueClass<EventClass, MAX_EVENTS> OutList;
+extern INSTANCE_LOCAL QueueClass<EventClass, (MAX_EVENTS * 64)> DoList;
 
 #ifdef MIRROR_QUEUE
-extern QueueClass<EventClass, (MAX_EVENTS * 64)> MirrorList;
+extern INSTANCE_LOCAL QueueClass<EventClass, (MAX_EVENTS * 64)> MirrorList;
 #endif
 
 typedef DynamicVectorArrayClass<ObjectClass*, HOUSE_COUNT, HOUSE_FIRST> SelectedObjectsType;
-extern SelectedObjectsType CurrentObject;
-extern DynamicVectorClass<TriggerClass*> LogicTriggers;
-extern DynamicVectorClass<TriggerClass*> MapTriggers;
-extern DynamicVectorClass<TriggerClass*> HouseTriggers[HOUSE_COUNT];
+extern INSTANCE_LOCAL SelectedObjectsType CurrentObject;
+extern INSTANCE_LOCAL DynamicVectorClass<TriggerClass*> LogicTriggers;
+extern INSTANCE_LOCAL DynamicVectorClass<TriggerClass*> MapTriggers;
+extern INSTANCE_LOCAL DynamicVectorClass<TriggerClass*> HouseTriggers[HOUSE_COUNT];
 
-extern BaseClass Base;
+extern INSTANCE_LOCAL BaseClass Base;
 
 /* These variables are used to keep track of the slowest speed of a team */
-extern TeamFormDataStruct TeamFormData[HOUSE_COUNT];
-extern bool FormMove;
-extern SpeedType FormSpeed;
-extern MPHType FormMaxSpeed;
+extern INSTANCE_LOCAL TeamFormDataStruct TeamFormData[HOUSE_COUNT];
+extern INSTANCE_LOCAL bool FormMove;
+extern INSTANCE_LOCAL SpeedType FormSpeed;
+extern INSTANCE_LOCAL MPHType FormMaxSpeed;
 
-extern bool IsTanyaDead;
-extern bool SaveTanya;
+extern INSTANCE_LOCAL bool IsTanyaDead;
+extern INSTANCE_LOCAL bool SaveTanya;
 
-extern bool TimeQuake;
+extern INSTANCE_LOCAL bool TimeQuake;
 
 #ifdef FIXIT_CSII //	checked - ajw 9/28/98
-extern bool PendingTimeQuake;
-extern TARGET TimeQuakeCenter;
+extern INSTANCE_LOCAL bool PendingTimeQuake;
+extern INSTANCE_LOCAL TARGET TimeQuakeCenter;
 extern fixed QuakeUnitDamage;
 extern fixed QuakeBuildingDamage;
 extern int QuakeInfantryDamage;
-extern int QuakeDelay;
+extern INSTANCE_LOCAL int QuakeDelay;
 extern fixed ChronoTankDuration;   // chrono override for chrono tanks
 #ifdef FIXIT_ENGINEER              //	checked - ajw 9/28/98
 extern fixed EngineerDamage;       // Amount of damage an engineer does
@@ -301,21 +303,21 @@ extern char const* DebugStrings;
 /*
 **	Miscellaneous globals.
 */
-extern ChronalVortexClass ChronalVortex;
+extern INSTANCE_LOCAL ChronalVortexClass ChronalVortex;
 extern TTimerClass<SystemTimerClass> TickCount;
 extern bool PassedProximity; // used in display.cpp
-extern HousesType Whom;
+extern INSTANCE_LOCAL HousesType Whom;
 extern VQAConfig AnimControl;
 extern int SpareTicks;
-extern int PathCount;
-extern int CellCount;
-extern int TargetScan;
+extern INSTANCE_LOCAL int PathCount;
+extern INSTANCE_LOCAL int CellCount;
+extern INSTANCE_LOCAL int TargetScan;
 extern int SidebarRedraws;
 extern DMonoType MonoPage;
-extern bool GameActive;
+extern INSTANCE_LOCAL bool GameActive;
 extern bool SpecialFlag;
-extern int ScenarioInit;
-extern HouseClass* PlayerPtr;
+extern INSTANCE_LOCAL int ScenarioInit;
+extern INSTANCE_LOCAL HouseClass* PlayerPtr;
 extern PaletteClass CCPalette;
 extern PaletteClass BlackPalette;
 extern PaletteClass WhitePalette;
@@ -324,8 +326,8 @@ extern PaletteClass GamePalette;
 #define InGamePalette GamePalette
 extern PaletteClass OriginalPalette;
 extern PaletteClass ScorePalette;
-extern int BuildLevel;
-extern unsigned int ScenarioCRC;
+extern INSTANCE_LOCAL int BuildLevel;
+extern INSTANCE_LOCAL unsigned int ScenarioCRC;
 
 #ifdef FIXIT_VERSION_3
 extern bool bAftermathMultiplayer; //	Is multiplayer game being played with Aftermath rules?
@@ -342,19 +344,21 @@ extern bool bAutoSonarPulse;
 extern CELL CurrentCell;
 #endif
 
-extern SessionClass Session;
+extern INSTANCE_LOCAL SessionClass Session;
+extern INSTANCE_LOCAL SnapshotRingClass Snapshots;
+extern INSTANCE_LOCAL StateHashClass StateHash;
 // extern NullModemClass 			NullModem;
 #ifdef NETWORKING
 extern IPXManagerClass Ipx;
 #endif
 
 #if (TIMING_FIX)
-extern int NewMaxAheadFrame1;
-extern int NewMaxAheadFrame2;
+extern INSTANCE_LOCAL int NewMaxAheadFrame1;
+extern INSTANCE_LOCAL int NewMaxAheadFrame2;
 #endif
 
-extern int Seed;
-extern int CustomSeed;
+extern INSTANCE_LOCAL int Seed;
+extern INSTANCE_LOCAL int CustomSeed;
 extern GroundType Ground[LAND_COUNT];
 
 /*
@@ -141,13 +141,13 @@ inline static FacingType Next_Direction(FacingType facing, FacingType dir)
 /* Define a couple of variables which are private to the module they are   */
 /*      declared in.                                                       */
 /*=========================================================================*/
-static unsigned int MainOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the main path
-static unsigned int LeftOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the left path
-static unsigned int RightOverlap[MAP_CELL_TOTAL / 32]; // overlap list for the right path
+static INSTANCE_LOCAL unsigned int MainOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the main path
+static INSTANCE_LOCAL unsigned int LeftOverlap[MAP_CELL_TOTAL / 32];  // overlap list for the left path
+static INSTANCE_LOCAL unsigned int RightOverlap[MAP_CELL_TOTAL / 32]; // overlap list for the right path
 
 // static CELL MoveMask = 0;
-static CELL DestLocation;
-static CELL StartLocation;
+static INSTANCE_LOCAL CELL DestLocation;
+static INSTANCE_LOCAL CELL StartLocation;
 
 /***************************************************************************
  * Point_Relative_To_Line -- Relation between a point and a line           *
@@ -431,12 +431,12 @@ bool FootClass::Register_Cell(PathType* path, CELL cell, FacingType dir, int cos
  *=============================================================================================*/
 PathType* FootClass::Find_Path(CELL dest, FacingType* final_moves, int maxlen, MoveType threshhold)
 {
-    CELL source = Coord_Cell(Coord); // Source expressed as cell
-    static PathType path;            // Main path control.
-    CELL next;                       // Next cell to enter
-    CELL startcell;                  // Cell we started in
-    FacingType direction;            // Working direction of look ahead.
-    FacingType newdir;               // Tentative facing value.
+    CELL source = Coord_Cell(Coord);     // Source expressed as cell
+    static INSTANCE_LOCAL PathType path; // Main path control.
+    CELL next;                           // Next cell to enter
+    CELL startcell;                      // Cell we started in
+    FacingType direction;                // Working direction of look ahead.
+    FacingType newdir;                   // Tentative facing value.
 
     bool left = false, // Was leftward path legal?
         right = false; // Was rightward path legal?
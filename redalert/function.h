@@ -59,6 +59,8 @@
 
 #include "common/wwlib32.h"
 #include "common/winstub.h"
+#include "common/gamelocal.h"
+#include "common/samplecache.h"
 #include "bench.h"
 #include "compat.h"
 #include "fixed.h"
@@ -86,7 +88,7 @@ typedef struct
 //#include <vqa32\vqaplay.h>
 //#include <vqa32\vqafile.h>
 
-extern bool GameActive;
+extern INSTANCE_LOCAL bool GameActive;
 extern int LParam;
 
 #include <assert.h>
@@ -100,7 +102,7 @@ extern int LParam;
 #include "ccini.h"
 #include "ccptr.h"
 
-extern int Frame;
+extern INSTANCE_LOCAL int Frame;
 CELL Coord_Cell(COORDINATE coord);
 
 #include "palettec.h" //ST 5/13/2019
@@ -125,6 +127,8 @@ CELL Coord_Cell(COORDINATE coord);
 #include "infantry.h" // Infantry objects.
 #include "score.h"    // Scoring system class.
 #include "factory.h"  // Production manager class.
+#include "snapshot.h" // Replay snapshot ring.
+#include "statehash.h" // Desync hash tree.
 
 // Denzil 5/18/98 - Mpeg movie playback
 #ifdef MPEGMOVIE
@@ -189,6 +193,9 @@ void Speak_AI(void);
 void Stop_Speaking(void);
 void Sound_Effect(VocType voc, COORDINATE coord, int variation = 1, HousesType house = HOUSE_NONE);
 bool Is_Speaking(void);
+void Prewarm_Sound_Effects(void);
+void Clear_Sound_Effects(void);
+void Get_Sound_Effect_Stats(SampleCacheStatsType& stats);
 
 /*
 **	COMBAT.CPP
@@ -382,6 +389,8 @@ void Load_Title_Page(bool visible = false);
 unsigned Obfuscate(char const* string);
 void Anim_Init(void);
 bool Init_Game(int argc, char* argv[]);
+bool Init_Headless_Game(void);
+void Init_Game_Instance(void);
 bool Select_Game(bool fade = false);
 bool Parse_Command_Line(int argc, char* argv[]);
 void Parse_INI_File(void);
@@ -525,6 +534,8 @@ bool Save_Game(const char* file_name, const char* descr);
 bool Write_Object(void* ptr, int class_size, FileClass& file);
 void Code_All_Pointers(void);
 void Decode_All_Pointers(void);
+void Save_Snapshot(Pipe& pipe);
+void Load_Snapshot(Straw& straw);
 void Dump(void);
 
 /*
@@ -58,23 +58,23 @@ bool Debug_Modem_Dump = false;      // true = print the Modem Stuff
 bool Debug_Print_Events = false;    // true = print event & packet processing
 bool Debug_Force_Crash = false;
 
-TFixedIHeapClass<AircraftClass> Aircraft;
-TFixedIHeapClass<AnimClass> Anims;
-TFixedIHeapClass<BuildingClass> Buildings;
-TFixedIHeapClass<BulletClass> Bullets;
-TFixedIHeapClass<FactoryClass> Factories;
-TFixedIHeapClass<HouseClass> Houses;
-TFixedIHeapClass<InfantryClass> Infantry;
-TFixedIHeapClass<OverlayClass> Overlays;
-TFixedIHeapClass<SmudgeClass> Smudges;
-TFixedIHeapClass<TeamClass> Teams;
-TFixedIHeapClass<TeamTypeClass> TeamTypes;
-TFixedIHeapClass<TemplateClass> Templates;
-TFixedIHeapClass<TerrainClass> Terrains;
-TFixedIHeapClass<TriggerClass> Triggers;
-TFixedIHeapClass<UnitClass> Units;
-TFixedIHeapClass<VesselClass> Vessels;
-TFixedIHeapClass<TriggerTypeClass> TriggerTypes;
+INSTANCE_LOCAL TFixedIHeapClass<AircraftClass> Aircraft;
+INSTANCE_LOCAL TFixedIHeapClass<AnimClass> Anims;
+INSTANCE_LOCAL TFixedIHeapClass<BuildingClass> Buildings;
+INSTANCE_LOCAL TFixedIHeapClass<BulletClass> Bullets;
+INSTANCE_LOCAL TFixedIHeapClass<FactoryClass> Factories;
+INSTANCE_LOCAL TFixedIHeapClass<HouseClass> Houses;
+INSTANCE_LOCAL TFixedIHeapClass<InfantryClass> Infantry;
+INSTANCE_LOCAL TFixedIHeapClass<OverlayClass> Overlays;
+INSTANCE_LOCAL TFixedIHeapClass<SmudgeClass> Smudges;
+INSTANCE_LOCAL TFixedIHeapClass<TeamClass> Teams;
+INSTANCE_LOCAL TFixedIHeapClass<TeamTypeClass> TeamTypes;
+INSTANCE_LOCAL TFixedIHeapClass<TemplateClass> Templates;
+INSTANCE_LOCAL TFixedIHeapClass<TerrainClass> Terrains;
+INSTANCE_LOCAL TFixedIHeapClass<TriggerClass> Triggers;
+INSTANCE_LOCAL TFixedIHeapClass<UnitClass> Units;
+INSTANCE_LOCAL TFixedIHeapClass<VesselClass> Vessels;
+INSTANCE_LOCAL TFixedIHeapClass<TriggerTypeClass> TriggerTypes;
 
 TFixedIHeapClass<HouseTypeClass> HouseTypes;
 TFixedIHeapClass<BuildingTypeClass> BuildingTypes;
@@ -128,10 +128,10 @@ template <> FixedIHeapClass* CCPtr<SmudgeTypeClass>::Heap = &SmudgeTypes;
 #endif
 
 /* These variables are used to keep track of the slowest speed of a team */
-TeamFormDataStruct TeamFormData[HOUSE_COUNT];
-bool FormMove;
-SpeedType FormSpeed;
-MPHType FormMaxSpeed;
+INSTANCE_LOCAL TeamFormDataStruct TeamFormData[HOUSE_COUNT];
+INSTANCE_LOCAL bool FormMove;
+INSTANCE_LOCAL SpeedType FormSpeed;
+INSTANCE_LOCAL MPHType FormMaxSpeed;
 
 char _staging_buffer[32000];
 
@@ -139,8 +139,8 @@ char _staging_buffer[32000];
 ** Global flag for the life of Tanya.  If this flag is set, she is
 ** no longer available.
 */
-bool IsTanyaDead;
-bool SaveTanya;
+INSTANCE_LOCAL bool IsTanyaDead;
+INSTANCE_LOCAL bool SaveTanya;
 
 #ifdef FIXIT_ANTS
 bool AntsEnabled = false;
@@ -158,15 +158,15 @@ int CarrierLaunchDelay = 60;
 
 int NewINIFormat = 0;
 
-bool TimeQuake;
+INSTANCE_LOCAL bool TimeQuake;
 
 #ifdef FIXIT_CSII //	checked - ajw 9/28/98
-bool PendingTimeQuake;
-TARGET TimeQuakeCenter;
+INSTANCE_LOCAL bool PendingTimeQuake;
+INSTANCE_LOCAL TARGET TimeQuakeCenter;
 fixed QuakeUnitDamage = 0x300;
 fixed QuakeBuildingDamage = 0x300;
 int QuakeInfantryDamage = 25;
-int QuakeDelay;
+INSTANCE_LOCAL int QuakeDelay;
 fixed ChronoTankDuration = 0x300;  // chrono override for chrono tanks
 #ifdef FIXIT_ENGINEER              //	checked - ajw 9/28/98
 fixed EngineerDamage = 0x55;       // Amount of damage an engineer does
@@ -232,6 +232,12 @@ CCINIClass RuleINI;
 CCINIClass AftermathINI;
 #endif
 
+/***************************************************************************
+**	Optional rule overrides applied over the scenario's own, before any of its
+**	objects are created. Used by the batch runner to try out balance changes.
+*/
+INSTANCE_LOCAL CCINIClass* RuleOverrideINI = nullptr;
+
 /***************************************************************************
 **	This points to the benchmark objects that are allocated only if the
 **	machine is running on a Pentium and this is a debug version.
@@ -271,13 +277,13 @@ RemapControlType GreyScheme;
 **	This is the source of the random numbers used in the game. This controls
 **	the game logic and thus must be in sync with any networked machines.
 */
-RandomClass NonCriticalRandomNumber;
+INSTANCE_LOCAL RandomClass NonCriticalRandomNumber;
 RandomStraw CryptRandom;
 
 /***************************************************************************
 **	This tracks all selected objects per house (for this map).
 */
-SelectedObjectsType CurrentObject;
+INSTANCE_LOCAL SelectedObjectsType CurrentObject;
 
 /***************************************************************************
 **	This is the game version.
@@ -299,7 +305,7 @@ bool SlowPalette = false;    // Slow palette flag set?
 **	These are the movie names to use for mission briefing, winning, and losing
 **	sequences. They are read from the INI file.
 */
-ScenarioClass Scen;
+INSTANCE_LOCAL ScenarioClass Scen;
 
 /***************************************************************************
 **	This is the pending speech sample to play. This sample will be played
@@ -325,22 +331,22 @@ bool AllowVoice = true;
 **	upward at the rate of one per game logic process. The target rate is 15
 **	per second. This value is saved and restored with the saved game.
 */
-int Frame = 0;
+INSTANCE_LOCAL int Frame = 0;
 
 /***************************************************************************
 **	These globals are constantly monitored to determine if the player
 **	has won or lost. They get set according to the trigger events associated
 **	with the scenario.
 */
-bool PlayerWins;
-bool PlayerLoses;
-bool PlayerRestarts;
+INSTANCE_LOCAL bool PlayerWins;
+INSTANCE_LOCAL bool PlayerLoses;
+INSTANCE_LOCAL bool PlayerRestarts;
 
 /*
 ** This flag is set if the player neither wins nor loses; it's mostly for
 ** multiplayer mode.
 */
-bool PlayerAborts;
+INSTANCE_LOCAL bool PlayerAborts;
 
 /***************************************************************************
 **	This is the pointer for the speech staging buffer. This buffer is used
@@ -363,9 +369,9 @@ Buffer* TheaterBuffer;
 **	histogram of game performance.
 */
 int SpareTicks;
-int PathCount;      // Number of findpaths called.
-int CellCount;      // Number of cells redrawn.
-int TargetScan;     // Number of target scans.
+INSTANCE_LOCAL int PathCount;      // Number of findpaths called.
+INSTANCE_LOCAL int CellCount;      // Number of cells redrawn.
+INSTANCE_LOCAL int TargetScan;     // Number of target scans.
 int SidebarRedraws; // Number of sidebar redraws.
 
 /***************************************************************************
@@ -396,26 +402,31 @@ GameOptionsClass Options;
 **	Logic processing is controlled by this element. It handles both graphic
 **	and AI logic.
 */
-LogicClass Logic;
+INSTANCE_LOCAL LogicClass Logic;
 
 /***************************************************************************
 **	This handles the background music.
 */
 ThemeClass Theme;
 
+/***************************************************************************
+**	Dense copies of the cell fields movement checks read, kept in step with the map cells.
+*/
+INSTANCE_LOCAL CellTableClass CellTables(MAP_CELL_W, MAP_CELL_H);
+
 /***************************************************************************
 **	This is the main control class for the map.
 */
 #ifdef SCENARIO_EDITOR
-MapEditClass Map;
+INSTANCE_LOCAL MapEditClass Map;
 #else
-MouseClass Map;
+INSTANCE_LOCAL MouseClass Map;
 #endif
 
 /**************************************************************************
 **	The running game score is handled by this class (and member functions).
 */
-ScoreClass Score;
+INSTANCE_LOCAL ScoreClass Score;
 
 /***************************************************************************
 **	The running credit display is controlled by this class (and member
@@ -427,7 +438,7 @@ CreditClass CreditDisplay;
 ** This class records the special command override options that C&C
 **	supports.
 */
-SpecialClass Special;
+INSTANCE_LOCAL SpecialClass Special;
 
 bool PassedProximity; // used in display.cpp
 
@@ -435,8 +446,8 @@ bool PassedProximity; // used in display.cpp
 **	This is the scenario data for the currently loaded scenario.
 ** These variables should all be set together.
 */
-HousesType Whom; // Initial command line house choice.
-int ScenarioInit;
+INSTANCE_LOCAL HousesType Whom; // Initial command line house choice.
+INSTANCE_LOCAL int ScenarioInit;
 bool SpecialFlag = false;
 
 /***************************************************************************
@@ -445,7 +456,7 @@ bool SpecialFlag = false;
 **	displayed value for tech level in the multiplay dialogs. It remaps to
 **	the in-game rules.ini tech levels.
 */
-int BuildLevel = 10; // Buildable level (1 = simplest)
+INSTANCE_LOCAL int BuildLevel = 10; // Buildable level (1 = simplest)
 
 /***************************************************************************
 **	The various tutor and dialog messages are located in the data block
@@ -457,7 +468,7 @@ char const* DebugStrings;
 /***************************************************************************
 **	The game plays as long as this var is true.
 */
-bool GameActive;
+INSTANCE_LOCAL bool GameActive;
 
 /***************************************************************************
 **	This is a scratch variable that is used to when a reference is needed to
@@ -493,7 +504,7 @@ void const* GradFont6Ptr;   // gradient 6 point font pointer.
 /***************************************************************************
 **	This is the house that the human player is currently playing.
 */
-HouseClass* PlayerPtr;
+INSTANCE_LOCAL HouseClass* PlayerPtr;
 
 /***************************************************************************
 **	Special palettes for MCGA mode goes here. These palette buffers are used
@@ -513,44 +524,56 @@ PaletteClass ScorePalette;
 **	sent to the remote computer for processing. The other list is for incoming events
 **	that need to be executed when the correct frame has been reached.
 */
-QueueClass<EventClass, MAX_EVENTS> OutList;
-QueueClass<EventClass, (MAX_EVENTS * 64)> DoList;
+INSTANCE_LOCAL QueueClass<EventClass, MAX_EVENTS> OutList;
+INSTANCE_LOCAL QueueClass<EventClass, (MAX_EVENTS * 64)> DoList;
 
 #ifdef MIRROR_QUEUE
-QueueClass<EventClass, (MAX_EVENTS * 64)> MirrorList;
+INSTANCE_LOCAL QueueClass<EventClass, (MAX_EVENTS * 64)> MirrorList;
 #endif
 
 /***************************************************************************
 **	These are arrays/lists of trigger pointers for each cell & the houses.
 */
-DynamicVectorClass<TriggerClass*> HouseTriggers[HOUSE_COUNT];
-DynamicVectorClass<TriggerClass*> MapTriggers;
-int MapTriggerID;
-DynamicVectorClass<TriggerClass*> LogicTriggers;
-int LogicTriggerID;
+INSTANCE_LOCAL DynamicVectorClass<TriggerClass*> HouseTriggers[HOUSE_COUNT];
+INSTANCE_LOCAL DynamicVectorClass<TriggerClass*> MapTriggers;
+INSTANCE_LOCAL int MapTriggerID;
+INSTANCE_LOCAL DynamicVectorClass<TriggerClass*> LogicTriggers;
+INSTANCE_LOCAL int LogicTriggerID;
 
 /***************************************************************************
 **	This is the list of BuildingTypes that define the AI's base.
 */
-BaseClass Base;
+INSTANCE_LOCAL BaseClass Base;
 
 /***************************************************************************
 **	This is the list of carry over objects. These objects are part of the
 **	pseudo saved game that might be carried along with the current saved
 **	game.
 */
-CarryoverClass* Carryover;
+INSTANCE_LOCAL CarryoverClass* Carryover;
 
 /***************************************************************************
 ** This value is computed every time a new scenario is loaded; it's a
 ** CRC of the INI and binary map files.
 */
-unsigned int ScenarioCRC;
+INSTANCE_LOCAL unsigned int ScenarioCRC;
 
 /***************************************************************************
 ** This class manages data specific to multiplayer games.
 */
-SessionClass Session;
+INSTANCE_LOCAL SessionClass Session;
+
+/***************************************************************************
+** Snapshots of the game state taken while a recording plays back, used to
+** seek backwards and forwards through it.
+*/
+INSTANCE_LOCAL SnapshotRingClass Snapshots;
+
+/***************************************************************************
+** Hash tree of the synchronised game state, used to find where a
+** multiplayer game went out of sync.
+*/
+INSTANCE_LOCAL StateHashClass StateHash;
 #if (TIMING_FIX)
 //
 // These values store the min & max frame #'s for when MaxAhead >>increases<<.
@@ -563,8 +586,8 @@ SessionClass Session;
 // events received that are scheduled to execute during this period should
 // be re-scheduled for after that period.
 //
-int NewMaxAheadFrame1;
-int NewMaxAheadFrame2;
+INSTANCE_LOCAL int NewMaxAheadFrame1;
+INSTANCE_LOCAL int NewMaxAheadFrame2;
 #endif
 
 #ifdef FIXIT_VERSION_3
@@ -611,13 +634,13 @@ IPXManagerClass Ipx(MAX(sizeof(GlobalPacketType), sizeof(RemoteFileTransferType)
 **	This is the random-number seed; it's synchronized between systems for
 ** multiplayer games.
 */
-int Seed = 0;
+INSTANCE_LOCAL int Seed = 0;
 
 /***************************************************************************
 ** If this value is non-zero, use it as the random # seed instead; this should
 ** help reproduce some bugs.
 */
-int CustomSeed = 0;
+INSTANCE_LOCAL int CustomSeed = 0;
 
 int WindowList[9][9];
 
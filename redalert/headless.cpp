@@ -0,0 +1,126 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "function.h"
+#include "instance.h"
+#include "common/utfargs.h"
+
+/*
+**	Runs several AI skirmish matches side by side in one process and reports how many logic
+**	frames per second the whole set manages.
+**
+**	HeadlessRA [-instances=N] [-frames=N] [-scenario=NAME] [-ai=N] [-seed=N]
+*/
+
+struct HeadlessOptionsType
+{
+    int Instances;
+    int Frames;
+    int AIPlayers;
+    int Seed;
+    char const* Scenario;
+};
+
+static void Parse_Headless_Args(int argc, char** argv, HeadlessOptionsType& options)
+{
+    options.Instances = int(std::thread::hardware_concurrency());
+    options.Frames = 2000;
+    options.AIPlayers = 1;
+    options.Seed = 0x1234;
+    options.Scenario = "SCM01EA.INI";
+
+    for (int index = 1; index < argc; ++index) {
+        char const* arg = argv[index];
+
+        if (strnicmp(arg, "-instances=", 11) == 0) {
+            options.Instances = atoi(arg + 11);
+        } else if (strnicmp(arg, "-frames=", 8) == 0) {
+            options.Frames = atoi(arg + 8);
+        } else if (strnicmp(arg, "-scenario=", 10) == 0) {
+            options.Scenario = arg + 10;
+        } else if (strnicmp(arg, "-ai=", 4) == 0) {
+            options.AIPlayers = atoi(arg + 4);
+        } else if (strnicmp(arg, "-seed=", 6) == 0) {
+            options.Seed = atoi(arg + 6);
+        }
+    }
+
+    if (options.Instances < 1) {
+        options.Instances = 1;
+    }
+    options.AIPlayers = Bound(options.AIPlayers, 1, 7);
+}
+
+int main(int argc, char* argv[])
+{
+    UtfArgs args(argc, argv);
+    HeadlessOptionsType options;
+
+    Parse_Headless_Args(args.ArgC, args.ArgV, options);
+
+    if (!GameInstanceClass::Init(args.ArgV[0])) {
+        printf("Unable to load the game data.\n");
+        return (EXIT_FAILURE);
+    }
+
+    std::vector<std::thread> threads;
+    std::atomic<int> started(0);
+    std::atomic<int> failed(0);
+    std::atomic<long long> total_frames(0);
+    std::chrono::steady_clock::time_point begin;
+
+    /*
+    **	Every instance loads its scenario before any of them start stepping, the load touches
+    **	shared rules data that must not change under a running match.
+    */
+    for (int index = 0; index < options.Instances; ++index) {
+        threads.emplace_back([&, index]() {
+            GameInstanceClass instance(index);
+
+            if (!instance.Start(options.Scenario, options.AIPlayers, options.Seed + index)) {
+                failed.fetch_add(1);
+            }
+            started.fetch_add(1);
+
+            while (started.load() < options.Instances) {
+                std::this_thread::yield();
+            }
+
+            while (instance.Is_Running() && instance.Frames() < options.Frames) {
+                instance.Step();
+            }
+
+            total_frames += instance.Frames();
+
+            instance.Stop();
+        });
+    }
+
+    while (started.load() < options.Instances) {
+        std::this_thread::yield();
+    }
+    begin = std::chrono::steady_clock::now();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    if (failed.load() != 0) {
+        printf("%d of %d instances failed to start %s.\n", failed.load(), options.Instances, options.Scenario);
+        return (EXIT_FAILURE);
+    }
+
+    printf("%d instances of %s, %lld frames in %.2fs, %.1f ticks/s (%.1f per instance).\n",
+           options.Instances,
+           options.Scenario,
+           total_frames.load(),
+           seconds,
+           seconds > 0 ? total_frames.load() / seconds : 0.0,
+           seconds > 0 ? total_frames.load() / seconds / options.Instances : 0.0);
+
+    return (EXIT_SUCCESS);
+}
@@ -69,6 +69,8 @@
  *   HouseClass::Find_Cell_In_Zone -- Finds a legal placement cell within the zone.            *
  *   HouseClass::Find_Juicy_Target -- Finds a suitable field target.                           *
  *   HouseClass::Fire_Sale -- Cause all buildings to be sold.                                  *
+ *   HouseClass::First_Owned -- Fetches the first object of a kind this house owns.            *
+ *   HouseClass::First_Owned -- Fetches the first object of a type this house owns.            *
  *   HouseClass::Flag_Attach -- Attach flag to specified cell (or thereabouts).                *
  *   HouseClass::Flag_Attach -- Attaches the house flag the specified unit.                    *
  *   HouseClass::Flag_Remove -- Removes the flag from the specified target.                    *
@@ -91,11 +93,15 @@
  *   HouseClass::Make_Enemy -- Make an enemy of the house specified.                           *
  *   HouseClass::Manual_Place -- Inform display system of building placement mode.             *
  *   HouseClass::One_Time -- Handles one time initialization of the house array.               *
+ *   HouseClass::Owned_Link -- Adds an object to this house's owned object lists.              *
+ *   HouseClass::Owned_List -- Fetches the owned object list for a kind or type.               *
+ *   HouseClass::Owned_Unlink -- Removes an object from this house's owned object lists.       *
  *   HouseClass::Place_Object -- Places the object (building) at location specified.           *
  *   HouseClass::Place_Special_Blast -- Place a special blast effect at location specified.    *
  *   HouseClass::Power_Fraction -- Fetches the current power output rating.                    *
  *   HouseClass::Production_Begun -- Records that production has begun.                        *
  *   HouseClass::Read_INI -- Reads house specific data from INI.                               *
+ *   HouseClass::Rebuild_Owned_Lists -- Rebuilds every house's owned object lists.             *
  *   HouseClass::Recalc_Attributes -- Recalcs all houses existence bits.                       *
  *   HouseClass::Recalc_Center -- Recalculates the center point of the base.                   *
  *   HouseClass::Refund_Money -- Refunds money to back to the house.                           *
@@ -111,6 +117,7 @@
  *   HouseClass::Super_Weapon_Handler -- Handles the super weapon charge and discharge logic.  *
  *   HouseClass::Suspend_Production -- Temporarily puts production on hold.                    *
  *   HouseClass::Tally_Score -- Fills in the score system for this round                       *
+ *   HouseClass::Threat_Field -- Fetches the region threat field of this house.                *
  *   HouseClass::Tiberium_Fraction -- Calculates the tiberium fraction of capacity.            *
  *   HouseClass::Tracking_Add -- Informs house of new inventory item.                          *
  *   HouseClass::Tracking_Remove -- Remove object from house tracking system.                  *
@@ -142,7 +149,7 @@
 */
 #include "sidebarglyphx.h"
 
-TFixedIHeapClass<HouseClass::BuildChoiceClass> HouseClass::BuildChoice;
+INSTANCE_LOCAL TFixedIHeapClass<HouseClass::BuildChoiceClass> HouseClass::BuildChoice;
 
 template <> int TFixedIHeapClass<HouseClass::BuildChoiceClass>::Save(Pipe&) const
 {
@@ -735,9 +742,20 @@ HouseClass::HouseClass(HousesType house)
     memset(IQuantity, '\0', sizeof(IQuantity));
     memset(AQuantity, '\0', sizeof(AQuantity));
     memset(VQuantity, '\0', sizeof(VQuantity));
+    memset(&OwnedBuildings, '\0', sizeof(OwnedBuildings));
+    memset(&OwnedUnits, '\0', sizeof(OwnedUnits));
+    memset(&OwnedInfantry, '\0', sizeof(OwnedInfantry));
+    memset(&OwnedAircraft, '\0', sizeof(OwnedAircraft));
+    memset(&OwnedVessels, '\0', sizeof(OwnedVessels));
+    memset(OwnedBuildingTypes, '\0', sizeof(OwnedBuildingTypes));
+    memset(OwnedUnitTypes, '\0', sizeof(OwnedUnitTypes));
+    memset(OwnedInfantryTypes, '\0', sizeof(OwnedInfantryTypes));
+    memset(OwnedAircraftTypes, '\0', sizeof(OwnedAircraftTypes));
+    memset(OwnedVesselTypes, '\0', sizeof(OwnedVesselTypes));
     strcpy(IniName, Text_String(TXT_COMPUTER)); // Default computer name.
     HouseTriggers[house].Clear();
     memset((void*)&Regions[0], 0x00, sizeof(Regions));
+    Threat_Field().Clear();
     Make_Ally(house);
     Assign_Handicap(Scen.CDifficulty);
 
@@ -1121,6 +1139,14 @@ void HouseClass::AI(void)
         DamageTime = TICKS_PER_MINUTE * Rule.DamageDelay;
     }
 
+    /*
+    **	Let the decayed threat catch up with the threat currently on the map. Threat is
+    **	only tracked in normal games.
+    */
+    if (Session.Type == GAME_NORMAL && (Frame % THREAT_DECAY_DELAY) == 0) {
+        Threat_Field().Decay(THREAT_DECAY_KEEP);
+    }
+
     /*
     **	If there are no more buildings to sell, then automatically cancel the
     **	sell mode.
@@ -2485,25 +2511,45 @@ void HouseClass::Adjust_Threat(int region, int threat)
                          MAP_REGION_WIDTH - 1,
                          MAP_REGION_WIDTH,
                          MAP_REGION_WIDTH + 1};
-    static int _thr[] = {2, 1, 2, 1, 0, 1, 2, 1, 2};
-    int neg;
-    int* val = &_val[0];
-    int* thr = &_thr[0];
-
-    if (threat < 0) {
-        threat = -threat;
-        neg = true;
-    } else {
-        neg = false;
-    }
+
+    /*
+    **	The threat field spreads the threat over the region and its neighbours. The regions
+    **	it touched are then copied back so that Regions always holds the field's values.
+    */
+    RegionThreatClass& field = Threat_Field();
+    field.Spread(region, threat);
 
     for (int lp = 0; lp < 9; lp++) {
-        Regions[region + *val].Adjust_Threat(threat >> *thr, neg);
-        val++;
-        thr++;
+        Regions[region + _val[lp]].Set_Threat(field.Value(region + _val[lp]));
     }
 }
 
+/***********************************************************************************************
+ * HouseClass::Threat_Field -- Fetches the region threat field of this house.                  *
+ *                                                                                             *
+ *    The field holds the threat that Regions mirrors and can also sum it over an area or give *
+ *    its decayed value. It is kept outside the house, the summed area tables make it several  *
+ *    times the size of the threat itself. Only the decayed layer is saved, by                 *
+ *    Save_Misc_Values. Decode_Pointers rebuilds the rest from Regions after a load.           *
+ *                                                                                             *
+ * INPUT:   house -- The house to fetch the field of. The member version uses this house.      *
+ *                                                                                             *
+ * OUTPUT:  Returns with a reference to the threat field of the house.                         *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+RegionThreatClass& HouseClass::Threat_Field(void) const
+{
+    return (Threat_Field(Class->House));
+}
+
+RegionThreatClass& HouseClass::Threat_Field(HousesType house)
+{
+    static INSTANCE_LOCAL RegionThreatClass _fields[HOUSE_COUNT];
+
+    return (_fields[house]);
+}
+
 /***********************************************************************************************
  * HouseClass::Begin_Production -- Starts production of the specified object type.             *
  *                                                                                             *
@@ -4765,10 +4811,10 @@ void HouseClass::Recalc_Center(void)
         int count = 0;
         int index;
 
-        for (index = 0; index < Buildings.Count(); index++) {
-            BuildingClass const* b = Buildings.Ptr(index);
+        for (TechnoClass const* t = First_Owned(RTTI_BUILDING); t != NULL; t = t->OwnedNext) {
+            BuildingClass const* b = (BuildingClass const*)t;
 
-            if (b != NULL && !b->IsInLimbo && (HouseClass*)b->House == this && b->Strength > 0) {
+            if (!b->IsInLimbo && b->Strength > 0) {
 
                 /*
                 **	Give more "weight" to buildings that cost more. The presumption is that cheap
@@ -4824,10 +4870,10 @@ void HouseClass::Recalc_Center(void)
         if (count > 1) {
             int radius = 0;
 
-            for (index = 0; index < Buildings.Count(); index++) {
-                BuildingClass const* b = Buildings.Ptr(index);
+            for (TechnoClass const* t = First_Owned(RTTI_BUILDING); t != NULL; t = t->OwnedNext) {
+                BuildingClass const* b = (BuildingClass const*)t;
 
-                if (b != NULL && !b->IsInLimbo && (HouseClass*)b->House == this && b->Strength > 0) {
+                if (!b->IsInLimbo && b->Strength > 0) {
                     radius += Distance(Center, b->Center_Coord());
                 }
             }
@@ -4836,10 +4882,10 @@ void HouseClass::Recalc_Center(void)
             /*
             **	Determine the relative strength of each base defense zone.
             */
-            for (index = 0; index < Buildings.Count(); index++) {
-                BuildingClass const* b = Buildings.Ptr(index);
+            for (TechnoClass const* t = First_Owned(RTTI_BUILDING); t != NULL; t = t->OwnedNext) {
+                BuildingClass const* b = (BuildingClass const*)t;
 
-                if (b != NULL && !b->IsInLimbo && (HouseClass*)b->House == this && b->Strength > 0) {
+                if (!b->IsInLimbo && b->Strength > 0) {
                     ZoneType z = Which_Zone(b);
 
                     if (z != ZONE_NONE) {
@@ -6130,10 +6176,11 @@ int HouseClass::AI_Unit(void)
         **	Reduce the theoretical maximum by the actual number of objects currently
         **	in play.
         */
-        for (int uindex = 0; uindex < Units.Count(); uindex++) {
-            UnitClass* unit = Units.Ptr(uindex);
-            if (unit != NULL && unit->Is_Recruitable(this) && counter[unit->Class->Type] > 0) {
-                counter[unit->Class->Type]--;
+        for (UnitType utype = UNIT_FIRST; utype < UNIT_COUNT; utype++) {
+            for (TechnoClass* t = First_Owned(RTTI_UNIT, utype); t != NULL && counter[utype] > 0; t = t->TypeNext) {
+                if (((UnitClass*)t)->Is_Recruitable(this)) {
+                    counter[utype]--;
+                }
             }
         }
 
@@ -6268,10 +6315,11 @@ int HouseClass::AI_Vessel(void)
         **	Reduce the theoretical maximum by the actual number of objects currently
         **	in play.
         */
-        for (int vindex = 0; vindex < Vessels.Count(); vindex++) {
-            VesselClass* unit = Vessels.Ptr(vindex);
-            if (unit != NULL && unit->Is_Recruitable(this) && counter[unit->Class->Type] > 0) {
-                counter[unit->Class->Type]--;
+        for (VesselType vtype = VESSEL_FIRST; vtype < VESSEL_COUNT; vtype++) {
+            for (TechnoClass* t = First_Owned(RTTI_VESSEL, vtype); t != NULL && counter[vtype] > 0; t = t->TypeNext) {
+                if (((VesselClass*)t)->Is_Recruitable(this)) {
+                    counter[vtype]--;
+                }
             }
         }
 
@@ -6385,10 +6433,11 @@ int HouseClass::AI_Infantry(void)
         **	Reduce the theoretical maximum by the actual number of objects currently
         **	in play.
         */
-        for (int uindex = 0; uindex < Infantry.Count(); uindex++) {
-            InfantryClass* infantry = Infantry.Ptr(uindex);
-            if (infantry != NULL && infantry->Is_Recruitable(this) && counter[infantry->Class->Type] > 0) {
-                counter[infantry->Class->Type]--;
+        for (InfantryType itype = INFANTRY_FIRST; itype < INFANTRY_COUNT; itype++) {
+            for (TechnoClass* t = First_Owned(RTTI_INFANTRY, itype); t != NULL && counter[itype] > 0; t = t->TypeNext) {
+                if (((InfantryClass*)t)->Is_Recruitable(this)) {
+                    counter[itype]--;
+                }
             }
         }
 
@@ -6652,6 +6701,8 @@ void HouseClass::Tracking_Remove(TechnoClass const* techno)
 
     int type;
 
+    Owned_Unlink((TechnoClass*)techno);
+
     switch (techno->What_Am_I()) {
     case RTTI_BUILDING:
         CurBuildings--;
@@ -6727,6 +6778,8 @@ void HouseClass::Tracking_Add(TechnoClass const* techno)
     VesselType vessel;
     int quant;
 
+    Owned_Link((TechnoClass*)techno);
+
     switch (techno->What_Am_I()) {
     case RTTI_BUILDING:
         CurBuildings++;
@@ -6808,6 +6861,258 @@ void HouseClass::Tracking_Add(TechnoClass const* techno)
     }
 }
 
+/***********************************************************************************************
+ * HouseClass::Owned_List -- Fetches the owned object list for a kind or type.                 *
+ *                                                                                             *
+ *    This returns the list of all objects of the given kind that this house owns, or just     *
+ *    those of the given type if a type is specified.                                          *
+ *                                                                                             *
+ * INPUT:   rtti  -- The kind of object (RTTI_UNIT, RTTI_BUILDING, etc).                       *
+ *                                                                                             *
+ *          type  -- The type (UnitType, StructType, etc) or -1 for all of that kind.          *
+ *                                                                                             *
+ * OUTPUT:  Returns with a pointer to the list, or NULL if the house doesn't keep one for it.  *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+OwnedListType* HouseClass::Owned_List(RTTIType rtti, int type)
+{
+    switch (rtti) {
+    case RTTI_BUILDING:
+        return ((type == -1) ? &OwnedBuildings : &OwnedBuildingTypes[type]);
+
+    case RTTI_UNIT:
+        return ((type == -1) ? &OwnedUnits : &OwnedUnitTypes[type]);
+
+    case RTTI_INFANTRY:
+        return ((type == -1) ? &OwnedInfantry : &OwnedInfantryTypes[type]);
+
+    case RTTI_AIRCRAFT:
+        return ((type == -1) ? &OwnedAircraft : &OwnedAircraftTypes[type]);
+
+    case RTTI_VESSEL:
+        return ((type == -1) ? &OwnedVessels : &OwnedVesselTypes[type]);
+
+    default:
+        break;
+    }
+    return (NULL);
+}
+
+/*
+**	Fetches the exact type of a techno object, as an index into the per type owned lists.
+*/
+static int Owned_Type(TechnoClass const* techno)
+{
+    switch (techno->What_Am_I()) {
+    case RTTI_BUILDING:
+        return (((BuildingTypeClass const&)techno->Class_Of()).Type);
+
+    case RTTI_UNIT:
+        return (((UnitTypeClass const&)techno->Class_Of()).Type);
+
+    case RTTI_INFANTRY:
+        return (((InfantryTypeClass const&)techno->Class_Of()).Type);
+
+    case RTTI_AIRCRAFT:
+        return (((AircraftTypeClass const&)techno->Class_Of()).Type);
+
+    case RTTI_VESSEL:
+        return (((VesselTypeClass const&)techno->Class_Of()).Type);
+
+    default:
+        break;
+    }
+    return (-1);
+}
+
+/*
+**	Inserts into an owned list using the given pair of links, keeping the list in creation
+**	(and thus heap) order. Objects are nearly always the newest, so the search from the tail
+**	is normally over at once; a captured object may need to go further back.
+*/
+static void
+Link_Owned(OwnedListType& list, TechnoClass* techno, TechnoClass* TechnoClass::*next, TechnoClass* TechnoClass::*prev)
+{
+    TechnoClass* after = list.Tail;
+    while (after != NULL && after->OwnedSequence > techno->OwnedSequence) {
+        after = after->*prev;
+    }
+
+    techno->*prev = after;
+    techno->*next = (after != NULL) ? after->*next : list.Head;
+
+    if (after != NULL) {
+        after->*next = techno;
+    } else {
+        list.Head = techno;
+    }
+
+    if (techno->*next != NULL) {
+        (techno->*next)->*prev = techno;
+    } else {
+        list.Tail = techno;
+    }
+}
+
+static void
+Unlink_Owned(OwnedListType& list, TechnoClass* techno, TechnoClass* TechnoClass::*next, TechnoClass* TechnoClass::*prev)
+{
+    if (techno->*prev != NULL) {
+        (techno->*prev)->*next = techno->*next;
+    } else {
+        list.Head = techno->*next;
+    }
+
+    if (techno->*next != NULL) {
+        (techno->*next)->*prev = techno->*prev;
+    } else {
+        list.Tail = techno->*prev;
+    }
+
+    techno->*next = NULL;
+    techno->*prev = NULL;
+}
+
+/***********************************************************************************************
+ * HouseClass::Owned_Link -- Adds an object to this house's owned object lists.                *
+ *                                                                                             *
+ *    The object is added to both the list for its kind and the list for its exact type.       *
+ *                                                                                             *
+ * INPUT:   techno   -- Pointer to the object that this house now owns.                        *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void HouseClass::Owned_Link(TechnoClass* techno)
+{
+    int type = Owned_Type(techno);
+
+    if (type != -1) {
+        Link_Owned(*Owned_List(techno->What_Am_I()), techno, &TechnoClass::OwnedNext, &TechnoClass::OwnedPrev);
+        Link_Owned(*Owned_List(techno->What_Am_I(), type), techno, &TechnoClass::TypeNext, &TechnoClass::TypePrev);
+    }
+}
+
+/***********************************************************************************************
+ * HouseClass::Owned_Unlink -- Removes an object from this house's owned object lists.         *
+ *                                                                                             *
+ * INPUT:   techno   -- Pointer to the object that this house no longer owns.                  *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void HouseClass::Owned_Unlink(TechnoClass* techno)
+{
+    int type = Owned_Type(techno);
+
+    if (type != -1) {
+        Unlink_Owned(*Owned_List(techno->What_Am_I()), techno, &TechnoClass::OwnedNext, &TechnoClass::OwnedPrev);
+        Unlink_Owned(*Owned_List(techno->What_Am_I(), type), techno, &TechnoClass::TypeNext, &TechnoClass::TypePrev);
+    }
+}
+
+/***********************************************************************************************
+ * HouseClass::First_Owned -- Fetches the first object of a kind this house owns.              *
+ *                                                                                             *
+ *    Follow OwnedNext from the returned object to visit the rest, in heap order.              *
+ *                                                                                             *
+ * INPUT:   rtti  -- The kind of object to fetch (RTTI_UNIT, RTTI_BUILDING, etc).              *
+ *                                                                                             *
+ * OUTPUT:  Returns with the first object of that kind owned by this house, or NULL if none.   *
+ *                                                                                             *
+ * WARNINGS:   The list must not be changed while walking it. Objects in limbo are included.   *
+ *=============================================================================================*/
+TechnoClass* HouseClass::First_Owned(RTTIType rtti) const
+{
+    OwnedListType const* list = ((HouseClass*)this)->Owned_List(rtti);
+
+    return ((list != NULL) ? list->Head : NULL);
+}
+
+/***********************************************************************************************
+ * HouseClass::First_Owned -- Fetches the first object of a type this house owns.              *
+ *                                                                                             *
+ *    Follow TypeNext from the returned object to visit the rest, in heap order.               *
+ *                                                                                             *
+ * INPUT:   rtti  -- The kind of object to fetch (RTTI_UNIT, RTTI_BUILDING, etc).              *
+ *                                                                                             *
+ *          type  -- The type of that kind to fetch (UnitType, StructType, etc).               *
+ *                                                                                             *
+ * OUTPUT:  Returns with the first object of that type owned by this house, or NULL if none.   *
+ *                                                                                             *
+ * WARNINGS:   The list must not be changed while walking it. Objects in limbo are included.   *
+ *=============================================================================================*/
+TechnoClass* HouseClass::First_Owned(RTTIType rtti, int type) const
+{
+    OwnedListType const* list = ((HouseClass*)this)->Owned_List(rtti, type);
+
+    return ((list != NULL) ? list->Head : NULL);
+}
+
+/***********************************************************************************************
+ * HouseClass::Rebuild_Owned_Lists -- Rebuilds every house's owned object lists.               *
+ *                                                                                             *
+ *    The owned lists are made of pointers, so they can't be carried over in a saved game.     *
+ *    This rebuilds them from the object heaps once a game has been loaded.                    *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Call only after all object pointers have been decoded.                          *
+ *=============================================================================================*/
+void HouseClass::Rebuild_Owned_Lists(void)
+{
+    for (int index = 0; index < Houses.Count(); index++) {
+        HouseClass* house = Houses.Ptr(index);
+
+        memset(&house->OwnedBuildings, '\0', sizeof(house->OwnedBuildings));
+        memset(&house->OwnedUnits, '\0', sizeof(house->OwnedUnits));
+        memset(&house->OwnedInfantry, '\0', sizeof(house->OwnedInfantry));
+        memset(&house->OwnedAircraft, '\0', sizeof(house->OwnedAircraft));
+        memset(&house->OwnedVessels, '\0', sizeof(house->OwnedVessels));
+        memset(house->OwnedBuildingTypes, '\0', sizeof(house->OwnedBuildingTypes));
+        memset(house->OwnedUnitTypes, '\0', sizeof(house->OwnedUnitTypes));
+        memset(house->OwnedInfantryTypes, '\0', sizeof(house->OwnedInfantryTypes));
+        memset(house->OwnedAircraftTypes, '\0', sizeof(house->OwnedAircraftTypes));
+        memset(house->OwnedVesselTypes, '\0', sizeof(house->OwnedVesselTypes));
+    }
+
+    /*
+    **	Relink each object to its house, renumbering the creation order from the heap order.
+    */
+    auto relink = [](TechnoClass* techno) {
+        techno->OwnedNext = NULL;
+        techno->OwnedPrev = NULL;
+        techno->TypeNext = NULL;
+        techno->TypePrev = NULL;
+        techno->OwnedSequence = ++TechnoClass::OwnedSequenceCount;
+        if (techno->House) {
+            techno->House->Owned_Link(techno);
+        }
+    };
+
+    TechnoClass::OwnedSequenceCount = 0;
+    for (int index = 0; index < Buildings.Count(); index++) {
+        relink(Buildings.Ptr(index));
+    }
+    for (int index = 0; index < Units.Count(); index++) {
+        relink(Units.Ptr(index));
+    }
+    for (int index = 0; index < Infantry.Count(); index++) {
+        relink(Infantry.Ptr(index));
+    }
+    for (int index = 0; index < Aircraft.Count(); index++) {
+        relink(Aircraft.Ptr(index));
+    }
+    for (int index = 0; index < Vessels.Count(); index++) {
+        relink(Vessels.Ptr(index));
+    }
+}
+
 /***********************************************************************************************
  * HouseClass::Factory_Counter -- Fetches a pointer to the factory counter value.              *
  *                                                                                             *
@@ -7166,6 +7471,21 @@ CELL HouseClass::Where_To_Go(FootClass const* object) const
         zone = ZONE_CORE;
     } else {
         zone = Random_Pick(ZONE_NORTH, ZONE_WEST);
+
+        /*
+        **	Rather cover the side of the base that enemies have been near lately. The decayed
+        **	threat still remembers enemies that have since moved on or been destroyed. With
+        **	no threat anywhere the random pick stands.
+        */
+        int range = Radius / CELL_LEPTON_W;
+        int best = 0;
+        for (int index = ZONE_NORTH; index <= ZONE_WEST; index++) {
+            int threat = Map.Area_Threat(Zone_Cell(ZoneType(index)), range, Class->House, true);
+            if (threat > best) {
+                best = threat;
+                zone = ZoneType(index);
+            }
+        }
     }
 
     CELL cell = Random_Cell_In_Zone(zone);
@@ -7915,6 +8235,52 @@ void HouseClass::Update_Spied_Power_Plants(void)
     }
 }
 
+/*
+**	Every cell offset sorted by the distance between cell centers, as Distance measures it. The
+**	lepton distance of an offset is 128 times its ring number, Start[ring] is where the ring's
+**	offsets begin and Start[ring + 1] where they end.
+*/
+#define PLACE_REACH (MAP_CELL_W - 1)
+#define PLACE_SPAN  (PLACE_REACH * 2 + 1)
+#define PLACE_RINGS (PLACE_REACH * 3 + 1)
+
+struct PlacementOrderStruct
+{
+    PlacementOrderStruct(void)
+    {
+        int count[PLACE_RINGS + 1] = {0};
+
+        for (int y = -PLACE_REACH; y <= PLACE_REACH; y++) {
+            for (int x = -PLACE_REACH; x <= PLACE_REACH; x++) {
+                count[Ring(x, y) + 1]++;
+            }
+        }
+        Start[0] = 0;
+        for (int ring = 0; ring < PLACE_RINGS; ring++) {
+            Start[ring + 1] = Start[ring] + count[ring + 1];
+            count[ring + 1] = Start[ring];
+        }
+        for (int y = -PLACE_REACH; y <= PLACE_REACH; y++) {
+            for (int x = -PLACE_REACH; x <= PLACE_REACH; x++) {
+                int index = count[Ring(x, y) + 1]++;
+                X[index] = (signed char)x;
+                Y[index] = (signed char)y;
+            }
+        }
+    }
+
+    static int Ring(int x, int y)
+    {
+        x = ABS(x);
+        y = ABS(y);
+        return ((x > y) ? (x * 2 + y) : (y * 2 + x));
+    }
+
+    signed char X[PLACE_SPAN * PLACE_SPAN];
+    signed char Y[PLACE_SPAN * PLACE_SPAN];
+    int Start[PLACE_RINGS + 1];
+};
+
 /***********************************************************************************************
  * HouseClass::Find_Cell_In_Zone -- Finds a legal placement cell within the zone.              *
  *                                                                                             *
@@ -7936,17 +8302,19 @@ void HouseClass::Update_Spied_Power_Plants(void)
  *=============================================================================================*/
 CELL HouseClass::Find_Cell_In_Zone(TechnoClass const* techno, ZoneType zone) const
 {
+    static PlacementOrderStruct const _order;
+
     if (techno == NULL)
         return (0);
 
-    int bestval = -1;
-    int bestcell = 0;
     TechnoTypeClass const* ttype = techno->Techno_Type_Class();
 
     /*
     **	Pick a random location within the zone specified.
     */
     CELL trycell = Random_Cell_In_Zone(zone);
+    int tryx = Cell_X(trycell);
+    int tryy = Cell_Y(trycell);
 
     short const* list = NULL;
     if (techno->What_Am_I() == RTTI_BUILDING) {
@@ -7955,34 +8323,54 @@ CELL HouseClass::Find_Cell_In_Zone(TechnoClass const* techno, ZoneType zone) con
 
     /*
     **	Find a legal placement position as close as possible to the picked location while still
-    **	remaining within the zone.
+    **	remaining within the zone. The cells are visited in rings of equal distance from the
+    **	picked location, so the first ring with a legal cell holds the closest ones. Within that
+    **	ring the lowest numbered legal cell wins, the same as a scan of the whole map would pick.
+    **	Cells in any zone lie within four radii of the base center, no ring beyond that can
+    **	hold one.
     */
-    for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
-        //		if (Map.In_Radar(cell)) {
-        if (Map.In_Radar(cell) && Which_Zone(cell) != ZONE_NONE) {
-            bool ok = ttype->Legal_Placement(cell);
+    int reach = Distance(Cell_Coord(trycell), Center) + Radius * 4 + CELL_LEPTON_W;
 
-            /*
-            **	Another (adjacency) check is required for buildings.
-            */
-            if (ok && list != NULL && !Map.Passes_Proximity_Check(ttype, techno->House->Class->House, list, cell)) {
-                ok = false;
+    for (int ring = 0; ring < PLACE_RINGS && ring * (CELL_LEPTON_W / 2) <= reach; ring++) {
+        int bestcell = -1;
+
+        for (int index = _order.Start[ring]; index < _order.Start[ring + 1]; index++) {
+            int x = tryx + _order.X[index];
+            int y = tryy + _order.Y[index];
+            if ((unsigned)x >= MAP_CELL_W || (unsigned)y >= MAP_CELL_H) {
+                continue;
+            }
+
+            CELL cell = XY_Cell(x, y);
+            if (bestcell != -1 && cell > bestcell) {
+                continue;
             }
 
-            if (ok) {
-                int dist = Distance(Cell_Coord(cell), Cell_Coord(trycell));
-                if (bestval == -1 || dist < bestval) {
-                    bestval = dist;
+            if (Map.In_Radar(cell) && Which_Zone(cell) != ZONE_NONE) {
+                bool ok = ttype->Legal_Placement(cell);
+
+                /*
+                **	Another (adjacency) check is required for buildings.
+                */
+                if (ok && list != NULL
+                    && !Map.Passes_Proximity_Check(ttype, techno->House->Class->House, list, cell)) {
+                    ok = false;
+                }
+
+                if (ok) {
                     bestcell = cell;
                 }
             }
         }
-    }
 
-    /*
-    **	Return the best location to move to.
-    */
-    return (bestcell);
+        /*
+        **	Return the best location to move to.
+        */
+        if (bestcell != -1) {
+            return (bestcell);
+        }
+    }
+    return (0);
 }
 
 /***********************************************************************************************
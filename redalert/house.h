@@ -37,6 +37,7 @@
 
 #include "type.h"
 #include "region.h"
+#include "common/threatfield.h"
 #include "credits.h"
 #include "super.h"
 
@@ -54,6 +55,11 @@ class FactoryClass;
 
 #define HOUSE_NAME_MAX 12
 
+/*
+**	Region threat with area sums and a decayed layer, see HouseClass::Threat_Field.
+*/
+typedef ThreatFieldClass<MAP_REGION_WIDTH, MAP_REGION_HEIGHT> RegionThreatClass;
+
 /****************************************************************************
 **	Certain aspects of the house "country" are initially set by the scenario
 **	control file. This information is static for the duration of the current
@@ -109,6 +115,19 @@ public:
     SourceType Edge;
 };
 
+/****************************************************************************
+**	Head and tail of one of the intrusive lists a house keeps of the objects it
+**	owns. The links live in TechnoClass (OwnedNext/OwnedPrev for the list of all
+**	objects of that kind, TypeNext/TypePrev for the list of that exact type). The
+**	lists are kept in the same order as the object heaps, so walking one visits
+**	objects in the order a scan of the heap would have.
+*/
+struct OwnedListType
+{
+    TechnoClass* Head;
+    TechnoClass* Tail;
+};
+
 /****************************************************************************
 **	Player control structure. Each player (computer or human) has one of
 **	these structures associated. These are located in a global array.
@@ -608,6 +627,27 @@ private:
     int VQuantity[VESSEL_COUNT];
 #endif
 
+    /*
+    **	Lists of the objects this house owns, both by kind and by exact type. These
+    **	are maintained by Tracking_Add and Tracking_Remove and let the AI walk its
+    **	own forces rather than the whole object heap. They aren't meaningful in a
+    **	saved game and are rebuilt after loading.
+    */
+    OwnedListType OwnedBuildings;
+    OwnedListType OwnedUnits;
+    OwnedListType OwnedInfantry;
+    OwnedListType OwnedAircraft;
+    OwnedListType OwnedVessels;
+    OwnedListType OwnedBuildingTypes[STRUCT_COUNT];
+    OwnedListType OwnedUnitTypes[UNIT_COUNT];
+    OwnedListType OwnedInfantryTypes[INFANTRY_COUNT];
+    OwnedListType OwnedAircraftTypes[AIRCRAFT_COUNT];
+    OwnedListType OwnedVesselTypes[VESSEL_COUNT];
+
+    OwnedListType* Owned_List(RTTIType rtti, int type = -1);
+    void Owned_Link(TechnoClass* techno);
+    void Owned_Unlink(TechnoClass* techno);
+
     /*
     **	This timer keeps track of when an all out attack should be performed.
     **	When this timer expires, send most of this house's units in an
@@ -784,8 +824,13 @@ public:
     };
     TeamTypeClass const* Suggested_New_Team(bool alertcheck = false);
     void Adjust_Threat(int region, int threat);
+    RegionThreatClass& Threat_Field(void) const;
+    static RegionThreatClass& Threat_Field(HousesType house);
     void Tracking_Remove(TechnoClass const* techno);
     void Tracking_Add(TechnoClass const* techno);
+    TechnoClass* First_Owned(RTTIType rtti) const;
+    TechnoClass* First_Owned(RTTIType rtti, int type) const;
+    static void Rebuild_Owned_Lists(void);
     void Active_Remove(TechnoClass const* techno);
     void Active_Add(TechnoClass const* techno);
 
@@ -963,7 +1008,7 @@ public:
         void Decode_Pointers(void){};
     };
 
-    static TFixedIHeapClass<BuildChoiceClass> BuildChoice;
+    static INSTANCE_LOCAL TFixedIHeapClass<BuildChoiceClass> BuildChoice;
 
     /*
     ** These values are for multiplay only.
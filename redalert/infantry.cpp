@@ -3216,6 +3216,7 @@ void InfantryClass::Set_Occupy_Bit(CELL cell, int spot_index)
     ** Set the occupy position for the spot that we passed in
     */
     Map[cell].Flag.Composite |= (1 << spot_index);
+    CellTables.Set_Composite(cell, Map[cell].Flag.Composite);
 
     /*
     ** Record the type of infantry that now owns the cell
@@ -3244,6 +3245,7 @@ void InfantryClass::Clear_Occupy_Bit(CELL cell, int spot_index)
     ** Clear the occupy bit for the infantry in that cell
     */
     Map[cell].Flag.Composite &= ~(1 << spot_index);
+    CellTables.Set_Composite(cell, Map[cell].Flag.Composite);
 
     /*
     ** If he was the last infantry recorded in the cell then
@@ -39,12 +39,19 @@
  *   Init_Expansion_Files -- Fetch any override expansion mixfiles.                            *
  *   Init_Fonts -- Initialize all the game font pointers.                                      *
  *   Init_Game -- Main game initialization routine.                                            *
+ *   Init_Game_Instance -- Initialize the state owned by a single game instance.               *
+ *   Init_Headless_Game -- Initialize the shared game data without any user interface.         *
  *   Init_Heaps -- Initialize the game heaps and buffers.                                      *
  *   Init_Keys -- Initialize the cryptographic keys.                                           *
  *   Init_Mouse -- Initialize the mouse system.                                                *
+ *   Init_Object_Heaps -- Size the heaps that hold the game objects.                           *
  *   Init_One_Time_Systems -- Initialize internal pointers to the bulk data.                   *
+ *   Init_Pointer_Heaps -- Tell the smart pointers which heaps they index into.                *
+ *   Init_Rules -- Find and process the rules files.                                           *
  *   Init_Random -- Initializes the random-number generator                                    *
  *   Init_Secondary_Mixfiles -- Register and cache secondary mixfiles.                         *
+ *   Init_Type_Heaps -- Allocate the heaps of the object type classes.                         *
+ *   Init_Type_One_Time -- One-time initialization of the object type classes.                 *
  *   Load_Recording_Values -- Loads recording values from recording file                       *
  *   Load_Title_Page -- Load the background art for the title page.                            *
  *   Obfuscate -- Sufficiently transform parameter to thwart casual hackers.                   *
@@ -90,6 +97,11 @@ extern bool bNoMovies;
 static void Play_Intro(bool sequenced = false);
 static void Init_Color_Remaps(void);
 static void Init_Heaps(void);
+static void Init_Object_Heaps(void);
+static void Init_Pointer_Heaps(void);
+static void Init_Rules(void);
+static void Init_Type_Heaps(void);
+static void Init_Type_One_Time(void);
 static void Init_Expansion_Files(void);
 static void Init_One_Time_Systems(void);
 static void Init_Fonts(void);
@@ -222,79 +234,15 @@ bool Init_Game(int, char*[])
     **	of processing the rules.ini file, but that is a bit beyond the capabilities of
     **	the rule parser routine (currently).
     */
-    HouseTypes.Set_Heap(HOUSE_COUNT);
-    BuildingTypes.Set_Heap(STRUCT_COUNT);
-    AircraftTypes.Set_Heap(AIRCRAFT_COUNT);
-    InfantryTypes.Set_Heap(INFANTRY_COUNT);
-    BulletTypes.Set_Heap(BULLET_COUNT);
-    AnimTypes.Set_Heap(ANIM_COUNT);
-    UnitTypes.Set_Heap(UNIT_COUNT);
-    VesselTypes.Set_Heap(VESSEL_COUNT);
-    TemplateTypes.Set_Heap(TEMPLATE_COUNT);
-    TerrainTypes.Set_Heap(TERRAIN_COUNT);
-    OverlayTypes.Set_Heap(OVERLAY_COUNT);
-    SmudgeTypes.Set_Heap(SMUDGE_COUNT);
-
-    HouseTypeClass::Init_Heap();
-    BuildingTypeClass::Init_Heap();
-    AircraftTypeClass::Init_Heap();
-    InfantryTypeClass::Init_Heap();
-    BulletTypeClass::Init_Heap();
-    AnimTypeClass::Init_Heap();
-    UnitTypeClass::Init_Heap();
-    VesselTypeClass::Init_Heap();
-    TemplateTypeClass::Init_Heap();
-    TerrainTypeClass::Init_Heap();
-    OverlayTypeClass::Init_Heap();
-    SmudgeTypeClass::Init_Heap();
+    Init_Type_Heaps();
 
     // Heap init moved here from globals.cpp. ST - 5/20/2019
-    CCPtr<AircraftClass>::Set_Heap(&Aircraft);
-    CCPtr<AnimClass>::Set_Heap(&Anims);
-    CCPtr<BuildingClass>::Set_Heap(&Buildings);
-    CCPtr<BulletClass>::Set_Heap(&Bullets);
-    CCPtr<FactoryClass>::Set_Heap(&Factories);
-    CCPtr<HouseClass>::Set_Heap(&Houses);
-    CCPtr<InfantryClass>::Set_Heap(&Infantry);
-    CCPtr<OverlayClass>::Set_Heap(&Overlays);
-    CCPtr<SmudgeClass>::Set_Heap(&Smudges);
-    CCPtr<TeamClass>::Set_Heap(&Teams);
-    CCPtr<TeamTypeClass>::Set_Heap(&TeamTypes);
-    CCPtr<TemplateClass>::Set_Heap(&Templates);
-    CCPtr<TerrainClass>::Set_Heap(&Terrains);
-    CCPtr<TriggerClass>::Set_Heap(&Triggers);
-    CCPtr<TriggerTypeClass>::Set_Heap(&TriggerTypes);
-
-    CCPtr<HouseTypeClass>::Set_Heap(&HouseTypes);
-    CCPtr<BuildingTypeClass>::Set_Heap(&BuildingTypes);
-    CCPtr<AircraftTypeClass>::Set_Heap(&AircraftTypes);
-    CCPtr<InfantryTypeClass>::Set_Heap(&InfantryTypes);
-    CCPtr<BulletTypeClass>::Set_Heap(&BulletTypes);
-    CCPtr<AnimTypeClass>::Set_Heap(&AnimTypes);
-    CCPtr<UnitTypeClass>::Set_Heap(&UnitTypes);
-    CCPtr<VesselTypeClass>::Set_Heap(&VesselTypes);
-    CCPtr<TemplateTypeClass>::Set_Heap(&TemplateTypes);
-    CCPtr<TerrainTypeClass>::Set_Heap(&TerrainTypes);
-    CCPtr<OverlayTypeClass>::Set_Heap(&OverlayTypes);
-    CCPtr<SmudgeTypeClass>::Set_Heap(&SmudgeTypes);
+    Init_Pointer_Heaps();
 
     /*
     **	Find and process any rules for this game.
     */
-    CCFileClass rulesIniFile("RULES.INI");
-    if (RuleINI.Load(rulesIniFile, false)) {
-        Rule.Process(RuleINI);
-    }
-#ifdef FIXIT_CSII //	checked - ajw 9/28/98
-    //  Aftermath runtime change 9/29/98
-    //	This is safe to do, as only rules for aftermath units are included in this ini.
-    if (Is_Aftermath_Installed() == true) {
-        CCFileClass aftermathIniFile("AFTRMATH.INI");
-        if (AftermathINI.Load(aftermathIniFile, false)) {
-            Rule.Process(AftermathINI);
-        }
-    }
-#endif
+    Init_Rules();
 
     Session.MaxPlayers = Rule.MaxPlayers;
 
@@ -572,6 +520,7 @@ bool Select_Game(bool fade)
         */
         if (Session.Play && Session.RecordFile.Is_Available()) {
             if (Session.RecordFile.Open(READ)) {
+                Session.Recording.Begin_Read(Session.RecordFile);
                 Load_Recording_Values(Session.RecordFile);
                 process = false;
                 Theme.Fade_Out();
@@ -595,13 +544,12 @@ bool Select_Game(bool fade)
                 GamePalette = CCPalette;
 
                 HidPage.Blit(SeenPage);
-                //				if (fade) {
-                //					WhitePalette.Set();
-                //					CCPalette.Set(FADE_PALETTE_SLOW, Call_Back);
-                //					fade = false;
-                //				} else {
-                CCPalette.Set();
-                //				}
+                if (fade) {
+                    CCPalette.Start_Fade(FADE_PALETTE_SLOW);
+                    fade = false;
+                } else {
+                    CCPalette.Set();
+                }
 
                 Set_Logic_Page(SeenBuff);
                 display = false;
@@ -1043,6 +991,7 @@ bool Select_Game(bool fade)
                 if (Session.Attract && Session.RecordFile.Is_Available()) {
                     Session.Play = true;
                     if (Session.RecordFile.Open(READ)) {
+                        Session.Recording.Begin_Read(Session.RecordFile);
                         Load_Recording_Values(Session.RecordFile);
                         process = false;
                         Theme.Fade_Out();
@@ -1082,6 +1031,7 @@ bool Select_Game(bool fade)
     */
     if (Session.Record) {
         if (Session.RecordFile.Open(WRITE)) {
+            Session.Recording.Begin_Write(Session.RecordFile);
             Save_Recording_Values(Session.RecordFile);
         } else {
             Session.Record = false;
@@ -1501,6 +1451,20 @@ bool Parse_Command_Line(int argc, char* argv[])
             continue;
         }
 
+        /*
+        **	Replay snapshot interval in frames (0 turns snapshots off), and a frame to
+        **	seek to as soon as playback starts.
+        */
+        if (strnicmp(string, "-SNAPSHOT:", 10) == 0) {
+            Snapshots.Set_Interval(atoi(string + 10));
+            continue;
+        }
+
+        if (strnicmp(string, "-SEEK:", 6) == 0) {
+            Snapshots.Request_Seek(atoi(string + 6));
+            continue;
+        }
+
 #ifdef CHEAT_KEYS
         /*
         **	Specify the random number seed (for debugging)
@@ -2044,6 +2008,155 @@ static void Init_Heaps(void)
     /*
     **	Initialize the game object heaps.
     */
+    Init_Object_Heaps();
+
+    /*
+    **	Speech holding tank buffer. Since speech does not mix, it can be placed
+    **	into a custom holding tank only as large as the largest speech file to
+    **	be played.
+    */
+    for (int index = 0; index < ARRAY_SIZE(SpeechBuffer); index++) {
+        SpeechBuffer[index] = new char[SPEECH_BUFFER_SIZE];
+        SpeechRecord[index] = VOX_NONE;
+        assert(SpeechBuffer[index] != NULL);
+    }
+
+    /*
+    **	Allocate the theater buffer block.
+    */
+    TheaterBuffer = new Buffer(THEATER_BUFFER_SIZE);
+    assert(TheaterBuffer != NULL);
+}
+
+/***********************************************************************************************
+ * Init_Type_Heaps -- Allocate the heaps of the object type classes.                           *
+ *                                                                                             *
+ *    The type heaps must be in place before the rules file is processed. The type objects     *
+ *    are read-only once the rules have been processed, so every game instance shares them.    *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *============================================================================================*/
+static void Init_Type_Heaps(void)
+{
+    HouseTypes.Set_Heap(HOUSE_COUNT);
+    BuildingTypes.Set_Heap(STRUCT_COUNT);
+    AircraftTypes.Set_Heap(AIRCRAFT_COUNT);
+    InfantryTypes.Set_Heap(INFANTRY_COUNT);
+    BulletTypes.Set_Heap(BULLET_COUNT);
+    AnimTypes.Set_Heap(ANIM_COUNT);
+    UnitTypes.Set_Heap(UNIT_COUNT);
+    VesselTypes.Set_Heap(VESSEL_COUNT);
+    TemplateTypes.Set_Heap(TEMPLATE_COUNT);
+    TerrainTypes.Set_Heap(TERRAIN_COUNT);
+    OverlayTypes.Set_Heap(OVERLAY_COUNT);
+    SmudgeTypes.Set_Heap(SMUDGE_COUNT);
+
+    HouseTypeClass::Init_Heap();
+    BuildingTypeClass::Init_Heap();
+    AircraftTypeClass::Init_Heap();
+    InfantryTypeClass::Init_Heap();
+    BulletTypeClass::Init_Heap();
+    AnimTypeClass::Init_Heap();
+    UnitTypeClass::Init_Heap();
+    VesselTypeClass::Init_Heap();
+    TemplateTypeClass::Init_Heap();
+    TerrainTypeClass::Init_Heap();
+    OverlayTypeClass::Init_Heap();
+    SmudgeTypeClass::Init_Heap();
+}
+
+/***********************************************************************************************
+ * Init_Pointer_Heaps -- Tell the smart pointers which heaps they index into.                  *
+ *                                                                                             *
+ *    CCPtr keeps a static pointer to the heap of each class it can refer to. When several     *
+ *    game instances run in one process this pointer is per thread, so every instance thread   *
+ *    must call this before it touches a game object.                                          *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *============================================================================================*/
+static void Init_Pointer_Heaps(void)
+{
+    CCPtr<AircraftClass>::Set_Heap(&Aircraft);
+    CCPtr<AnimClass>::Set_Heap(&Anims);
+    CCPtr<BuildingClass>::Set_Heap(&Buildings);
+    CCPtr<BulletClass>::Set_Heap(&Bullets);
+    CCPtr<FactoryClass>::Set_Heap(&Factories);
+    CCPtr<HouseClass>::Set_Heap(&Houses);
+    CCPtr<InfantryClass>::Set_Heap(&Infantry);
+    CCPtr<OverlayClass>::Set_Heap(&Overlays);
+    CCPtr<SmudgeClass>::Set_Heap(&Smudges);
+    CCPtr<TeamClass>::Set_Heap(&Teams);
+    CCPtr<TeamTypeClass>::Set_Heap(&TeamTypes);
+    CCPtr<TemplateClass>::Set_Heap(&Templates);
+    CCPtr<TerrainClass>::Set_Heap(&Terrains);
+    CCPtr<TriggerClass>::Set_Heap(&Triggers);
+    CCPtr<TriggerTypeClass>::Set_Heap(&TriggerTypes);
+
+    CCPtr<HouseTypeClass>::Set_Heap(&HouseTypes);
+    CCPtr<BuildingTypeClass>::Set_Heap(&BuildingTypes);
+    CCPtr<AircraftTypeClass>::Set_Heap(&AircraftTypes);
+    CCPtr<InfantryTypeClass>::Set_Heap(&InfantryTypes);
+    CCPtr<BulletTypeClass>::Set_Heap(&BulletTypes);
+    CCPtr<AnimTypeClass>::Set_Heap(&AnimTypes);
+    CCPtr<UnitTypeClass>::Set_Heap(&UnitTypes);
+    CCPtr<VesselTypeClass>::Set_Heap(&VesselTypes);
+    CCPtr<TemplateTypeClass>::Set_Heap(&TemplateTypes);
+    CCPtr<TerrainTypeClass>::Set_Heap(&TerrainTypes);
+    CCPtr<OverlayTypeClass>::Set_Heap(&OverlayTypes);
+    CCPtr<SmudgeTypeClass>::Set_Heap(&SmudgeTypes);
+}
+
+/***********************************************************************************************
+ * Init_Rules -- Find and process the rules files.                                             *
+ *                                                                                             *
+ *    Loads RULES.INI, and AFTRMATH.INI when the expansion is installed, into the global       *
+ *    rules and the object type classes.                                                       *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *============================================================================================*/
+static void Init_Rules(void)
+{
+    CCFileClass rulesIniFile("RULES.INI");
+    if (RuleINI.Load(rulesIniFile, false)) {
+        Rule.Process(RuleINI);
+    }
+#ifdef FIXIT_CSII //	checked - ajw 9/28/98
+    //  Aftermath runtime change 9/29/98
+    //	This is safe to do, as only rules for aftermath units are included in this ini.
+    if (Is_Aftermath_Installed() == true) {
+        CCFileClass aftermathIniFile("AFTRMATH.INI");
+        if (AftermathINI.Load(aftermathIniFile, false)) {
+            Rule.Process(AftermathINI);
+        }
+    }
+#endif
+}
+
+/***********************************************************************************************
+ * Init_Object_Heaps -- Size the heaps that hold the game objects.                             *
+ *                                                                                             *
+ *    The heap sizes come from the rules.                                                      *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The rules must have been processed.                                             *
+ *============================================================================================*/
+static void Init_Object_Heaps(void)
+{
     Vessels.Set_Heap(Rule.VesselMax);
     Units.Set_Heap(Rule.UnitMax);
     Factories.Set_Heap(Rule.FactoryMax);
@@ -2062,23 +2175,104 @@ static void Init_Heaps(void)
     Houses.Set_Heap(HOUSE_MAX);
     TriggerTypes.Set_Heap(Rule.TrigTypeMax);
     //	Weapons.Set_Heap(Rule.WeaponMax);
+}
 
-    /*
-    **	Speech holding tank buffer. Since speech does not mix, it can be placed
-    **	into a custom holding tank only as large as the largest speech file to
-    **	be played.
-    */
-    for (int index = 0; index < ARRAY_SIZE(SpeechBuffer); index++) {
-        SpeechBuffer[index] = new char[SPEECH_BUFFER_SIZE];
-        SpeechRecord[index] = VOX_NONE;
-        assert(SpeechBuffer[index] != NULL);
+/***********************************************************************************************
+ * Init_Type_One_Time -- One-time initialization of the object type classes.                   *
+ *                                                                                             *
+ *    Fetches the shapes and other data the type classes refer to.                             *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   The bulk data must have been cached.                                            *
+ *============================================================================================*/
+static void Init_Type_One_Time(void)
+{
+    ObjectTypeClass::One_Time();
+    BuildingTypeClass::One_Time();
+    BulletTypeClass::One_Time();
+    HouseTypeClass::One_Time();
+    TemplateTypeClass::One_Time();
+    OverlayTypeClass::One_Time();
+    SmudgeTypeClass::One_Time();
+    TerrainTypeClass::One_Time();
+    UnitTypeClass::One_Time();
+    VesselTypeClass::One_Time();
+    InfantryTypeClass::One_Time();
+    AnimTypeClass::One_Time();
+    AircraftTypeClass::One_Time();
+}
+
+/***********************************************************************************************
+ * Init_Headless_Game -- Initialize the shared game data without any user interface.           *
+ *                                                                                             *
+ *    This performs the part of Init_Game that a headless game needs: the mixfiles, the        *
+ *    language strings, the rules and the object type classes. The mouse, video, fonts and     *
+ *    movies are left alone. Everything set up here is shared by all game instances in the     *
+ *    process and must be treated as read-only afterwards.                                     *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the game data found?                                                     *
+ *                                                                                             *
+ * WARNINGS:   Call once, before any game instance is started.                                 *
+ *============================================================================================*/
+bool Init_Headless_Game(void)
+{
+    Init_Keys();
+
+    if (CCFileClass::Is_There_Search_Drives()) {
+        RequiredCD = -2;
     }
 
-    /*
-    **	Allocate the theater buffer block.
-    */
+    Init_Bootstrap_Mixfiles();
+    Init_Secondary_Mixfiles();
+
+    SystemStrings = (char const*)MFCD::Retrieve(Language_Name("CONQUER"));
+    DebugStrings = (char const*)MFCD::Retrieve("DEBUG.ENG");
+    if (SystemStrings == NULL) {
+        return (false);
+    }
+
+    Init_Type_Heaps();
+    Init_Pointer_Heaps();
+    Init_Rules();
+
     TheaterBuffer = new Buffer(THEATER_BUFFER_SIZE);
     assert(TheaterBuffer != NULL);
+
+    MFCD::Cache("CONQUER.MIX");
+    Init_Type_One_Time();
+
+    return (true);
+}
+
+/***********************************************************************************************
+ * Init_Game_Instance -- Initialize the state owned by a single game instance.                 *
+ *                                                                                             *
+ *    Sets up the object heaps, the map and the other systems that every running match         *
+ *    keeps its own copy of. Init_Game does this for the one match of the normal game, a       *
+ *    headless instance calls this on its own thread after Init_Headless_Game.                 *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Call once per instance thread.                                                  *
+ *============================================================================================*/
+void Init_Game_Instance(void)
+{
+    Init_Pointer_Heaps();
+    Init_Object_Heaps();
+
+    Session.MaxPlayers = Rule.MaxPlayers;
+
+    Map.One_Time();
+    Logic.One_Time();
+    Session.One_Time();
+    HouseClass::One_Time();
 }
 
 /***********************************************************************************************
@@ -2175,19 +2369,7 @@ static void Init_One_Time_Systems(void)
     Options.One_Time();
     Session.One_Time();
 
-    ObjectTypeClass::One_Time();
-    BuildingTypeClass::One_Time();
-    BulletTypeClass::One_Time();
-    HouseTypeClass::One_Time();
-    TemplateTypeClass::One_Time();
-    OverlayTypeClass::One_Time();
-    SmudgeTypeClass::One_Time();
-    TerrainTypeClass::One_Time();
-    UnitTypeClass::One_Time();
-    VesselTypeClass::One_Time();
-    InfantryTypeClass::One_Time();
-    AnimTypeClass::One_Time();
-    AircraftTypeClass::One_Time();
+    Init_Type_One_Time();
     HouseClass::One_Time();
 }
 
@@ -968,7 +968,7 @@ inline bool Percent_Chance(int percent)
  * HISTORY:                                                                                    *
  *   09/30/1996 JLB : Created.                                                                 *
  *=============================================================================================*/
-extern RandomClass NonCriticalRandomNumber;
+extern INSTANCE_LOCAL RandomClass NonCriticalRandomNumber;
 template <class T> inline T Sim_Random_Pick(T a, T b)
 {
     return T(NonCriticalRandomNumber((int)a, (int)b));
@@ -0,0 +1,223 @@
+#include <mutex>
+
+#include "function.h"
+#include "instance.h"
+
+extern void Set_Resfactor_Globals(int resfactor);
+
+INSTANCE_LOCAL GameInstanceClass* GameInstanceClass::CurrentInstance = nullptr;
+INSTANCE_LOCAL bool GameInstanceClass::IsThreadReady = false;
+
+/*
+** Reading a scenario reprocesses the scenario's rule overrides into the shared Rule object and
+** touches the shared mixfile cache, so only one instance may be loading at any time. This does
+** not keep a load away from instances that are stepping, the caller has to do that.
+*/
+static std::mutex LoadMutex;
+
+GameInstanceClass::GameInstanceClass(int id)
+    : ID(id)
+    , FrameCount(0)
+    , IsRunning(false)
+{
+}
+
+GameInstanceClass::~GameInstanceClass(void)
+{
+    if (IsRunning && CurrentInstance == this) {
+        Stop();
+    }
+}
+
+/***********************************************************************************************
+ * GameInstanceClass::Init -- Loads the data shared by every instance.                         *
+ *                                                                                             *
+ *    Nothing is drawn, but parts of the map code expect the pages to exist, so they are set  *
+ *    up without any memory behind them.                                                       *
+ *                                                                                             *
+ * INPUT:   program  -- The path the program was started from, argv[0].                        *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the game data loaded?                                                    *
+ *                                                                                             *
+ * WARNINGS:   Call this once, from the main thread, before any instance is started.           *
+ *=============================================================================================*/
+bool GameInstanceClass::Init(char const* program)
+{
+    Paths.Init("vanillara", CONFIG_FILE_NAME, "REDALERT.MIX", program);
+    CDFileClass::Refresh_Search_Drives();
+    WinTimerClass::Init(60);
+    Set_Resfactor_Globals(RESFACTOR);
+
+    VisiblePage.Init(ScreenWidth, ScreenHeight, NULL, 0, (GBC_Enum)0);
+    HiddenPage.Init(ScreenWidth, ScreenHeight, NULL, 0, (GBC_Enum)0);
+    SeenBuff.Attach(&VisiblePage, 0, 0, ScreenWidth, ScreenHeight);
+    HidPage.Attach(&HiddenPage, 0, 0, ScreenWidth, ScreenHeight);
+
+    return (Init_Headless_Game());
+}
+
+/***********************************************************************************************
+ * GameInstanceClass::Start -- Loads a skirmish scenario into this thread's instance.           *
+ *                                                                                             *
+ *    The local house is handed to the computer straight away so every side in the match is   *
+ *    played by the AI. Init_Headless_Game must have been called once before any instance is  *
+ *    started.                                                                                 *
+ *                                                                                             *
+ * INPUT:   scenario   -- Scenario file name, eg "SCM01EA.INI".                                *
+ *                                                                                             *
+ *          ai_players -- Number of computer opponents besides the local house.                *
+ *                                                                                             *
+ *          seed       -- Random seed for the match.                                           *
+ *                                                                                             *
+ *          house      -- The country the local house plays as.                                *
+ *                                                                                             *
+ *          rules      -- Optional INI file of rule overrides, applied over the scenario's      *
+ *                        before any of its objects are created.                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the scenario loaded?                                                     *
+ *                                                                                             *
+ * WARNINGS:   The instance is bound to the calling thread from here on. The rules are shared  *
+ *             by every instance and loading rewrites them, so instances running side by side  *
+ *             must use the same scenario and overrides and all be started before any steps.   *
+ *=============================================================================================*/
+bool GameInstanceClass::Start(char const* scenario, int ai_players, int seed, HousesType house, char const* rules)
+{
+    std::lock_guard<std::mutex> lock(LoadMutex);
+
+    CurrentInstance = this;
+
+    if (!IsThreadReady) {
+        Init_Game_Instance();
+        IsThreadReady = true;
+    }
+
+    Session.Type = GAME_SKIRMISH;
+    Session.Options.AIPlayers = ai_players;
+    Session.NumPlayers = 1;
+
+    while (Session.Players.Count() > 0) {
+        delete Session.Players[0];
+        Session.Players.Delete(Session.Players[0]);
+    }
+
+    NodeNameType* who = new NodeNameType;
+    sprintf(who->Name, "Instance %d", ID);
+    who->Player.House = house;
+    who->Player.Color = PCOLOR_GOLD;
+    Session.Players.Add(who);
+
+    Seed = seed;
+    Scen.RandomNumber = seed;
+
+    strncpy(Scen.ScenarioName, scenario, sizeof(Scen.ScenarioName) - 1);
+    Scen.ScenarioName[sizeof(Scen.ScenarioName) - 1] = '\0';
+
+    CCINIClass overrides;
+    if (rules != nullptr && rules[0] != '\0') {
+        CCFileClass file(rules);
+        if (!overrides.Load(file, false)) {
+            DBG_INFO("GameInstanceClass::Start - instance %d failed to load rules %s", ID, rules);
+            return (false);
+        }
+        RuleOverrideINI = &overrides;
+    }
+
+    bool loaded = Read_Scenario(Scen.ScenarioName);
+    RuleOverrideINI = nullptr;
+
+    if (!loaded) {
+        DBG_INFO("GameInstanceClass::Start - instance %d failed to load %s", ID, Scen.ScenarioName);
+        return (false);
+    }
+
+    /*
+    **	Let the computer take over the local house, starting with deploying its MCVs.
+    */
+    PlayerPtr->IsHuman = false;
+    PlayerPtr->IQ = Rule.MaxIQ;
+    PlayerPtr->IsBaseBuilding = true;
+
+    for (TechnoClass* techno = PlayerPtr->First_Owned(RTTI_UNIT, UNIT_MCV); techno != nullptr;
+         techno = techno->TypeNext) {
+        if (!techno->IsInLimbo) {
+            techno->Assign_Mission(MISSION_UNLOAD);
+            techno->Commence();
+        }
+    }
+
+    FrameCount = 0;
+    Frame = 0;
+    GameActive = true;
+    IsRunning = true;
+    return (true);
+}
+
+/***********************************************************************************************
+ * GameInstanceClass::Step -- Advances the match by one logic frame.                           *
+ *                                                                                             *
+ *    This is the simulation half of Main_Loop, without any rendering, sound or input.         *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  bool; Is the match still running?                                                  *
+ *                                                                                             *
+ * WARNINGS:   Must be called from the thread that started the instance.                       *
+ *=============================================================================================*/
+bool GameInstanceClass::Step(void)
+{
+    if (!IsRunning) {
+        return (false);
+    }
+
+    TimeQuake = PendingTimeQuake;
+    PendingTimeQuake = false;
+
+    DisplayClass::Layer[LAYER_GROUND].Sort();
+
+    Logic.AI();
+    TimeQuake = false;
+    if (!PendingTimeQuake) {
+        TimeQuakeCenter = 0;
+    }
+
+    Queue_AI();
+
+    Frame++;
+    FrameCount++;
+
+    if (PlayerWins || PlayerLoses || PlayerRestarts || !GameActive) {
+        IsRunning = false;
+    }
+    return (IsRunning);
+}
+
+/***********************************************************************************************
+ * GameInstanceClass::Stop -- Releases the match so the thread can start another.              *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Must be called from the thread that started the instance.                       *
+ *=============================================================================================*/
+void GameInstanceClass::Stop(void)
+{
+    std::lock_guard<std::mutex> lock(LoadMutex);
+
+    Clear_Scenario();
+
+    while (Session.Players.Count() > 0) {
+        delete Session.Players[0];
+        Session.Players.Delete(Session.Players[0]);
+    }
+
+    PlayerWins = false;
+    PlayerLoses = false;
+    PlayerRestarts = false;
+    GameActive = false;
+    IsRunning = false;
+
+    if (CurrentInstance == this) {
+        CurrentInstance = nullptr;
+    }
+}
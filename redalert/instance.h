@@ -0,0 +1,61 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include "common/gamelocal.h"
+
+/***********************************************************************************************
+**	A single running match. The simulation state of a match (the object heaps, the map, the
+**	scenario, the session, the event queues and the random number generators) is declared
+**	INSTANCE_LOCAL, so in builds that define GAME_INSTANCES each thread holds the state of
+**	the one instance it runs. The mixfiles, rules and object type classes are loaded once by
+**	Init_Headless_Game and are shared, read-only, by every instance.
+**
+**	An instance is bound to the thread that starts it and must only be stepped from there.
+*/
+class GameInstanceClass
+{
+public:
+    GameInstanceClass(int id);
+    ~GameInstanceClass(void);
+
+    static bool Init(char const* program);
+
+    bool Start(char const* scenario,
+               int ai_players,
+               int seed,
+               HousesType house = HOUSE_GREECE,
+               char const* rules = nullptr);
+    bool Step(void);
+    void Stop(void);
+
+    int Get_ID(void) const
+    {
+        return (ID);
+    };
+    int Frames(void) const
+    {
+        return (FrameCount);
+    };
+    bool Is_Running(void) const
+    {
+        return (IsRunning);
+    };
+
+    /*
+    **	The instance running on the calling thread, or NULL.
+    */
+    static GameInstanceClass* Current(void)
+    {
+        return (CurrentInstance);
+    };
+
+private:
+    int ID;
+    int FrameCount;
+    bool IsRunning;
+
+    static INSTANCE_LOCAL GameInstanceClass* CurrentInstance;
+    static INSTANCE_LOCAL bool IsThreadReady;
+};
+
+#endif
@@ -291,6 +291,7 @@ bool MouseClass::Load(Straw& file)
             return (false);
         }
     }
+    Cell_Tables_Reset();
 
     LastTheater = Scen.Theater;
     return (true);
@@ -544,6 +544,15 @@ void HouseClass::Decode_Pointers(void)
     */
 
     Init_Data(RemapColor, ActLike, Credits);
+
+    /*
+    ** The region threat field isn't saved with the house, rebuild it from the threat that is.
+    ** Its decayed layer was already restored by Load_Misc_Values.
+    */
+    RegionThreatClass& field = Threat_Field();
+    for (int region = 0; region < MAP_TOTAL_REGIONS; region++) {
+        field.Set(region, Regions[region].Threat_Value());
+    }
 }
 
 /***********************************************************************************************
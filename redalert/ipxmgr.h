@@ -222,6 +222,17 @@ public:
     unsigned int Global_Response_Time(void);
     virtual void Reset_Response_Time(void);
 
+    /*.....................................................................
+    Per-connection latency statistics.  With no connection ID given, these
+    report the worst value of all connections (or, for the stall count,
+    the total).
+    .....................................................................*/
+    virtual unsigned int Smooth_Response_Time(int id = CONNECTION_NONE);
+    virtual unsigned int Response_Jitter(int id = CONNECTION_NONE);
+    virtual unsigned int Response_Percentile(int percent, int id = CONNECTION_NONE);
+    virtual void Add_Stall(int id, unsigned int ticks);
+    virtual unsigned int Stall_Count(int id = CONNECTION_NONE);
+
     /*.....................................................................
     This routine returns a pointer to the oldest non-ACK'd buffer I've sent.
     .....................................................................*/
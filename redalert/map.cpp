@@ -31,6 +31,7 @@
  *---------------------------------------------------------------------------------------------*
  * Functions:                                                                                  *
  *   MapClass::Base_Region -- Finds the owner and base zone for specified cell.                *
+ *   MapClass::Area_Threat -- Sums the threat a house sees around a cell.                      *
  *   MapClass::Cell_Region -- Determines the region from a specified cell number.              *
  *   MapClass::Cell_Threat -- Gets a houses threat value for a cell                            *
  *   MapClass::Close_Object -- Finds a clickable close object to the specified coordinate.     *
@@ -56,6 +57,8 @@
  *   MapClass::Write_Binary -- Pipes the map template data to the destination specified.       *
  *   MapClass::Zone_Reset -- Resets all zone numbers to match the map.                         *
  *   MapClass::Zone_Span -- Flood fills the specified zone from the cell origin.               *
+ *   MapClass::Cell_Tables_Reset -- Copies every cell into the cell tables.                    *
+ *   MapClass::Cell_Query -- Builds a cell table query matching Is_Clear_To_Move.              *
  *   MapClass::Pick_Random_Location -- Picks a random location on the map.                     *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
@@ -518,6 +521,7 @@ void MapClass::Init_Cells(void)
     for (int index = 0; index < MAP_CELL_TOTAL; index++) {
         new (&Array[index]) CellClass;
     }
+    Cell_Tables_Reset();
 }
 
 /***********************************************************************************************
@@ -1432,6 +1436,43 @@ void MapClass::Logic(void)
     }
 }
 
+/***********************************************************************************************
+ * MapClass::Area_Threat -- Sums the threat a house sees around a cell.                        *
+ *                                                                                             *
+ *    This totals the region threat over the regions within the given range of a cell. The     *
+ *    regions are summed as a block, so the cost does not depend on the range. Use it where    *
+ *    checking the threat cell by cell would be too slow.                                      *
+ *                                                                                             *
+ * INPUT:   cell     -- The cell at the center of the area.                                    *
+ *                                                                                             *
+ *          range    -- The distance in cells to cover. It is rounded up to whole regions.     *
+ *                                                                                             *
+ *          house    -- The house whose view of the threat is wanted.                          *
+ *                                                                                             *
+ *          decayed  -- Use the decayed threat, which also remembers recent threat?            *
+ *                                                                                             *
+ * OUTPUT:  Returns with the total threat in the area.                                         *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int MapClass::Area_Threat(CELL cell, int range, HousesType house, bool decayed)
+{
+    HouseClass* hptr = HouseClass::As_Pointer(house);
+    if (hptr == NULL) {
+        return (0);
+    }
+
+    int region = Cell_Region(cell);
+    int x = region % MAP_REGION_WIDTH;
+    int y = region / MAP_REGION_WIDTH;
+    int radius = (range + REGION_WIDTH - 1) / REGION_WIDTH;
+
+    if (decayed) {
+        return (hptr->Threat_Field().Heat_Radius_Sum(x, y, radius));
+    }
+    return (hptr->Threat_Field().Radius_Sum(x, y, radius));
+}
+
 /***********************************************************************************************
  * MapClass::Cell_Region -- Determines the region from a specified cell number.                *
  *                                                                                             *
@@ -1806,15 +1847,19 @@ bool MapClass::Zone_Reset(int method)
     for (int index = 0; index < MAP_CELL_TOTAL; index++) {
         if (method & MZONEF_NORMAL) {
             Array[index].Zones[MZONE_NORMAL] = 0;
+            CellTables.Set_Zone(index, MZONE_NORMAL, 0);
         }
         if (method & MZONEF_CRUSHER) {
             Array[index].Zones[MZONE_CRUSHER] = 0;
+            CellTables.Set_Zone(index, MZONE_CRUSHER, 0);
         }
         if (method & MZONEF_DESTROYER) {
             Array[index].Zones[MZONE_DESTROYER] = 0;
+            CellTables.Set_Zone(index, MZONE_DESTROYER, 0);
         }
         if (method & MZONEF_WATER) {
             Array[index].Zones[MZONE_WATER] = 0;
+            CellTables.Set_Zone(index, MZONE_WATER, 0);
         }
     }
 
@@ -1907,14 +1952,18 @@ int MapClass::Zone_Span(CELL cell, int zone, MZoneType check)
         return (0);
     }
 
+    /*
+    **	A candidate cell is one that is clear to move through and has no zone yet, which
+    **	is a query for zone 0.
+    */
+    CellQueryType query = Cell_Query(check == MZONE_WATER ? SPEED_FLOAT : SPEED_TRACK, true, true, 0, check);
+
     /*
     **	Find the full extent of the current span by first scanning leftward
     **	until a boundary is reached.
     */
     for (; xbegin >= MapCellX; xbegin--) {
-        CellClass* cellptr = &(*this)[XY_Cell(xbegin, y)];
-        if (cellptr->Zones[check] != 0
-            || (!cellptr->Is_Clear_To_Move(check == MZONE_WATER ? SPEED_FLOAT : SPEED_TRACK, true, true, -1, check))) {
+        if (!CellTables.Is_Clear(XY_Cell(xbegin, y), query)) {
 
             /*
             **	Special short circuit code to bail from this entire routine if
@@ -1939,9 +1988,7 @@ int MapClass::Zone_Span(CELL cell, int zone, MZoneType check)
     **	extent of the current span.
     */
     for (; xend < MapCellX + MapCellWidth; xend++) {
-        CellClass* cellptr = &(*this)[XY_Cell(xend, y)];
-        if (cellptr->Zones[check] != 0
-            || (!cellptr->Is_Clear_To_Move(check == MZONE_WATER ? SPEED_FLOAT : SPEED_TRACK, true, true, -1, check))) {
+        if (!CellTables.Is_Clear(XY_Cell(xend, y), query)) {
             xend--;
             break;
         }
@@ -1954,6 +2001,7 @@ int MapClass::Zone_Span(CELL cell, int zone, MZoneType check)
     */
     for (int x = xbegin; x <= xend; x++) {
         (*this)[XY_Cell(x, y)].Zones[check] = zone;
+        CellTables.Set_Zone(XY_Cell(x, y), check, zone);
         filled++;
     }
 
@@ -1962,15 +2010,133 @@ int MapClass::Zone_Span(CELL cell, int zone, MZoneType check)
     **	candidate cells, then recursively call the span process for them. Take
     **	note that the adjacent span scanning starts one cell wider on each
     **	end of the scan. This is necessary because diagonals are considered
-    **	adjacent.
+    **	adjacent. Each shadow row is tested in one pass and only its candidate
+    **	cells are visited. Filling a span can only take cells away from the
+    **	candidates, which the recursive call checks for again.
     */
-    for (int x = xbegin - 1; x <= xend; x++) {
-        filled += Zone_Span(XY_Cell(x, y - 1), zone, check);
-        filled += Zone_Span(XY_Cell(x, y + 1), zone, check);
+    int first = max(xbegin - 1, MapCellX);
+    int count = xend - first + 1;
+
+    for (int row = y - 1; row <= y + 1; row += 2) {
+        if (row < MapCellY || row >= MapCellY + MapCellHeight) {
+            continue;
+        }
+
+        static INSTANCE_LOCAL unsigned char _clear[MAP_CELL_W];
+        unsigned candidates[MAP_CELL_W / 32] = {0};
+        if (CellTables.Clear_Row(XY_Cell(first, row), count, query, _clear) == 0) {
+            continue;
+        }
+        for (int index = 0; index < count; index++) {
+            candidates[index / 32] |= (unsigned)_clear[index] << (index % 32);
+        }
+
+        for (int index = 0; index < count; index++) {
+            if (candidates[index / 32] & (1U << (index % 32))) {
+                filled += Zone_Span(XY_Cell(first + index, row), zone, check);
+            }
+        }
     }
     return (filled);
 }
 
+/***********************************************************************************************
+ * MapClass::Cell_Tables_Reset -- Copies every cell into the cell tables.                      *
+ *                                                                                             *
+ *    This brings the whole of the CellTables up to date with the map cells, zones included.   *
+ *    It is used after the cells have been created or loaded wholesale, individual changes     *
+ *    are copied over by the cell as they happen.                                              *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void MapClass::Cell_Tables_Reset(void)
+{
+    for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
+        CellClass const& cellptr = (*this)[cell];
+
+        cellptr.Update_Cell_Tables();
+        for (MZoneType zone = MZONE_FIRST; zone < MZONE_COUNT; zone++) {
+            CellTables.Set_Zone(cell, zone, cellptr.Zones[zone]);
+        }
+    }
+}
+
+/***********************************************************************************************
+ * MapClass::Cell_Query -- Builds a cell table query matching Is_Clear_To_Move.                *
+ *                                                                                             *
+ *    Cell table queries test a cell the same way CellClass::Is_Clear_To_Move does, but from   *
+ *    the dense CellTables so that whole rows can be tested at once. This builds the query     *
+ *    for the given Is_Clear_To_Move parameters.                                               *
+ *                                                                                             *
+ * INPUT:   loco           -- The locomotion type to check against.                            *
+ *                                                                                             *
+ *          ignoreinfantry -- Should infantry in the cell be ignored?                          *
+ *                                                                                             *
+ *          ignorevehicles -- Should vehicles and buildings in the cell be ignored?            *
+ *                                                                                             *
+ *          zone           -- The zone a cell must be in, or -1 for any zone.                  *
+ *                                                                                             *
+ *          check          -- The zone type to check against.                                  *
+ *                                                                                             *
+ * OUTPUT:  Returns with the query to pass to the CellTables.                                  *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+CellQueryType MapClass::Cell_Query(SpeedType loco, bool ignoreinfantry, bool ignorevehicles, int zone, MZoneType check)
+    const
+{
+    CellQueryType query;
+
+    /*
+    **	Flying objects consider every cell passable.
+    */
+    if (loco == SPEED_WINGED) {
+        query.LandMask = ~0U;
+        query.Blocking = 0;
+        query.WallLimit = CELLWALL_SOLID;
+        query.ZoneType = MZONE_NORMAL;
+        query.Zone = -1;
+        return (query);
+    }
+
+    query.LandMask = 0;
+    for (LandType land = LAND_FIRST; land < LAND_COUNT; land++) {
+        if (::Ground[land].Cost[loco] != 0) {
+            query.LandMask |= 1U << land;
+        }
+    }
+
+    query.Blocking = 0xFF;
+    if (ignoreinfantry) {
+        query.Blocking &= 0xE0; // Drop the infantry occupation bits.
+    }
+    if (ignorevehicles) {
+        query.Blocking &= 0x5F; // Drop the vehicle/building bit.
+    }
+
+    switch (check) {
+    case MZONE_DESTROYER:
+        query.WallLimit = CELLWALL_SOLID;
+        break;
+
+    case MZONE_CRUSHER:
+        query.WallLimit = CELLWALL_CRUSHABLE;
+        break;
+
+    default:
+        query.WallLimit = CELLWALL_NONE;
+        break;
+    }
+
+    query.ZoneType = check;
+    query.Zone = zone;
+    return (query);
+}
+
 /***********************************************************************************************
  * MapClass::Nearby_Location -- Finds a generally clear location near a specified cell.        *
  *                                                                                             *
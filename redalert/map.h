@@ -37,6 +37,7 @@
 
 #include "gscreen.h"
 #include "crate.h"
+#include "common/celltable.h"
 
 class MapClass : public GScreenClass
 {
@@ -75,6 +76,7 @@ public:
     virtual void Detach(ObjectClass*){};
     int Cell_Region(CELL cell);
     int Cell_Threat(CELL cell, HousesType house);
+    int Area_Threat(CELL cell, int range, HousesType house, bool decayed = false);
     bool In_Radar(CELL cell) const;
     void Sight_From(CELL cell, int sightrange, HouseClass* house, bool incremental = false);
     void Jam_From(CELL cell, int jamrange, HouseClass* house);
@@ -91,6 +93,12 @@ public:
     bool Zone_Reset(int method);
     bool Zone_Cell(CELL cell, int zone);
     int Zone_Span(CELL cell, int zone, MZoneType check);
+    void Cell_Tables_Reset(void);
+    CellQueryType Cell_Query(SpeedType loco,
+                             bool ignoreinfantry,
+                             bool ignorevehicles,
+                             int zone = -1,
+                             MZoneType check = MZONE_NORMAL) const;
     bool Destroy_Bridge_At(CELL cell);
     void Detach(TARGET target, bool all = true);
     void Shroud_The_Map(HouseClass* house);
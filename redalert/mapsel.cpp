@@ -149,7 +149,7 @@ char const* Map_Selection(void)
 
     Keyboard->Clear();
     SeenPage.Clear();
-    mappalette.Set(FADE_PALETTE_FAST, Call_Back);
+    mappalette.Start_Fade(FADE_PALETTE_FAST);
 
     pseudoseenbuff->Clear();
     Animate_Frame(anim, *pseudoseenbuff, 1);
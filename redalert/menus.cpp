@@ -743,7 +743,9 @@ int Main_Menu(unsigned int)
             **	Load the background picture.
             */
             Load_Title_Page();
-            CCPalette.Set();
+            if (!Palette_Fade_Active()) {
+                CCPalette.Set();
+            }
 
             /*
             **	Display the title and text overlay for the menu.
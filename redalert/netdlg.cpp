@@ -93,6 +93,7 @@
 
 #include "function.h"
 #include "common/framelimit.h"
+#include "common/tickwait.h"
 #include "colrlist.h"
 #include "cheklist.h"
 #include "drop.h"
@@ -2357,6 +2358,7 @@ static int Net_Join_Dialog(void)
         starttime = TickCount;
         while (TickCount - starttime < (unsigned)i) {
             Ipx.Service();
+            Wait_For_Tick(WAKE_NETWORK);
         }
     }
 
@@ -4130,6 +4132,7 @@ static int Net_New_Dialog(void)
             i = max(Ipx.Global_Response_Time() * 2, 60);
             while ((int)TickCount - ok_timer < i) {
                 Ipx.Service();
+                Wait_For_Tick(WAKE_NETWORK);
             }
 
             //...............................................................
@@ -5760,6 +5763,7 @@ static int Net_Fake_New_Dialog(void)
                 i = MAX((int)Ipx.Global_Response_Time() * 2, 60 * 2);
                 while ((int)TickCount - ok_timer < i) {
                     Ipx.Service();
+                    Wait_For_Tick(WAKE_NETWORK);
                 }
 
                 //...............................................................
@@ -6075,6 +6079,7 @@ static int Net_Fake_New_Dialog(void)
     int starttime = TickCount;
     while ((int)TickCount - starttime < i) {
         Ipx.Service();
+        Wait_For_Tick(WAKE_NETWORK);
     }
 
     //------------------------------------------------------------------------
@@ -6959,6 +6964,7 @@ static int Net_Fake_Join_Dialog(void)
         starttime = TickCount;
         while (TickCount - starttime < (unsigned)i) {
             Ipx.Service();
+            Wait_For_Tick(WAKE_NETWORK);
         }
     }
 
@@ -44,7 +44,7 @@
 #include "lcwstraw.h"
 #include "xpipe.h"
 
-HousesType OverlayClass::ToOwn = HOUSE_NONE;
+INSTANCE_LOCAL HousesType OverlayClass::ToOwn = HOUSE_NONE;
 
 /***********************************************************************************************
  * OverlayClass::Init -- Resets the overlay object system.                                     *
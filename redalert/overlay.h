@@ -108,7 +108,7 @@ private:
     **	set to a valid house number, then the cell that the overlay is marked down
     **	upon will be flagged as being owned by the specified house.
     */
-    static HousesType ToOwn;
+    static INSTANCE_LOCAL HousesType ToOwn;
 
     /*
     ** Some additional padding in case we need to add data to the class and maintain backwards compatibility for
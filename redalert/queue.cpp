@@ -41,12 +41,16 @@
  * Main Multiplayer Queue Logic:															*
  *   Wait_For_Players -- Waits for other systems to come on-line           *
  *   Generate_Timing_Event -- computes & queues a RESPONSE_TIME event      *
+ *   Generate_Real_Timing_Event -- Generates a TIMING event                *
+ *   Retry_Delta -- computes the connection retry time                     *
+ *   Log_Connection_Stats -- logs each connection's latency statistics     *
  *   Process_Send_Period -- timing for sending packets every 'n' frames    *
  *   Send_Packets -- sends out events from the OutList                     *
  *   Send_FrameSync -- Sends a FRAMESYNC packet                            *
  *   Process_Receive_Packet -- processes an incoming packet                *
  *   Process_Serial_Packet -- Handles an incoming serial packet            *
  *   Can_Advance -- determines if it's OK to advance to the next frame     *
+ *   Stalled_Connections -- finds the connections holding us back          *
  *   Process_Reconnect_Dialog -- processes the reconnection dialog         *
  *   Handle_Timeout -- attempts to reconnect; if fails, bails.             *
  *   Stop_Game -- stops the game															*
@@ -111,6 +115,11 @@ int NetMonoMode = 1;
 int NewMonoMode = 1;
 static int IsMono = 0;
 
+//...........................................................................
+// Total frame-sync stalls as of the last TIMING event we generated.
+//...........................................................................
+static unsigned int LastStallCount = 0;
+
 //---------------------------------------------------------------------------
 // Several routines return various codes; here's an enum for all of them.
 //---------------------------------------------------------------------------
@@ -150,6 +159,8 @@ static RetcodeType Wait_For_Players(int first_time,
 static void Generate_Timing_Event(ConnManClass* net, int my_sent);
 static void Generate_Real_Timing_Event(ConnManClass* net, int my_sent);
 static void Generate_Process_Time_Event(ConnManClass* net);
+static unsigned int Retry_Delta(ConnManClass* net);
+static void Log_Connection_Stats(ConnManClass* net);
 static int Process_Send_Period(ConnManClass* net); //, int init);
 static int Send_Packets(ConnManClass* net, char* multi_packet_buf, int multi_packet_max, int max_ahead, int my_sent);
 static void Send_FrameSync(ConnManClass* net, int cmd_count);
@@ -163,6 +174,11 @@ static RetcodeType Process_Receive_Packet(ConnManClass* net,
 static RetcodeType Process_Serial_Packet(char* multi_packet_buf, int first_time);
 static int
 Can_Advance(ConnManClass* net, int max_ahead, int* their_frame, unsigned short* their_sent, unsigned short* their_recv);
+static unsigned int Stalled_Connections(ConnManClass* net,
+                                        int max_ahead,
+                                        int* their_frame,
+                                        unsigned short* their_sent,
+                                        unsigned short* their_recv);
 static int Process_Reconnect_Dialog(CDTimerClass<SystemTimerClass>* timeout_timer,
                                     int* their_frame,
                                     int num_conn,
@@ -624,6 +640,15 @@ static void Queue_AI_Multiplayer(void)
     Compute_Game_CRC();
     CRC[Frame & 0x001f] = GameCRC;
 
+    //------------------------------------------------------------------------
+    //	Build the state hash tree, used to find where the game went out of sync
+    // if the CRC's ever disagree.  Start afresh for a new or loaded game.
+    //------------------------------------------------------------------------
+    if (Frame == 0 || Session.LoadGame) {
+        StateHash.Reset();
+    }
+    StateHash.Compute();
+
     //------------------------------------------------------------------------
     //	If we've just started a game, or loaded a multiplayer game, we must
     // wait for all other systems to signal ready.
@@ -709,6 +734,7 @@ static void Queue_AI_Multiplayer(void)
         // deceptively large values).
         //.....................................................................
         net->Reset_Response_Time();
+        LastStallCount = net->Stall_Count();
 
         //.....................................................................
         // Initialize the frame timers
@@ -944,6 +970,13 @@ static RetcodeType Wait_For_Players(int first_time,
     int x, y;         // for map input
     RetcodeType rc;
 
+    //........................................................................
+    // Stall tracking
+    //........................................................................
+    unsigned int stalled = 0;     // bit per connection we're waiting on
+    unsigned int stall_start = 0; // TickCount when we started waiting
+    int i;
+
     //------------------------------------------------------------------------
     // Wait to hear from all other players
     //------------------------------------------------------------------------
@@ -1220,8 +1253,21 @@ static RetcodeType Wait_For_Players(int first_time,
         //.....................................................................
         else {
             if (Can_Advance(net, Session.MaxAhead, their_frame, their_sent, their_recv)) {
+                //...............................................................
+                // Charge the time we waited to whoever was holding us back.
+                //...............................................................
+                for (i = 0; stalled && i < net->Num_Connections(); i++) {
+                    if (stalled & (1 << i)) {
+                        net->Add_Stall(net->Connection_ID(i), TickCount - stall_start);
+                    }
+                }
                 break;
             }
+
+            if (!stalled) {
+                stalled = Stalled_Connections(net, Session.MaxAhead, their_frame, their_sent, their_recv);
+                stall_start = TickCount;
+            }
         }
 
         //---------------------------------------------------------------------
@@ -1355,6 +1401,8 @@ static void Generate_Real_Timing_Event(ConnManClass* net, int my_sent)
     int i;
     int specified_frame_rate;
     int maxahead;
+    int step;
+    unsigned int stalls;
 
     //
     // If we haven't sent out at least 5 guaranteed-delivery packets, don't
@@ -1403,10 +1451,12 @@ static void Generate_Real_Timing_Event(ConnManClass* net, int my_sent)
     //
     // Measure the current connection response time.  This time will be in
     // 60ths of a second, and represents full round-trip time of a packet.
-    // To convert to one-way packet time, divide by 2; to convert to game
-    // frames, ....uh....
+    // Rather than the long-term average, budget for the slower of the 90th
+    // percentile of recent round trips and the smoothed round trip plus
+    // twice its jitter, so one slow packet doesn't stall the game but a
+    // jittery line gets the headroom it needs.
     //
-    resp_time = net->Response_Time();
+    resp_time = MAX(net->Response_Percentile(90), net->Smooth_Response_Time() + 2 * net->Response_Jitter());
 
     //
     // Compute our new 'MaxAhead' value, based upon the response time of our
@@ -1418,15 +1468,32 @@ static void Generate_Real_Timing_Event(ConnManClass* net, int my_sent)
     // resp_time is divided by 2 because, as reported, it represents a round-
     // trip, and we only want to use a one-way trip.
     //
-    maxahead = (resp_time * Session.DesiredFrameRate) / (2 * 60);
+    maxahead = (resp_time * Session.DesiredFrameRate + (2 * 60 - 1)) / (2 * 60);
+
+    //
+    // If we kept stalling anyway, the measurements are behind the line
+    // conditions; go up a step.  Going down, only close half the gap each
+    // time so a brief lull doesn't undo the headroom straight away.  Only
+    // the host runs this, and everyone applies the MaxAhead it sends, so all
+    // systems stay in step.
+    //
+    stalls = net->Stall_Count();
+    if (stalls - LastStallCount > STALL_STEP_COUNT) {
+        maxahead = MAX(maxahead, (int)(Session.MaxAhead + Session.FrameSendRate));
+    } else if (maxahead < (int)Session.MaxAhead) {
+        step = (((int)Session.MaxAhead - maxahead) / 2 + (int)Session.FrameSendRate - 1) / (int)Session.FrameSendRate;
+        maxahead = (int)Session.MaxAhead - MAX(step, 1) * (int)Session.FrameSendRate;
+    }
+    LastStallCount = stalls;
 
     //
     // Now, we have to round 'maxahead' so it's an even multiple of our
     // send rate.  It also must be at least thrice the FrameSendRate.
-    // (Isn't "thrice" a cool word?)
+    // (Isn't "thrice" a cool word?)  Keep it within NETWORK_MAX_MAX_AHEAD.
     //
     maxahead = ((maxahead + Session.FrameSendRate - 1) / Session.FrameSendRate) * Session.FrameSendRate;
     maxahead = MAX(maxahead, (int)Session.FrameSendRate * 3);
+    maxahead = MIN(maxahead, (int)((NETWORK_MAX_MAX_AHEAD / Session.FrameSendRate) * Session.FrameSendRate));
 
     ev.Type = EventClass::TIMING;
     ev.Data.Timing.DesiredFrameRate = Session.DesiredFrameRate;
@@ -1441,10 +1508,11 @@ static void Generate_Real_Timing_Event(ConnManClass* net, int my_sent)
     //
     // net->Set_Timing (resp_time + 10, -1, (resp_time * 4)+15);
 
+    resp_time = net->Response_Time();
     if (Session.Type == GAME_INTERNET) {
-        net->Set_Timing(resp_time + 10, -1, ((resp_time + 10) * 8) + 15);
+        net->Set_Timing(Retry_Delta(net), -1, ((resp_time + 10) * 8) + 15);
     } else {
-        net->Set_Timing(resp_time + 10, -1, (resp_time * 4) + 15);
+        net->Set_Timing(Retry_Delta(net), -1, (resp_time * 4) + 15);
     }
 }
 
@@ -1484,11 +1552,13 @@ static void Generate_Process_Time_Event(ConnManClass* net)
     //
     // net->Set_Timing (resp_time + 10, -1, (resp_time * 4)+15);
     if (Session.Type == GAME_INTERNET) {
-        net->Set_Timing(resp_time + 10, -1, ((resp_time + 10) * 8) + 15);
+        net->Set_Timing(Retry_Delta(net), -1, ((resp_time + 10) * 8) + 15);
     } else {
-        net->Set_Timing(resp_time + 10, -1, (resp_time * 4) + 15);
+        net->Set_Timing(Retry_Delta(net), -1, (resp_time * 4) + 15);
     }
 
+    Log_Connection_Stats(net);
+
     if (IsMono) {
         MonoClass::Enable();
         Mono_Set_Cursor(0, 23);
@@ -1506,6 +1576,67 @@ static void Generate_Process_Time_Event(ConnManClass* net)
     Session.ProcessFrames = 0;
 }
 
+/***************************************************************************
+ * Retry_Delta -- computes the connection retry time                       *
+ *                                                                         *
+ * A packet is resent if it hasn't been ACK'd within one smoothed round		*
+ * trip plus four times the jitter, the same allowance TCP makes.  The		*
+ * old fixed 10-tick padding resent too late on a LAN, and too early on a	*
+ * line whose round trips swing by more than that.								*
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		net			ptr to connection manager											*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		retry delta, in ticks																*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+static unsigned int Retry_Delta(ConnManClass* net)
+{
+    unsigned int retry = net->Smooth_Response_Time() + 4 * net->Response_Jitter() + 2;
+
+    return (MIN(MAX(retry, 4U), 120U));
+
+} // end of Retry_Delta
+
+/***************************************************************************
+ * Log_Connection_Stats -- logs each connection's latency statistics       *
+ *                                                                         *
+ * Writes one line per connection, as space-separated key=value pairs so	*
+ * the log can be fed to a script.  All times are in ticks.						*
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		net			ptr to connection manager											*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		none.																						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+static void Log_Connection_Stats(ConnManClass* net)
+{
+    int i;
+    int id;
+
+    for (i = 0; i < net->Num_Connections(); i++) {
+        id = net->Connection_ID(i);
+        DBG_INFO("netstats frame=%d peer=%d srtt=%u jitter=%u p50=%u p90=%u stalls=%u maxahead=%d fps=%d",
+                 Frame,
+                 id,
+                 net->Smooth_Response_Time(id),
+                 net->Response_Jitter(id),
+                 net->Response_Percentile(50, id),
+                 net->Response_Percentile(90, id),
+                 net->Stall_Count(id),
+                 (int)Session.MaxAhead,
+                 (int)Session.DesiredFrameRate);
+    }
+
+} // end of Log_Connection_Stats
+
 /***************************************************************************
  * Process_Send_Period -- timing for sending packets every 'n' frames      *
  *                                                                         *
@@ -2095,6 +2226,44 @@ Can_Advance(ConnManClass* net, int max_ahead, int* their_frame, unsigned short*
 
 } // end of Can_Advance
 
+/***************************************************************************
+ * Stalled_Connections -- finds the connections holding us back            *
+ *                                                                         *
+ * Applies the same tests as Can_Advance(), but to each connection on its	*
+ * own, so a frame-sync stall can be charged to the players causing it.		*
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		net				ptr to connection manager										*
+ *		max_ahead		max frames ahead													*
+ *		their_frame		array of their frame #'s										*
+ *		their_sent		array of their sent command count							*
+ *		their_recv		array of their # received commands							*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		bit mask of connection indices we're waiting on								*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+static unsigned int Stalled_Connections(ConnManClass* net,
+                                        int max_ahead,
+                                        int* their_frame,
+                                        unsigned short* their_sent,
+                                        unsigned short* their_recv)
+{
+    unsigned int stalled = 0;
+    int i;
+
+    for (i = 0; i < net->Num_Connections(); i++) {
+        if (their_recv[i] < their_sent[i] || Frame >= their_frame[i] + max_ahead) {
+            stalled |= (1 << i);
+        }
+    }
+
+    return (stalled);
+
+} // end of Stalled_Connections
+
 /***************************************************************************
  * Process_Reconnect_Dialog -- processes the reconnection dialog           *
  *                                                                         *
@@ -3295,7 +3464,12 @@ static int Execute_DoList(int max_houses,
                     }
                     if (check_crc && DoList[j].Frame == Frame && DoList[j].Data.FrameInfo.Delay < 32) {
                         index = ((DoList[j].Frame - DoList[j].Data.FrameInfo.Delay) & 0x001f);
-                        if (CRC[index] != DoList[j].Data.FrameInfo.CRC) {
+                        //.........................................................
+                        // Keep playing while the state hash trees are compared
+                        // to find where we went out of sync; only then stop.
+                        //.........................................................
+                        if (CRC[index] != DoList[j].Data.FrameInfo.CRC
+                            && (!net || !StateHash.Localise(DoList[j].Frame - DoList[j].Data.FrameInfo.Delay))) {
                             Print_CRCs(&DoList[j]);
 
 #ifdef NETWORKING
@@ -3405,27 +3579,26 @@ static void Clean_DoList(ConnManClass* net)
  *=========================================================================*/
 static void Queue_Record(void)
 {
-    int i, j;
+    int i;
 
     //------------------------------------------------------------------------
-    //	Compute # of events to save this frame
+    //	Save all events for this frame.
     //------------------------------------------------------------------------
-    j = 0;
     for (i = 0; i < DoList.Count; i++) {
         if (Frame == DoList[i].Frame && !DoList[i].IsExecuted) {
-            j++;
+            Session.Recording.Write_Event(DoList[i]);
         }
     }
 
     //------------------------------------------------------------------------
-    //	Save the # of events, then all events.
+    //	Close off the frame. The first frame of each chunk keeps the game CRC,
+    //	so playback can tell where it went out of sync.
     //------------------------------------------------------------------------
-    Session.RecordFile.Write(&j, sizeof(j));
-    for (i = 0; i < DoList.Count; i++) {
-        if (Frame == DoList[i].Frame && !DoList[i].IsExecuted) {
-            Session.RecordFile.Write(&DoList[i], sizeof(EventClass));
-            j--;
-        }
+    if (Session.Recording.Is_Chunk_Start()) {
+        Compute_Game_CRC();
+        Session.Recording.End_Frame(Frame, GameCRC, true);
+    } else {
+        Session.Recording.End_Frame(Frame, 0, false);
     }
 
 } /* end of Queue_Record */
@@ -3473,6 +3646,36 @@ static void Queue_Playback(void)
             GameActive = false;
             return;
         }
+
+        //---------------------------------------------------------------------
+        //	Seek through the recording by one or ten snapshot intervals, or go
+        //	back to the start. The seek happens at the start of the next frame.
+        //---------------------------------------------------------------------
+        int step = Snapshots.Get_Interval() ? Snapshots.Get_Interval() : TICKS_PER_MINUTE / 2;
+        switch (key) {
+        case KN_LEFT:
+            Snapshots.Request_Seek(Frame - step);
+            break;
+
+        case KN_RIGHT:
+            Snapshots.Request_Seek(Frame + step);
+            break;
+
+        case KN_PGUP:
+            Snapshots.Request_Seek(Frame - step * 10);
+            break;
+
+        case KN_PGDN:
+            Snapshots.Request_Seek(Frame + step * 10);
+            break;
+
+        case KN_HOME:
+            Snapshots.Request_Seek(0);
+            break;
+
+        default:
+            break;
+        }
     }
 
     //------------------------------------------------------------------------
@@ -3491,6 +3694,11 @@ static void Queue_Playback(void)
     //------------------------------------------------------------------------
     Compute_Game_CRC();
     CRC[Frame & 0x001f] = GameCRC;
+
+    unsigned int checkpoint;
+    if (Session.Recording.Checkpoint(Frame, checkpoint) && checkpoint != GameCRC) {
+        DBG_INFO("Playback out of sync at frame %d: recorded CRC %08x, game CRC %08x", Frame, checkpoint, GameCRC);
+    }
 #if 0 // This whole block is potentially the cause of playback desyncs, so wall it off for now.
     //------------------------------------------------------------------------
     // If we've reached the CRC print frame, do so & exit
@@ -3525,9 +3733,10 @@ static void Queue_Playback(void)
     //	Read the DoList from disk
     //------------------------------------------------------------------------
     ok = 1;
-    if (Session.RecordFile.Read(&numevents, sizeof(numevents)) == sizeof(numevents)) {
+    numevents = Session.Recording.Read_Event_Count();
+    if (numevents >= 0) {
         for (i = 0; i < numevents; i++) {
-            if (Session.RecordFile.Read(&event, sizeof(EventClass)) == sizeof(EventClass)) {
+            if (Session.Recording.Read_Event(event)) {
                 event.IsExecuted = 0;
                 DoList.Add(event);
 #ifdef MIRROR_QUEUE
@@ -44,6 +44,7 @@
  *   RadarClass::Is_Radar_Existing -- Queries to see if radar map is available.                *
  *   RadarClass::Is_Zoomable -- Determines if the map can be zoomed.                           *
  *   RadarClass::Map_Cell -- Updates radar map when a cell becomes mapped.                     *
+ *   RadarClass::Map_Region -- Updates radar map when a block of cells is mapped.              *
  *   RadarClass::One_Time -- Handles one time processing for the radar map.                    *
  *   RadarClass::Player_Names -- toggles the Player-Names mode of the radar map                *
  *   RadarClass::Plot_Radar_Pixel -- Updates the radar map with a terrain pixel.               *
@@ -1211,6 +1212,34 @@ bool RadarClass::Map_Cell(CELL cell, HouseClass* house, bool check_radar_spied,
     return (false);
 }
 
+/***********************************************************************************************
+ * RadarClass::Map_Region -- Updates radar map when a block of cells is mapped.                *
+ *                                                                                             *
+ *    Mapping a block of cells can change far more pixels than the pixel stack holds, so if    *
+ *    any cell became mapped the whole radar map is redrawn instead.                           *
+ *                                                                                             *
+ * INPUT:   x,y   -- The cell coordinates of the upper left corner of the block.               *
+ *                                                                                             *
+ *          w,h   -- The width and height of the block in cells.                               *
+ *                                                                                             *
+ *          house -- The house that is doing the mapping.                                      *
+ *                                                                                             *
+ * OUTPUT:  Returns with the number of cells that became mapped, for any player.               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int RadarClass::Map_Region(int x, int y, int w, int h, HouseClass* house, bool check_radar_spied, bool and_for_allies)
+{
+    int count = DisplayClass::Map_Region(x, y, w, h, house, check_radar_spied, and_for_allies);
+
+    if (count > 0 && IsRadarActive && Map.IsSidebarActive) {
+        IsToRedraw = true;
+        Flag_To_Redraw(false);
+        FullRedraw = true;
+    }
+    return (count);
+}
+
 void RadarClass::Cursor_Cell(CELL cell, int value)
 {
     /*
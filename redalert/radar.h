@@ -73,6 +73,13 @@ public:
                           bool check_radar_spied = true,
                           bool and_for_allies = true); // Added check_radar_spied parameter to prevent recursion. ST -
                                                        // 8/6/2019 10:16AM. Added and_for_allies ST - 10/31/2019 1:18PM
+    virtual int Map_Region(int x,
+                           int y,
+                           int w,
+                           int h,
+                           HouseClass* house,
+                           bool check_radar_spied = true,
+                           bool and_for_allies = true);
     virtual bool Jam_Cell(CELL cell, HouseClass* house);
     virtual bool UnJam_Cell(CELL cell, HouseClass* house);
     virtual CELL Click_Cell_Calc(int x, int y) const;
@@ -0,0 +1,138 @@
+#include "function.h"
+#include "common/utfargs.h"
+
+/*
+**	Converts a recording from the old plain format to the chunked one read and written by
+**	RecordingClass, so that it gets the index and checkpoints. Recordings already in the
+**	chunked format are copied frame by frame, which rebuilds their index.
+**
+**	RecordConvRA <in> <out>
+*/
+
+extern bool Load_Recording_Values(CCFileClass& file);
+extern bool Save_Recording_Values(CCFileClass& file);
+
+/*
+**	The view data written by Do_Record_Playback each frame: the map position, the selected
+**	objects, then the team and formation state. The old format has no framing, so it has to
+**	be walked field by field.
+*/
+static bool Copy_View(RecordingClass& in, RecordingClass& out)
+{
+    COORDINATE coord;
+    int count;
+    unsigned int sum;
+
+    if (in.Read(&coord, sizeof(coord)) != sizeof(coord) || in.Read(&count, sizeof(count)) != sizeof(count)
+        || in.Read(&sum, sizeof(sum)) != sizeof(sum) || count < 0) {
+        return (false);
+    }
+    out.Write(&coord, sizeof(coord));
+    out.Write(&count, sizeof(count));
+    out.Write(&sum, sizeof(sum));
+
+    for (int index = 0; index < count; index++) {
+        TARGET tgt;
+        if (in.Read(&tgt, sizeof(tgt)) != sizeof(tgt)) {
+            return (false);
+        }
+        out.Write(&tgt, sizeof(tgt));
+    }
+
+    char tail[3 * sizeof(char) + sizeof(TeamFormData) + sizeof(FormMove) + sizeof(FormSpeed) + sizeof(FormMaxSpeed)];
+    if (in.Read(tail, sizeof(tail)) != sizeof(tail)) {
+        return (false);
+    }
+    out.Write(tail, sizeof(tail));
+    return (true);
+}
+
+int main(int argc, char* argv[])
+{
+    UtfArgs args(argc, argv);
+
+    if (args.ArgC != 3) {
+        printf("Usage: %s <in> <out>\n", args.ArgV[0]);
+        return (EXIT_FAILURE);
+    }
+
+    CCFileClass infile(args.ArgV[1]);
+    CCFileClass outfile(args.ArgV[2]);
+    RecordingClass in;
+    RecordingClass out;
+
+    if (!infile.Open(READ)) {
+        printf("Unable to open %s.\n", args.ArgV[1]);
+        return (EXIT_FAILURE);
+    }
+    if (!outfile.Open(WRITE)) {
+        printf("Unable to create %s.\n", args.ArgV[2]);
+        return (EXIT_FAILURE);
+    }
+
+    bool legacy = !in.Begin_Read(infile);
+    Load_Recording_Values(infile);
+
+    out.Begin_Write(outfile);
+    Save_Recording_Values(outfile);
+
+    int frames = 0;
+    int events = 0;
+
+    for (;;) {
+        if (!legacy) {
+            char buffer[256];
+            int size;
+            while ((size = in.Read(buffer, sizeof(buffer))) > 0) {
+                out.Write(buffer, size);
+            }
+        } else if (!Copy_View(in, out)) {
+            break;
+        }
+
+        /*
+        **	Multiplayer games record no events on their first frame, so in the old format the
+        **	view data of the next frame follows straight on. An event count is never as large
+        **	as the map position that starts a view.
+        */
+        if (legacy && frames == 0) {
+            int count;
+            int pos = infile.Seek(0, SEEK_CUR);
+            if (infile.Read(&count, sizeof(count)) != sizeof(count)) {
+                break;
+            }
+            infile.Seek(pos, SEEK_SET);
+            if (count < 0 || count > MAX_EVENTS * 64) {
+                frames++;
+                continue;
+            }
+        }
+
+        int count = in.Read_Event_Count();
+        if (count < 0) {
+            break;
+        }
+
+        int frame = frames;
+        for (int index = 0; index < count; index++) {
+            EventClass event;
+            if (!in.Read_Event(event)) {
+                break;
+            }
+            out.Write_Event(event);
+            frame = event.Frame;
+            events++;
+        }
+
+        out.End_Frame(frame, 0, false);
+        frames++;
+    }
+
+    out.End();
+    in.End();
+    outfile.Close();
+    infile.Close();
+
+    printf("%s: %s recording, %d frames, %d events.\n", args.ArgV[2], legacy ? "converted old" : "copied", frames, events);
+    return (EXIT_SUCCESS);
+}
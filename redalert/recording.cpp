@@ -0,0 +1,801 @@
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "function.h"
+#include "recording.h"
+#include "common/lcw.h"
+
+#define RECORD_MAGIC  0x43455241 // "AREC"
+#define CHUNK_MAGIC   0x4B4E4843 // "CHNK"
+#define INDEX_MAGIC   0x58444E49 // "INDX"
+#define RECORD_VERSION 1
+
+/*
+**	Writes finished blocks of the recording to disk on its own thread, so the game thread never
+**	waits on the file.
+*/
+class RecordFlusherClass
+{
+public:
+    RecordFlusherClass(CCFileClass& file)
+        : File(file)
+        , Quit(false)
+        , Thread(&RecordFlusherClass::Loop, this)
+    {
+    }
+
+    /*
+    **	Everything posted is written before the thread stops.
+    */
+    ~RecordFlusherClass(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Quit = true;
+        }
+        Wake.notify_one();
+        Thread.join();
+    }
+
+    /*
+    **	Takes ownership of the block, which must have been allocated with new[].
+    */
+    void Post(unsigned char* data, int size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Blocks.push_back(BlockType{data, size});
+        }
+        Wake.notify_one();
+    }
+
+private:
+    struct BlockType
+    {
+        unsigned char* Data;
+        int Size;
+    };
+
+    void Loop(void)
+    {
+        for (;;) {
+            BlockType block;
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                Wake.wait(lock, [this]() { return Quit || !Blocks.empty(); });
+                if (Blocks.empty()) {
+                    return;
+                }
+                block = Blocks.front();
+                Blocks.pop_front();
+            }
+            File.Write(block.Data, block.Size);
+            delete[] block.Data;
+        }
+    }
+
+    CCFileClass& File;
+    std::mutex Mutex;
+    std::condition_variable Wake;
+    std::deque<BlockType> Blocks;
+    bool Quit;
+    std::thread Thread;
+};
+
+RecordingClass::RecordingClass(void)
+    : File(NULL)
+    , IsWriting(false)
+    , IsLegacy(true)
+    , ChunkFirstFrame(0)
+    , ChunkCRC(0)
+    , ChunkFlags(0)
+    , Frames(0)
+    , PrevEventFrame(0)
+    , NextFrame(0)
+    , FrameEventCount(0)
+    , DataStart(-1)
+    , WriteOffset(0)
+    , Flusher(NULL)
+    , Index(NULL)
+    , IndexCount(0)
+    , IndexAllocated(0)
+    , ReadChunk(-1)
+    , ReadFrame(0)
+    , ReadPos(0)
+    , ViewLeft(0)
+    , EventsLeft(0)
+    , InFrame(false)
+{
+    Chunk.Data = NULL;
+    Chunk.Size = Chunk.Allocated = 0;
+    FrameEvents.Data = NULL;
+    FrameEvents.Size = FrameEvents.Allocated = 0;
+    FrameView.Data = NULL;
+    FrameView.Size = FrameView.Allocated = 0;
+    Pending.Data = NULL;
+    Pending.Size = Pending.Allocated = 0;
+}
+
+RecordingClass::~RecordingClass(void)
+{
+    End();
+}
+
+void RecordingClass::Reserve(BufferType& buffer, int size)
+{
+    if (size > buffer.Allocated) {
+        int newsize = buffer.Allocated ? buffer.Allocated : 1024;
+        while (newsize < size) {
+            newsize *= 2;
+        }
+
+        unsigned char* data = new unsigned char[newsize];
+        if (buffer.Size) {
+            memcpy(data, buffer.Data, buffer.Size);
+        }
+        delete[] buffer.Data;
+        buffer.Data = data;
+        buffer.Allocated = newsize;
+    }
+}
+
+void RecordingClass::Put(BufferType& buffer, void const* data, int size)
+{
+    if (size > 0) {
+        Reserve(buffer, buffer.Size + size);
+        memcpy(buffer.Data + buffer.Size, data, size);
+        buffer.Size += size;
+    }
+}
+
+void RecordingClass::Put_Varint(BufferType& buffer, unsigned int value)
+{
+    unsigned char bytes[5];
+    int count = 0;
+
+    while (value >= 0x80) {
+        bytes[count++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[count++] = (unsigned char)value;
+    Put(buffer, bytes, count);
+}
+
+bool RecordingClass::Get(void* data, int size)
+{
+    if (ReadPos + size > Chunk.Size) {
+        return (false);
+    }
+    if (data != NULL) {
+        memcpy(data, Chunk.Data + ReadPos, size);
+    }
+    ReadPos += size;
+    return (true);
+}
+
+bool RecordingClass::Get_Varint(unsigned int& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (ReadPos >= Chunk.Size) {
+            return (false);
+        }
+        unsigned char byte = Chunk.Data[ReadPos++];
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return (true);
+        }
+    }
+    return (false);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Begin_Write -- Start a new recording.                                       *
+ *                                                                                             *
+ *    This writes the format tag. The recording values must be written to the file straight    *
+ *    after, before the first frame.                                                           *
+ *                                                                                             *
+ * INPUT:   file  -- The recording file, open for writing.                                     *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the tag written?                                                         *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool RecordingClass::Begin_Write(CCFileClass& file)
+{
+    End();
+
+    File = &file;
+    IsWriting = true;
+    IsLegacy = false;
+    DataStart = -1;
+
+    FileTagType tag;
+    tag.Magic = RECORD_MAGIC;
+    tag.Version = RECORD_VERSION;
+    return (file.Write(&tag, sizeof(tag)) == sizeof(tag));
+}
+
+/***********************************************************************************************
+ * RecordingClass::Write -- Add view data to the frame being written.                          *
+ *                                                                                             *
+ * INPUT:   data  -- The data to add.                                                          *
+ *                                                                                             *
+ *          size  -- Its size in bytes.                                                        *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void RecordingClass::Write(void const* data, int size)
+{
+    Put(FrameView, data, size);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Write_Event -- Add an event to the frame being written.                     *
+ *                                                                                             *
+ *    Each event is stored as its type and house, the difference between its frame and the    *
+ *    frame of the event before it in the chunk, and the part of its data the type uses.       *
+ *                                                                                             *
+ * INPUT:   event -- The event to add.                                                         *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void RecordingClass::Write_Event(EventClass const& event)
+{
+    unsigned char header[2];
+    header[0] = event.Type;
+    header[1] = event.ID;
+    Put(FrameEvents, header, sizeof(header));
+
+    int delta = int(event.Frame) - PrevEventFrame;
+    Put_Varint(FrameEvents, (unsigned int)((delta << 1) ^ (delta >> 31)));
+    PrevEventFrame = event.Frame;
+
+    if (event.Type < EventClass::LAST_EVENT) {
+        Put(FrameEvents, &event.Data, EventClass::EventLength[event.Type]);
+    }
+    FrameEventCount++;
+}
+
+/***********************************************************************************************
+ * RecordingClass::End_Frame -- Finish the frame being written.                                *
+ *                                                                                             *
+ * INPUT:   frame    -- The game frame.                                                        *
+ *                                                                                             *
+ *          crc      -- The game CRC of the frame, kept when this is the first of a chunk.     *
+ *                                                                                             *
+ *          has_crc  -- Is the CRC valid?                                                      *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void RecordingClass::End_Frame(int frame, unsigned int crc, bool has_crc)
+{
+    if (Frames == 0) {
+        ChunkFirstFrame = frame;
+        ChunkCRC = crc;
+        ChunkFlags = has_crc ? FLAG_CRC : 0;
+    }
+    NextFrame = frame + 1;
+
+    Put_Varint(Chunk, FrameView.Size);
+    Put(Chunk, FrameView.Data, FrameView.Size);
+    Put_Varint(Chunk, FrameEventCount);
+    Put(Chunk, FrameEvents.Data, FrameEvents.Size);
+
+    FrameView.Size = 0;
+    FrameEvents.Size = 0;
+    FrameEventCount = 0;
+
+    if (++Frames == CHUNK_FRAMES) {
+        Flush_Chunk();
+    }
+}
+
+/*
+**	Compress the current chunk onto the end of the pending data.
+*/
+void RecordingClass::Flush_Chunk(void)
+{
+    if (Frames == 0) {
+        return;
+    }
+
+    if (DataStart < 0) {
+        DataStart = File->Seek(0, SEEK_CUR);
+        WriteOffset = DataStart;
+    }
+
+    unsigned char* packed = new unsigned char[Chunk.Size + Chunk.Size / 8 + 64];
+    int packedsize = LCW_Comp(Chunk.Data, packed, Chunk.Size);
+
+    ChunkHeaderType header;
+    header.Magic = CHUNK_MAGIC;
+    header.FirstFrame = ChunkFirstFrame;
+    header.Frames = Frames;
+    header.RawSize = Chunk.Size;
+    header.CRC = ChunkCRC;
+    header.Flags = ChunkFlags;
+
+    if (packedsize < Chunk.Size) {
+        header.Flags |= FLAG_PACKED;
+        header.PackedSize = packedsize;
+    } else {
+        header.PackedSize = Chunk.Size;
+    }
+
+    if (IndexCount == IndexAllocated) {
+        IndexAllocated = IndexAllocated ? IndexAllocated * 2 : 64;
+        IndexType* index = new IndexType[IndexAllocated];
+        if (IndexCount) {
+            memcpy(index, Index, IndexCount * sizeof(IndexType));
+        }
+        delete[] Index;
+        Index = index;
+    }
+    Index[IndexCount].Offset = WriteOffset;
+    Index[IndexCount].FirstFrame = header.FirstFrame;
+    Index[IndexCount].CRC = header.CRC;
+    Index[IndexCount].Flags = header.Flags;
+    IndexCount++;
+
+    Put(Pending, &header, sizeof(header));
+    Put(Pending, (header.Flags & FLAG_PACKED) ? packed : Chunk.Data, header.PackedSize);
+    WriteOffset += sizeof(header) + header.PackedSize;
+    delete[] packed;
+
+    Chunk.Size = 0;
+    Frames = 0;
+    PrevEventFrame = 0;
+
+    if (Pending.Size >= FLUSH_SIZE) {
+        Post(false);
+    }
+}
+
+/*
+**	Hand the pending data to the flusher thread, starting it the first time.
+*/
+void RecordingClass::Post(bool final)
+{
+    if (Pending.Size == 0) {
+        return;
+    }
+
+    if (Flusher == NULL) {
+        Flusher = new RecordFlusherClass(*File);
+    }
+
+    if (final) {
+        unsigned char* data = new unsigned char[Pending.Size];
+        memcpy(data, Pending.Data, Pending.Size);
+        Flusher->Post(data, Pending.Size);
+        Pending.Size = 0;
+    } else {
+        Flusher->Post(Pending.Data, Pending.Size);
+        Pending.Data = NULL;
+        Pending.Size = 0;
+        Pending.Allocated = 0;
+    }
+}
+
+/***********************************************************************************************
+ * RecordingClass::Begin_Read -- Start reading a recording.                                    *
+ *                                                                                             *
+ *    The file is left at the recording values, which must be read before the first frame.     *
+ *                                                                                             *
+ * INPUT:   file  -- The recording file, open for reading.                                     *
+ *                                                                                             *
+ * OUTPUT:  bool; Is this a recording in the chunked format?                                   *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool RecordingClass::Begin_Read(CCFileClass& file)
+{
+    End();
+
+    File = &file;
+    IsWriting = false;
+
+    FileTagType tag;
+    if (file.Read(&tag, sizeof(tag)) == sizeof(tag) && tag.Magic == RECORD_MAGIC && tag.Version == RECORD_VERSION) {
+        IsLegacy = false;
+    } else {
+        IsLegacy = true;
+        file.Seek(0, SEEK_SET);
+    }
+    return (!IsLegacy);
+}
+
+/*
+**	Find the chunks. The footer has them all, but if the game that made the recording did not
+**	shut down cleanly it will be missing and the chunk headers are walked instead.
+*/
+bool RecordingClass::Load_Index(void)
+{
+    DataStart = File->Seek(0, SEEK_CUR);
+    int size = File->Size();
+
+    TrailerType trailer;
+    if (size >= DataStart + (int)sizeof(trailer)) {
+        File->Seek(size - sizeof(trailer), SEEK_SET);
+        if (File->Read(&trailer, sizeof(trailer)) == sizeof(trailer) && trailer.Magic == INDEX_MAGIC
+            && trailer.Count >= 0 && trailer.IndexOffset >= DataStart
+            && trailer.IndexOffset + trailer.Count * (int)sizeof(IndexType) <= size) {
+            IndexCount = IndexAllocated = trailer.Count;
+            Index = new IndexType[IndexAllocated ? IndexAllocated : 1];
+            File->Seek(trailer.IndexOffset, SEEK_SET);
+            if (File->Read(Index, IndexCount * sizeof(IndexType)) == IndexCount * (int)sizeof(IndexType)) {
+                return (true);
+            }
+            delete[] Index;
+            Index = NULL;
+            IndexCount = IndexAllocated = 0;
+        }
+    }
+
+    int offset = DataStart;
+    for (;;) {
+        ChunkHeaderType header;
+        File->Seek(offset, SEEK_SET);
+        if (File->Read(&header, sizeof(header)) != sizeof(header) || header.Magic != CHUNK_MAGIC
+            || header.PackedSize < 0 || offset + (int)sizeof(header) + header.PackedSize > size) {
+            break;
+        }
+
+        if (IndexCount == IndexAllocated) {
+            IndexAllocated = IndexAllocated ? IndexAllocated * 2 : 64;
+            IndexType* index = new IndexType[IndexAllocated];
+            if (IndexCount) {
+                memcpy(index, Index, IndexCount * sizeof(IndexType));
+            }
+            delete[] Index;
+            Index = index;
+        }
+        Index[IndexCount].Offset = offset;
+        Index[IndexCount].FirstFrame = header.FirstFrame;
+        Index[IndexCount].CRC = header.CRC;
+        Index[IndexCount].Flags = header.Flags;
+        IndexCount++;
+
+        offset += sizeof(header) + header.PackedSize;
+    }
+
+    DBG_INFO("Recording has no index, found %d chunks", IndexCount);
+    return (IndexCount > 0);
+}
+
+bool RecordingClass::Load_Chunk(int chunk)
+{
+    if (Index == NULL && !Load_Index()) {
+        return (false);
+    }
+    if (chunk < 0 || chunk >= IndexCount) {
+        return (false);
+    }
+
+    ChunkHeaderType header;
+    File->Seek(Index[chunk].Offset, SEEK_SET);
+    if (File->Read(&header, sizeof(header)) != sizeof(header) || header.Magic != CHUNK_MAGIC) {
+        return (false);
+    }
+
+    unsigned char* packed = new unsigned char[header.PackedSize + 1];
+    bool ok = File->Read(packed, header.PackedSize) == header.PackedSize;
+    if (ok) {
+        Chunk.Size = 0;
+        Reserve(Chunk, header.RawSize);
+        if (header.Flags & FLAG_PACKED) {
+            ok = LCW_Uncompress(packed, Chunk.Data, header.RawSize) == header.RawSize;
+        } else {
+            memcpy(Chunk.Data, packed, header.RawSize);
+        }
+        Chunk.Size = header.RawSize;
+    }
+    delete[] packed;
+
+    ReadChunk = chunk;
+    ReadFrame = 0;
+    ReadPos = 0;
+    InFrame = false;
+    Frames = ok ? header.Frames : 0;
+    PrevEventFrame = 0;
+    return (ok);
+}
+
+/*
+**	Move on to the view data of the next frame, loading the next chunk when this one is done.
+*/
+bool RecordingClass::Next_Frame(void)
+{
+    if (InFrame) {
+        return (true);
+    }
+
+    if (ReadChunk < 0 || ReadFrame >= Frames) {
+        if (!Load_Chunk(ReadChunk + 1)) {
+            return (false);
+        }
+    }
+
+    unsigned int viewsize;
+    if (!Get_Varint(viewsize)) {
+        return (false);
+    }
+    ViewLeft = viewsize;
+    EventsLeft = -1;
+    InFrame = true;
+    return (true);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Read -- Read view data from the current frame.                              *
+ *                                                                                             *
+ * INPUT:   data  -- Where to put the data.                                                    *
+ *                                                                                             *
+ *          size  -- How many bytes are wanted.                                                *
+ *                                                                                             *
+ * OUTPUT:  Returns the number of bytes read, short at the end of the frame's view data.       *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int RecordingClass::Read(void* data, int size)
+{
+    if (IsLegacy) {
+        return (File->Read(data, size));
+    }
+
+    if (!Next_Frame() || EventsLeft >= 0) {
+        return (0);
+    }
+
+    if (size > ViewLeft) {
+        size = ViewLeft;
+    }
+    if (!Get(data, size)) {
+        return (0);
+    }
+    ViewLeft -= size;
+    return (size);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Read_Event_Count -- Read how many events the current frame has.             *
+ *                                                                                             *
+ *    Any view data not read yet is skipped.                                                   *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns the event count, or -1 at the end of the recording.                        *
+ *                                                                                             *
+ * WARNINGS:   Every one of the events must be read with Read_Event before the next frame.     *
+ *=============================================================================================*/
+int RecordingClass::Read_Event_Count(void)
+{
+    if (IsLegacy) {
+        int count;
+        if (File->Read(&count, sizeof(count)) != sizeof(count)) {
+            return (-1);
+        }
+        return (count);
+    }
+
+    if (!Next_Frame() || !Get(NULL, ViewLeft)) {
+        return (-1);
+    }
+    ViewLeft = 0;
+
+    unsigned int count;
+    if (!Get_Varint(count)) {
+        return (-1);
+    }
+
+    EventsLeft = count;
+    if (EventsLeft == 0) {
+        InFrame = false;
+        ReadFrame++;
+    }
+    return (count);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Read_Event -- Read the next event of the current frame.                     *
+ *                                                                                             *
+ * INPUT:   event -- Where to put the event.                                                   *
+ *                                                                                             *
+ * OUTPUT:  bool; Was an event read?                                                           *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool RecordingClass::Read_Event(EventClass& event)
+{
+    if (IsLegacy) {
+        return (File->Read(&event, sizeof(EventClass)) == sizeof(EventClass));
+    }
+
+    if (!InFrame || EventsLeft <= 0) {
+        return (false);
+    }
+
+    unsigned char header[2];
+    unsigned int delta;
+    if (!Get(header, sizeof(header)) || !Get_Varint(delta)) {
+        return (false);
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.Type = EventClass::EventType(header[0]);
+    event.ID = header[1];
+    PrevEventFrame += int(delta >> 1) ^ -int(delta & 1);
+    event.Frame = PrevEventFrame;
+    event.IsExecuted = 0;
+
+    if (event.Type < EventClass::LAST_EVENT && !Get(&event.Data, EventClass::EventLength[event.Type])) {
+        return (false);
+    }
+
+    if (--EventsLeft == 0) {
+        InFrame = false;
+        ReadFrame++;
+    }
+    return (true);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Checkpoint -- Fetch the recorded game CRC of a frame, if there is one.      *
+ *                                                                                             *
+ * INPUT:   frame -- The frame being played back, its view data must have been read.           *
+ *                                                                                             *
+ *          crc   -- Set to the game CRC the recording has for the frame.                      *
+ *                                                                                             *
+ * OUTPUT:  bool; Does the recording have a CRC for this frame?                                *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool RecordingClass::Checkpoint(int frame, unsigned int& crc)
+{
+    if (IsLegacy || ReadChunk < 0 || ReadChunk >= IndexCount) {
+        return (false);
+    }
+    if (Index[ReadChunk].FirstFrame != frame || (Index[ReadChunk].Flags & FLAG_CRC) == 0) {
+        return (false);
+    }
+    crc = Index[ReadChunk].CRC;
+    return (true);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Tell -- Fetch a position in the recording that Seek can go back to.         *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns the file offset of a legacy recording, or the frame count for the chunked  *
+ *          format.                                                                            *
+ *                                                                                             *
+ * WARNINGS:   Only call this between frames.                                                  *
+ *=============================================================================================*/
+int RecordingClass::Tell(void)
+{
+    if (IsLegacy) {
+        return (File->Seek(0, SEEK_CUR));
+    }
+    return (ReadChunk < 0 ? 0 : ReadChunk * CHUNK_FRAMES + ReadFrame);
+}
+
+/***********************************************************************************************
+ * RecordingClass::Seek -- Go back to a position returned by Tell.                             *
+ *                                                                                             *
+ *    With the chunked format the chunk holding the frame is found from the index, and the     *
+ *    frames before it in the chunk are skipped.                                               *
+ *                                                                                             *
+ * INPUT:   position -- The position to go to.                                                 *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void RecordingClass::Seek(int position)
+{
+    if (IsLegacy) {
+        File->Seek(position, SEEK_SET);
+        return;
+    }
+
+    if (!Load_Chunk(position / CHUNK_FRAMES)) {
+        return;
+    }
+
+    EventClass event;
+    for (int frame = position % CHUNK_FRAMES; frame > 0; frame--) {
+        int count = Read_Event_Count();
+        if (count < 0) {
+            break;
+        }
+        while (count-- > 0) {
+            Read_Event(event);
+        }
+    }
+}
+
+/***********************************************************************************************
+ * RecordingClass::End -- Finish with the recording.                                           *
+ *                                                                                             *
+ *    When writing, the last chunk and the index are written out and the flusher thread is     *
+ *    waited for, so the file can be closed straight after.                                    *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void RecordingClass::End(void)
+{
+    if (IsWriting && File != NULL) {
+        if (FrameView.Size || FrameEventCount) {
+            End_Frame(NextFrame, 0, false);
+        }
+        Flush_Chunk();
+
+        if (DataStart < 0) {
+            DataStart = File->Seek(0, SEEK_CUR);
+            WriteOffset = DataStart;
+        }
+
+        TrailerType trailer;
+        trailer.Count = IndexCount;
+        trailer.IndexOffset = WriteOffset;
+        trailer.Magic = INDEX_MAGIC;
+        Put(Pending, Index, IndexCount * sizeof(IndexType));
+        Put(Pending, &trailer, sizeof(trailer));
+        Post(true);
+    }
+
+    delete Flusher;
+    Flusher = NULL;
+
+    Free();
+}
+
+void RecordingClass::Free(void)
+{
+    delete[] Chunk.Data;
+    delete[] FrameEvents.Data;
+    delete[] FrameView.Data;
+    delete[] Pending.Data;
+    delete[] Index;
+
+    Chunk.Data = NULL;
+    Chunk.Size = Chunk.Allocated = 0;
+    FrameEvents.Data = NULL;
+    FrameEvents.Size = FrameEvents.Allocated = 0;
+    FrameView.Data = NULL;
+    FrameView.Size = FrameView.Allocated = 0;
+    Pending.Data = NULL;
+    Pending.Size = Pending.Allocated = 0;
+    Index = NULL;
+    IndexCount = IndexAllocated = 0;
+
+    File = NULL;
+    IsWriting = false;
+    IsLegacy = true;
+    Frames = 0;
+    NextFrame = 0;
+    FrameEventCount = 0;
+    PrevEventFrame = 0;
+    DataStart = -1;
+    WriteOffset = 0;
+    ReadChunk = -1;
+    ReadFrame = 0;
+    ReadPos = 0;
+    ViewLeft = 0;
+    EventsLeft = 0;
+    InFrame = false;
+}
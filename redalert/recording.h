@@ -0,0 +1,179 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+class CCFileClass;
+class EventClass;
+class RecordFlusherClass;
+
+/*
+**	Reads and writes the per frame data of a game recording. The recording values written by
+**	Save_Recording_Values still come first in the file and go straight to the file; everything
+**	after them goes through this class.
+**
+**	Recordings are written in chunks of CHUNK_FRAMES frames. Within a chunk each frame holds the
+**	view data from Do_Record_Playback followed by that frame's events, with the frame numbers
+**	delta coded, the counts as varints and only the used part of each event's data. The chunk
+**	is then LCW compressed. Every chunk header is a checkpoint carrying the game CRC of its
+**	first frame, and a footer indexes the chunks so playback can seek. Finished chunks are
+**	gathered in memory and written out by a background thread.
+**
+**	Recordings made before this format, which are a plain stream of structures, are still read.
+*/
+class RecordingClass
+{
+public:
+    enum
+    {
+        CHUNK_FRAMES = 64,
+        FLUSH_SIZE = 32 * 1024
+    };
+
+    RecordingClass(void);
+    ~RecordingClass(void);
+
+    /*
+    **	Writing.
+    */
+    bool Begin_Write(CCFileClass& file);
+    void Write(void const* data, int size);
+    void Write_Event(EventClass const& event);
+    bool Is_Chunk_Start(void) const
+    {
+        return (Frames == 0);
+    };
+    void End_Frame(int frame, unsigned int crc, bool has_crc);
+
+    /*
+    **	Reading.
+    */
+    bool Begin_Read(CCFileClass& file);
+    bool Is_Legacy(void) const
+    {
+        return (IsLegacy);
+    };
+    int Read(void* data, int size);
+    int Read_Event_Count(void);
+    bool Read_Event(EventClass& event);
+    bool Checkpoint(int frame, unsigned int& crc);
+
+    /*
+    **	A position that Seek can return to. It must be taken at the start of a frame.
+    */
+    int Tell(void);
+    void Seek(int position);
+
+    void End(void);
+
+private:
+    /*
+    **	On disk structures.
+    */
+    struct FileTagType
+    {
+        unsigned int Magic;
+        unsigned int Version;
+    };
+
+    struct ChunkHeaderType
+    {
+        unsigned int Magic;
+        int FirstFrame;
+        int Frames;
+        int RawSize;
+        int PackedSize;
+        unsigned int CRC;
+        unsigned int Flags;
+    };
+
+    struct IndexType
+    {
+        int Offset;
+        int FirstFrame;
+        unsigned int CRC;
+        unsigned int Flags;
+    };
+
+    struct TrailerType
+    {
+        int Count;
+        int IndexOffset;
+        unsigned int Magic;
+    };
+
+    enum
+    {
+        FLAG_CRC = 0x0001,
+        FLAG_PACKED = 0x0002
+    };
+
+    struct BufferType
+    {
+        unsigned char* Data;
+        int Size;
+        int Allocated;
+    };
+
+    static void Reserve(BufferType& buffer, int size);
+    static void Put(BufferType& buffer, void const* data, int size);
+    static void Put_Varint(BufferType& buffer, unsigned int value);
+    bool Get(void* data, int size);
+    bool Get_Varint(unsigned int& value);
+
+    void Flush_Chunk(void);
+    void Post(bool final);
+
+    bool Load_Index(void);
+    bool Load_Chunk(int chunk);
+    bool Next_Frame(void);
+    void Free(void);
+
+    CCFileClass* File;
+    bool IsWriting;
+    bool IsLegacy;
+
+    /*
+    **	The chunk being written or read, uncompressed.
+    */
+    BufferType Chunk;
+    int ChunkFirstFrame;
+    unsigned int ChunkCRC;
+    unsigned int ChunkFlags;
+    int Frames;
+    int PrevEventFrame;
+
+    /*
+    **	The frame after the last one ended, which is the frame an unfinished one belongs to.
+    */
+    int NextFrame;
+
+    /*
+    **	Events are gathered here while a frame is written, since their count comes first.
+    */
+    BufferType FrameEvents;
+    int FrameEventCount;
+    BufferType FrameView;
+
+    /*
+    **	Finished chunks waiting to go to disk, and where the next one will land.
+    */
+    BufferType Pending;
+    int DataStart;
+    int WriteOffset;
+    RecordFlusherClass* Flusher;
+
+    IndexType* Index;
+    int IndexCount;
+    int IndexAllocated;
+
+    /*
+    **	Read position: chunk, frame within it, and what is left of that frame.
+    */
+    int ReadChunk;
+    int ReadFrame;
+    int ReadPos;
+    int ViewLeft;
+    int EventsLeft;
+    bool InFrame;
+};
+
+#endif
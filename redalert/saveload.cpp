@@ -32,15 +32,18 @@
  * Functions:                                                                                  *
  *   Code_All_Pointers -- Code all pointers.                                                   *
  *   Decode_All_Pointers -- Decodes all pointers.                                              *
+ *   Get_All -- Load all save game data from the straw.                                        *
  *   Get_Savefile_Info -- gets description, scenario #, house                                  *
  *   Load_Game -- loads a saved game                                                           *
  *   Load_MPlayer_Values -- Loads multiplayer-specific values                                  *
+ *   Load_Snapshot -- Restore the complete game state from a straw.                            *
  *   Load_Misc_Values -- loads miscellaneous variables                                         *
  *   MPlayer_Save_Message -- pops up a "saving..." message                                     *
  *   Put_All -- Store all save game data to the pipe.                                          *
  *   Reconcile_Players -- Reconciles loaded data with the 'Players' vector							  *
  *   Save_Game -- saves a game to disk                                                         *
  *   Save_MPlayer_Values -- Saves multiplayer-specific values                                  *
+ *   Save_Snapshot -- Store the complete game state to a pipe.                                 *
  *   Save_Misc_Values -- saves miscellaneous variables                                         *
  * - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
@@ -67,7 +70,7 @@ extern bool DLLLoad(Straw& file);
 ********************************** Defines **********************************
 */
 #define SAVEGAME_VERSION                                                                                               \
-    (DESCRIP_MAX + 0x01000006                                                                                          \
+    (DESCRIP_MAX + 0x01000007                                                                                          \
      + (sizeof(AircraftClass) + sizeof(AircraftTypeClass) + sizeof(AnimClass) + sizeof(AnimTypeClass)                  \
         + sizeof(BaseClass) + sizeof(BuildingClass) + sizeof(BuildingTypeClass) + sizeof(BulletClass)                  \
         + sizeof(BulletTypeClass) + sizeof(CellClass) + sizeof(FactoryClass) + sizeof(HouseClass)                      \
@@ -282,6 +285,145 @@ static void Put_All(Pipe& pipe, int save_net)
     pipe.Flush();
 }
 
+/***********************************************************************************************
+ * Get_All -- Load all save game data from the straw.                                          *
+ *                                                                                             *
+ *    This is the counterpart of Put_All. It reads everything Put_All wrote after the          *
+ *    scenario globals, which the caller must already have read and acted on.                  *
+ *                                                                                             *
+ * INPUT:   straw -- Reference to the straw that supplies the save game data.                  *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   All pointers are left in coded form, call Decode_All_Pointers afterwards.       *
+ *=============================================================================================*/
+static void Get_All(Straw& straw)
+{
+    int i;
+
+    /*
+    **	Load the map.  The map comes first, since it loads the Theater & init's
+    **	mixfiles.  The map calls all the type-class's Init routines, telling them
+    **	what the Theater is; this must be done before any objects are created, so
+    **	they'll be properly created.
+    */
+    Map.Load(straw);
+
+    Call_Back();
+
+    /*
+    **	Load the object data.
+    */
+    Houses.Load(straw);
+    TeamTypes.Load(straw);
+    Teams.Load(straw);
+    TriggerTypes.Load(straw);
+    Triggers.Load(straw);
+    Aircraft.Load(straw);
+    Anims.Load(straw);
+    Buildings.Load(straw);
+    Bullets.Load(straw);
+
+    Call_Back();
+
+    Infantry.Load(straw);
+    Overlays.Load(straw);
+    Smudges.Load(straw);
+    Templates.Load(straw);
+    Terrains.Load(straw);
+    Units.Load(straw);
+    Factories.Load(straw);
+    Vessels.Load(straw);
+
+    /*
+    **	Load the Logic & Map Layers
+    */
+    Logic.Load(straw);
+
+    int count;
+    straw.Get(&count, sizeof(count));
+    MapTriggers.Clear();
+    int index;
+    for (index = 0; index < count; index++) {
+        TARGET target;
+        straw.Get(&target, sizeof(target));
+        MapTriggers.Add(As_Trigger(target));
+    }
+
+    straw.Get(&count, sizeof(count));
+    LogicTriggers.Clear();
+    for (index = 0; index < count; index++) {
+        TARGET target;
+        straw.Get(&target, sizeof(target));
+        LogicTriggers.Add(As_Trigger(target));
+    }
+
+    for (HousesType h = HOUSE_FIRST; h < HOUSE_COUNT; h++) {
+        straw.Get(&count, sizeof(count));
+        HouseTriggers[h].Clear();
+        for (index = 0; index < count; index++) {
+            TARGET target;
+            straw.Get(&target, sizeof(target));
+            HouseTriggers[h].Add(As_Trigger(target));
+        }
+    }
+
+    for (i = 0; i < LAYER_COUNT; i++) {
+        Map.Layer[i].Load(straw);
+    }
+
+    Call_Back();
+
+    /*
+    **	Load the Score
+    */
+    straw.Get(&Score, sizeof(Score));
+    new (&Score) ScoreClass(NoInitClass());
+
+    /*
+    **	Load the AI Base
+    */
+    Base.Load(straw);
+
+    /*
+    **	Delete any carryover pseudo-saved game list.
+    */
+    while (Carryover != NULL) {
+        CarryoverClass* cptr = (CarryoverClass*)Carryover->Get_Next();
+        Carryover->Remove();
+        delete Carryover;
+        Carryover = cptr;
+    }
+
+    /*
+    **	Load any carryover pseudo-saved game list.
+    */
+    int carry_count = 0;
+    straw.Get(&carry_count, sizeof(carry_count));
+    while (carry_count) {
+        CarryoverClass* cptr = new CarryoverClass;
+        assert(cptr != NULL);
+
+        straw.Get(cptr, sizeof(CarryoverClass));
+        new (cptr) CarryoverClass(NoInitClass());
+        cptr->Zap();
+
+        if (!Carryover) {
+            Carryover = cptr;
+        } else {
+            cptr->Add_Tail(*Carryover);
+        }
+        carry_count--;
+    }
+
+    Call_Back();
+
+    /*
+    **	Load miscellaneous variables, including the map size & the Theater
+    */
+    Load_Misc_Values(straw);
+}
+
 /***************************************************************************
  * Save_Game -- saves a game to disk                                       *
  *                                                                         *
@@ -509,7 +651,6 @@ bool Load_Game(int id)
 */
 bool Load_Game(const char* file_name)
 {
-    int i;
     unsigned scenario;
     HousesType house;
     char descr_buf[DESCRIP_MAX];
@@ -676,127 +817,7 @@ bool Load_Game(const char* file_name)
         }
     }
 
-    /*
-    **	Load the map.  The map comes first, since it loads the Theater & init's
-    **	mixfiles.  The map calls all the type-class's Init routines, telling them
-    **	what the Theater is; this must be done before any objects are created, so
-    **	they'll be properly created.
-    */
-    Map.Load(straw);
-
-    Call_Back();
-
-    /*
-    **	Load the object data.
-    */
-    Houses.Load(straw);
-    TeamTypes.Load(straw);
-    Teams.Load(straw);
-    TriggerTypes.Load(straw);
-    Triggers.Load(straw);
-    Aircraft.Load(straw);
-    Anims.Load(straw);
-    Buildings.Load(straw);
-    Bullets.Load(straw);
-
-    Call_Back();
-
-    Infantry.Load(straw);
-    Overlays.Load(straw);
-    Smudges.Load(straw);
-    Templates.Load(straw);
-    Terrains.Load(straw);
-    Units.Load(straw);
-    Factories.Load(straw);
-    Vessels.Load(straw);
-
-    /*
-    **	Load the Logic & Map Layers
-    */
-    Logic.Load(straw);
-
-    int count;
-    straw.Get(&count, sizeof(count));
-    MapTriggers.Clear();
-    int index;
-    for (index = 0; index < count; index++) {
-        TARGET target;
-        straw.Get(&target, sizeof(target));
-        MapTriggers.Add(As_Trigger(target));
-    }
-
-    straw.Get(&count, sizeof(count));
-    LogicTriggers.Clear();
-    for (index = 0; index < count; index++) {
-        TARGET target;
-        straw.Get(&target, sizeof(target));
-        LogicTriggers.Add(As_Trigger(target));
-    }
-
-    for (HousesType h = HOUSE_FIRST; h < HOUSE_COUNT; h++) {
-        straw.Get(&count, sizeof(count));
-        HouseTriggers[h].Clear();
-        for (index = 0; index < count; index++) {
-            TARGET target;
-            straw.Get(&target, sizeof(target));
-            HouseTriggers[h].Add(As_Trigger(target));
-        }
-    }
-
-    for (i = 0; i < LAYER_COUNT; i++) {
-        Map.Layer[i].Load(straw);
-    }
-
-    Call_Back();
-
-    /*
-    **	Load the Score
-    */
-    straw.Get(&Score, sizeof(Score));
-    new (&Score) ScoreClass(NoInitClass());
-
-    /*
-    **	Load the AI Base
-    */
-    Base.Load(straw);
-
-    /*
-    **	Delete any carryover pseudo-saved game list.
-    */
-    while (Carryover != NULL) {
-        CarryoverClass* cptr = (CarryoverClass*)Carryover->Get_Next();
-        Carryover->Remove();
-        delete Carryover;
-        Carryover = cptr;
-    }
-
-    /*
-    **	Load any carryover pseudo-saved game list.
-    */
-    int carry_count = 0;
-    straw.Get(&carry_count, sizeof(carry_count));
-    while (carry_count) {
-        CarryoverClass* cptr = new CarryoverClass;
-        assert(cptr != NULL);
-
-        straw.Get(cptr, sizeof(CarryoverClass));
-        new (cptr) CarryoverClass(NoInitClass());
-        cptr->Zap();
-
-        if (!Carryover) {
-            Carryover = cptr;
-        } else {
-            cptr->Add_Tail(*Carryover);
-        }
-        carry_count--;
-    }
-
-    Call_Back();
-
-    /*
-    **	Load miscellaneous variables, including the map size & the Theater
-    */
-    Load_Misc_Values(straw);
+    Get_All(straw);
 
     /*
     **	Load multiplayer values
@@ -1025,6 +1046,71 @@ bool Load_Game(const char* file_name)
     return (true);
 }
 
+/***********************************************************************************************
+ * Save_Snapshot -- Store the complete game state to a pipe.                                   *
+ *                                                                                             *
+ *    This writes the same data as a saved game, without the file header, digest or            *
+ *    encryption. It is used to take in-memory snapshots while a recording plays back.         *
+ *                                                                                             *
+ * INPUT:   pipe  -- The pipe to receive the game state.                                       *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void Save_Snapshot(Pipe& pipe)
+{
+    Code_All_Pointers();
+    Put_All(pipe, 0);
+    Decode_All_Pointers();
+}
+
+/***********************************************************************************************
+ * Load_Snapshot -- Restore the complete game state from a straw.                              *
+ *                                                                                             *
+ *    This is the counterpart of Save_Snapshot. The rules and the scenario's mixfiles are      *
+ *    expected to be those of the game the snapshot was taken from.                            *
+ *                                                                                             *
+ * INPUT:   straw -- The straw that supplies the game state.                                   *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Like Load_Game, the game is in an unknown state if the data is bad.             *
+ *=============================================================================================*/
+void Load_Snapshot(Straw& straw)
+{
+    int load_net = 0;
+
+    Clear_Scenario();
+    straw.Get(&Scen, sizeof(Scen));
+    Get_All(straw);
+
+    straw.Get(&load_net, sizeof(load_net));
+    if (load_net) {
+        Load_MPlayer_Values(straw);
+    }
+
+    Decode_All_Pointers();
+    Map.Init_IO();
+    Map.Flag_To_Redraw(true);
+
+    /*
+    **	Treat this like a multiplayer load so nothing draws on the random number
+    **	generator, the game has to carry on exactly as it was recorded.
+    */
+    Post_Load_Game(true);
+
+    for (HousesType house = HOUSE_FIRST; house < HOUSE_COUNT; house++) {
+        HouseClass* hptr = HouseClass::As_Pointer(house);
+        if (hptr && hptr->IsActive) {
+            hptr->Init_Unit_Trackers();
+        }
+    }
+
+    ScenarioInit = 0;
+    Map.Reload_Sidebar();
+}
+
 /***************************************************************************
  * Save_Misc_Values -- saves miscellaneous variables                       *
  *                                                                         *
@@ -1087,6 +1173,15 @@ bool Save_Misc_Values(Pipe& file)
     file.Put(&IsTanyaDead, sizeof(IsTanyaDead));
     file.Put(&SaveTanya, sizeof(SaveTanya));
 
+    /*
+    **	Save the decayed threat of every house, it can't be rebuilt from the current threat.
+    */
+    int heat[MAP_TOTAL_REGIONS];
+    for (HousesType house = HOUSE_FIRST; house < HOUSE_COUNT; house++) {
+        HouseClass::Threat_Field(house).Get_Heat(heat);
+        file.Put(heat, sizeof(heat));
+    }
+
     return (true);
 }
 
@@ -1149,6 +1244,16 @@ bool Load_Misc_Values(Straw& file)
     file.Get(&IsTanyaDead, sizeof(IsTanyaDead));
     file.Get(&SaveTanya, sizeof(SaveTanya));
 
+    /*
+    **	Load the decayed threat of every house. The rest of each threat field is rebuilt
+    **	from the house regions when the house pointers are decoded.
+    */
+    int heat[MAP_TOTAL_REGIONS];
+    for (HousesType house = HOUSE_FIRST; house < HOUSE_COUNT; house++) {
+        file.Get(heat, sizeof(heat));
+        HouseClass::Threat_Field(house).Set_Heat(heat);
+    }
+
     return (true);
 }
 
@@ -1375,6 +1480,11 @@ void Decode_All_Pointers(void)
     */
     Base.Decode_Pointers();
 
+    /*
+    **	The per-house owned object lists are not saved, rebuild them from the heaps.
+    */
+    HouseClass::Rebuild_Owned_Lists();
+
     /*
     **	PlayerPtr.
     */
@@ -535,6 +535,8 @@ bool Read_Scenario(char* name)
         }
 #endif
         Fill_In_Data();
+        Clear_Sound_Effects();
+        Prewarm_Sound_Effects();
 #ifdef REMASTER_BUILD
         // Sets view dimensions to whole map for the way the remaster works.
         Map.Set_View_Dimensions(0, 0, Map.MapCellWidth, Map.MapCellHeight);
@@ -1121,7 +1123,7 @@ void Do_Win(void)
     //	PlayerPtr->NukePieces = nukes;
 
     Map.Render();
-    GamePalette.Set(FADE_PALETTE_FAST, Call_Back);
+    GamePalette.Start_Fade(FADE_PALETTE_FAST);
     //	Fade_Palette_To(GamePalette, FADE_PALETTE_FAST, Call_Back);
     Show_Mouse();
 }
@@ -1230,7 +1232,7 @@ void Do_Lose(void)
         GameActive = false;
     }
 
-    GamePalette.Set(FADE_PALETTE_FAST, Call_Back);
+    GamePalette.Start_Fade(FADE_PALETTE_FAST);
     Show_Mouse();
 }
 
@@ -2257,6 +2259,22 @@ bool Read_Scenario_INI(char* fname, bool)
     Rule.Objects(ini);
     Rule.Difficulty(ini);
 
+    /*
+    **	Any overrides the caller asked for go over the scenario's, while the objects
+    **	are still to be created so they pick up the changed stats.
+    */
+    if (RuleOverrideINI != nullptr) {
+        Rule.General(*RuleOverrideINI);
+        Rule.Recharge(*RuleOverrideINI);
+        Rule.AI(*RuleOverrideINI);
+        Rule.Powerups(*RuleOverrideINI);
+        Rule.Land_Types(*RuleOverrideINI);
+        Rule.Themes(*RuleOverrideINI);
+        Rule.IQ(*RuleOverrideINI);
+        Rule.Objects(*RuleOverrideINI);
+        Rule.Difficulty(*RuleOverrideINI);
+    }
+
     /*
     **	- Use ore growth and spread values from the special settings.
     */
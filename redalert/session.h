@@ -41,6 +41,7 @@
 #include "connect.h"
 #include "version.h"
 #include "event.h"
+#include "recording.h"
 #include <stdint.h>
 
 //---------------------------------------------------------------------------
@@ -95,6 +96,15 @@ class CellClass;
 #define MODEM_MIN_MAX_AHEAD   5
 #define NETWORK_MIN_MAX_AHEAD 2
 
+//...........................................................................
+// Bounds for the MaxAhead that the game host computes from the measured
+// response times; only applies for COMM_PROTOCOL_MULTI_E_COMP.  If more than
+// STALL_STEP_COUNT frame-sync stalls happen between timing events, MaxAhead
+// is raised a step even if the measured times don't call for it.
+//...........................................................................
+#define NETWORK_MAX_MAX_AHEAD 60
+#define STALL_STEP_COUNT      2
+
 //...........................................................................
 // Send period (in frames) for COMM_PROTOCOL_MULTI_E_COMP and above
 //...........................................................................
@@ -763,6 +773,7 @@ public:
     // For Recording & Playing back a file
     //.....................................................................
     CCFileClass RecordFile;
+    RecordingClass Recording;
     unsigned Record : 1;
     unsigned Play : 1;
     unsigned Attract : 1;
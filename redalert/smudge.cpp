@@ -43,7 +43,7 @@
 #include "function.h"
 #include "smudge.h"
 
-HousesType SmudgeClass::ToOwn = HOUSE_NONE;
+INSTANCE_LOCAL HousesType SmudgeClass::ToOwn = HOUSE_NONE;
 
 /***********************************************************************************************
  * SmudgeClass::operator new -- Creator of smudge objects.                                     *
@@ -103,7 +103,7 @@ public:
     void Disown(CELL cell);
 
 private:
-    static HousesType ToOwn;
+    static INSTANCE_LOCAL HousesType ToOwn;
 
     /*
     ** Some additional padding in case we need to add data to the class and maintain backwards compatibility for
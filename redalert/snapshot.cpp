@@ -0,0 +1,371 @@
+#include <chrono>
+
+#include "function.h"
+#include "snapshot.h"
+#include "lcwpipe.h"
+#include "lcwstraw.h"
+#include "xstraw.h"
+
+/*
+**	LCW block size for snapshot data, larger blocks than a saved game compress better.
+*/
+#define SNAPSHOT_BLOCK_SIZE (16 * 1024)
+
+/*
+**	Pipe terminator that appends everything it is given to a snapshot slot, growing the slot
+**	as needed. Slot memory is kept when the slot is reused so steady state captures do not
+**	allocate.
+*/
+class SnapshotPipe : public Pipe
+{
+public:
+    SnapshotPipe(char*& data, int& size, int& allocated)
+        : Data(data)
+        , Size(size)
+        , Allocated(allocated)
+    {
+        Size = 0;
+    }
+
+    virtual int Put(void const* source, int slen)
+    {
+        if (source == NULL || slen <= 0) {
+            return (0);
+        }
+
+        if (Size + slen > Allocated) {
+            int newsize = Allocated ? Allocated : 64 * 1024;
+            while (newsize < Size + slen) {
+                newsize *= 2;
+            }
+
+            char* newdata = new char[newsize];
+            if (Size) {
+                memcpy(newdata, Data, Size);
+            }
+            delete[] Data;
+            Data = newdata;
+            Allocated = newsize;
+        }
+
+        memcpy(Data + Size, source, slen);
+        Size += slen;
+        return (slen);
+    }
+
+private:
+    char*& Data;
+    int& Size;
+    int& Allocated;
+};
+
+/*
+**	Pass through pipe that counts the uncompressed bytes.
+*/
+class CountPipe : public Pipe
+{
+public:
+    CountPipe(void)
+        : Total(0)
+    {
+    }
+
+    virtual int Put(void const* source, int slen)
+    {
+        Total += slen;
+        return (Pipe::Put(source, slen));
+    }
+
+    int Total;
+};
+
+static int Elapsed_Microseconds(std::chrono::steady_clock::time_point start)
+{
+    return int(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+SnapshotRingClass::SnapshotRingClass(void)
+    : Slots(NULL)
+    , SlotCount(0)
+    , NextSlot(1)
+    , Interval(DEFAULT_INTERVAL)
+    , SeekFrame(NO_SEEK)
+    , LastSize(0)
+    , LastRawSize(0)
+    , LastCaptureTime(0)
+    , LastRestoreTime(0)
+{
+}
+
+SnapshotRingClass::~SnapshotRingClass(void)
+{
+    Free_Slots();
+}
+
+void SnapshotRingClass::Free_Slots(void)
+{
+    for (int index = 0; index < SlotCount; index++) {
+        delete[] Slots[index].Data;
+    }
+    delete[] Slots;
+    Slots = NULL;
+    SlotCount = 0;
+    NextSlot = 1;
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Clear -- Forget every snapshot, keeping the slot memory.                 *
+ *                                                                                             *
+ *    Call this whenever a new playback starts, snapshots of another game are useless.         *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void SnapshotRingClass::Clear(void)
+{
+    for (int index = 0; index < SlotCount; index++) {
+        Slots[index].Frame = -1;
+        Slots[index].RecordPos = 0;
+        Slots[index].Size = 0;
+    }
+    NextSlot = 1;
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Set_Interval -- Set how many frames apart snapshots are taken.           *
+ *                                                                                             *
+ * INPUT:   frames   -- The snapshot interval. Zero or less turns snapshots off.               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void SnapshotRingClass::Set_Interval(int frames)
+{
+    Interval = frames > 0 ? frames : 0;
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Set_Slots -- Set how many snapshots are held at once.                    *
+ *                                                                                             *
+ * INPUT:   count -- The number of slots, at least two so the ring has room beside the         *
+ *                   pinned first snapshot.                                                    *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   This discards any snapshots already taken.                                      *
+ *=============================================================================================*/
+void SnapshotRingClass::Set_Slots(int count)
+{
+    Free_Slots();
+
+    SlotCount = count < 2 ? 2 : count;
+    Slots = new SnapshotType[SlotCount];
+    for (int index = 0; index < SlotCount; index++) {
+        Slots[index].Frame = -1;
+        Slots[index].RecordPos = 0;
+        Slots[index].Data = NULL;
+        Slots[index].Size = 0;
+        Slots[index].Allocated = 0;
+    }
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Slot -- Find the snapshot taken at a frame.                              *
+ *                                                                                             *
+ * INPUT:   frame -- The frame to look for.                                                    *
+ *                                                                                             *
+ * OUTPUT:  Returns the slot holding that frame, or NULL.                                      *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+SnapshotRingClass::SnapshotType* SnapshotRingClass::Slot(int frame) const
+{
+    for (int index = 0; index < SlotCount; index++) {
+        if (Slots[index].Frame == frame) {
+            return (&Slots[index]);
+        }
+    }
+    return (NULL);
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Is_Due -- Should a snapshot be taken at this frame?                      *
+ *                                                                                             *
+ * INPUT:   frame -- The frame that is about to be processed.                                  *
+ *                                                                                             *
+ * OUTPUT:  bool; Is this an interval frame that has no snapshot yet?                          *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool SnapshotRingClass::Is_Due(int frame) const
+{
+    if (Interval == 0 || (frame % Interval) != 0) {
+        return (false);
+    }
+    return (SlotCount == 0 || Slot(frame) == NULL);
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Nearest -- Find the latest snapshot at or before a frame.                *
+ *                                                                                             *
+ * INPUT:   frame -- The frame being sought.                                                   *
+ *                                                                                             *
+ * OUTPUT:  Returns the frame of that snapshot, or -1 if there is none.                        *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int SnapshotRingClass::Nearest(int frame) const
+{
+    int best = -1;
+
+    for (int index = 0; index < SlotCount; index++) {
+        int slotframe = Slots[index].Frame;
+        if (slotframe >= 0 && slotframe <= frame && slotframe > best) {
+            best = slotframe;
+        }
+    }
+    return (best);
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Capture -- Take a snapshot of the current game state.                    *
+ *                                                                                             *
+ *    This must be called at the start of a playback frame, before any of that frame's         *
+ *    recorded data has been read.                                                             *
+ *                                                                                             *
+ * INPUT:   frame       -- The frame about to be processed.                                    *
+ *                                                                                             *
+ *          record_pos  -- Offset into the recording of this frame's data.                     *
+ *                                                                                             *
+ * OUTPUT:  bool; Was the snapshot taken?                                                      *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool SnapshotRingClass::Capture(int frame, int record_pos)
+{
+    if (Interval == 0) {
+        return (false);
+    }
+
+    if (SlotCount == 0) {
+        Set_Slots(DEFAULT_SLOTS);
+    }
+
+    /*
+    **	The first snapshot keeps slot zero for good, the rest cycle through the others.
+    */
+    SnapshotType* slot = &Slots[0];
+    if (slot->Frame >= 0) {
+        slot = &Slots[NextSlot];
+        NextSlot = (NextSlot + 1 < SlotCount) ? NextSlot + 1 : 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    SnapshotPipe store(slot->Data, slot->Size, slot->Allocated);
+    LCWPipe compress(LCWPipe::COMPRESS, SNAPSHOT_BLOCK_SIZE);
+    CountPipe counter;
+    compress.Put_To(store);
+    counter.Put_To(compress);
+
+    /*
+    **	Events read ahead of their execution frame are still waiting in the DoList, and the
+    **	time quake flag has already been moved on for this frame.
+    */
+    counter.Put(&TimeQuake, sizeof(TimeQuake));
+    counter.Put(&PendingTimeQuake, sizeof(PendingTimeQuake));
+    int count = DoList.Count;
+    counter.Put(&count, sizeof(count));
+    for (int index = 0; index < count; index++) {
+        counter.Put(&DoList[index], sizeof(EventClass));
+    }
+
+    Save_Snapshot(counter);
+    counter.End();
+
+    slot->Frame = frame;
+    slot->RecordPos = record_pos;
+
+    LastRawSize = counter.Total;
+    LastSize = slot->Size;
+    LastCaptureTime = Elapsed_Microseconds(start);
+
+    DBG_INFO("Snapshot of frame %d: %d bytes from %d, %d us, %d bytes held",
+             frame,
+             LastSize,
+             LastRawSize,
+             LastCaptureTime,
+             Total_Size());
+    return (true);
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Restore -- Restore the latest snapshot at or before a frame.             *
+ *                                                                                             *
+ * INPUT:   frame       -- The frame being sought.                                             *
+ *                                                                                             *
+ *          record_pos  -- Set to the recording offset that playback must resume from.         *
+ *                                                                                             *
+ * OUTPUT:  Returns the frame that was restored, or -1 if there was no snapshot to use.        *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int SnapshotRingClass::Restore(int frame, int& record_pos)
+{
+    int nearest = Nearest(frame);
+    if (nearest < 0) {
+        return (-1);
+    }
+
+    SnapshotType* slot = Slot(nearest);
+
+    auto start = std::chrono::steady_clock::now();
+
+    BufferStraw source(slot->Data, slot->Size);
+    LCWStraw decompress(LCWStraw::DECOMPRESS, SNAPSHOT_BLOCK_SIZE);
+    decompress.Get_From(source);
+
+    decompress.Get(&TimeQuake, sizeof(TimeQuake));
+    decompress.Get(&PendingTimeQuake, sizeof(PendingTimeQuake));
+
+    int count = 0;
+    decompress.Get(&count, sizeof(count));
+    DoList.Init();
+    for (int index = 0; index < count; index++) {
+        EventClass event;
+        decompress.Get(&event, sizeof(event));
+        DoList.Add(event);
+    }
+
+    Load_Snapshot(decompress);
+
+    record_pos = slot->RecordPos;
+    LastRestoreTime = Elapsed_Microseconds(start);
+
+    DBG_INFO("Restored snapshot of frame %d for frame %d in %d us", nearest, frame, LastRestoreTime);
+    return (nearest);
+}
+
+/***********************************************************************************************
+ * SnapshotRingClass::Total_Size -- Memory held by the snapshots taken so far.                 *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns the compressed size of all held snapshots, in bytes.                       *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+int SnapshotRingClass::Total_Size(void) const
+{
+    int total = 0;
+    for (int index = 0; index < SlotCount; index++) {
+        if (Slots[index].Frame >= 0) {
+            total += Slots[index].Size;
+        }
+    }
+    return (total);
+}
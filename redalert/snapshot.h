@@ -0,0 +1,98 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/*
+**	Compressed in-memory copies of the game state taken at a fixed frame interval while a
+**	recording plays back. Seeking restores the closest snapshot at or before the wanted
+**	frame and the playback code then simulates forward to it.
+**
+**	The first snapshot of a playback is never evicted so any earlier frame can still be
+**	reached once the ring has wrapped.
+*/
+class SnapshotRingClass
+{
+public:
+    enum
+    {
+        DEFAULT_INTERVAL = TICKS_PER_MINUTE / 2,
+        DEFAULT_SLOTS = 32,
+        NO_SEEK = -1
+    };
+
+    SnapshotRingClass(void);
+    ~SnapshotRingClass(void);
+
+    void Clear(void);
+    void Set_Interval(int frames);
+    int Get_Interval(void) const
+    {
+        return (Interval);
+    };
+    void Set_Slots(int count);
+
+    bool Is_Due(int frame) const;
+    bool Capture(int frame, int record_pos);
+    int Restore(int frame, int& record_pos);
+    int Nearest(int frame) const;
+
+    void Request_Seek(int frame)
+    {
+        SeekFrame = frame < 0 ? 0 : frame;
+    };
+    int Pending_Seek(void) const
+    {
+        return (SeekFrame);
+    };
+    void Clear_Seek(void)
+    {
+        SeekFrame = NO_SEEK;
+    };
+
+    /*
+    **	Figures from the most recent capture and restore, for tuning the interval. Sizes are in
+    **	bytes and times in microseconds.
+    */
+    int Last_Size(void) const
+    {
+        return (LastSize);
+    };
+    int Last_Raw_Size(void) const
+    {
+        return (LastRawSize);
+    };
+    int Last_Capture_Time(void) const
+    {
+        return (LastCaptureTime);
+    };
+    int Last_Restore_Time(void) const
+    {
+        return (LastRestoreTime);
+    };
+    int Total_Size(void) const;
+
+private:
+    struct SnapshotType
+    {
+        int Frame;
+        int RecordPos;
+        char* Data;
+        int Size;
+        int Allocated;
+    };
+
+    SnapshotType* Slot(int frame) const;
+    void Free_Slots(void);
+
+    SnapshotType* Slots;
+    int SlotCount;
+    int NextSlot;
+    int Interval;
+    int SeekFrame;
+
+    int LastSize;
+    int LastRawSize;
+    int LastCaptureTime;
+    int LastRestoreTime;
+};
+
+#endif
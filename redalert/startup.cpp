@@ -39,6 +39,7 @@
 #include "settings.h"
 #include "common/paths.h"
 #include "common/utfargs.h"
+#include "common/tickwait.h"
 
 extern char RedAlertINI[_MAX_PATH];
 
@@ -81,8 +82,7 @@ const char* Game_Registry_Key();
 // Added. ST - 5/14/2019
 bool ProgEndCalled = false;
 
-extern char* BigShapeBufferStart;
-extern char* TheaterShapeBufferStart;
+extern void Free_Shape_Cache(void);
 extern unsigned int IsTheaterShape;
 
 extern void Free_Heaps(void);
@@ -141,15 +141,7 @@ BOOL WINAPI DllMain(HINSTANCE instance, unsigned int fdwReason, void* lpvReserve
         */
         MFCD::Free_All();
 
-        if (BigShapeBufferStart) {
-            Free(BigShapeBufferStart);
-            BigShapeBufferStart = NULL;
-        }
-
-        if (TheaterShapeBufferStart) {
-            Free(TheaterShapeBufferStart);
-            TheaterShapeBufferStart = NULL;
-        }
+        Free_Shape_Cache();
 
         if (_ShapeBuffer) {
             delete[] _ShapeBuffer;
@@ -275,6 +267,11 @@ int DLL_Startup(const char* command_line_in)
 }
 #endif //REMASTER_BUILD
 
+/*
+**	Headless builds that run several game instances, and tools built on the game, supply their
+**	own main().
+*/
+#if !defined(GAME_INSTANCES) && !defined(TOOL_MAIN)
 int main(int argc, char* argv[])
 {
     UtfArgs args(argc, argv);
@@ -519,6 +516,7 @@ int main(int argc, char* argv[])
 
     return (EXIT_SUCCESS);
 }
+#endif // !GAME_INSTANCES && !TOOL_MAIN
 
 /* Initialize DirectDraw and surfaces */
 bool InitDDraw(void)
@@ -626,6 +624,29 @@ void Prog_End(const char* why, bool fatal)
         *((int*)0) = 0;
     }
 
+    /*
+    ** Log how much of the session the tick waits spent asleep against the work done between them.
+    */
+    TickWaitStatsType waits;
+    Get_Tick_Wait_Stats(waits);
+    DBG_INFO("Tick waits: %u waits, %u woken early, %llu ms asleep, %llu ms working",
+             waits.Waits,
+             waits.Wakeups,
+             (unsigned long long)(waits.WaitTime / 1000),
+             (unsigned long long)(waits.WorkTime / 1000));
+
+    /*
+    ** And how well the sound effect cache did.
+    */
+    SampleCacheStatsType sounds;
+    Get_Sound_Effect_Stats(sounds);
+    DBG_INFO("Sound effect cache: %u hits, %u misses, %u evictions, %u samples in %u bytes",
+             sounds.Hits,
+             sounds.Misses,
+             sounds.Evictions,
+             sounds.Entries,
+             (unsigned)sounds.Bytes);
+
     if (Session.Type == GAME_GLYPHX_MULTIPLAYER) {
         return;
     }
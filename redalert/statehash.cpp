@@ -0,0 +1,740 @@
+#include <chrono>
+
+#include "function.h"
+#include "statehash.h"
+
+static char const* const BranchNames[StateHashClass::BRANCH_COUNT] = {
+    "Infantry", "Units", "Vessels", "Aircraft", "Buildings", "Bullets", "Anims", "Terrains", "Houses", "Layers", "Random", "Map"};
+
+static char const* const ObjectFieldNames[StateHashClass::MAX_FIELDS] = {
+    "Coord", "Strength", "State", "Facing", "Mission", "TarCom", "NavCom", "Speed"};
+
+static char const* const HouseFieldNames[StateHashClass::MAX_FIELDS] = {
+    "Credits", "Tiberium", "Power", "Drain", "Counts", "Flags", "BScan", "Owned"};
+
+static char const* const LayerFieldNames[StateHashClass::MAX_FIELDS] = {"Count", "Order"};
+
+static char const* const RandomFieldNames[StateHashClass::MAX_FIELDS] = {"Seed"};
+
+/*
+**	Final mix of MurmurHash3, spreads every input bit over the whole result.
+*/
+static inline unsigned int Mix(unsigned int hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35;
+    hash ^= hash >> 16;
+    return (hash);
+}
+
+static int Elapsed_Microseconds(std::chrono::steady_clock::time_point start)
+{
+    return int(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+/*
+**	The object heap behind a branch, or NULL for the branches that are not heaps.
+*/
+static FixedIHeapClass const* Branch_Heap(int branch)
+{
+    switch (branch) {
+    case StateHashClass::BRANCH_INFANTRY:
+        return (&Infantry);
+    case StateHashClass::BRANCH_UNITS:
+        return (&Units);
+    case StateHashClass::BRANCH_VESSELS:
+        return (&Vessels);
+    case StateHashClass::BRANCH_AIRCRAFT:
+        return (&Aircraft);
+    case StateHashClass::BRANCH_BUILDINGS:
+        return (&Buildings);
+    case StateHashClass::BRANCH_BULLETS:
+        return (&Bullets);
+    case StateHashClass::BRANCH_ANIMS:
+        return (&Anims);
+    case StateHashClass::BRANCH_TERRAINS:
+        return (&Terrains);
+    default:
+        return (NULL);
+    }
+}
+
+static char const* Field_Name(int branch, int field, char* buffer)
+{
+    char const* name = NULL;
+
+    if (Branch_Heap(branch) != NULL) {
+        name = ObjectFieldNames[field];
+    } else if (branch == StateHashClass::BRANCH_HOUSES) {
+        name = HouseFieldNames[field];
+    } else if (branch == StateHashClass::BRANCH_LAYERS) {
+        name = LayerFieldNames[field];
+    } else if (branch == StateHashClass::BRANCH_RANDOM) {
+        name = RandomFieldNames[field];
+    }
+
+    if (name == NULL) {
+        sprintf(buffer, "Field%d", field);
+        name = buffer;
+    }
+    return (name);
+}
+
+/*
+**	The values of an object that must agree on every machine. Selection, visibility and
+**	other state that differs between players is left out.
+*/
+static void Object_Fields(ObjectClass const* object, unsigned int* field)
+{
+    field[0] = object->Coord;
+    field[1] = object->Strength;
+    field[2] = object->IsInLimbo | (object->IsDown << 1) | (object->Height << 8);
+    field[3] = 0;
+    field[4] = 0;
+    field[5] = 0;
+    field[6] = 0;
+    field[7] = 0;
+
+    if (object->Is_Techno()) {
+        TechnoClass const* techno = (TechnoClass const*)object;
+        field[3] = techno->PrimaryFacing.Current() | (techno->Turret_Facing() << 8);
+        field[4] = (unsigned char)techno->Mission | ((unsigned char)techno->MissionQueue << 8);
+        field[5] = techno->TarCom;
+        field[7] = (unsigned char)techno->Owner() << 16;
+
+        if (object->Is_Foot()) {
+            FootClass const* foot = (FootClass const*)object;
+            field[6] = foot->NavCom;
+            field[7] |= (unsigned short)foot->Speed;
+        }
+    }
+}
+
+static unsigned int Object_Key(ObjectClass const* object)
+{
+    return (object ? ((object->What_Am_I() << 16) | (unsigned short)object->ID) : 0);
+}
+
+static unsigned int Layer_Order(LayerClass const& layer)
+{
+    unsigned int hash = 0;
+    for (int index = 0; index < layer.Count(); index++) {
+        hash = Mix(hash ^ Object_Key(layer[index]));
+    }
+    return (hash);
+}
+
+static unsigned int Row_Hash(int y)
+{
+    unsigned int hash = y;
+    for (int x = 0; x < MAP_CELL_W; x++) {
+        CellClass const& cell = Map[XY_Cell(x, y)];
+        hash = Mix(hash ^ ((unsigned char)cell.Overlay | (cell.OverlayData << 8) | ((unsigned char)cell.Smudge << 16)
+                           | (cell.SmudgeData << 24)));
+        hash = Mix(hash ^ ((unsigned char)cell.Owner | ((unsigned char)cell.InfType << 8) | (cell.Flag.Composite << 16)));
+        hash = Mix(hash ^ (cell.Jammed | (Object_Key(cell.Cell_Occupier()) << 16)));
+    }
+    return (hash);
+}
+
+StateHashClass::StateHashClass(void)
+{
+    for (int index = 0; index < HISTORY; index++) {
+        History[index].Leaves = NULL;
+        History[index].Allocated = 0;
+    }
+    for (int index = 0; index < FROZEN; index++) {
+        Frozen[index].Record.Leaves = NULL;
+        Frozen[index].Record.Allocated = 0;
+    }
+    Reset();
+}
+
+StateHashClass::~StateHashClass(void)
+{
+    for (int index = 0; index < HISTORY; index++) {
+        Free_Record(History[index]);
+    }
+    for (int index = 0; index < FROZEN; index++) {
+        Free_Record(Frozen[index].Record);
+    }
+}
+
+void StateHashClass::Free_Record(RecordType& record)
+{
+    delete[] record.Leaves;
+    record.Leaves = NULL;
+    record.Allocated = 0;
+    record.Count = 0;
+}
+
+/***********************************************************************************************
+ * StateHashClass::Reset -- Forget all trees, for the start of a new or loaded game.           *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Every peer must reset on the same frame, the map rows are hashed a few at a     *
+ *             time and must start out equal.                                                  *
+ *=============================================================================================*/
+void StateHashClass::Reset(void)
+{
+    for (int index = 0; index < HISTORY; index++) {
+        History[index].Frame = -1;
+        History[index].Count = 0;
+    }
+    for (int index = 0; index < FROZEN; index++) {
+        Frozen[index].Record.Frame = -1;
+        Frozen[index].Record.Count = 0;
+        Frozen[index].SentCount = 0;
+    }
+    memset(MapRows, 0, sizeof(MapRows));
+
+    LocaliseFrame = -1;
+    Deadline = 0;
+    FoundFrame = -1;
+    LastReported = 0xFFFFFFFF;
+
+    LastComputeTime = 0;
+    TotalComputeTime = 0;
+    ComputeCount = 0;
+}
+
+StateHashClass::LeafType* StateHashClass::Add_Leaf(RecordType& record, BranchType branch, int slot, int fields)
+{
+    if (record.Count == record.Allocated) {
+        int newsize = record.Allocated ? record.Allocated * 2 : 256;
+        LeafType* leaves = new LeafType[newsize];
+        if (record.Count) {
+            memcpy(leaves, record.Leaves, record.Count * sizeof(LeafType));
+        }
+        delete[] record.Leaves;
+        record.Leaves = leaves;
+        record.Allocated = newsize;
+    }
+
+    LeafType* leaf = &record.Leaves[record.Count++];
+    leaf->Branch = branch;
+    leaf->Slot = slot;
+    leaf->FieldCount = fields;
+    memset(leaf->Field, 0, sizeof(leaf->Field));
+    return (leaf);
+}
+
+void StateHashClass::Copy_Record(RecordType& to, RecordType const& from)
+{
+    if (to.Allocated < from.Count) {
+        delete[] to.Leaves;
+        to.Allocated = from.Count;
+        to.Leaves = new LeafType[to.Allocated];
+    }
+    if (from.Count) {
+        memcpy(to.Leaves, from.Leaves, from.Count * sizeof(LeafType));
+    }
+    to.Count = from.Count;
+    to.Frame = from.Frame;
+    to.Root = from.Root;
+    memcpy(to.Branch, from.Branch, sizeof(to.Branch));
+}
+
+/***********************************************************************************************
+ * StateHashClass::Compute -- Build the hash tree of the current frame.                        *
+ *                                                                                             *
+ *    Every object, house and layer is hashed each frame. The map is too big for that, so one  *
+ *    of the MAP_REGIONS bands of rows is rehashed per frame and the rest are carried over.    *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   Call this at the same point of the frame as Compute_Game_CRC.                   *
+ *=============================================================================================*/
+void StateHashClass::Compute(void)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    RecordType& record = History[Frame % HISTORY];
+    record.Frame = Frame;
+    record.Count = 0;
+
+    unsigned int owned[HOUSE_COUNT];
+    memset(owned, 0, sizeof(owned));
+
+    /*
+    **	Objects, keyed by their heap slot.
+    */
+    for (int branch = BRANCH_INFANTRY; branch <= BRANCH_TERRAINS; branch++) {
+        FixedIHeapClass const* heap = Branch_Heap(branch);
+
+        for (int index = 0; index < heap->Count(); index++) {
+            ObjectClass const* object = (ObjectClass const*)heap->Active_Ptr(index);
+            LeafType* leaf = Add_Leaf(record, BranchType(branch), object->ID, MAX_FIELDS);
+            Object_Fields(object, leaf->Field);
+
+            HousesType owner = object->Owner();
+            if (owner >= HOUSE_FIRST && owner < HOUSE_COUNT) {
+                owned[owner] += Leaf_Hash(*leaf);
+            }
+        }
+    }
+
+    /*
+    **	Houses, with a roll up of everything each one owns.
+    */
+    for (int index = 0; index < Houses.Count(); index++) {
+        HouseClass const* house = (HouseClass const*)Houses.Active_Ptr(index);
+        LeafType* leaf = Add_Leaf(record, BRANCH_HOUSES, house->ID, MAX_FIELDS);
+
+        leaf->Field[0] = house->Credits;
+        leaf->Field[1] = house->Tiberium;
+        leaf->Field[2] = house->Power;
+        leaf->Field[3] = house->Drain;
+        leaf->Field[4] = house->CurInfantry | (house->CurUnits << 8) | (house->CurBuildings << 16)
+                         | (house->CurVessels << 24) | (house->CurAircraft << 28);
+        leaf->Field[5] = house->IsDefeated | (house->IsHuman << 1) | (house->IsAlerted << 2);
+        leaf->Field[6] = house->BScan;
+        leaf->Field[7] = house->ID < HOUSE_COUNT ? owned[house->ID] : 0;
+    }
+
+    /*
+    **	The display layers and the logic list, in order, since processing order matters.
+    */
+    for (int layer = 0; layer <= LAYER_COUNT; layer++) {
+        LayerClass const& list = (layer < LAYER_COUNT) ? Map.Layer[layer] : Logic;
+        LeafType* leaf = Add_Leaf(record, BRANCH_LAYERS, layer, 2);
+        leaf->Field[0] = list.Count();
+        leaf->Field[1] = Layer_Order(list);
+    }
+
+    /*
+    **	Capture the current internal value, don't roll the random, otherwise playbacks desync.
+    */
+    LeafType* leaf = Add_Leaf(record, BRANCH_RANDOM, 0, 1);
+    leaf->Field[0] = Scen.RandomNumber.Seed;
+
+    /*
+    **	The map, one band of rows refreshed per frame.
+    */
+    int region = Frame % MAP_REGIONS;
+    for (int row = 0; row < MAP_REGION_ROWS; row++) {
+        int y = region * MAP_REGION_ROWS + row;
+        MapRows[y] = Row_Hash(y);
+    }
+    for (region = 0; region < MAP_REGIONS; region++) {
+        leaf = Add_Leaf(record, BRANCH_MAP, region, MAP_REGION_ROWS);
+        memcpy(leaf->Field, &MapRows[region * MAP_REGION_ROWS], MAP_REGION_ROWS * sizeof(unsigned int));
+    }
+
+    /*
+    **	Roll the leaves up. Sums make the branch hashes independent of heap order.
+    */
+    memset(record.Branch, 0, sizeof(record.Branch));
+    for (int index = 0; index < record.Count; index++) {
+        record.Branch[record.Leaves[index].Branch] += Leaf_Hash(record.Leaves[index]);
+    }
+    record.Root = 0;
+    for (int branch = 0; branch < BRANCH_COUNT; branch++) {
+        record.Root = Mix(record.Root ^ record.Branch[branch]);
+    }
+
+    LastComputeTime = Elapsed_Microseconds(start);
+    TotalComputeTime += LastComputeTime;
+    ComputeCount++;
+
+    if ((Frame % STATS_INTERVAL) == 0) {
+        DBG_INFO("statehash frame=%d leaves=%d root=%08X us=%d avg_us=%d",
+                 Frame,
+                 record.Count,
+                 record.Root,
+                 LastComputeTime,
+                 Average_Compute_Time());
+    }
+}
+
+/***********************************************************************************************
+ * StateHashClass::Root -- Fetch the root hash of the latest tree.                             *
+ *                                                                                             *
+ * INPUT:   none                                                                               *
+ *                                                                                             *
+ * OUTPUT:  Returns the root hash of the current frame, or zero if none has been built.        *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+unsigned int StateHashClass::Root(void) const
+{
+    RecordType const& record = History[Frame % HISTORY];
+    return (record.Frame == Frame ? record.Root : 0);
+}
+
+unsigned int StateHashClass::Leaf_Hash(LeafType const& leaf)
+{
+    unsigned int hash = Mix(((leaf.Branch << 16) | leaf.Slot) + 0x9E3779B9);
+    for (int field = 0; field < leaf.FieldCount; field++) {
+        hash = Mix(hash ^ leaf.Field[field]);
+    }
+    return (hash ? hash : 1);
+}
+
+StateHashClass::LeafType const* StateHashClass::Find_Leaf(RecordType const& record, int branch, int slot)
+{
+    for (int index = 0; index < record.Count; index++) {
+        if (record.Leaves[index].Branch == branch && record.Leaves[index].Slot == slot) {
+            return (&record.Leaves[index]);
+        }
+    }
+    return (NULL);
+}
+
+/*
+**	The number of children of a node. This depends only on the heap sizes from the rules, so
+**	every peer sends and expects the same count.
+*/
+int StateHashClass::Child_Count(LevelType level, int branch)
+{
+    int slots = 0;
+
+    switch (level) {
+    case LEVEL_ROOT:
+        return (BRANCH_COUNT);
+
+    case LEVEL_BRANCH:
+        if (Branch_Heap(branch) != NULL) {
+            slots = Branch_Heap(branch)->Length();
+        } else if (branch == BRANCH_HOUSES) {
+            slots = HOUSE_COUNT;
+        } else if (branch == BRANCH_LAYERS) {
+            slots = LAYER_COUNT + 1;
+        } else if (branch == BRANCH_MAP) {
+            slots = MAP_REGIONS;
+        } else {
+            slots = 1;
+        }
+        return ((slots + GROUP_SIZE - 1) / GROUP_SIZE);
+
+    case LEVEL_GROUP:
+        return (GROUP_SIZE);
+
+    default:
+        return (MAX_FIELDS);
+    }
+}
+
+unsigned int StateHashClass::Child_Hash(RecordType const& record, LevelType level, int branch, int index, int child)
+{
+    unsigned int hash = 0;
+    LeafType const* leaf;
+
+    switch (level) {
+    case LEVEL_ROOT:
+        return (child < BRANCH_COUNT ? record.Branch[child] : 0);
+
+    case LEVEL_BRANCH:
+        for (int leafindex = 0; leafindex < record.Count; leafindex++) {
+            LeafType const& entry = record.Leaves[leafindex];
+            if (entry.Branch == branch && entry.Slot / GROUP_SIZE == child) {
+                hash += Leaf_Hash(entry);
+            }
+        }
+        return (hash);
+
+    case LEVEL_GROUP:
+        leaf = Find_Leaf(record, branch, index * GROUP_SIZE + child);
+        return (leaf ? Leaf_Hash(*leaf) : 0);
+
+    default:
+        leaf = Find_Leaf(record, branch, index);
+        return ((leaf && child < leaf->FieldCount) ? leaf->Field[child] : 0);
+    }
+}
+
+/***********************************************************************************************
+ * StateHashClass::Freeze -- Hold on to the tree of a frame for the length of an exchange.     *
+ *                                                                                             *
+ * INPUT:   frame -- The frame wanted, only the low 16 bits are compared.                      *
+ *                                                                                             *
+ * OUTPUT:  Returns the held copy, or NULL if that frame has already left the history.         *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+StateHashClass::FrozenType* StateHashClass::Freeze(int frame)
+{
+    frame &= 0xFFFF;
+
+    FrozenType* free = NULL;
+    for (int index = 0; index < FROZEN; index++) {
+        if (Frozen[index].Record.Frame < 0) {
+            if (free == NULL) {
+                free = &Frozen[index];
+            }
+        } else if ((Frozen[index].Record.Frame & 0xFFFF) == frame) {
+            return (&Frozen[index]);
+        }
+    }
+
+    if (free == NULL) {
+        return (NULL);
+    }
+
+    for (int index = 0; index < HISTORY; index++) {
+        if (History[index].Frame >= 0 && (History[index].Frame & 0xFFFF) == frame) {
+            Copy_Record(free->Record, History[index]);
+            free->SentCount = 0;
+            return (free);
+        }
+    }
+    return (NULL);
+}
+
+/***********************************************************************************************
+ * StateHashClass::Send_Children -- Queue the hashes of the children of a node for the peers.  *
+ *                                                                                             *
+ *    Two hashes fit in each STATEHASH event. A node is only ever sent once per exchange.      *
+ *                                                                                             *
+ * INPUT:   frozen   -- The frozen tree to send from.                                          *
+ *                                                                                             *
+ *          level    -- The level of the node.                                                 *
+ *                                                                                             *
+ *          branch   -- The branch the node is on.                                             *
+ *                                                                                             *
+ *          index    -- The group number or slot of the node, within the branch.               *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void StateHashClass::Send_Children(FrozenType& frozen, LevelType level, int branch, int index)
+{
+    unsigned int key = (level << 24) | (branch << 16) | (unsigned short)index;
+
+    for (int sent = 0; sent < frozen.SentCount; sent++) {
+        if (frozen.Sent[sent] == key) {
+            return;
+        }
+    }
+    if (frozen.SentCount == MAX_SENT) {
+        return;
+    }
+    frozen.Sent[frozen.SentCount++] = key;
+
+    int count = Child_Count(level, branch);
+    for (int first = 0; first < count; first += 2) {
+        EventClass event;
+        event.Type = EventClass::STATEHASH;
+        event.Data.StateHash.HashFrame = frozen.Record.Frame;
+        event.Data.StateHash.Level = level;
+        event.Data.StateHash.Count = (count - first) < 2 ? (count - first) : 2;
+        event.Data.StateHash.Branch = branch;
+        event.Data.StateHash.Index = index;
+        event.Data.StateHash.First = first;
+        for (int child = 0; child < event.Data.StateHash.Count; child++) {
+            event.Data.StateHash.Hash[child] = Child_Hash(frozen.Record, level, branch, index, first + child);
+        }
+        if (!OutList.Add(event)) {
+            break;
+        }
+    }
+}
+
+/***********************************************************************************************
+ * StateHashClass::Localise -- Start, or check on, the search for where the game diverged.     *
+ *                                                                                             *
+ * INPUT:   frame -- The frame whose game CRC did not match.                                   *
+ *                                                                                             *
+ * OUTPUT:  bool; Is the search still going? Once this returns false the out of sync should    *
+ *                be reported as it was before.                                                *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+bool StateHashClass::Localise(int frame)
+{
+    /*
+    **	A round trip is an event sent MaxAhead frames ahead and the reply to it.
+    */
+    int round_trip = Session.MaxAhead * 2 + 4;
+
+    if (LocaliseFrame < 0) {
+        FrozenType* frozen = Freeze(frame);
+        if (frozen == NULL) {
+            DBG_INFO("statehash frame=%d has no tree to compare", frame);
+            return (false);
+        }
+
+        DBG_INFO("statehash frame=%d out of sync at %d, comparing trees", frame, Frame);
+        LocaliseFrame = frame;
+        Deadline = Frame + round_trip * 6;
+        FoundFrame = -1;
+        Send_Children(*frozen, LEVEL_ROOT, 0, 0);
+        return (true);
+    }
+
+    /*
+    **	Leave time for the peer to be sent our side of the difference once it is found.
+    */
+    if (FoundFrame >= 0 && Frame >= FoundFrame + round_trip) {
+        return (false);
+    }
+
+    if (Frame >= Deadline) {
+        if (FoundFrame < 0) {
+            DBG_INFO("statehash frame=%d difference not found after %d frames", LocaliseFrame, Frame - LocaliseFrame);
+            FoundFrame = Frame - round_trip;
+        }
+        return (false);
+    }
+    return (true);
+}
+
+/***********************************************************************************************
+ * StateHashClass::Receive -- Compare a peer's hashes with ours and descend where they differ. *
+ *                                                                                             *
+ * INPUT:   event -- The STATEHASH event.                                                      *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void StateHashClass::Receive(EventClass const& event)
+{
+    /*
+    **	Our own hashes come back to us, and a recording has no trees to compare with.
+    */
+    if (event.ID == PlayerPtr->ID || Session.Play) {
+        return;
+    }
+
+    int frame = event.Data.StateHash.HashFrame;
+    if (LocaliseFrame < 0) {
+        Localise(frame);
+    }
+
+    FrozenType* frozen = Freeze(frame);
+    if (frozen == NULL) {
+        DBG_INFO("statehash frame=%d from peer %d is too old to compare", frame, (int)event.ID);
+        return;
+    }
+
+    LevelType level = LevelType(event.Data.StateHash.Level);
+    int branch = event.Data.StateHash.Branch;
+    int index = event.Data.StateHash.Index;
+
+    if (branch >= BRANCH_COUNT) {
+        return;
+    }
+
+    for (int child = 0; child < event.Data.StateHash.Count; child++) {
+        int which = event.Data.StateHash.First + child;
+        unsigned int theirs = event.Data.StateHash.Hash[child];
+
+        if (Child_Hash(frozen->Record, level, branch, index, which) == theirs) {
+            continue;
+        }
+
+        switch (level) {
+        case LEVEL_ROOT:
+            if (which < BRANCH_COUNT) {
+                Send_Children(*frozen, LEVEL_BRANCH, which, 0);
+            }
+            break;
+
+        case LEVEL_BRANCH:
+            Send_Children(*frozen, LEVEL_GROUP, branch, which);
+            break;
+
+        case LEVEL_GROUP:
+            Send_Children(*frozen, LEVEL_LEAF, branch, index * GROUP_SIZE + which);
+            break;
+
+        default:
+            Report(frozen->Record, branch, index, which, theirs, event.ID);
+            Send_Children(*frozen, LEVEL_LEAF, branch, index);
+            break;
+        }
+    }
+}
+
+/***********************************************************************************************
+ * StateHashClass::Report -- Log a field that differs from a peer's.                           *
+ *                                                                                             *
+ *    The first report for an object also dumps everything recorded for it, and what is in    *
+ *    its slot now.                                                                            *
+ *                                                                                             *
+ * INPUT:   record   -- The frozen tree.                                                       *
+ *                                                                                             *
+ *          branch   -- The branch of the object.                                              *
+ *                                                                                             *
+ *          slot     -- The slot of the object.                                                *
+ *                                                                                             *
+ *          field    -- The field that differs.                                                *
+ *                                                                                             *
+ *          theirs   -- The peer's value of the field.                                         *
+ *                                                                                             *
+ *          id       -- The house ID of the peer.                                              *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void StateHashClass::Report(RecordType const& record, int branch, int slot, int field, unsigned int theirs, int id)
+{
+    char namebuf[16];
+    LeafType const* leaf = Find_Leaf(record, branch, slot);
+    unsigned int ours = (leaf && field < leaf->FieldCount) ? leaf->Field[field] : 0;
+
+    if (FoundFrame < 0) {
+        FoundFrame = Frame;
+    }
+
+    DBG_INFO("statehash frame=%d peer=%d branch=%s slot=%d field=%s ours=%08X theirs=%08X%s",
+             record.Frame,
+             id,
+             BranchNames[branch],
+             slot,
+             Field_Name(branch, field, namebuf),
+             ours,
+             theirs,
+             leaf ? "" : " (missing here)");
+
+    unsigned int key = (branch << 16) | (unsigned short)slot;
+    if (key == LastReported) {
+        return;
+    }
+    LastReported = key;
+
+    if (leaf != NULL) {
+        char buffer[512];
+        int length = 0;
+        for (int index = 0; index < leaf->FieldCount; index++) {
+            length += snprintf(buffer + length,
+                               sizeof(buffer) - length,
+                               " %s=%08X",
+                               Field_Name(branch, index, namebuf),
+                               leaf->Field[index]);
+        }
+        DBG_INFO("statehash frame=%d dump %s %d:%s", record.Frame, BranchNames[branch], slot, buffer);
+    }
+
+    FixedIHeapClass const* heap = Branch_Heap(branch);
+    if (heap != NULL && slot < heap->Length()) {
+        ObjectClass const* object = (ObjectClass const*)(*heap)[slot];
+        if (object->IsActive) {
+            DBG_INFO("statehash frame=%d now %s %d: %s cell=%d strength=%d owner=%d",
+                     Frame,
+                     BranchNames[branch],
+                     slot,
+                     object->Name(),
+                     Coord_Cell(object->Coord),
+                     object->Strength,
+                     object->Owner());
+        }
+    } else if (branch == BRANCH_HOUSES && slot < HOUSE_COUNT) {
+        HouseClass const* house = HouseClass::As_Pointer(HousesType(slot));
+        if (house != NULL) {
+            DBG_INFO("statehash frame=%d now house %d: %s credits=%d", Frame, slot, house->Name(), house->Credits);
+        }
+    } else if (branch == BRANCH_MAP) {
+        DBG_INFO("statehash frame=%d map rows %d to %d", record.Frame, slot * MAP_REGION_ROWS, (slot + 1) * MAP_REGION_ROWS - 1);
+    }
+}
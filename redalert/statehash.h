@@ -0,0 +1,149 @@
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+class EventClass;
+
+/*
+**	A tree of hashes over the synchronised game state, built once per multiplayer frame
+**	alongside the game CRC. The root is made from one hash per branch (an object heap, the
+**	houses, the layers, the random number generator or the map), each branch is a sum of
+**	groups of GROUP_SIZE slots, and each slot is a leaf of up to MAX_FIELDS values taken
+**	from one object, house or run of map cells.
+**
+**	When the game CRCs of two peers disagree, both sides freeze the tree of the frame that
+**	went wrong and trade the hashes one level at a time as STATEHASH events, each side only
+**	descending into the nodes the other side disagrees with. Within a few round trips this
+**	reaches the first differing field of the first differing object, which is written to
+**	the debug log.
+*/
+class StateHashClass
+{
+public:
+    typedef enum BranchType : unsigned char
+    {
+        BRANCH_INFANTRY,
+        BRANCH_UNITS,
+        BRANCH_VESSELS,
+        BRANCH_AIRCRAFT,
+        BRANCH_BUILDINGS,
+        BRANCH_BULLETS,
+        BRANCH_ANIMS,
+        BRANCH_TERRAINS,
+        BRANCH_HOUSES,
+        BRANCH_LAYERS,
+        BRANCH_RANDOM,
+        BRANCH_MAP,
+
+        BRANCH_COUNT
+    } BranchType;
+
+    /*
+    **	Tree levels, a STATEHASH event carries hashes of the children of a node at one of these.
+    */
+    typedef enum LevelType : unsigned char
+    {
+        LEVEL_ROOT,
+        LEVEL_BRANCH,
+        LEVEL_GROUP,
+        LEVEL_LEAF
+    } LevelType;
+
+    enum
+    {
+        MAX_FIELDS = 8,
+        GROUP_SIZE = 16,
+        HISTORY = 32,
+        FROZEN = 2,
+        MAX_SENT = 256,
+        MAP_REGIONS = 32,
+        MAP_REGION_ROWS = MAP_CELL_H / MAP_REGIONS,
+        STATS_INTERVAL = 128
+    };
+
+    StateHashClass(void);
+    ~StateHashClass(void);
+
+    void Reset(void);
+    void Compute(void);
+    unsigned int Root(void) const;
+
+    bool Localise(int frame);
+    bool Is_Localising(void) const
+    {
+        return (LocaliseFrame >= 0);
+    };
+    void Receive(EventClass const& event);
+
+    /*
+    **	Cost of building the tree, in microseconds.
+    */
+    int Last_Compute_Time(void) const
+    {
+        return (LastComputeTime);
+    };
+    int Average_Compute_Time(void) const
+    {
+        return (ComputeCount ? int(TotalComputeTime / ComputeCount) : 0);
+    };
+
+private:
+    struct LeafType
+    {
+        BranchType Branch;
+        unsigned char FieldCount;
+        unsigned short Slot;
+        unsigned int Field[MAX_FIELDS];
+    };
+
+    struct RecordType
+    {
+        int Frame;
+        LeafType* Leaves;
+        int Count;
+        int Allocated;
+        unsigned int Branch[BRANCH_COUNT];
+        unsigned int Root;
+    };
+
+    /*
+    **	A record held for the length of an exchange, with the nodes already sent for it so
+    **	that peers do not trade the same hashes back and forth.
+    */
+    struct FrozenType
+    {
+        RecordType Record;
+        unsigned int Sent[MAX_SENT];
+        int SentCount;
+    };
+
+    static unsigned int Leaf_Hash(LeafType const& leaf);
+    static int Child_Count(LevelType level, int branch);
+    static unsigned int Child_Hash(RecordType const& record, LevelType level, int branch, int index, int child);
+    static LeafType const* Find_Leaf(RecordType const& record, int branch, int slot);
+
+    LeafType* Add_Leaf(RecordType& record, BranchType branch, int slot, int fields);
+    void Copy_Record(RecordType& to, RecordType const& from);
+    void Free_Record(RecordType& record);
+    FrozenType* Freeze(int frame);
+    void Send_Children(FrozenType& frozen, LevelType level, int branch, int index);
+    void Report(RecordType const& record, int branch, int slot, int field, unsigned int theirs, int id);
+
+    RecordType History[HISTORY];
+    FrozenType Frozen[FROZEN];
+
+    /*
+    **	The map is hashed one region of rows per frame, these hold the latest hash of each row.
+    */
+    unsigned int MapRows[MAP_CELL_H];
+
+    int LocaliseFrame;
+    int Deadline;
+    int FoundFrame;
+    unsigned int LastReported;
+
+    int LastComputeTime;
+    long long TotalComputeTime;
+    int ComputeCount;
+};
+
+#endif
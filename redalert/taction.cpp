@@ -449,9 +449,7 @@ bool TActionClass::operator()(HousesType house, ObjectClass* object, int id, CEL
     case TACTION_REVEAL_ALL:
         if (!PlayerPtr->IsVisionary) {
             PlayerPtr->IsVisionary = true;
-            for (CELL cell = 0; cell < MAP_CELL_TOTAL; cell++) {
-                Map.Map_Cell(cell, PlayerPtr);
-            }
+            Map.Map_All(PlayerPtr);
         }
         break;
 
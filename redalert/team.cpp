@@ -1195,16 +1195,16 @@ int TeamClass::Recruit(int typeindex)
         switch (Class->Members[typeindex].Class->What_Am_I()) {
 
         /*
-        **	For infantry objects, sweep through the infantry in the game looking for
-        **	ones owned by the house that owns the team. When found, try to add.
+        **	For infantry objects, sweep through the infantry owned by the house that
+        **	owns the team. When found, try to add.
         */
         case RTTI_INFANTRYTYPE:
         case RTTI_INFANTRY: {
             InfantryClass* best = 0;
             int bestdist = -1;
 
-            for (int index = 0; index < Infantry.Count(); index++) {
-                InfantryClass* infantry = Infantry.Ptr(index);
+            for (TechnoClass* t = House->First_Owned(RTTI_INFANTRY); t != NULL; t = t->OwnedNext) {
+                InfantryClass* infantry = (InfantryClass*)t;
                 int d = infantry->Distance(center);
 
                 if ((d < bestdist || bestdist == -1) && Can_Add(infantry, typeindex)) {
@@ -1225,8 +1225,8 @@ int TeamClass::Recruit(int typeindex)
             AircraftClass* best = 0;
             int bestdist = -1;
 
-            for (int index = 0; index < Aircraft.Count(); index++) {
-                AircraftClass* aircraft = Aircraft.Ptr(index);
+            for (TechnoClass* t = House->First_Owned(RTTI_AIRCRAFT); t != NULL; t = t->OwnedNext) {
+                AircraftClass* aircraft = (AircraftClass*)t;
                 int d = aircraft->Distance(center);
 
                 if ((d < bestdist || bestdist == -1) && Can_Add(aircraft, typeindex)) {
@@ -1246,9 +1246,11 @@ int TeamClass::Recruit(int typeindex)
         case RTTI_UNIT: {
             UnitClass* best = 0;
             int bestdist = -1;
+            TechnoClass* first =
+                House->First_Owned(RTTI_UNIT, ((UnitTypeClass const*)Class->Members[typeindex].Class)->Type);
 
-            for (int index = 0; index < Units.Count(); index++) {
-                UnitClass* unit = Units.Ptr(index);
+            for (TechnoClass* t = first; t != NULL; t = t->TypeNext) {
+                UnitClass* unit = (UnitClass*)t;
                 int d = unit->Distance(center);
 
                 if (unit->House == House && unit->Class == Class->Members[typeindex].Class) {
@@ -1281,9 +1283,11 @@ int TeamClass::Recruit(int typeindex)
         case RTTI_VESSEL: {
             VesselClass* best = 0;
             int bestdist = -1;
+            TechnoClass* first =
+                House->First_Owned(RTTI_VESSEL, ((VesselTypeClass const*)Class->Members[typeindex].Class)->Type);
 
-            for (int index = 0; index < Vessels.Count(); index++) {
-                VesselClass* vessel = Vessels.Ptr(index);
+            for (TechnoClass* t = first; t != NULL; t = t->TypeNext) {
+                VesselClass* vessel = (VesselClass*)t;
                 int d = vessel->Distance(center);
 
                 if (vessel->House == House && vessel->Class == Class->Members[typeindex].Class) {
@@ -220,6 +220,11 @@ const char* NewName[] = {
 int const TechnoClass::BodyShape[32] = {0,  31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
                                         16, 15, 14, 13, 12, 11, 10, 9,  8,  7,  6,  5,  4,  3,  2,  1};
 
+/***************************************************************************
+**	Creation counter used to keep each house's owned object lists in heap order.
+*/
+INSTANCE_LOCAL unsigned int TechnoClass::OwnedSequenceCount = 0;
+
 /***********************************************************************************************
  * TechnoClass::Is_Players_Army -- Determines if this object is part of the player's army.     *
  *                                                                                             *
@@ -679,6 +684,11 @@ TechnoClass::TechnoClass(RTTIType rtti, int id, HousesType house)
     , ElectricZapTarget(0)
     , ElectricZapWhich(0)
     , PurchasePrice(0)
+    , OwnedNext(NULL)
+    , OwnedPrev(NULL)
+    , TypeNext(NULL)
+    , TypePrev(NULL)
+    , OwnedSequence(++OwnedSequenceCount)
 {
     // IsOwnedByPlayer = (PlayerPtr == House);
     // Added for multiplayer changes. ST - 4/24/2019 10:40AM
@@ -244,6 +244,18 @@ public:
     */
     unsigned int IsDiscoveredByPlayerMask;
 
+    /*
+    **	Links for the owning house's lists of the objects it has, one list for each
+    **	kind of object and one for each exact type. OwnedSequence records the order
+    **	objects were created in, which is the order the house keeps its lists in.
+    */
+    TechnoClass* OwnedNext;
+    TechnoClass* OwnedPrev;
+    TechnoClass* TypeNext;
+    TechnoClass* TypePrev;
+    unsigned int OwnedSequence;
+    static INSTANCE_LOCAL unsigned int OwnedSequenceCount;
+
     /*
     ** Some additional padding in case we need to add data to the class and maintain backwards compatibility for
     *save/load
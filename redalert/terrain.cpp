@@ -617,6 +617,7 @@ bool TerrainClass::Limbo(void)
     if (!IsInLimbo) {
         CELL cell = Coord_Cell(Coord);
         Map[cell].Flag.Occupy.Monolith = false;
+        CellTables.Set_Composite(cell, Map[cell].Flag.Composite);
     }
     return (ObjectClass::Limbo());
 }
@@ -37,6 +37,7 @@
  *   ThemeClass::Is_Allowed -- Checks to see if the specified theme is legal.                  *
  *   ThemeClass::Next_Song -- Calculates the next song number to play.                         *
  *   ThemeClass::Play_Song -- Starts the specified song play NOW.                              *
+ *   ThemeClass::Prefetch_Next -- Picks the song to follow and starts reading it ahead.        *
  *   ThemeClass::Queue_Song -- Queues the song to the play queue.                              *
  *   ThemeClass::Scan -- Scans all scores for availability.                                    *
  *   ThemeClass::Set_Theme_Data -- Set the theme data for scenario and owner.                  *
@@ -148,6 +149,7 @@ ThemeClass::ThemeClass(void)
     : Current(-1)
     , Score(THEME_NONE)
     , Pending(THEME_NONE)
+    , Next(THEME_NONE)
 {
 }
 
@@ -194,20 +196,31 @@ char const* ThemeClass::Full_Name(ThemeType theme) const
 void ThemeClass::AI(void)
 {
     if (SampleType && !Debug_Quiet) {
+        /*
+        **	If the song carried straight on into the one read ahead to follow it, then that one
+        **	is now playing and the song to follow it in turn can be read ahead.
+        */
+        if (Current != -1 && File_Stream_Handed_Off(Current)) {
+            Score = Next;
+            Prefetch_Next(true);
+        }
+
         if (ScoresPresent && Options.ScoreVolume != 0 && !Still_Playing() && Pending != THEME_NONE && GameInFocus) {
             /*
             **	If the pending song needs to be picked, then pick it now.
             */
             if (Pending == THEME_PICK_ANOTHER) {
-                Pending = Next_Song(Score);
+                Pending = (Next != THEME_NONE) ? Next : Next_Song(Score);
             }
 
             /*
             **	Start the song playing and then flag it so that a new song will
-            **	be picked when this one ends.
+            **	be picked when this one ends. That song is picked now so it can
+            **	be read ahead and follow on without a gap.
             */
             Play_Song(Pending);
             Pending = THEME_PICK_ANOTHER;
+            Prefetch_Next(true);
         }
         Sound_Callback();
     }
@@ -306,6 +319,19 @@ void ThemeClass::Queue_Song(ThemeType theme)
     */
     if (Pending == THEME_NONE || Pending == THEME_PICK_ANOTHER || theme == THEME_NONE || theme == THEME_QUIET) {
         Pending = theme;
+
+        /*
+        **	Read the queued song ahead while the current one fades. A song already read ahead
+        **	to follow this one is dropped, unless it is only the next song being asked for.
+        */
+        if (theme >= THEME_FIRST) {
+            Next = THEME_NONE;
+            File_Stream_Prefetch(Theme_File_Name(theme));
+        } else if (theme != THEME_PICK_ANOTHER) {
+            Next = THEME_NONE;
+            File_Stream_Prefetch(NULL);
+        }
+
         if (Still_Playing()) {
             Fade_Sample(Current, THEME_DELAY);
         }
@@ -333,6 +359,7 @@ int ThemeClass::Play_Song(ThemeType theme)
     if (ScoresPresent && SampleType && !Debug_Quiet && Options.ScoreVolume != 0) {
         Stop();
         Score = theme;
+        Next = THEME_NONE;
         if (theme != THEME_NONE && theme != THEME_QUIET) {
             // PG StreamLowImpact = true;
             Current = File_Stream_Sample_Vol(Theme_File_Name(theme), 0xFF, true);
@@ -342,6 +369,27 @@ int ThemeClass::Play_Song(ThemeType theme)
     return (Current);
 }
 
+/***********************************************************************************************
+ * ThemeClass::Prefetch_Next -- Picks the song to follow and starts reading it ahead.          *
+ *                                                                                             *
+ *    The song to play after the current one is picked as soon as the current one starts, so  *
+ *    that the start of it can be read from disk in the background well before it is needed.  *
+ *                                                                                             *
+ * INPUT:   follow_on -- Should the song carry straight on into the next one when it ends?     *
+ *                                                                                             *
+ * OUTPUT:  none                                                                               *
+ *                                                                                             *
+ * WARNINGS:   none                                                                            *
+ *=============================================================================================*/
+void ThemeClass::Prefetch_Next(bool follow_on)
+{
+    Next = THEME_NONE;
+    if (Current != -1 && Score != THEME_NONE && Score != THEME_QUIET) {
+        Next = Next_Song(Score);
+        File_Stream_Prefetch(Theme_File_Name(Next), follow_on);
+    }
+}
+
 /***********************************************************************************************
  * ThemeClass::Theme_File_Name -- Constructs a filename for the specified theme.               *
  *                                                                                             *
@@ -39,10 +39,12 @@ class ThemeClass
 {
 private:
     static char const* Theme_File_Name(ThemeType theme);
+    void Prefetch_Next(bool follow_on);
 
     int Current;       // Handle to current score.
     ThemeType Score;   // Score number currently being played.
     ThemeType Pending; // Score to play next.
+    ThemeType Next;    // Score picked to follow this one, being read ahead.
 
     typedef struct
     {
@@ -63,7 +63,7 @@
 /*
 ** Instance of chronal vortex class. This must be the only instance.
 */
-ChronalVortexClass ChronalVortex;
+INSTANCE_LOCAL ChronalVortexClass ChronalVortex;
 
 /***********************************************************************************************
  * CVC::ChronalVortexClass -- vortex class constructor                                         *
@@ -0,0 +1,228 @@
+#include "common/soscomp.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#define STREAMS 6
+#define BYTES   40000
+
+static uint32_t Seed = 0x2468ace1;
+
+static uint32_t Random()
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+/*
+** Compressed data to decode. Odd streams are ADPCM of a noisy tone, which is what the game plays,
+** even ones are random bytes, which keep running into the sample limits.
+*/
+static void Make_Stream(std::vector<char>& data, int stream, int channels)
+{
+    data.resize(BYTES * channels);
+
+    if (stream & 1) {
+        std::vector<short> pcm(BYTES * 2 * channels);
+        for (size_t i = 0; i < pcm.size(); ++i) {
+            pcm[i] = short(((i * (stream + 3)) % 400) * 120 - 24000 + (Random() % 2000));
+        }
+
+        _SOS_COMPRESS_INFO info;
+        memset(&info, 0, sizeof(info));
+        sosCODECInitStream(&info);
+        info.lpSource = reinterpret_cast<char*>(pcm.data());
+        info.lpDest = data.data();
+        info.wBitSize = 16;
+        info.wChannels = channels;
+        sosCODECCompressData(&info, unsigned(pcm.size() * 2));
+    } else {
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = char(Random());
+        }
+    }
+}
+
+static void Init_Info(_SOS_COMPRESS_INFO& info, int channels)
+{
+    memset(&info, 0, sizeof(info));
+    sosCODECInitStream(&info);
+    info.wBitSize = 16;
+    info.wChannels = channels;
+}
+
+// Each stream decodes in random sized chunks to exactly what the original decoder gives.
+int test_streams()
+{
+    int ret = 0;
+
+    for (int stream = 0; stream < STREAMS; ++stream) {
+        int channels = 1 + stream / 3 % 2;
+        std::vector<char> data;
+        Make_Stream(data, stream, channels);
+
+        std::vector<short> expected(BYTES * 2 * channels + 16);
+        std::vector<short> result(expected.size());
+        _SOS_COMPRESS_INFO direct;
+        _SOS_COMPRESS_INFO info;
+        Init_Info(direct, channels);
+        Init_Info(info, channels);
+
+        size_t offset = 0;
+        while (offset < BYTES) {
+            unsigned chunk = std::min<size_t>(Random() % 3000, BYTES - offset);
+            direct.lpSource = &data[offset * channels];
+            direct.lpDest = reinterpret_cast<char*>(&expected[offset * 2 * channels]);
+            info.lpSource = direct.lpSource;
+            info.lpDest = reinterpret_cast<char*>(&result[offset * 2 * channels]);
+
+            if (sosCODECDecompressDataDirect(&direct, chunk * 4) != sosCODECDecompressData(&info, chunk * 4)) {
+                fprintf(stderr, "Stream %d returned the wrong size.\n", stream);
+                ret = 1;
+            }
+            offset += chunk;
+        }
+
+        if (expected != result) {
+            fprintf(stderr, "Stream %d with %d channels decoded differently.\n", stream, channels);
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
+
+// Several streams of different lengths and channel counts decoded together match decoding each alone.
+int test_multiple()
+{
+    int ret = 0;
+    std::vector<char> data[STREAMS];
+    std::vector<short> expected[STREAMS];
+    std::vector<short> result[STREAMS];
+    _SOS_COMPRESS_INFO infos[STREAMS];
+    _SOS_COMPRESS_INFO* streams[STREAMS];
+    unsigned bytes[STREAMS];
+
+    for (int pass = 0; pass < 4; ++pass) {
+        for (int stream = 0; stream < STREAMS; ++stream) {
+            int channels = 1 + (stream + pass) % 2;
+            Make_Stream(data[stream], stream, channels);
+            bytes[stream] = (BYTES - Random() % 1000) * 4;
+
+            expected[stream].assign(BYTES * 2 * channels, 0);
+            result[stream].assign(BYTES * 2 * channels, 0);
+
+            Init_Info(infos[stream], channels);
+            infos[stream].lpSource = data[stream].data();
+            infos[stream].lpDest = reinterpret_cast<char*>(expected[stream].data());
+            sosCODECDecompressDataDirect(&infos[stream], bytes[stream]);
+
+            Init_Info(infos[stream], channels);
+            infos[stream].lpSource = data[stream].data();
+            infos[stream].lpDest = reinterpret_cast<char*>(result[stream].data());
+            streams[stream] = &infos[stream];
+        }
+
+        unsigned total = 0;
+        int count = 1 + pass + pass / 2;
+        for (int stream = 0; stream < count; ++stream) {
+            total += bytes[stream];
+        }
+
+        if (sosCODECDecompressStreams(streams, bytes, count) != total) {
+            fprintf(stderr, "Decoding %d streams returned the wrong size.\n", count);
+            ret = 1;
+        }
+
+        for (int stream = 0; stream < count; ++stream) {
+            if (expected[stream] != result[stream]) {
+                fprintf(stderr, "Stream %d of %d decoded differently.\n", stream, count);
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+typedef unsigned (*DecodeType)(_SOS_COMPRESS_INFO* const* streams, const unsigned* bytes, int count);
+
+static unsigned Decode_Direct(_SOS_COMPRESS_INFO* const* streams, const unsigned* bytes, int count)
+{
+    unsigned total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += sosCODECDecompressDataDirect(streams[i], bytes[i]);
+    }
+    return total;
+}
+
+static unsigned Decode_Each(_SOS_COMPRESS_INFO* const* streams, const unsigned* bytes, int count)
+{
+    unsigned total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += sosCODECDecompressData(streams[i], bytes[i]);
+    }
+    return total;
+}
+
+static double Time_Decode(DecodeType decode, int count, int channels)
+{
+    std::vector<char> data[STREAMS];
+    std::vector<short> output[STREAMS];
+    _SOS_COMPRESS_INFO infos[STREAMS];
+    _SOS_COMPRESS_INFO* streams[STREAMS];
+    unsigned bytes[STREAMS];
+
+    for (int stream = 0; stream < count; ++stream) {
+        Make_Stream(data[stream], stream | 1, channels);
+        output[stream].resize(BYTES * 2 * channels);
+        Init_Info(infos[stream], channels);
+        streams[stream] = &infos[stream];
+        bytes[stream] = BYTES * 4;
+    }
+
+    double samples = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed;
+
+    do {
+        for (int stream = 0; stream < count; ++stream) {
+            infos[stream].lpSource = data[stream].data();
+            infos[stream].lpDest = reinterpret_cast<char*>(output[stream].data());
+        }
+        decode(streams, bytes, count);
+        samples += double(BYTES) * 2 * channels * count;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < 0.25);
+
+    return samples / elapsed.count() / 1000000.0;
+}
+
+// Millions of samples a second decoded one stream at a time and several at once.
+void test_speed()
+{
+    printf("Mono        Direct %7.1f  Decoder %7.1f Msamples/s\n",
+           Time_Decode(Decode_Direct, 1, 1),
+           Time_Decode(Decode_Each, 1, 1));
+    printf("Stereo      Direct %7.1f  Decoder %7.1f Msamples/s\n",
+           Time_Decode(Decode_Direct, 1, 2),
+           Time_Decode(Decode_Each, 1, 2));
+    printf("4 x mono    Direct %7.1f  Decoder %7.1f Msamples/s\n",
+           Time_Decode(Decode_Direct, 4, 1),
+           Time_Decode(sosCODECDecompressStreams, 4, 1));
+}
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_streams();
+    ret |= test_multiple();
+    test_speed();
+
+    return ret;
+}
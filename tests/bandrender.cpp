@@ -0,0 +1,200 @@
+#include "common/drawbuff.h"
+#include "common/gbuffer.h"
+#include "common/shape.h"
+#include "common/workerpool.h"
+#include "common/wwkeyboard.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <vector>
+
+// Globals needed to compile GraphicBufferClass.
+bool GameInFocus;
+int ScreenWidth;
+int WindowList[9][9];
+char* _ShapeBuffer = 0;
+WWKeyboardClass* Keyboard;
+
+void Process_Network()
+{
+}
+
+void Focus_Restore()
+{
+}
+
+void Focus_Loss()
+{
+}
+
+int Open_File(char const*, int)
+{
+    return 0;
+}
+
+void Close_File(int)
+{
+}
+
+int Read_File(int, void*, unsigned int)
+{
+    return 0;
+}
+
+// Needed by the shape cache that Buffer_Frame_To_Page links against.
+void Mem_Copy(void const* source, void* dest, unsigned int bytes_to_copy)
+{
+    memmove(dest, source, bytes_to_copy);
+}
+
+void Buffer_Frame_To_Page(int x, int y, int w, int h, void* Buffer, GraphicViewPortClass& view, int flags, ...);
+
+#define CELL_SIZE    24
+#define ICON_COUNT   8
+#define SHAPE_TRANS  0x40
+#define BUFF_WIDTH   400
+#define BUFF_HEIGHT  300
+#define WIN_X        16
+#define WIN_Y        8
+#define WIN_WIDTH    352
+#define WIN_HEIGHT   261
+#define GRID_XOFFSET -7
+#define GRID_YOFFSET -13
+
+static std::vector<uint8_t> Tileset;
+static uint8_t ShadowFrame[CELL_SIZE * CELL_SIZE];
+static uint8_t GhostTable[256 + 256 * 2];
+
+// Builds a Red Alert style tileset with a mix of opaque and transparent icons.
+static void Build_Tileset()
+{
+    const int header = 40;
+    const int icons = CELL_SIZE * CELL_SIZE * ICON_COUNT;
+
+    Tileset.assign(header + icons + ICON_COUNT * 2, 0);
+
+    uint8_t* data = Tileset.data();
+    int16_t w = CELL_SIZE, h = CELL_SIZE, count = ICON_COUNT;
+    int32_t icon_offset = header, trans_offset = header + icons, map_offset = header + icons + ICON_COUNT;
+    memcpy(data + 0, &w, 2);
+    memcpy(data + 2, &h, 2);
+    memcpy(data + 4, &count, 2);
+    memcpy(data + 16, &icon_offset, 4);
+    memcpy(data + 28, &trans_offset, 4);
+    memcpy(data + 36, &map_offset, 4);
+
+    for (int i = 0; i < icons; ++i) {
+        data[header + i] = uint8_t((i * 7 + i / 13) & 0xFF);
+    }
+
+    for (int i = 0; i < ICON_COUNT; ++i) {
+        data[trans_offset + i] = i & 1;
+        data[map_offset + i] = uint8_t(ICON_COUNT - 1 - i);
+    }
+
+    for (int i = 0; i < CELL_SIZE * CELL_SIZE; ++i) {
+        ShadowFrame[i] = (i % 5) == 0 ? 0 : uint8_t(1 + (i % 3));
+    }
+
+    memset(GhostTable, 0xFF, 256);
+    GhostTable[1] = 0;
+    GhostTable[2] = 1;
+    for (int i = 0; i < 256 * 2; ++i) {
+        GhostTable[256 + i] = uint8_t(255 - (i & 0xFF));
+    }
+}
+
+// Draws cells of the rows [first, last) clipped to the window lines [top, bottom).
+static void Draw_Rows(GraphicBufferClass& buff, int first, int last, int top, int bottom)
+{
+    GraphicViewPortClass window(&buff, WIN_X, WIN_Y + top, WIN_WIDTH, bottom - top);
+
+    for (int row = first; row < last; ++row) {
+        int y = GRID_YOFFSET + row * CELL_SIZE;
+
+        for (int x = GRID_XOFFSET; x < WIN_WIDTH; x += CELL_SIZE) {
+            int icon = (row * 3 + x) & (ICON_COUNT - 1);
+            Buffer_Draw_Stamp_Clip(
+                &buff, Tileset.data(), icon, x, y - top, nullptr, WIN_X, WIN_Y + top, WIN_WIDTH, bottom - top);
+
+            if ((row + x) & 1) {
+                Buffer_Frame_To_Page(x,
+                                     y - top,
+                                     CELL_SIZE,
+                                     CELL_SIZE,
+                                     ShadowFrame,
+                                     window,
+                                     SHAPE_GHOST | SHAPE_TRANS,
+                                     GhostTable,
+                                     0);
+            }
+        }
+    }
+}
+
+int test_bands()
+{
+    int ret = 0;
+    int rows = (WIN_HEIGHT - GRID_YOFFSET + CELL_SIZE - 1) / CELL_SIZE;
+
+    Build_Tileset();
+
+    GraphicBufferClass serial(BUFF_WIDTH, BUFF_HEIGHT);
+    serial.Clear(0x55);
+    Draw_Rows(serial, 0, rows, 0, WIN_HEIGHT);
+
+    WorkerPoolClass pool;
+    pool.Init(4);
+
+    for (int bands = 2; bands <= 8; ++bands) {
+        GraphicBufferClass banded(BUFF_WIDTH, BUFF_HEIGHT);
+        banded.Clear(0x55);
+
+        pool.Run(bands, [&](int band) {
+            int first = band * rows / bands;
+            int last = (band + 1) * rows / bands;
+            int top = band == 0 ? 0 : GRID_YOFFSET + first * CELL_SIZE;
+            int bottom = band == bands - 1 ? WIN_HEIGHT : GRID_YOFFSET + last * CELL_SIZE;
+            Draw_Rows(banded, first, last, top, bottom);
+        });
+
+        if (memcmp(serial.Get_Buffer(), banded.Get_Buffer(), BUFF_WIDTH * BUFF_HEIGHT) != 0) {
+            fprintf(stderr, "Banded draw with %d bands did not match the serial draw.\n", bands);
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
+
+int test_pool()
+{
+    int ret = 0;
+    WorkerPoolClass pool;
+    pool.Init(3);
+
+    for (int count = 1; count < 64; count += 7) {
+        std::vector<int> hits(count, 0);
+        pool.Run(count, [&](int index) { hits[index]++; });
+
+        for (int i = 0; i < count; ++i) {
+            if (hits[i] != 1) {
+                fprintf(stderr, "WorkerPoolClass::Run(%d) ran job %d %d times.\n", count, i, hits[i]);
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_pool();
+    ret |= test_bands();
+
+    return ret;
+}
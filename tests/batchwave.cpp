@@ -0,0 +1,117 @@
+#include "common/batchwave.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+/*
+** Stands in for the rules every game instance shares. Loading a match writes them, playing
+** reads them every frame.
+*/
+static std::atomic<int> SharedRule;
+static std::atomic<int> Playing;
+static std::atomic<int> LoadsWhilePlaying;
+
+struct JobType
+{
+    int Seed;
+    int Rule;
+};
+
+static uint32_t Play(JobType const& job, const std::function<void()>& ready)
+{
+    if (Playing.load() != 0) {
+        LoadsWhilePlaying++;
+    }
+    SharedRule = job.Rule;
+    std::this_thread::yield();
+
+    ready();
+
+    Playing++;
+    uint32_t state = job.Seed;
+    for (int frame = 0; frame < 2000; ++frame) {
+        state = state * 1664525 + 1013904223 + SharedRule.load();
+        if ((frame & 63) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    Playing--;
+    return state;
+}
+
+static std::vector<uint32_t> Run(std::vector<JobType> const& jobs, int threads)
+{
+    std::vector<int> groups;
+    for (JobType const& job : jobs) {
+        groups.push_back(job.Rule);
+    }
+
+    std::vector<uint32_t> results(jobs.size());
+    Run_In_Waves(groups, threads, [&](int index, const std::function<void()>& ready) {
+        results[index] = Play(jobs[index], ready);
+    });
+    return results;
+}
+
+// A match gives the same result in a batch with siblings on other rules as it does alone.
+int test_isolation()
+{
+    int ret = 0;
+
+    std::vector<JobType> alone = {{1234, 1}};
+    uint32_t expected = Run(alone, 1)[0];
+
+    std::vector<JobType> batch = {{99, 2}, {1234, 1}, {7, 2}, {1234, 1}, {5, 3}, {8, 2}, {1234, 1}};
+    LoadsWhilePlaying = 0;
+    std::vector<uint32_t> results = Run(batch, 4);
+
+    for (size_t index = 0; index < batch.size(); ++index) {
+        if (batch[index].Seed == 1234 && results[index] != expected) {
+            fprintf(stderr, "Job %zu gave %08x in a batch, %08x alone.\n", index, results[index], expected);
+            ret = 1;
+        }
+    }
+    if (LoadsWhilePlaying != 0) {
+        fprintf(stderr, "%d jobs loaded while another was playing.\n", LoadsWhilePlaying.load());
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Every job runs once, and one that gives up before it is ready doesn't hold up its wave.
+int test_all_run()
+{
+    int ret = 0;
+    std::vector<int> groups = {0, 1, 0, 0, 1, 2, 0, 0, 0};
+    std::vector<std::atomic<int>> runs(groups.size());
+
+    Run_In_Waves(groups, 3, [&](int index, const std::function<void()>& ready) {
+        runs[index]++;
+        if (index != 3) {
+            ready();
+        }
+    });
+
+    for (size_t index = 0; index < groups.size(); ++index) {
+        if (runs[index] != 1) {
+            fprintf(stderr, "Job %zu ran %d times.\n", index, runs[index].load());
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_isolation();
+    ret |= test_all_run();
+
+    return ret;
+}
@@ -0,0 +1,318 @@
+#include "common/mp.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#define PRECISION MAX_UNIT_PRECISION
+
+static uint32_t Seed = 0x12345678;
+
+static uint32_t Random()
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+// A random number of exactly the given bit count.
+static void Random_Number(digit* r, int bits)
+{
+    XMP_Init(r, 0, PRECISION);
+    for (int i = 0; i < XMP_Bits_To_Digits(bits); ++i) {
+        r[i] = Random();
+    }
+    r[(bits - 1) / 32] &= XMP_Bits_To_Mask(bits) | (XMP_Bits_To_Mask(bits) - 1);
+    XMP_Set_Bit(r, bits - 1);
+}
+
+// Schoolbook arithmetic on 32 bit words, sharing no code with the library, to check both
+// backends against. The product is words * 2 long.
+static void Schoolbook_Mult(uint32_t* product, const digit* left, const digit* right, int words)
+{
+    memset(product, 0, sizeof(uint32_t) * words * 2);
+
+    for (int i = 0; i < words; ++i) {
+        uint64_t carry = 0;
+        for (int j = 0; j < words; ++j) {
+            uint64_t t = uint64_t(left[i]) * right[j] + product[i + j] + carry;
+            product[i + j] = uint32_t(t);
+            carry = t >> 32;
+        }
+        product[i + words] = uint32_t(carry);
+    }
+}
+
+// Remainder of a words * 2 long number, shifting it in a bit at a time and subtracting the
+// modulus whenever it fits.
+static void Schoolbook_Mod(digit* remainder, const uint32_t* number, const digit* modulus, int words)
+{
+    uint32_t r[PRECISION + 1];
+
+    memset(r, 0, sizeof(r));
+
+    for (int bit = words * 64 - 1; bit >= 0; --bit) {
+        for (int i = words; i > 0; --i) {
+            r[i] = (r[i] << 1) | (r[i - 1] >> 31);
+        }
+        r[0] = (r[0] << 1) | ((number[bit / 32] >> (bit % 32)) & 1);
+
+        bool fits = r[words] != 0;
+        for (int i = words - 1; i >= 0 && !fits; --i) {
+            if (r[i] != modulus[i]) {
+                fits = r[i] > modulus[i];
+                break;
+            }
+            fits = i == 0;
+        }
+
+        if (fits) {
+            int64_t borrow = 0;
+            for (int i = 0; i <= words; ++i) {
+                int64_t t = int64_t(r[i]) - (i < words ? modulus[i] : 0) - borrow;
+                r[i] = uint32_t(t);
+                borrow = t < 0;
+            }
+        }
+    }
+
+    XMP_Init(remainder, 0, PRECISION);
+    memcpy(remainder, r, sizeof(uint32_t) * words);
+}
+
+// Plain square and multiply with the schoolbook routines.
+static void Reference_Exponent_Mod(digit* result, const digit* base, const digit* exponent, const digit* modulus)
+{
+    uint32_t product[PRECISION * 2];
+    int words = XMP_Significance(modulus, PRECISION);
+
+    XMP_Init(result, 1, PRECISION);
+    for (int bit = XMP_Count_Bits(exponent, PRECISION) - 1; bit >= 0; --bit) {
+        Schoolbook_Mult(product, result, result, words);
+        Schoolbook_Mod(result, product, modulus, words);
+        if (XMP_Test_Bit(exponent, bit)) {
+            Schoolbook_Mult(product, result, base, words);
+            Schoolbook_Mod(result, product, modulus, words);
+        }
+    }
+}
+
+static int Check(const char* what, int bits, const digit* expected, const digit* result)
+{
+    if (XMP_Compare(expected, result, PRECISION) != 0) {
+        fprintf(stderr, "%s gave the wrong result for a %d bit modulus.\n", what, bits);
+        return 1;
+    }
+    return 0;
+}
+
+// Both backends agree with schoolbook arithmetic, from moduli of a few digits right up to the
+// largest precision and with moduli that fill their top digit or not.
+int test_reference()
+{
+    static const int sizes[] = {64, 80, 96, 250, 512, 768, 1000, 1024, 1500, 2040};
+    int ret = 0;
+    digit modulus[PRECISION];
+    digit base[PRECISION];
+    digit exponent[PRECISION];
+    digit expected[PRECISION];
+    digit result[PRECISION];
+
+    for (int size = 0; size < int(sizeof(sizes) / sizeof(sizes[0])); ++size) {
+        int bits = sizes[size];
+
+        for (int pass = 0; pass < 4; ++pass) {
+            Random_Number(modulus, bits);
+            modulus[0] |= 1;
+            Random_Number(base, bits - 1 - pass);
+
+            switch (pass) {
+            case 0:
+                XMP_Init(exponent, 65537, PRECISION);
+                break;
+            case 1:
+                XMP_Init(exponent, 2 + size, PRECISION);
+                break;
+            case 2:
+                Random_Number(exponent, bits > 64 ? 64 : bits - 1);
+                break;
+            default:
+                Random_Number(exponent, bits > 512 ? 128 : bits - 1);
+                break;
+            }
+
+            Reference_Exponent_Mod(expected, base, exponent, modulus);
+
+            XMP_Exponent_Mod_Smith(result, base, exponent, modulus, PRECISION);
+            ret |= Check("Smith", bits, expected, result);
+#ifdef XMP_MONTGOMERY
+            XMP_Exponent_Mod_Montgomery(result, base, exponent, modulus, PRECISION);
+            ret |= Check("Montgomery", bits, expected, result);
+#endif
+            xmp_exponent_mod(result, base, exponent, modulus, PRECISION);
+            ret |= Check("xmp_exponent_mod", bits, expected, result);
+        }
+    }
+
+    return ret;
+}
+
+// A square whose last quotient digit Smith's reduction guesses one too large, with a modulus
+// that doesn't fill its top digit. The correction used to borrow from the wrong place.
+int test_smith_correction()
+{
+    digit modulus[PRECISION];
+    digit base[PRECISION];
+    digit exponent[PRECISION];
+    digit expected[PRECISION];
+    digit result[PRECISION];
+
+    XMP_Init(modulus, 0, PRECISION);
+    modulus[0] = 0x42136397;
+    modulus[1] = 0x2df0df9f;
+    modulus[2] = 0x8ed8;
+    XMP_Init(base, 0, PRECISION);
+    base[0] = 0xa03f9cb0;
+    base[1] = 0xc876d7bf;
+    base[2] = 0x0b56;
+    XMP_Init(exponent, 2, PRECISION);
+    XMP_Init(expected, 0, PRECISION);
+    expected[0] = 0x5000e93c;
+    expected[1] = 0xc5f8db89;
+    expected[2] = 0x8ed7;
+
+    XMP_Exponent_Mod_Smith(result, base, exponent, modulus, PRECISION);
+    return Check("Smith", 80, expected, result);
+}
+
+// The backends agree on full sized exponents at the largest precisions, and return the same
+// errors.
+int test_backends()
+{
+    int ret = 0;
+#ifdef XMP_MONTGOMERY
+    digit modulus[PRECISION];
+    digit base[PRECISION];
+    digit exponent[PRECISION];
+    digit expected[PRECISION];
+    digit result[PRECISION];
+
+    for (int pass = 0; pass < 4; ++pass) {
+        int bits = 1024 + pass * 255;
+
+        Random_Number(modulus, bits);
+        modulus[0] |= 1;
+        Random_Number(base, bits - 1);
+        Random_Number(exponent, pass & 1 ? bits - 1 : 17);
+
+        XMP_Exponent_Mod_Smith(expected, base, exponent, modulus, PRECISION);
+        XMP_Exponent_Mod_Montgomery(result, base, exponent, modulus, PRECISION);
+        ret |= Check("Montgomery", bits, expected, result);
+    }
+
+    Random_Number(modulus, 512);
+    modulus[0] |= 1;
+    digit zero[PRECISION];
+    XMP_Init(zero, 0, PRECISION);
+
+    const digit* cases[][3] = {
+        {zero, zero, modulus},
+        {base, zero, modulus},
+        {base, exponent, zero},
+        {modulus, exponent, modulus},
+        {base, modulus, modulus},
+    };
+
+    Random_Number(base, 300);
+    Random_Number(exponent, 300);
+
+    for (int i = 0; i < int(sizeof(cases) / sizeof(cases[0])); ++i) {
+        int smith = XMP_Exponent_Mod_Smith(expected, cases[i][0], cases[i][1], cases[i][2], PRECISION);
+        int montgomery = XMP_Exponent_Mod_Montgomery(result, cases[i][0], cases[i][1], cases[i][2], PRECISION);
+
+        if (smith != montgomery || XMP_Compare(expected, result, PRECISION) != 0) {
+            fprintf(stderr, "Case %d returned %d from Smith and %d from Montgomery.\n", i, smith, montgomery);
+            ret = 1;
+        }
+    }
+
+    // An even modulus is left to Smith.
+    modulus[0] &= ~1;
+    if (XMP_Exponent_Mod_Montgomery(result, base, exponent, modulus, PRECISION) != -5) {
+        fprintf(stderr, "Montgomery accepted an even modulus.\n");
+        ret = 1;
+    }
+    XMP_Exponent_Mod_Smith(expected, base, exponent, modulus, PRECISION);
+    xmp_exponent_mod(result, base, exponent, modulus, PRECISION);
+    ret |= Check("xmp_exponent_mod", 512, expected, result);
+#endif
+
+    return ret;
+}
+
+typedef int (*ExponentModType)(digit*, const digit*, const digit*, const digit*, int);
+
+static double Time_Exponent_Mod(ExponentModType func, const digit* base, const digit* exponent, const digit* modulus)
+{
+    digit result[PRECISION];
+    int loops = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed;
+
+    do {
+        func(result, base, exponent, modulus, PRECISION);
+        ++loops;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < 0.25);
+
+    return elapsed.count() * 1000.0 / loops;
+}
+
+// Milliseconds for a public and a private key sized operation, only run when asked as the
+// private key timings take a while.
+void bench_speed()
+{
+    static const int sizes[] = {512, 1024, 2040};
+    digit modulus[PRECISION];
+    digit base[PRECISION];
+    digit exponent[PRECISION];
+    digit public_exponent[PRECISION];
+
+    XMP_Init(public_exponent, 65537, PRECISION);
+
+    for (int size = 0; size < int(sizeof(sizes) / sizeof(sizes[0])); ++size) {
+        int bits = sizes[size];
+
+        Random_Number(modulus, bits);
+        modulus[0] |= 1;
+        Random_Number(base, bits - 1);
+        Random_Number(exponent, bits - 1);
+
+        printf("%4d bit Smith      %9.4f ms public %9.4f ms private\n",
+               bits,
+               Time_Exponent_Mod(XMP_Exponent_Mod_Smith, base, public_exponent, modulus),
+               Time_Exponent_Mod(XMP_Exponent_Mod_Smith, base, exponent, modulus));
+#ifdef XMP_MONTGOMERY
+        printf("%4d bit Montgomery %9.4f ms public %9.4f ms private\n",
+               bits,
+               Time_Exponent_Mod(XMP_Exponent_Mod_Montgomery, base, public_exponent, modulus),
+               Time_Exponent_Mod(XMP_Exponent_Mod_Montgomery, base, exponent, modulus));
+#endif
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    ret |= test_reference();
+    ret |= test_smith_correction();
+    ret |= test_backends();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_speed();
+    }
+
+    return ret;
+}
@@ -0,0 +1,226 @@
+#include "common/blitsimd.h"
+#include "common/gbuffer.h"
+#include "common/shape.h"
+#include "common/wwkeyboard.h"
+
+#include <chrono>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <vector>
+
+// Globals needed to compile GraphicBufferClass.
+bool GameInFocus;
+int ScreenWidth;
+int WindowList[9][9];
+char* _ShapeBuffer = 0;
+WWKeyboardClass* Keyboard;
+
+void Process_Network()
+{
+}
+
+void Focus_Restore()
+{
+}
+
+void Focus_Loss()
+{
+}
+
+int Open_File(char const*, int)
+{
+    return 0;
+}
+
+void Close_File(int)
+{
+}
+
+int Read_File(int, void*, unsigned int)
+{
+    return 0;
+}
+
+// Needed by the shape cache that Buffer_Frame_To_Page links against.
+void Mem_Copy(void const* source, void* dest, unsigned int bytes_to_copy)
+{
+    memmove(dest, source, bytes_to_copy);
+}
+
+void Buffer_Frame_To_Page(int x, int y, int w, int h, void* Buffer, GraphicViewPortClass& view, int flags, ...);
+
+#define SHAPE_TRANS 0x40
+#define BUFF_WIDTH  160
+#define BUFF_HEIGHT 100
+#define MAX_FRAME   96
+
+static uint32_t Seed = 0x1234567;
+
+static uint8_t Random_Byte()
+{
+    Seed = Seed * 1103515245 + 12345;
+    return uint8_t(Seed >> 16);
+}
+
+static uint8_t Frame[MAX_FRAME * MAX_FRAME];
+static uint8_t GhostTable[256 + 256 * 4];
+static uint8_t SparseGhostTable[256 + 256 * 4];
+static uint8_t FadeTable[256];
+static uint8_t Background[BUFF_WIDTH * BUFF_HEIGHT];
+
+static void Build_Data()
+{
+    for (int i = 0; i < MAX_FRAME * MAX_FRAME; ++i) {
+        uint8_t value = Random_Byte();
+        Frame[i] = (value & 3) == 0 ? 0 : value;
+    }
+
+    // One table ghosts a good share of colors, the other only a handful like the shadow remaps.
+    for (int i = 0; i < 256; ++i) {
+        GhostTable[i] = (i % 3) == 0 ? uint8_t(i & 3) : 0xFF;
+        SparseGhostTable[i] = 0xFF;
+        FadeTable[i] = Random_Byte();
+    }
+
+    SparseGhostTable[4] = 0;
+    SparseGhostTable[5] = 1;
+
+    for (int i = 256; i < 256 + 256 * 4; ++i) {
+        GhostTable[i] = Random_Byte();
+        SparseGhostTable[i] = Random_Byte();
+    }
+
+    for (int i = 0; i < BUFF_WIDTH * BUFF_HEIGHT; ++i) {
+        Background[i] = Random_Byte();
+    }
+}
+
+static void Draw(GraphicBufferClass& buff, int x, int y, int w, int h, int flags, uint8_t* ghost, int fade_count)
+{
+    GraphicViewPortClass view(&buff, 0, 0, BUFF_WIDTH, BUFF_HEIGHT);
+    memcpy(buff.Get_Buffer(), Background, BUFF_WIDTH * BUFF_HEIGHT);
+
+    if (flags & SHAPE_GHOST) {
+        Buffer_Frame_To_Page(x, y, w, h, Frame, view, flags, ghost, FadeTable, fade_count);
+    } else {
+        Buffer_Frame_To_Page(x, y, w, h, Frame, view, flags, FadeTable, fade_count);
+    }
+}
+
+struct BlitCaseType
+{
+    const char* Name;
+    int Flags;
+};
+
+static const BlitCaseType BlitCases[] = {
+    {"Trans", SHAPE_TRANS},
+    {"Ghost", SHAPE_GHOST},
+    {"Ghost_Trans", SHAPE_GHOST | SHAPE_TRANS},
+    {"Fading", SHAPE_FADING},
+    {"Fading_Trans", SHAPE_FADING | SHAPE_TRANS},
+    {"Ghost_Fading", SHAPE_GHOST | SHAPE_FADING},
+};
+
+int test_levels()
+{
+    int ret = 0;
+    GraphicBufferClass expected(BUFF_WIDTH, BUFF_HEIGHT);
+    GraphicBufferClass actual(BUFF_WIDTH, BUFF_HEIGHT);
+
+    for (int level = BLIT_SSE2; level < BLIT_LEVEL_COUNT; ++level) {
+        if (Set_Shape_Blit_Level(BlitLevelType(level)) != level) {
+            printf("Blit level %d not supported on this CPU, skipping.\n", level);
+            continue;
+        }
+
+        for (const BlitCaseType& blit : BlitCases) {
+            for (int w = 1; w <= MAX_FRAME; w += (w < 40 ? 1 : 7)) {
+                for (int pass = 0; pass < 6; ++pass) {
+                    int h = 1 + (w * 7 + pass * 13) % 40;
+                    int x = (pass & 1) ? -(w / 3) : (w * 5) % 60;
+                    int y = (pass & 2) ? -(h / 2) : (pass * 9) % 50;
+                    int fade_count = pass % 4;
+                    uint8_t* ghost = (pass & 4) ? SparseGhostTable : GhostTable;
+
+                    Set_Shape_Blit_Level(BLIT_SCALAR);
+                    Draw(expected, x, y, w, h, blit.Flags, ghost, fade_count);
+
+                    Set_Shape_Blit_Level(BlitLevelType(level));
+                    Draw(actual, x, y, w, h, blit.Flags, ghost, fade_count);
+
+                    if (memcmp(expected.Get_Buffer(), actual.Get_Buffer(), BUFF_WIDTH * BUFF_HEIGHT) != 0) {
+                        BlitKernelsType kernels;
+                        Blit_Get_Kernels(BlitLevelType(level), kernels);
+                        fprintf(stderr,
+                                "%s %s blit of %dx%d at %d,%d fade %d did not match scalar.\n",
+                                kernels.Name,
+                                blit.Name,
+                                w,
+                                h,
+                                x,
+                                y,
+                                fade_count);
+                        ret = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    Set_Shape_Blit_Level(BLIT_AVX2);
+    return ret;
+}
+
+// Reports blit throughput for each level, only run when asked as the timings mean little on CI.
+void bench_levels()
+{
+    GraphicBufferClass buff(BUFF_WIDTH, BUFF_HEIGHT);
+    GraphicViewPortClass view(&buff, 0, 0, BUFF_WIDTH, BUFF_HEIGHT);
+    const int w = 64;
+    const int h = 64;
+    const int loops = 20000;
+
+    for (int level = BLIT_SCALAR; level < BLIT_LEVEL_COUNT; ++level) {
+        BlitKernelsType kernels;
+
+        if (!Blit_Get_Kernels(BlitLevelType(level), kernels)) {
+            continue;
+        }
+
+        Set_Shape_Blit_Level(BlitLevelType(level));
+
+        for (const BlitCaseType& blit : BlitCases) {
+            auto start = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < loops; ++i) {
+                if (blit.Flags & SHAPE_GHOST) {
+                    Buffer_Frame_To_Page(i & 31, i & 15, w, h, Frame, view, blit.Flags, SparseGhostTable, FadeTable, 1);
+                } else {
+                    Buffer_Frame_To_Page(i & 31, i & 15, w, h, Frame, view, blit.Flags, FadeTable, 1);
+                }
+            }
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            printf("%-7s %-13s %8.1f Mpixel/s\n", kernels.Name, blit.Name, double(w) * h * loops / seconds / 1e6);
+        }
+    }
+
+    Set_Shape_Blit_Level(BLIT_AVX2);
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    Build_Data();
+
+    ret |= test_levels();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_levels();
+    }
+
+    return ret;
+}
@@ -0,0 +1,352 @@
+#include "common/celltable.h"
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#define MAP_WIDTH  128
+#define MAP_HEIGHT 128
+#define MAP_TOTAL  (MAP_WIDTH * MAP_HEIGHT)
+#define LAND_TYPES 9
+#define SPEEDS     3
+#define LAND_CLEAR 0
+
+static uint32_t Seed = 0x13579bd;
+
+static int Random(int range)
+{
+    Seed = Seed * 1103515245 + 12345;
+    return int((Seed >> 8) % unsigned(range));
+}
+
+/*
+** Stand in for the game's cell object, the movement fields mixed in with as much other state
+** as the real one carries.
+*/
+struct CellStruct
+{
+    unsigned char Zones[CellTableClass::ZONE_TYPES];
+    void* Trigger;
+    short Template;
+    unsigned char Icon;
+    unsigned char Wall;
+    unsigned char Land;
+    void* Occupier;
+    void* Overlapper[6];
+    unsigned Mapped;
+    unsigned Visible;
+    unsigned char Composite;
+    void* Flag;
+};
+
+static CellStruct Cells[MAP_TOTAL];
+static CellTableClass Tables(MAP_WIDTH, MAP_HEIGHT);
+
+/*
+** Which land types each speed can cross, as the ground cost table would give.
+*/
+static const bool Passable[SPEEDS][LAND_TYPES] = {
+    {true, true, true, false, false, true, true, true, false},
+    {true, true, false, false, false, true, true, true, false},
+    {false, false, false, false, true, false, false, false, false},
+};
+
+static void Build_Map()
+{
+    for (int cell = 0; cell < MAP_TOTAL; ++cell) {
+        CellStruct& c = Cells[cell];
+        memset(&c, 0, sizeof(c));
+
+        int roll = Random(100);
+        c.Land = roll < 70 ? LAND_CLEAR : Random(LAND_TYPES);
+        c.Wall = Random(100) < 5 ? 1 + Random(2) : CELLWALL_NONE;
+        c.Composite = Random(100) < 10 ? (unsigned char)(1 << Random(8)) : 0;
+        for (int type = 0; type < CellTableClass::ZONE_TYPES; ++type) {
+            c.Zones[type] = (unsigned char)(1 + Random(3));
+        }
+
+        Tables.Set_Composite(cell, c.Composite);
+        Tables.Set_Terrain(cell, c.Wall != CELLWALL_NONE ? LAND_CLEAR : c.Land, c.Wall);
+        for (int type = 0; type < CellTableClass::ZONE_TYPES; ++type) {
+            Tables.Set_Zone(cell, type, c.Zones[type]);
+        }
+    }
+}
+
+/*
+** The cell by cell check the tables replace, as the game's Is_Clear_To_Move does it.
+*/
+static bool
+Reference_Clear(int cell, int speed, bool ignoreinfantry, bool ignorevehicles, int zone, int check)
+{
+    CellStruct const& c = Cells[cell];
+
+    if (zone != -1 && c.Zones[check] != zone) {
+        return false;
+    }
+
+    int composite = c.Composite;
+    if (ignoreinfantry) {
+        composite &= 0xE0;
+    }
+    if (ignorevehicles) {
+        composite &= 0x5F;
+    }
+    if (composite != 0) {
+        return false;
+    }
+
+    int land = c.Land;
+    if (c.Wall != CELLWALL_NONE) {
+        if (check != 2 && (check != 1 || c.Wall != CELLWALL_CRUSHABLE)) {
+            return false;
+        }
+        land = LAND_CLEAR;
+    }
+
+    return Passable[speed][land];
+}
+
+static CellQueryType Make_Query(int speed, bool ignoreinfantry, bool ignorevehicles, int zone, int check)
+{
+    CellQueryType query;
+
+    query.LandMask = 0;
+    for (int land = 0; land < LAND_TYPES; ++land) {
+        if (Passable[speed][land]) {
+            query.LandMask |= 1U << land;
+        }
+    }
+    query.Blocking = 0xFF;
+    if (ignoreinfantry) {
+        query.Blocking &= 0xE0;
+    }
+    if (ignorevehicles) {
+        query.Blocking &= 0x5F;
+    }
+    query.WallLimit = check == 2 ? CELLWALL_SOLID : (check == 1 ? CELLWALL_CRUSHABLE : CELLWALL_NONE);
+    query.ZoneType = check;
+    query.Zone = zone;
+    return query;
+}
+
+// Single cell, row and rectangle queries must all agree with the cell by cell check.
+int test_queries()
+{
+    int ret = 0;
+    std::vector<unsigned char> result(MAP_TOTAL);
+
+    for (int speed = 0; speed < SPEEDS; ++speed) {
+        for (int flags = 0; flags < 4; ++flags) {
+            for (int check = 0; check < 3; ++check) {
+                for (int zone = -1; zone <= 3; ++zone) {
+                    bool inf = (flags & 1) != 0;
+                    bool veh = (flags & 2) != 0;
+                    CellQueryType query = Make_Query(speed, inf, veh, zone, check);
+                    int expected_count = 0;
+
+                    for (int cell = 0; cell < MAP_TOTAL; ++cell) {
+                        bool expected = Reference_Clear(cell, speed, inf, veh, zone, check);
+                        expected_count += expected;
+                        if (Tables.Is_Clear(cell, query) != expected) {
+                            fprintf(stderr, "Cell %d differs for speed %d check %d zone %d.\n", cell, speed, check, zone);
+                            return 1;
+                        }
+                    }
+
+                    // Rows that start part way along, so the vector loops get ragged ends.
+                    for (int y = 0; y < MAP_HEIGHT; ++y) {
+                        int x = y % 7;
+                        int count = MAP_WIDTH - x - y % 5;
+                        int clear = Tables.Clear_Row(y * MAP_WIDTH + x, count, query, result.data());
+                        int tally = 0;
+                        for (int i = 0; i < count; ++i) {
+                            bool expected = Reference_Clear(y * MAP_WIDTH + x + i, speed, inf, veh, zone, check);
+                            tally += expected;
+                            if (result[i] != expected) {
+                                fprintf(stderr, "Row %d cell %d differs.\n", y, x + i);
+                                ret = 1;
+                            }
+                        }
+                        if (clear != tally) {
+                            fprintf(stderr, "Row %d counted %d clear, expected %d.\n", y, clear, tally);
+                            ret = 1;
+                        }
+                    }
+
+                    int clear = Tables.Clear_Rect(0, 0, MAP_WIDTH, MAP_HEIGHT, query, result.data());
+                    if (clear != expected_count) {
+                        fprintf(stderr, "Map counted %d clear, expected %d.\n", clear, expected_count);
+                        ret = 1;
+                    }
+
+                    clear = Tables.Clear_Rect(5, 9, 17, 23, query, result.data());
+                    for (int y = 0; y < 23; ++y) {
+                        for (int x = 0; x < 17; ++x) {
+                            if (result[y * 17 + x]
+                                != Reference_Clear((y + 9) * MAP_WIDTH + x + 5, speed, inf, veh, zone, check)) {
+                                fprintf(stderr, "Rect cell %d,%d differs.\n", x, y);
+                                ret = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*
+** How each search tests a cell. Cell checks the stand in cells one at a time, Table checks the
+** tables one cell at a time and Batch tests the whole map with one rectangle query up front.
+*/
+enum SearchType
+{
+    SEARCH_CELL,
+    SEARCH_TABLE,
+    SEARCH_BATCH,
+    SEARCH_COUNT
+};
+
+/*
+** Breadth first search over the 8 connected cells, returns the path length in cells or -1.
+*/
+static int Find_Path(SearchType type, int start, int goal, int speed, int check, std::vector<int>& queue)
+{
+    static short distance[MAP_TOTAL];
+    static unsigned char clear[MAP_TOTAL];
+    static const int dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static const int dy[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+    CellQueryType query = Make_Query(speed, false, false, -1, check);
+    if (type == SEARCH_BATCH) {
+        Tables.Clear_Rect(0, 0, MAP_WIDTH, MAP_HEIGHT, query, clear);
+    }
+
+    memset(distance, 0xFF, sizeof(distance));
+    queue.clear();
+    queue.push_back(start);
+    distance[start] = 0;
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int cell = queue[head];
+        if (cell == goal) {
+            return distance[cell];
+        }
+
+        int x = cell % MAP_WIDTH;
+        int y = cell / MAP_WIDTH;
+        for (int dir = 0; dir < 8; ++dir) {
+            int nx = x + dx[dir];
+            int ny = y + dy[dir];
+            if (nx < 0 || ny < 0 || nx >= MAP_WIDTH || ny >= MAP_HEIGHT) {
+                continue;
+            }
+
+            int next = ny * MAP_WIDTH + nx;
+            if (distance[next] != -1) {
+                continue;
+            }
+
+            bool ok;
+            switch (type) {
+            case SEARCH_CELL:
+                ok = Reference_Clear(next, speed, false, false, -1, check);
+                break;
+            case SEARCH_TABLE:
+                ok = Tables.Is_Clear(next, query);
+                break;
+            default:
+                ok = clear[next] != 0;
+                break;
+            }
+
+            if (ok) {
+                distance[next] = short(distance[cell] + 1);
+                queue.push_back(next);
+            }
+        }
+    }
+
+    return -1;
+}
+
+static void Pick_Route(int& start, int& goal)
+{
+    start = Random(MAP_TOTAL);
+    goal = Random(MAP_TOTAL);
+}
+
+// Every way of testing cells must find paths of the same length.
+int test_paths()
+{
+    int ret = 0;
+    std::vector<int> queue;
+    queue.reserve(MAP_TOTAL);
+
+    for (int i = 0; i < 60; ++i) {
+        int start;
+        int goal;
+        Pick_Route(start, goal);
+        int speed = i % SPEEDS;
+        int check = i % 3;
+
+        int expected = Find_Path(SEARCH_CELL, start, goal, speed, check, queue);
+        for (int type = SEARCH_TABLE; type < SEARCH_COUNT; ++type) {
+            int length = Find_Path(SearchType(type), start, goal, speed, check, queue);
+            if (length != expected) {
+                fprintf(stderr, "Search %d from %d to %d found %d, expected %d.\n", type, start, goal, length, expected);
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Reports path search throughput, only run when asked as the timings mean little on CI.
+void bench_paths()
+{
+    static const char* names[SEARCH_COUNT] = {"cell objects", "cell tables", "batched tables"};
+    const int searches = 400;
+    std::vector<int> queue;
+    queue.reserve(MAP_TOTAL);
+
+    for (int type = 0; type < SEARCH_COUNT; ++type) {
+        uint32_t seed = Seed;
+        long long visited = 0;
+
+        auto start_time = std::chrono::steady_clock::now();
+        for (int i = 0; i < searches; ++i) {
+            int start;
+            int goal;
+            Pick_Route(start, goal);
+            Find_Path(SearchType(type), start, goal, i % SPEEDS, i % 3, queue);
+            visited += queue.size();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        printf("%s: %.3f ms per search, %lld cells queued\n", names[type], seconds * 1000.0 / searches, visited);
+        Seed = seed;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    Build_Map();
+
+    ret |= test_queries();
+    ret |= test_paths();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_paths();
+    }
+
+    return ret;
+}
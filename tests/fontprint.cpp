@@ -0,0 +1,287 @@
+#include "common/blitsimd.h"
+#include "common/font.h"
+#include "common/gbuffer.h"
+#include "common/settings.h"
+#include "common/wwkeyboard.h"
+
+#include <chrono>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+// Globals needed to compile GraphicBufferClass.
+bool GameInFocus;
+int ScreenWidth;
+int WindowList[9][9];
+char* _ShapeBuffer = 0;
+WWKeyboardClass* Keyboard;
+
+void Process_Network()
+{
+}
+
+void Focus_Restore()
+{
+}
+
+void Focus_Loss()
+{
+}
+
+int Open_File(char const*, int)
+{
+    return 0;
+}
+
+void Close_File(int)
+{
+}
+
+int Read_File(int, void*, unsigned int)
+{
+    return 0;
+}
+
+void Mem_Copy(void const* source, void* dest, unsigned int bytes_to_copy)
+{
+    memmove(dest, source, bytes_to_copy);
+}
+
+#define BUFF_WIDTH  320
+#define BUFF_HEIGHT 200
+
+#define FONT_HEIGHT    10
+#define FONT_MAX_WIDTH 11
+
+/*
+** Font layout, the header is followed by the offset, width and line lists and then the glyphs.
+*/
+#define FONT_OFFSETS 20
+#define FONT_WIDTHS  (FONT_OFFSETS + 256 * 2)
+#define FONT_LINES   (FONT_WIDTHS + 256)
+#define FONT_DATA    (FONT_LINES + 256 * 2)
+#define FONT_SIZE    (FONT_DATA + 256 * FONT_HEIGHT * ((FONT_MAX_WIDTH + 1) / 2))
+
+static uint32_t Seed = 0x2468ace;
+
+static int Random(int range)
+{
+    Seed = Seed * 1103515245 + 12345;
+    return int((Seed >> 8) % unsigned(range));
+}
+
+static uint8_t Font[FONT_SIZE];
+static uint8_t Background[BUFF_WIDTH * BUFF_HEIGHT];
+
+static void Put_Short(int offset, int value)
+{
+    Font[offset] = uint8_t(value);
+    Font[offset + 1] = uint8_t(value >> 8);
+}
+
+/*
+** A font with glyphs of every width, some with blank lines above and below, some with none at all
+** and a few with no lines of data, using all 16 colors.
+*/
+static void Build_Font()
+{
+    memset(Font, 0, sizeof(Font));
+    Put_Short(0, FONT_SIZE);
+    Font[3] = 5;
+    Put_Short(4, 14);
+    Put_Short(6, FONT_OFFSETS);
+    Put_Short(8, FONT_WIDTHS);
+    Put_Short(10, FONT_DATA);
+    Put_Short(12, FONT_LINES);
+    Font[17] = 255;
+    Font[18] = FONT_HEIGHT;
+    Font[19] = FONT_MAX_WIDTH;
+
+    int data = FONT_DATA;
+
+    for (int i = 0; i < 256; ++i) {
+        int width = Random(FONT_MAX_WIDTH + 1);
+        int ypos = Random(4);
+        int lines = Random(8) == 0 ? 0 : 1 + Random(FONT_HEIGHT - ypos);
+
+        Put_Short(FONT_OFFSETS + i * 2, data);
+        Font[FONT_WIDTHS + i] = width;
+        Put_Short(FONT_LINES + i * 2, ypos | (lines << 8));
+
+        for (int j = 0; j < lines * ((width + 1) / 2); ++j) {
+            // Mostly the text color or nothing, like real fonts.
+            int low = Random(4) == 0 ? Random(16) : Random(2);
+            int high = Random(4) == 0 ? Random(16) : Random(2);
+            Font[data++] = low | (high << 4);
+        }
+    }
+
+    for (int i = 0; i < BUFF_WIDTH * BUFF_HEIGHT; ++i) {
+        Background[i] = Random(256);
+    }
+
+    Set_Font(Font);
+}
+
+static void Random_String(char* string, int length, bool breaks)
+{
+    for (int i = 0; i < length; ++i) {
+        string[i] = 32 + Random(224);
+
+        if (breaks && Random(12) == 0) {
+            string[i] = Random(2) ? '\n' : '\r';
+        }
+    }
+
+    string[length] = '\0';
+}
+
+static bool Print_Both(GraphicBufferClass& expected,
+                       GraphicBufferClass& actual,
+                       char const* string,
+                       int x,
+                       int y,
+                       int fground,
+                       int bground)
+{
+    GraphicViewPortClass expected_view(&expected, 8, 4, BUFF_WIDTH - 16, BUFF_HEIGHT - 8);
+    GraphicViewPortClass actual_view(&actual, 8, 4, BUFF_WIDTH - 16, BUFF_HEIGHT - 8);
+
+    memcpy(expected.Get_Buffer(), Background, BUFF_WIDTH * BUFF_HEIGHT);
+    memcpy(actual.Get_Buffer(), Background, BUFF_WIDTH * BUFF_HEIGHT);
+    Buffer_Print_Direct(&expected_view, string, x, y, fground, bground);
+    Buffer_Print(&actual_view, string, x, y, fground, bground);
+
+    return memcmp(expected.Get_Buffer(), actual.Get_Buffer(), BUFF_WIDTH * BUFF_HEIGHT) == 0;
+}
+
+// Every string must come out the same as the original routine draws it, whatever the spacing,
+// colors, blitters and run cache settings.
+int test_pixels()
+{
+    int ret = 0;
+    GraphicBufferClass expected(BUFF_WIDTH, BUFF_HEIGHT);
+    GraphicBufferClass actual(BUFF_WIDTH, BUFF_HEIGHT);
+    static const int spacings[] = {0, 1, -2};
+    static const unsigned char palette[] = {0, 0, 3, 0, 200, 17, 0, 99, 45, 0, 12, 250, 13, 7, 8};
+    char string[200];
+    int fground = 0;
+    int bground = 0;
+
+    for (int level = BLIT_SCALAR; level < BLIT_LEVEL_COUNT; ++level) {
+        if (Set_Font_Blit_Level(BlitLevelType(level)) != level) {
+            continue;
+        }
+
+        for (int runs = 0; runs < 2; ++runs) {
+            Settings.Video.TextRunCache = runs ? 8 : 0;
+            Set_Font_Palette_Range(palette, 1, 15);
+
+            for (int pass = 0; pass < 600; ++pass) {
+                FontXSpacing = spacings[(pass / 4) % 3];
+                FontYSpacing = Random(3);
+
+                if (pass == 300) {
+                    Set_Font_Palette_Range(palette + 1, 2, 15);
+                }
+
+                // Draw some strings again in the same colors elsewhere, so drawn strings get found.
+                if (pass % 4 != 3) {
+                    Random_String(string, 1 + Random(pass % 5 == 0 ? 150 : 20), pass % 7 == 0);
+                    fground = 1 + Random(255);
+                    bground = Random(3) == 0 ? 0 : Random(256);
+                }
+
+                int x = Random(BUFF_WIDTH - 16);
+                int y = Random(BUFF_HEIGHT - 8);
+
+                if (!Print_Both(expected, actual, string, x, y, fground, bground)) {
+                    fprintf(stderr,
+                            "Level %d, runs %d, pass %d: \"%s\" at %d,%d differs from the original.\n",
+                            level,
+                            runs,
+                            pass,
+                            string,
+                            x,
+                            y);
+                    ret = 1;
+                }
+            }
+        }
+    }
+
+    FontCacheStatsType stats;
+    Get_Font_Cache_Stats(stats);
+    if (stats.Hits == 0 || stats.Entries > 8) {
+        fprintf(stderr, "Drawn strings were found %u times with %u kept.\n", stats.Hits, stats.Entries);
+        ret = 1;
+    }
+
+    Free_Font_Cache();
+    Get_Font_Cache_Stats(stats);
+    if (stats.Entries != 0 || stats.Bytes != 0) {
+        fprintf(stderr, "Free left %u drawn strings.\n", stats.Entries);
+        ret = 1;
+    }
+
+    Set_Font_Blit_Level(BLIT_AVX2);
+    return ret;
+}
+
+typedef int (*PrintType)(void* thisptr, const char* str, int x, int y, int fcolor, int bcolor);
+
+// Print the sort of strings the sidebar and counters redraw every frame.
+static double Time_Print(PrintType print, GraphicBufferClass& buff, int loops)
+{
+    static const char* strings[] = {"$12345", "Power", "Ore Truck", "Construction Yard", "Player 3: gg"};
+    static const int colors[] = {0, 0, 15, 0, 120};
+    GraphicViewPortClass view(&buff, 0, 0, BUFF_WIDTH, BUFF_HEIGHT);
+    long long chars = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < loops; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            print(&view, strings[j], (i * 7 + j * 31) % 160, (i * 3 + j * 29) % 180, 1 + j * 40, colors[j]);
+            chars += strlen(strings[j]);
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return double(chars) / seconds / 1e6;
+}
+
+int test_speed()
+{
+    GraphicBufferClass buff(BUFF_WIDTH, BUFF_HEIGHT);
+    int loops = 200000;
+
+    FontXSpacing = 1;
+    FontYSpacing = 0;
+
+    double direct = Time_Print(Buffer_Print_Direct, buff, loops);
+
+    Settings.Video.TextRunCache = 0;
+    double atlas = Time_Print(Buffer_Print, buff, loops);
+
+    Settings.Video.TextRunCache = 64;
+    double runs = Time_Print(Buffer_Print, buff, loops);
+
+    printf("Direct       %8.2f Mchar/s\n", direct);
+    printf("Atlas        %8.2f Mchar/s\n", atlas);
+    printf("Atlas + runs %8.2f Mchar/s\n", runs);
+
+    return 0;
+}
+
+int main()
+{
+    int ret = 0;
+
+    Build_Font();
+
+    ret |= test_pixels();
+    ret |= test_speed();
+
+    return ret;
+}
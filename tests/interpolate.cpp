@@ -0,0 +1,237 @@
+#include "common/interpscale.h"
+#include "common/winasm.h"
+#include "common/workerpool.h"
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#define SRC_WIDTH  320
+#define SRC_HEIGHT 200
+#define FILL       0xCD
+
+static uint32_t Seed = 0x2468ace;
+
+static uint8_t Random_Byte()
+{
+    Seed = Seed * 1103515245 + 12345;
+    return uint8_t(Seed >> 16);
+}
+
+static uint8_t Source[SRC_WIDTH * SRC_HEIGHT];
+static struct InterpolationTable Table;
+
+static void Build_Data()
+{
+    // Runs of the same color, like the menu art, with noise between them.
+    uint8_t color = 0;
+    for (int i = 0; i < SRC_WIDTH * SRC_HEIGHT; ++i) {
+        if ((Random_Byte() & 3) == 0) {
+            color = Random_Byte();
+        }
+        Source[i] = color;
+    }
+
+    // Not symmetric, so swapped arguments show up.
+    for (int a = 0; a < 256; ++a) {
+        for (int b = 0; b < 256; ++b) {
+            Table.PaletteInterpolationTable[a][b] = uint8_t(a * 3 + b * 5 + (a ^ b));
+        }
+    }
+
+    InterpolationTable = &Table;
+}
+
+static uint32_t CRC32(const uint8_t* data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+static void Scale(std::vector<uint8_t>& out, int height, int scale, int mode)
+{
+    out.assign(SRC_WIDTH * scale * height * scale, FILL);
+    Interpolate_Scale(Source,
+                      out.data(),
+                      height,
+                      SRC_WIDTH,
+                      SRC_WIDTH * scale,
+                      scale,
+                      mode,
+                      &Table.PaletteInterpolationTable[0][0]);
+}
+
+// At 2x the output must match the original routines byte for byte, untouched rows included.
+int test_reference()
+{
+    int ret = 0;
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> actual;
+
+    for (int mode = 0; mode < 3; ++mode) {
+        expected.assign(SRC_WIDTH * 2 * SRC_HEIGHT * 2, FILL);
+        switch (mode) {
+        case 0:
+            Asm_Interpolate(Source, expected.data(), SRC_HEIGHT, SRC_WIDTH, SRC_WIDTH * 4);
+            break;
+        case 1:
+            Asm_Interpolate_Line_Double(Source, expected.data(), SRC_HEIGHT, SRC_WIDTH, SRC_WIDTH * 4);
+            break;
+        default:
+            Asm_Interpolate_Line_Interpolate(Source, expected.data(), SRC_HEIGHT, SRC_WIDTH, SRC_WIDTH * 4);
+            break;
+        }
+
+        Scale(actual, SRC_HEIGHT, 2, mode);
+
+        if (actual != expected) {
+            fprintf(stderr, "2x mode %d did not match the original routine.\n", mode);
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
+
+// Every kernel level and thread count must give the same image, including band splits that
+// leave odd row counts.
+int test_levels()
+{
+    int ret = 0;
+    static const int heights[] = {1, 2, 17, 37, SRC_HEIGHT};
+    static const int threads[] = {1, 3, 8};
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> actual;
+
+    for (int height : heights) {
+        for (int scale = 1; scale <= 4; ++scale) {
+            for (int mode = 0; mode < 3; ++mode) {
+                Set_Interpolate_Level(BLIT_SCALAR);
+                Worker_Pool().Init(1);
+                Scale(expected, height, scale, mode);
+
+                for (int level = BLIT_SCALAR; level < BLIT_LEVEL_COUNT; ++level) {
+                    if (Set_Interpolate_Level(BlitLevelType(level)) != level) {
+                        continue;
+                    }
+
+                    for (int count : threads) {
+                        Worker_Pool().Init(count);
+                        Scale(actual, height, scale, mode);
+
+                        if (actual != expected) {
+                            fprintf(stderr,
+                                    "%dx mode %d of %d rows at level %d on %d threads did not match.\n",
+                                    scale,
+                                    mode,
+                                    height,
+                                    level,
+                                    count);
+                            ret = 1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    Set_Interpolate_Level(BLIT_AVX2);
+    Worker_Pool().Init();
+    return ret;
+}
+
+// Golden checksums of the 3x and 4x images, these have no original routine to compare with.
+int test_golden()
+{
+    int ret = 0;
+    static const uint32_t golden[2][3] = {
+        {0x5999acf6, 0x248f65f7, 0xad86a08c},
+        {0x84b1c2a5, 0xc598513c, 0x80c22d81},
+    };
+    std::vector<uint8_t> actual;
+
+    for (int scale = 3; scale <= 4; ++scale) {
+        for (int mode = 0; mode < 3; ++mode) {
+            Scale(actual, SRC_HEIGHT, scale, mode);
+            uint32_t crc = CRC32(actual.data(), actual.size());
+
+            if (crc != golden[scale - 3][mode]) {
+                fprintf(stderr, "%dx mode %d gave %08x, expected %08x.\n", scale, mode, crc, golden[scale - 3][mode]);
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Reports scaling throughput, only run when asked as the timings mean little on CI.
+void bench_scale()
+{
+    std::vector<uint8_t> out;
+    const int loops = 200;
+    static const int threads[] = {1, 0};
+
+    for (int level = BLIT_SCALAR; level < BLIT_LEVEL_COUNT; ++level) {
+        if (Set_Interpolate_Level(BlitLevelType(level)) != level) {
+            continue;
+        }
+
+        for (int count : threads) {
+            Worker_Pool().Init(count);
+
+            for (int scale = 2; scale <= 4; ++scale) {
+                for (int mode = 0; mode < 3; ++mode) {
+                    out.assign(SRC_WIDTH * scale * SRC_HEIGHT * scale, FILL);
+                    auto start = std::chrono::steady_clock::now();
+                    for (int i = 0; i < loops; ++i) {
+                        Interpolate_Scale(Source,
+                                          out.data(),
+                                          SRC_HEIGHT,
+                                          SRC_WIDTH,
+                                          SRC_WIDTH * scale,
+                                          scale,
+                                          mode,
+                                          &Table.PaletteInterpolationTable[0][0]);
+                    }
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    printf("level %d, %d threads, %dx mode %d: %.3f ms\n",
+                           level,
+                           Worker_Pool().Thread_Count(),
+                           scale,
+                           mode,
+                           seconds * 1000.0 / loops);
+                }
+            }
+        }
+    }
+
+    Set_Interpolate_Level(BLIT_AVX2);
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+
+    Build_Data();
+
+    ret |= test_reference();
+    ret |= test_levels();
+    ret |= test_golden();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_scale();
+    }
+
+    return ret;
+}
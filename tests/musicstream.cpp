@@ -0,0 +1,302 @@
+#include "common/musicstream.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#define CHUNK_SIZE 1000
+#define CHUNKS     4
+#define TRACKS     3
+
+/*
+** Tracks "A", "B" and "C" fill every byte with their letter and position, "B" is an exact number
+** of chunks long.
+*/
+static const int TrackSize[TRACKS] = {5500, 3000, 12345};
+
+class TestStreamClass : public MusicStreamClass
+{
+public:
+    TestStreamClass()
+        : MusicStreamClass(CHUNK_SIZE, CHUNKS)
+        , Opens(0)
+        , Closes(0)
+        , BadCloses(0)
+        , Slow(false)
+        , Reading(-1)
+    {
+        memset(Position, 0, sizeof(Position));
+    }
+
+    ~TestStreamClass()
+    {
+        Shutdown();
+    }
+
+    int Opens;
+    int Closes;
+    int BadCloses;
+    std::atomic<bool> Slow;
+
+protected:
+    virtual int Open_Track(char const* name)
+    {
+        int track = name[0] - 'A';
+        if (track < 0 || track >= TRACKS || name[1] != '\0') {
+            return -1;
+        }
+
+        /*
+        ** Handles are the track plus a count of opens, so each open of a track reads from the start.
+        */
+        int handle = Opens++ * TRACKS + track;
+        Position[handle % (TRACKS * 8)] = 0;
+        return handle;
+    }
+
+    virtual int Read_Track(int handle, void* buffer, int size)
+    {
+        Reading = handle;
+        if (Slow) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        int track = handle % TRACKS;
+        int& position = Position[handle % (TRACKS * 8)];
+        int count = TrackSize[track] - position < size ? TrackSize[track] - position : size;
+        for (int i = 0; i < count; ++i) {
+            static_cast<char*>(buffer)[i] = char('A' + track + position + i);
+        }
+        position += count;
+
+        Reading = -1;
+        return count;
+    }
+
+    virtual void Close_Track(int handle)
+    {
+        if (Reading == handle) {
+            BadCloses++;
+        }
+        Closes++;
+    }
+
+private:
+    int Position[TRACKS * 8];
+    std::atomic<int> Reading;
+};
+
+/*
+** Read the rest of the track being played, checking it is the given track from the offset on.
+*/
+static bool Check_Track(TestStreamClass& stream, int track, int offset)
+{
+    char buffer[CHUNK_SIZE];
+
+    while (true) {
+        int size = stream.Read(buffer, true);
+        if (size == 0) {
+            break;
+        }
+        if (size < 0 || offset + size > TrackSize[track] || (size < CHUNK_SIZE && offset + size != TrackSize[track])) {
+            fprintf(stderr, "Track %c read %d bytes at %d.\n", 'A' + track, size, offset);
+            return false;
+        }
+        for (int i = 0; i < size; ++i) {
+            if (buffer[i] != char('A' + track + offset + i)) {
+                fprintf(stderr, "Track %c has the wrong data at %d.\n", 'A' + track, offset + i);
+                return false;
+            }
+        }
+        offset += size;
+    }
+
+    if (offset != TrackSize[track]) {
+        fprintf(stderr, "Track %c ended at %d.\n", 'A' + track, offset);
+        return false;
+    }
+    return stream.Read(buffer, false) == 0;
+}
+
+static void Wait_For_Reader()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+// Tracks started without a prefetch are read in full and counted as misses.
+int test_read()
+{
+    int ret = 0;
+    TestStreamClass stream;
+    MusicStreamStatsType stats;
+
+    for (int track = 0; track < TRACKS; ++track) {
+        char name[2] = {char('A' + track), '\0'};
+        if (!stream.Start(name) || !Check_Track(stream, track, 0)) {
+            fprintf(stderr, "Track %s didn't play.\n", name);
+            ret = 1;
+        }
+    }
+
+    if (stream.Start("D") || stream.Prefetch("D")) {
+        fprintf(stderr, "A missing track was opened.\n");
+        ret = 1;
+    }
+
+    stream.Get_Stats(stats);
+    if (stats.Misses != TRACKS + 1 || stats.Hits != 0 || stats.Bytes != size_t(5500 + 3000 + 12345)) {
+        fprintf(stderr, "Read %zu bytes with %u hits and %u misses.\n", stats.Bytes, stats.Hits, stats.Misses);
+        ret = 1;
+    }
+
+    stream.Shutdown();
+    if (stream.Opens != stream.Closes || stream.BadCloses != 0) {
+        fprintf(stderr, "%d tracks opened and %d closed.\n", stream.Opens, stream.Closes);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// A prefetched track is ready to play the moment it starts and is counted as a hit.
+int test_prefetch()
+{
+    int ret = 0;
+    TestStreamClass stream;
+    MusicStreamStatsType stats;
+    char buffer[CHUNK_SIZE];
+
+    stream.Start("A");
+    stream.Prefetch("C");
+    stream.Prefetch("C");
+    Wait_For_Reader();
+
+    if (!stream.Start("C") || stream.Read(buffer, false) != CHUNK_SIZE || !Check_Track(stream, 2, CHUNK_SIZE)) {
+        fprintf(stderr, "Prefetched track wasn't ready.\n");
+        ret = 1;
+    }
+
+    stream.Get_Stats(stats);
+    if (stats.Prefetches != 1 || stats.Hits != 1 || stats.Misses != 1 || stats.LeadTime < 40) {
+        fprintf(stderr,
+                "%u prefetches, %u hits, %u misses, %u ms lead.\n",
+                stats.Prefetches,
+                stats.Hits,
+                stats.Misses,
+                stats.LeadTime);
+        ret = 1;
+    }
+
+    // Starting something else keeps the prefetch, a new prefetch replaces it.
+    stream.Prefetch("B");
+    stream.Start("A");
+    if (!stream.Is_Prefetched()) {
+        fprintf(stderr, "Prefetch was dropped.\n");
+        ret = 1;
+    }
+    stream.Prefetch(nullptr);
+    if (stream.Is_Prefetched() || stream.Start_Next()) {
+        fprintf(stderr, "Prefetch wasn't dropped.\n");
+        ret = 1;
+    }
+
+    stream.Shutdown();
+    if (stream.Opens != stream.Closes || stream.BadCloses != 0) {
+        fprintf(stderr, "%d tracks opened and %d closed.\n", stream.Opens, stream.Closes);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// The prefetched track follows straight on from the last one.
+int test_handoff()
+{
+    int ret = 0;
+    TestStreamClass stream;
+    MusicStreamStatsType stats;
+
+    stream.Start("A");
+    for (int pass = 0; pass < 4; ++pass) {
+        int track = pass % 2 == 0 ? 1 : 0;
+        char name[2] = {char('A' + track), '\0'};
+
+        stream.Prefetch(name);
+        if (!Check_Track(stream, 1 - track, 0) || !stream.Start_Next() || stream.Is_Prefetched()) {
+            fprintf(stderr, "Handoff %d failed.\n", pass);
+            ret = 1;
+        }
+    }
+
+    if (!Check_Track(stream, 0, 0)) {
+        ret = 1;
+    }
+
+    stream.Get_Stats(stats);
+    if (stats.Handoffs != 4 || stats.Prefetches != 4) {
+        fprintf(stderr, "%u handoffs from %u prefetches.\n", stats.Handoffs, stats.Prefetches);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// A slow reader makes the player wait, which is counted, unless it asked not to.
+int test_underrun()
+{
+    int ret = 0;
+    TestStreamClass stream;
+    MusicStreamStatsType stats;
+    char buffer[CHUNK_SIZE];
+
+    stream.Slow = true;
+    stream.Start("C");
+    if (stream.Read(buffer, false) != MusicStreamClass::STREAM_WAIT) {
+        fprintf(stderr, "Slow reader had a chunk ready.\n");
+        ret = 1;
+    }
+
+    stream.Get_Stats(stats);
+    if (stats.Underruns != 0) {
+        fprintf(stderr, "Not waiting counted an underrun.\n");
+        ret = 1;
+    }
+
+    // Stopping while the reader is busy waits for it before closing the track.
+    stream.Start("A");
+    if (!Check_Track(stream, 0, 0)) {
+        ret = 1;
+    }
+
+    stream.Get_Stats(stats);
+    if (stats.Underruns == 0) {
+        fprintf(stderr, "Waiting didn't count an underrun.\n");
+        ret = 1;
+    }
+
+    stream.Shutdown();
+    if (stream.Opens != stream.Closes || stream.BadCloses != 0) {
+        fprintf(stderr,
+                "%d tracks opened and %d closed, %d while reading.\n",
+                stream.Opens,
+                stream.Closes,
+                stream.BadCloses);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_read();
+    ret |= test_prefetch();
+    ret |= test_handoff();
+    ret |= test_underrun();
+
+    return ret;
+}
@@ -0,0 +1,309 @@
+#include "common/palette.h"
+#include "common/framelimit.h"
+#include "common/mssleep.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#define MAX_SETS 4096
+
+static unsigned char Sets[MAX_SETS][PALETTE_BYTES];
+static int SetCount;
+static int LimiterCount;
+static int CallbackCount;
+
+void Set_Palette_Range(void* palette)
+{
+    memcpy(CurrentPalette, palette, PALETTE_BYTES);
+    if (SetCount < MAX_SETS) {
+        memcpy(Sets[SetCount], palette, PALETTE_BYTES);
+    }
+    SetCount++;
+}
+
+void Frame_Limiter(FrameLimitFlags)
+{
+    LimiterCount++;
+}
+
+static void Callback()
+{
+    CallbackCount++;
+}
+
+static uint32_t Seed = 0x13579bdf;
+
+static uint32_t Random()
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+}
+
+static void Random_Palette(unsigned char* palette)
+{
+    for (int i = 0; i < PALETTE_BYTES; ++i) {
+        palette[i] = Random() % 64;
+    }
+}
+
+/*
+** The palettes the original fade stepped through, worked out the way it did from the palette it
+** started at.
+*/
+static std::vector<std::vector<unsigned char>>
+Reference_Steps(unsigned char const* from, unsigned char const* to, int delay, int first, int count)
+{
+    int diff = 0;
+    for (int i = first * RGB_BYTES; i < (first + count) * RGB_BYTES; ++i) {
+        diff = std::max(diff, abs(from[i] - to[i]));
+    }
+
+    int t = delay << 8;
+    if (diff) {
+        t = std::min(t / diff, 0x7FFF);
+    }
+    short ticks = short(t);
+    short tp = ticks;
+    short jump = 1;
+    while (jump <= diff && ticks < 256) {
+        ticks += tp;
+        jump += 1;
+    }
+
+    std::vector<std::vector<unsigned char>> steps;
+    std::vector<unsigned char> palette(from, from + PALETTE_BYTES);
+    while (memcmp(&palette[first * RGB_BYTES], &to[first * RGB_BYTES], count * RGB_BYTES) != 0) {
+        for (int i = first * RGB_BYTES; i < (first + count) * RGB_BYTES; ++i) {
+            if (palette[i] < to[i]) {
+                palette[i] = std::min(palette[i] + jump, int(to[i]));
+            } else if (palette[i] > to[i]) {
+                palette[i] = std::max(palette[i] - jump, int(to[i]));
+            }
+        }
+        steps.push_back(palette);
+    }
+    return steps;
+}
+
+/*
+** Every palette set from the given one on has to be a later step of the original fade than the
+** one before, ending on the last.
+*/
+static bool Check_Steps(const char* what, int set, std::vector<std::vector<unsigned char>> const& steps)
+{
+    size_t step = 0;
+    for (; set < SetCount; ++set) {
+        while (step < steps.size() && memcmp(steps[step].data(), Sets[set], PALETTE_BYTES) != 0) {
+            ++step;
+        }
+        if (step == steps.size()) {
+            fprintf(stderr, "%s set palette %d which isn't a step of the fade.\n", what, set);
+            return false;
+        }
+    }
+    if (step + 1 != steps.size()) {
+        fprintf(stderr, "%s stopped at step %zu of %zu.\n", what, step, steps.size());
+        return false;
+    }
+    return true;
+}
+
+/*
+** Tick the fade from a game loop that has other things to do, timing each tick.
+*/
+static bool Run_Fade(const char* what, int delay)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> slowest(0);
+
+    while (true) {
+        auto before = std::chrono::steady_clock::now();
+        bool active = Palette_Fade_Tick();
+        auto after = std::chrono::steady_clock::now();
+        slowest = std::max<std::chrono::duration<double>>(slowest, after - before);
+
+        if (!active) {
+            break;
+        }
+        if (after - start > std::chrono::seconds(5)) {
+            fprintf(stderr, "%s never finished.\n", what);
+            return false;
+        }
+        ms_sleep(3);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (slowest.count() > 0.002 || elapsed.count() < (delay - 4) / 120.0) {
+        fprintf(stderr, "%s took %f seconds, the slowest tick %f.\n", what, elapsed.count(), slowest.count());
+        return false;
+    }
+    return true;
+}
+
+// A fade ticked from a loop steps through what the original did and ends on the palette faded to.
+int test_fade()
+{
+    int ret = 0;
+    unsigned char from[PALETTE_BYTES];
+    unsigned char to[PALETTE_BYTES];
+
+    static const int delays[] = {0, 1, 15, 40};
+
+    for (int pass = 0; pass < int(sizeof(delays) / sizeof(delays[0])); ++pass) {
+        Random_Palette(from);
+        Random_Palette(to);
+        Set_Palette(from);
+        auto steps = Reference_Steps(from, to, delays[pass], 0, PALETTE_SIZE);
+
+        SetCount = 0;
+        Start_Palette_Fade(to, delays[pass]);
+        if (!Run_Fade("Fade", delays[pass]) || !Check_Steps("Fade", 0, steps)) {
+            ret = 1;
+        }
+        if (memcmp(CurrentPalette, to, PALETTE_BYTES) != 0 || Palette_Fade_Active()) {
+            fprintf(stderr, "Fade over %d ticks didn't finish on the palette.\n", delays[pass]);
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
+
+// Only the colours in range change, and a crossfade starts from the palette it is given.
+int test_range()
+{
+    int ret = 0;
+    unsigned char from[PALETTE_BYTES];
+    unsigned char to[PALETTE_BYTES];
+    unsigned char start[PALETTE_BYTES];
+    unsigned char expected[PALETTE_BYTES];
+
+    Random_Palette(start);
+    Random_Palette(from);
+    Random_Palette(to);
+
+    Set_Palette(start);
+    memcpy(expected, start, PALETTE_BYTES);
+    memcpy(&expected[16 * RGB_BYTES], &to[16 * RGB_BYTES], 32 * RGB_BYTES);
+    auto steps = Reference_Steps(start, to, 10, 16, 32);
+
+    SetCount = 0;
+    Start_Palette_Fade(to, 10, 16, 32);
+    if (!Run_Fade("Range", 10) || !Check_Steps("Range", 0, steps)
+        || memcmp(CurrentPalette, expected, PALETTE_BYTES) != 0) {
+        fprintf(stderr, "Range fade changed the wrong colours.\n");
+        ret = 1;
+    }
+
+    Set_Palette(start);
+    memcpy(expected, start, PALETTE_BYTES);
+    memcpy(&expected[200 * RGB_BYTES], &from[200 * RGB_BYTES], 56 * RGB_BYTES);
+    steps = Reference_Steps(expected, to, 20, 200, 56);
+    memcpy(&expected[200 * RGB_BYTES], &to[200 * RGB_BYTES], 56 * RGB_BYTES);
+
+    SetCount = 0;
+    Start_Palette_Fade(to, 20, 200, 56, from);
+    if (SetCount < 1 || memcmp(&Sets[0][200 * RGB_BYTES], &from[200 * RGB_BYTES], 56 * RGB_BYTES) != 0) {
+        fprintf(stderr, "Crossfade didn't start from the palette given.\n");
+        ret = 1;
+    }
+    if (!Run_Fade("Crossfade", 20) || !Check_Steps("Crossfade", 1, steps)
+        || memcmp(CurrentPalette, expected, PALETTE_BYTES) != 0) {
+        fprintf(stderr, "Crossfade didn't end on the palette.\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Cancelling leaves the palette where it got to or jumps to the end, a new fade or setting the
+// palette replaces the old.
+int test_cancel()
+{
+    int ret = 0;
+    unsigned char from[PALETTE_BYTES];
+    unsigned char to[PALETTE_BYTES];
+    unsigned char other[PALETTE_BYTES];
+    unsigned char held[PALETTE_BYTES];
+
+    Random_Palette(from);
+    Random_Palette(to);
+    Random_Palette(other);
+
+    Set_Palette(from);
+    Start_Palette_Fade(to, 60);
+    ms_sleep(100);
+    Palette_Fade_Tick();
+    memcpy(held, CurrentPalette, PALETTE_BYTES);
+    Cancel_Palette_Fade(false);
+    if (Palette_Fade_Active() || Palette_Fade_Tick() || memcmp(CurrentPalette, held, PALETTE_BYTES) != 0
+        || memcmp(held, from, PALETTE_BYTES) == 0 || memcmp(held, to, PALETTE_BYTES) == 0) {
+        fprintf(stderr, "Cancelled fade didn't stop where it was.\n");
+        ret = 1;
+    }
+
+    Start_Palette_Fade(to, 60);
+    Start_Palette_Fade(other, 60);
+    Cancel_Palette_Fade(true);
+    if (Palette_Fade_Active() || memcmp(CurrentPalette, other, PALETTE_BYTES) != 0) {
+        fprintf(stderr, "Finished fade didn't end on the last palette faded to.\n");
+        ret = 1;
+    }
+
+    Set_Palette(from);
+    Start_Palette_Fade(to, 60);
+    Set_Palette(other);
+    ms_sleep(100);
+    if (Palette_Fade_Active() || Palette_Fade_Tick() || memcmp(CurrentPalette, other, PALETTE_BYTES) != 0) {
+        fprintf(stderr, "Setting the palette didn't cancel the fade.\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// The blocking fade still gives the same steps and keeps calling back, but sleeps between steps.
+int test_blocking()
+{
+    int ret = 0;
+    unsigned char from[PALETTE_BYTES];
+    unsigned char to[PALETTE_BYTES];
+
+    Random_Palette(from);
+    Random_Palette(to);
+    Set_Palette(from);
+    auto steps = Reference_Steps(from, to, 30, 0, PALETTE_SIZE);
+
+    SetCount = 0;
+    CallbackCount = 0;
+    LimiterCount = 0;
+    auto start = std::clock();
+    Fade_Palette_To(to, 30, Callback);
+    double cpu = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    if (!Check_Steps("Blocking fade", 0, steps) || memcmp(CurrentPalette, to, PALETTE_BYTES) != 0) {
+        ret = 1;
+    }
+    if (CallbackCount < 20 || LimiterCount == 0 || cpu > 0.25) {
+        fprintf(stderr, "Blocking fade called back %d times and used %f seconds.\n", CallbackCount, cpu);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_fade();
+    ret |= test_range();
+    ret |= test_cancel();
+    ret |= test_blocking();
+
+    return ret;
+}
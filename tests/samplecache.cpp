@@ -0,0 +1,247 @@
+#include "common/samplecache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SOUNDS   20
+#define VARIANTS 3
+
+/*
+** Sounds below RESIDENT_SOUNDS stay in memory, the rest are read in as SAMPLE_SIZE byte blocks.
+** The last variant of every sound is missing.
+*/
+#define RESIDENT_SOUNDS 5
+#define SAMPLE_SIZE     1000
+
+static char Resident[RESIDENT_SOUNDS][VARIANTS];
+
+class TestCacheClass : public SampleCacheClass
+{
+public:
+    TestCacheClass()
+        : SampleCacheClass(SOUNDS, VARIANTS)
+        , Loads(0)
+        , Playing(nullptr)
+    {
+    }
+
+    int Loads;
+    void const* Playing;
+
+protected:
+    virtual void const* Load(int sound, int variant, size_t& size)
+    {
+        Loads++;
+
+        if (variant == VARIANTS - 1) {
+            return nullptr;
+        }
+        if (sound < RESIDENT_SOUNDS) {
+            return &Resident[sound][variant];
+        }
+
+        char* data = new char[SAMPLE_SIZE];
+        memset(data, sound * VARIANTS + variant, SAMPLE_SIZE);
+        size = SAMPLE_SIZE;
+        return data;
+    }
+
+    virtual bool In_Use(void const* data)
+    {
+        return data == Playing;
+    }
+};
+
+static bool Check_Sample(void const* data, int sound, int variant)
+{
+    if (data == nullptr) {
+        return false;
+    }
+    if (sound < RESIDENT_SOUNDS) {
+        return data == &Resident[sound][variant];
+    }
+
+    char const* bytes = static_cast<char const*>(data);
+    return bytes[0] == char(sound * VARIANTS + variant) && bytes[SAMPLE_SIZE - 1] == bytes[0];
+}
+
+// Each sound is only looked for once, whether it was found or not.
+int test_lookup()
+{
+    int ret = 0;
+    TestCacheClass cache;
+    SampleCacheStatsType stats;
+
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int sound = 0; sound < SOUNDS; ++sound) {
+            for (int variant = 0; variant < VARIANTS; ++variant) {
+                void const* data = cache.Fetch(sound, variant);
+                bool expected = variant != VARIANTS - 1;
+                if (expected != (data != nullptr) || (expected && !Check_Sample(data, sound, variant))) {
+                    fprintf(stderr, "Sound %d variant %d fetched wrong data.\n", sound, variant);
+                    ret = 1;
+                }
+            }
+        }
+    }
+
+    cache.Get_Stats(stats);
+    if (cache.Loads != SOUNDS * VARIANTS || stats.Misses != SOUNDS * VARIANTS || stats.Hits != SOUNDS * VARIANTS * 2) {
+        fprintf(stderr, "Loaded %d times with %u hits and %u misses.\n", cache.Loads, stats.Hits, stats.Misses);
+        ret = 1;
+    }
+    if (stats.Entries != (SOUNDS - RESIDENT_SOUNDS) * (VARIANTS - 1)
+        || stats.Bytes != size_t(stats.Entries) * SAMPLE_SIZE) {
+        fprintf(stderr, "Cache holds %u entries of %zu bytes.\n", stats.Entries, stats.Bytes);
+        ret = 1;
+    }
+
+    if (cache.Fetch(-1, 0) != nullptr || cache.Fetch(SOUNDS, 0) != nullptr || cache.Fetch(0, VARIANTS) != nullptr) {
+        fprintf(stderr, "Out of range sound fetched data.\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Prewarmed sounds are loaded without counting and are hits when played.
+int test_prewarm()
+{
+    int ret = 0;
+    TestCacheClass cache;
+    SampleCacheStatsType stats;
+
+    cache.Prewarm(7, 0);
+    cache.Prewarm(2, 1);
+    cache.Get_Stats(stats);
+    if (cache.Loads != 2 || stats.Hits != 0 || stats.Misses != 0) {
+        fprintf(stderr, "Prewarm counted %u hits and %u misses.\n", stats.Hits, stats.Misses);
+        ret = 1;
+    }
+
+    if (!Check_Sample(cache.Fetch(7, 0), 7, 0) || !Check_Sample(cache.Fetch(2, 1), 2, 1)) {
+        fprintf(stderr, "Prewarmed sound fetched wrong data.\n");
+        ret = 1;
+    }
+    cache.Get_Stats(stats);
+    if (cache.Loads != 2 || stats.Hits != 2) {
+        fprintf(stderr, "Prewarmed sounds were not hits.\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Going over budget drops the least recently used samples, but never one that is playing.
+int test_budget()
+{
+    int ret = 0;
+    TestCacheClass cache;
+    SampleCacheStatsType stats;
+
+    cache.Set_Budget(SAMPLE_SIZE * 3);
+
+    cache.Fetch(10, 0);
+    cache.Fetch(11, 0);
+    cache.Fetch(12, 0);
+    cache.Fetch(10, 0);
+    cache.Playing = cache.Fetch(11, 0);
+    cache.Fetch(12, 0);
+
+    // Sound 10 is now the least recently used but 11 is playing, so 10 goes.
+    cache.Fetch(13, 0);
+    cache.Get_Stats(stats);
+    if (stats.Entries != 3 || stats.Evictions != 1 || stats.Bytes != SAMPLE_SIZE * 3) {
+        fprintf(stderr, "After one eviction %u entries, %u evictions.\n", stats.Entries, stats.Evictions);
+        ret = 1;
+    }
+
+    int loads = cache.Loads;
+    cache.Fetch(11, 0);
+    cache.Fetch(12, 0);
+    cache.Fetch(13, 0);
+    if (cache.Loads != loads) {
+        fprintf(stderr, "A sample that should be kept was dropped.\n");
+        ret = 1;
+    }
+
+    if (!Check_Sample(cache.Fetch(10, 0), 10, 0) || cache.Loads != loads + 1) {
+        fprintf(stderr, "Dropped sample was not loaded again.\n");
+        ret = 1;
+    }
+
+    // With no budget at all only the sample just loaded is kept.
+    cache.Playing = nullptr;
+    cache.Set_Budget(0);
+    cache.Fetch(14, 0);
+    cache.Get_Stats(stats);
+    if (stats.Entries != 1 || stats.Bytes != SAMPLE_SIZE) {
+        fprintf(stderr, "Zero budget kept %u entries.\n", stats.Entries);
+        ret = 1;
+    }
+
+    cache.Clear();
+    cache.Get_Stats(stats);
+    if (stats.Entries != 0 || stats.Bytes != 0) {
+        fprintf(stderr, "Clear left %u entries.\n", stats.Entries);
+        ret = 1;
+    }
+    if (!Check_Sample(cache.Fetch(14, 0), 14, 0)) {
+        fprintf(stderr, "Sample fetched wrong data after clear.\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Clearing forgets every sound except one still playing, which goes once it has finished.
+int test_clear()
+{
+    int ret = 0;
+    TestCacheClass cache;
+    SampleCacheStatsType stats;
+
+    cache.Fetch(2, 0);
+    cache.Fetch(10, 0);
+    cache.Playing = cache.Fetch(11, 0);
+    cache.Fetch(12, 0);
+
+    int loads = cache.Loads;
+    cache.Clear();
+    cache.Get_Stats(stats);
+    if (stats.Entries != 1 || stats.Bytes != SAMPLE_SIZE) {
+        fprintf(stderr, "Clear while playing left %u entries.\n", stats.Entries);
+        ret = 1;
+    }
+    if (cache.Fetch(11, 0) != cache.Playing || cache.Loads != loads) {
+        fprintf(stderr, "Playing sample was not kept by clear.\n");
+        ret = 1;
+    }
+    if (!Check_Sample(cache.Fetch(2, 0), 2, 0) || !Check_Sample(cache.Fetch(10, 0), 10, 0)
+        || cache.Loads != loads + 2) {
+        fprintf(stderr, "Cleared sounds were not looked up again.\n");
+        ret = 1;
+    }
+
+    cache.Playing = nullptr;
+    cache.Clear();
+    cache.Get_Stats(stats);
+    if (stats.Entries != 0 || stats.Bytes != 0) {
+        fprintf(stderr, "Clear after playing left %u entries.\n", stats.Entries);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_lookup();
+    ret |= test_prewarm();
+    ret |= test_budget();
+    ret |= test_clear();
+
+    return ret;
+}
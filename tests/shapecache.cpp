@@ -0,0 +1,161 @@
+#include "common/keyframe.h"
+#include "common/lcw.h"
+#include "common/settings.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <vector>
+
+// Needed by Build_Frame.
+void Mem_Copy(void const* source, void* dest, unsigned int bytes_to_copy)
+{
+    memmove(dest, source, bytes_to_copy);
+}
+
+void Check_Use_Compressed_Shapes();
+void Reallocate_Big_Shape_Buffer();
+void* Get_Shape_Header_Data(void* ptr);
+
+#define FRAME_WIDTH  64
+#define FRAME_HEIGHT 64
+#define FRAME_COUNT  100
+#define FRAME_SIZE   (FRAME_WIDTH * FRAME_HEIGHT)
+
+static uint8_t Pixel(int shape, int frame, int i)
+{
+    return uint8_t((shape * 31 + frame * 7 + i / 5) & 0xFF);
+}
+
+// Builds a keyframe shape file where every frame is an LCW compressed key frame.
+static std::vector<uint8_t> Build_Shape(int shape)
+{
+    const int header = 14;
+    const int offsets = (FRAME_COUNT + 2) * 8;
+    std::vector<uint8_t> data(header + offsets, 0);
+
+    uint16_t fields[7] = {FRAME_COUNT, 0, 0, FRAME_WIDTH, FRAME_HEIGHT, FRAME_SIZE, 0};
+    memcpy(data.data(), fields, sizeof(fields));
+
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        uint8_t pixels[FRAME_SIZE];
+        uint8_t packed[FRAME_SIZE * 2];
+
+        for (int i = 0; i < FRAME_SIZE; ++i) {
+            pixels[i] = Pixel(shape, frame, i);
+        }
+
+        uint32_t offset = uint32_t(data.size()) | (uint32_t(KF_KEYFRAME) << 24);
+        memcpy(&data[header + frame * 8], &offset, 4);
+
+        int length = LCW_Comp(pixels, packed, FRAME_SIZE);
+        data.insert(data.end(), packed, packed + length);
+    }
+
+    return data;
+}
+
+static bool Check_Frame(uintptr_t frame, int shape, int number)
+{
+    uint8_t* pixels = static_cast<uint8_t*>(Get_Shape_Header_Data(reinterpret_cast<void*>(frame)));
+
+    for (int i = 0; i < FRAME_SIZE; ++i) {
+        if (pixels[i] != Pixel(shape, number, i)) {
+            fprintf(stderr, "Frame %d of shape %d has the wrong pixels.\n", number, shape);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int test_shape_cache()
+{
+    int ret = 0;
+    uint8_t scratch[FRAME_SIZE];
+    std::vector<uint8_t> shapes[3] = {Build_Shape(0), Build_Shape(1), Build_Shape(2)};
+    ShapeCacheStatsType stats;
+
+    Settings.Video.ShapeCacheSize = 1;
+    Check_Use_Compressed_Shapes();
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+            if (!Check_Frame(Build_Frame(shapes[0].data(), frame, scratch), 0, frame)) {
+                ret = 1;
+            }
+        }
+    }
+
+    Get_Shape_Cache_Stats(stats);
+    if (stats.Misses != FRAME_COUNT || stats.Hits != FRAME_COUNT || stats.Entries != FRAME_COUNT) {
+        fprintf(stderr,
+                "Expected %d misses and hits, got %u misses, %u hits.\n",
+                FRAME_COUNT,
+                stats.Misses,
+                stats.Hits);
+        ret = 1;
+    }
+
+    // Touching the other shapes pushes the cache over its budget, the first shape is coldest.
+    for (int shape = 1; shape < 3; ++shape) {
+        for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+            Build_Frame(shapes[shape].data(), frame, scratch);
+        }
+    }
+
+    Reallocate_Big_Shape_Buffer();
+    Get_Shape_Cache_Stats(stats);
+
+    if (stats.Bytes > 1024 * 1024 || stats.Evictions == 0) {
+        fprintf(stderr, "Cache holds %u bytes after %u evictions.\n", unsigned(stats.Bytes), stats.Evictions);
+        ret = 1;
+    }
+
+    // The most recently drawn frames must have survived.
+    unsigned hits = stats.Hits;
+    for (int frame = FRAME_COUNT - 10; frame < FRAME_COUNT; ++frame) {
+        if (!Check_Frame(Build_Frame(shapes[2].data(), frame, scratch), 2, frame)) {
+            ret = 1;
+        }
+    }
+
+    Get_Shape_Cache_Stats(stats);
+    if (stats.Hits != hits + 10) {
+        fprintf(stderr, "Recently drawn frames were evicted.\n");
+        ret = 1;
+    }
+
+    // Evicted frames decode again with the right contents.
+    unsigned misses = stats.Misses;
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        if (!Check_Frame(Build_Frame(shapes[0].data(), frame, scratch), 0, frame)) {
+            ret = 1;
+        }
+    }
+
+    Get_Shape_Cache_Stats(stats);
+    if (stats.Misses == misses) {
+        fprintf(stderr, "Coldest shape was not evicted.\n");
+        ret = 1;
+    }
+
+    Free_Shape_Cache();
+    Get_Shape_Cache_Stats(stats);
+    if (stats.Entries != 0 || stats.Bytes != 0) {
+        fprintf(stderr, "Free_Shape_Cache left %u entries.\n", stats.Entries);
+        ret = 1;
+    }
+
+    // Shapes are still usable after a flush.
+    if (!Check_Frame(Build_Frame(shapes[1].data(), 5, scratch), 1, 5)) {
+        ret = 1;
+    }
+
+    return ret;
+}
+
+int main(int argc, char** argv)
+{
+    return test_shape_cache();
+}
@@ -0,0 +1,218 @@
+#include "common/threatfield.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define GRID_W 34
+#define GRID_H 30
+
+typedef ThreatFieldClass<GRID_W, GRID_H> FieldType;
+
+static uint32_t Seed = 0x7531;
+
+static int Random(int range)
+{
+    Seed = Seed * 1103515245 + 12345;
+    return int((Seed >> 8) % unsigned(range));
+}
+
+static FieldType Field;
+
+static long long Brute_Sum(int x, int y, int w, int h, bool heat)
+{
+    long long sum = 0;
+
+    for (int yy = y; yy < y + h; ++yy) {
+        for (int xx = x; xx < x + w; ++xx) {
+            if (xx >= 0 && yy >= 0 && xx < GRID_W && yy < GRID_H) {
+                sum += heat ? Field.Heat(yy * GRID_W + xx) : Field.Value(yy * GRID_W + xx);
+            }
+        }
+    }
+
+    return sum;
+}
+
+static int Random_Inner_Region()
+{
+    return (1 + Random(GRID_H - 2)) * GRID_W + 1 + Random(GRID_W - 2);
+}
+
+// Block sums must match adding the regions up one by one, with queries between changes so
+// the partial rebuilds get exercised.
+int test_sums()
+{
+    int ret = 0;
+
+    Field.Clear();
+
+    for (int step = 0; step < 2000; ++step) {
+        if (Random(2)) {
+            Field.Spread(Random_Inner_Region(), Random(400) - 200);
+        } else {
+            Field.Adjust(Random(GRID_W * GRID_H), Random(50) - 25);
+        }
+
+        int x = Random(GRID_W + 4) - 2;
+        int y = Random(GRID_H + 4) - 2;
+        int w = Random(GRID_W);
+        int h = Random(GRID_H);
+
+        if (Field.Rect_Sum(x, y, w, h) != Brute_Sum(x, y, w, h, false)) {
+            fprintf(stderr, "Step %d: block %d,%d %dx%d summed wrong.\n", step, x, y, w, h);
+            ret = 1;
+        }
+
+        int r = Random(5);
+        if (Field.Radius_Sum(x, y, r) != Brute_Sum(x - r, y - r, r * 2 + 1, r * 2 + 1, false)) {
+            fprintf(stderr, "Step %d: radius %d around %d,%d summed wrong.\n", step, r, x, y);
+            ret = 1;
+        }
+    }
+
+    if (Field.Rect_Sum(0, 0, GRID_W, GRID_H) != Brute_Sum(0, 0, GRID_W, GRID_H, false)) {
+        fprintf(stderr, "Whole grid summed wrong.\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Taking threat away must undo adding it exactly, odd values and all.
+int test_spread()
+{
+    static const int values[] = {1, 3, 7, 255, 1001};
+
+    Field.Clear();
+
+    int regions[5];
+    for (int i = 0; i < 5; ++i) {
+        regions[i] = Random_Inner_Region();
+        Field.Spread(regions[i], values[i]);
+    }
+    for (int i = 4; i >= 0; --i) {
+        Field.Spread(regions[i], -values[i]);
+    }
+
+    for (int region = 0; region < GRID_W * GRID_H; ++region) {
+        if (Field.Value(region) != 0) {
+            fprintf(stderr, "Region %d left with %d threat.\n", region, Field.Value(region));
+            return 1;
+        }
+    }
+
+    if (Field.Rect_Sum(0, 0, GRID_W, GRID_H) != 0) {
+        fprintf(stderr, "Grid sum not back to zero.\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+// The decayed layer must close in on the threat, let go of it again once it is gone, and give
+// the same numbers every run.
+int test_decay()
+{
+    int ret = 0;
+    int region = 5 * GRID_W + 7;
+
+    Field.Clear();
+    Field.Adjust(region, 100);
+
+    Field.Decay(128);
+    if (Field.Heat(region) != 50) {
+        fprintf(stderr, "Half decay gave %d, expected 50.\n", Field.Heat(region));
+        ret = 1;
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        Field.Decay(240);
+    }
+    if (Field.Heat(region) < 99 || Field.Heat(region) > 100) {
+        fprintf(stderr, "Decayed threat settled at %d, expected 100.\n", Field.Heat(region));
+        ret = 1;
+    }
+    if (Field.Heat_Radius_Sum(7, 5, 2) != Brute_Sum(5, 3, 5, 5, true)) {
+        fprintf(stderr, "Decayed radius summed wrong.\n");
+        ret = 1;
+    }
+
+    Field.Adjust(region, -100);
+    for (int i = 0; i < 20; ++i) {
+        Field.Decay(240);
+    }
+    int remembered = Field.Heat(region);
+    if (remembered <= 0 || remembered >= 100) {
+        fprintf(stderr, "Threat that left should linger, got %d.\n", remembered);
+        ret = 1;
+    }
+    if (remembered != 27) {
+        fprintf(stderr, "Decay gave %d, expected 27.\n", remembered);
+        ret = 1;
+    }
+
+    for (int i = 0; i < 400; ++i) {
+        Field.Decay(240);
+    }
+    if (Field.Heat(region) != 0) {
+        fprintf(stderr, "Decayed threat stuck at %d.\n", Field.Heat(region));
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Rebuilding a field from its saved decayed layer and its region values, as a load does, must
+// leave it answering exactly as the original.
+int test_restore()
+{
+    static FieldType copy;
+    static int heat[GRID_W * GRID_H];
+    int ret = 0;
+
+    Field.Clear();
+    for (int step = 0; step < 200; ++step) {
+        Field.Spread(Random_Inner_Region(), Random(400) - 100);
+        if (step % 10 == 0) {
+            Field.Decay(240);
+        }
+    }
+
+    copy.Clear();
+    copy.Adjust(0, 1234);
+    copy.Decay(0);
+    Field.Get_Heat(heat);
+    copy.Set_Heat(heat);
+    for (int region = 0; region < GRID_W * GRID_H; ++region) {
+        copy.Set(region, Field.Value(region));
+    }
+
+    for (int step = 0; step < 50; ++step) {
+        int x = Random(GRID_W);
+        int y = Random(GRID_H);
+        int r = Random(5);
+
+        if (copy.Radius_Sum(x, y, r) != Field.Radius_Sum(x, y, r)
+            || copy.Heat_Radius_Sum(x, y, r) != Field.Heat_Radius_Sum(x, y, r)) {
+            fprintf(stderr, "Restored field differs around %d,%d.\n", x, y);
+            ret = 1;
+        }
+        Field.Decay(240);
+        copy.Decay(240);
+    }
+
+    return ret;
+}
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_sums();
+    ret |= test_spread();
+    ret |= test_decay();
+    ret |= test_restore();
+
+    return ret;
+}
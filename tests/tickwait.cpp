@@ -0,0 +1,142 @@
+#include "common/tickwait.h"
+#include "common/timer.h"
+
+#include <chrono>
+#include <ctime>
+#include <stdio.h>
+#include <thread>
+
+// Each wait ends on the next tick, and waiting uses next to no CPU.
+int test_tick()
+{
+    int ret = 0;
+
+    Wait_For_Tick();
+    int start = WinTickCount.Time();
+    std::clock_t cpu = std::clock();
+
+    for (int i = 0; i < 30; ++i) {
+        if (Wait_For_Tick(WAKE_INPUT | WAKE_NETWORK) != WAKE_TICK) {
+            fprintf(stderr, "Wait %d ended without a tick or an event.\n", i);
+            ret = 1;
+        }
+    }
+
+    int ticks = WinTickCount.Time() - start;
+    double seconds = double(std::clock() - cpu) / CLOCKS_PER_SEC;
+    if (ticks < 30 || ticks > 34) {
+        fprintf(stderr, "30 waits took %d ticks.\n", ticks);
+        ret = 1;
+    }
+    if (seconds > 0.05) {
+        fprintf(stderr, "30 waits used %f seconds of CPU.\n", seconds);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// Events end a wait early from another thread, but only the events waited for.
+int test_wake()
+{
+    int ret = 0;
+
+    std::thread waker([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        Wake_Tick_Wait(WAKE_INPUT);
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        Wake_Tick_Wait(WAKE_NETWORK);
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    int woken = WAKE_TICK;
+    int waits = 0;
+    while (woken == WAKE_TICK && waits < 20) {
+        woken = Wait_For_Tick(WAKE_NETWORK);
+        ++waits;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    waker.join();
+
+    if (woken != WAKE_NETWORK || elapsed < std::chrono::milliseconds(70) || elapsed > std::chrono::milliseconds(150)) {
+        fprintf(stderr,
+                "Wait ended with %d after %d ms.\n",
+                woken,
+                int(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+        ret = 1;
+    }
+
+    // The input event is still waiting for someone to ask for it.
+    if (Wait_For_Tick(WAKE_INPUT | WAKE_NETWORK) != WAKE_INPUT || Wait_For_Tick(WAKE_INPUT) != WAKE_TICK) {
+        fprintf(stderr, "Input event wasn't kept for the next wait.\n");
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// A loop that mostly waits is counted as mostly waiting.
+int test_stats()
+{
+    int ret = 0;
+    TickWaitStatsType before;
+    TickWaitStatsType after;
+
+    Get_Tick_Wait_Stats(before);
+    for (int i = 0; i < 10; ++i) {
+        auto busy = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+        while (std::chrono::steady_clock::now() < busy) {
+        }
+        Wait_For_Tick();
+    }
+    Get_Tick_Wait_Stats(after);
+
+    uint64_t wait = after.WaitTime - before.WaitTime;
+    uint64_t work = after.WorkTime - before.WorkTime;
+    if (after.Waits - before.Waits != 10 || after.Wakeups != before.Wakeups || work < 20000 || work > 60000
+        || wait < 100000) {
+        fprintf(stderr,
+                "%u waits, %u wakeups, %llu us waiting and %llu us working.\n",
+                after.Waits - before.Waits,
+                after.Wakeups - before.Wakeups,
+                (unsigned long long)wait,
+                (unsigned long long)work);
+        ret = 1;
+    }
+
+    return ret;
+}
+
+// A stopped timer never ticks, so a wait on it returns straight away instead of hanging.
+int test_stopped()
+{
+    int ret = 0;
+
+    WinTimerClass::Init(0);
+    auto start = std::chrono::steady_clock::now();
+    int woken = Wait_For_Tick(WAKE_INPUT);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    WinTimerClass::Init(60);
+
+    if (woken != WAKE_TICK || elapsed > std::chrono::milliseconds(50)) {
+        fprintf(stderr,
+                "Wait on a stopped timer returned %d after %lld ms.\n",
+                woken,
+                (long long)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+        ret = 1;
+    }
+
+    return ret;
+}
+
+int main()
+{
+    int ret = 0;
+
+    ret |= test_tick();
+    ret |= test_wake();
+    ret |= test_stats();
+    ret |= test_stopped();
+
+    return ret;
+}
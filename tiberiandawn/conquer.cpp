@@ -161,7 +161,7 @@ void Main_Game(int argc, char* argv[])
         **	values, and then show the mouse.  This PRESUMES that Select_Game() has
         **	told the map to draw itself.
         */
-        Fade_Palette_To(GamePalette, FADE_PALETTE_MEDIUM, NULL);
+        Start_Palette_Fade(GamePalette, FADE_PALETTE_MEDIUM);
         Keyboard->Clear();
 
         /*
@@ -1180,9 +1180,10 @@ bool Color_Cycle(void)
 
     /*
     **	If any of the processing functions changed the palette, then this palette must be
-    **	passed to the system.
+    **	passed to the system. Leave it until any fade in progress is done, setting it now
+    **	would cancel the fade.
     */
-    if (changed) {
+    if (changed && !Palette_Fade_Active()) {
         Wait_Vert_Blank();
         Set_Palette(GamePalette);
         return (true);
@@ -1216,6 +1217,11 @@ void Call_Back(void)
     unsigned short crc;
 #endif
 
+    /*
+    **	Step along any palette fade that was started without waiting for it.
+    */
+    Palette_Fade_Tick();
+
     /*
     **	Score maintenance
     */
@@ -1563,7 +1569,7 @@ bool Main_Loop()
     Check_For_Focus_Loss();
 
     /*
-    ** Allocate extra memory for uncompressed shapes as needed
+    ** Trim the uncompressed shape cache as needed
     */
     Reallocate_Big_Shape_Buffer();
 
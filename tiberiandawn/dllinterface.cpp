@@ -1533,7 +1533,7 @@ extern "C" __declspec(dllexport) bool __cdecl CNC_Advance_Instance(uint64 player
     }
 
     /*
-    ** Allocate extra memory for uncompressed shapes as needed
+    ** Trim the uncompressed shape cache as needed
     */
     Reallocate_Big_Shape_Buffer();
 
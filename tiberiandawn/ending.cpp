@@ -35,6 +35,7 @@
 #include "function.h"
 #include "textblit.h"
 #include "common/settings.h"
+#include "common/tickwait.h"
 
 void GDI_Ending(void)
 {
@@ -72,8 +73,9 @@ void GDI_Ending(void)
         Fade_Palette_To(Palette, FADE_PALETTE_MEDIUM, Call_Back);
         Keyboard->Clear();
         count.Set(TIMER_SECOND * 3);
-        while (count.Time()) {
+        while (count.Time() && !Keyboard->Check()) {
             Call_Back();
+            Wait_For_Tick(WAKE_INPUT);
         }
         Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
@@ -87,8 +89,9 @@ void GDI_Ending(void)
     Keyboard->Clear();
     //	CountDownTimerClass count;
     count.Set(TIMER_SECOND * 3);
-    while (count.Time()) {
+    while (count.Time() && !Keyboard->Check()) {
         Call_Back();
+        Wait_For_Tick(WAKE_INPUT);
     }
     Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
@@ -224,8 +227,9 @@ void Nod_Ending(void)
         Fade_Palette_To(Palette, FADE_PALETTE_MEDIUM, Call_Back);
         Keyboard->Clear();
         count.Set(TIMER_SECOND * 3);
-        while (count.Time()) {
+        while (count.Time() && !Keyboard->Check()) {
             Call_Back();
+            Wait_For_Tick(WAKE_INPUT);
         }
         Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
@@ -239,8 +243,9 @@ void Nod_Ending(void)
     Keyboard->Clear();
     //	CountDownTimerClass count;
     count.Set(TIMER_SECOND * 3);
-    while (count.Time()) {
+    while (count.Time() && !Keyboard->Check()) {
         Call_Back();
+        Wait_For_Tick(WAKE_INPUT);
     }
     Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
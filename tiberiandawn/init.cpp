@@ -47,6 +47,7 @@
 #include "common/wspudp.h"
 #include "common/paths.h"
 #include "common/winasm.h"
+#include "common/tickwait.h"
 #include <time.h>
 
 /****************************************
@@ -836,7 +837,7 @@ bool Select_Game(bool fade)
                 Blit_Hid_Page_To_Seen_Buff();
 
                 if (fade) {
-                    Fade_Palette_To(Palette, FADE_PALETTE_SLOW, Call_Back);
+                    Start_Palette_Fade(Palette, FADE_PALETTE_SLOW);
                     fade = false;
                 }
 
@@ -1225,12 +1226,13 @@ bool Select_Game(bool fade)
                     if (CCFileClass("ATTRACT2.CPS").Is_Available()) {
                         Load_Uncompress(CCFileClass("ATTRACT2.CPS"), SysMemPage, SysMemPage, Palette);
                         SysMemPage.Scale(SeenBuff, 0, 0, 0, 0, 320, 199, 640, 398);
-                        Fade_Palette_To(Palette, FADE_PALETTE_MEDIUM, Call_Back);
+                        Start_Palette_Fade(Palette, FADE_PALETTE_MEDIUM);
                     }
                     Keyboard->Clear();
                     count.Set(TIMER_SECOND * 3);
-                    while (count.Time()) {
+                    while (count.Time() && !Keyboard->Check()) {
                         Call_Back();
+                        Wait_For_Tick(WAKE_INPUT);
                     }
                     Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
@@ -1243,12 +1245,13 @@ bool Select_Game(bool fade)
                     if (CCFileClass("ATTRACT2.CPS").Is_Available()) {
                         Load_Uncompress(CCFileClass("ATTRACT2.CPS"), SysMemPage, SysMemPage, Palette);
                         SysMemPage.Scale(SeenBuff, 0, 0, 0, 0, 320, 199, 640, 398);
-                        Fade_Palette_To(Palette, FADE_PALETTE_MEDIUM, Call_Back);
+                        Start_Palette_Fade(Palette, FADE_PALETTE_MEDIUM);
                     }
                     Keyboard->Clear();
                     count.Set(TIMER_SECOND * 3);
-                    while (count.Time()) {
+                    while (count.Time() && !Keyboard->Check()) {
                         Call_Back();
+                        Wait_For_Tick(WAKE_INPUT);
                     }
                     Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
@@ -1261,12 +1264,13 @@ bool Select_Game(bool fade)
                     if (CCFileClass("ATTRACT2.CPS").Is_Available()) {
                         Load_Uncompress(CCFileClass("ATTRACT2.CPS"), SysMemPage, SysMemPage, Palette);
                         SysMemPage.Scale(SeenBuff, 0, 0, 0, 0, 320, 199, 640, 398);
-                        Fade_Palette_To(Palette, FADE_PALETTE_MEDIUM, Call_Back);
+                        Start_Palette_Fade(Palette, FADE_PALETTE_MEDIUM);
                     }
                     Keyboard->Clear();
                     count.Set(TIMER_SECOND * 3);
-                    while (count.Time()) {
+                    while (count.Time() && !Keyboard->Check()) {
                         Call_Back();
+                        Wait_For_Tick(WAKE_INPUT);
                     }
                     Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
@@ -1278,12 +1282,13 @@ bool Select_Game(bool fade)
                 if (CCFileClass("ATTRACT2.CPS").Is_Available()) {
                     Load_Uncompress(CCFileClass("ATTRACT2.CPS"), SysMemPage, SysMemPage, Palette);
                     SysMemPage.Scale(SeenBuff, 0, 0, 0, 0, 320, 199, 640, 398);
-                    Fade_Palette_To(Palette, FADE_PALETTE_MEDIUM, Call_Back);
+                    Start_Palette_Fade(Palette, FADE_PALETTE_MEDIUM);
                 }
                 Keyboard->Clear();
                 count.Set(TIMER_SECOND * 3);
-                while (count.Time()) {
+                while (count.Time() && !Keyboard->Check()) {
                     Call_Back();
+                    Wait_For_Tick(WAKE_INPUT);
                 }
                 Fade_Palette_To(BlackPalette, FADE_PALETTE_MEDIUM, Call_Back);
 
@@ -58,6 +58,11 @@
  *   IPXManagerClass::Response_Time -- Returns largest Avg Response Time   *
  *   IPXManagerClass::Global_Response_Time -- Returns Avg Response Time    *
  *   IPXManagerClass::Reset_Response_Time -- Reset response time 				*
+ *   IPXManagerClass::Smooth_Response_Time -- Returns smoothed response time*
+ *   IPXManagerClass::Response_Jitter -- Returns response time jitter      *
+ *   IPXManagerClass::Response_Percentile -- Returns a delay percentile    *
+ *   IPXManagerClass::Add_Stall -- Records a frame-sync stall              *
+ *   IPXManagerClass::Stall_Count -- Returns # frame-sync stalls           *
  *   IPXManagerClass::Oldest_Send -- gets ptr to oldest send buf           *
  *   IPXManagerClass::Mono_Debug_Print -- debug output routine					*
  *   IPXManagerClass::Alloc_RealMode_Mem -- allocates real-mode memory		*
@@ -1435,6 +1440,163 @@ void IPXManagerClass::Reset_Response_Time(void)
 
 } /* end of Reset_Response_Time */
 
+/***************************************************************************
+ * IPXManagerClass::Smooth_Response_Time -- Returns smoothed response time *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		id			connection ID; CONNECTION_NONE = all connections				*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		smoothed response time of that connection, or the largest of all		*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+unsigned int IPXManagerClass::Smooth_Response_Time(int id)
+{
+    unsigned int resp;
+    unsigned int maxresp = 0;
+    int i;
+
+    if (id != CONNECTION_NONE) {
+        i = Connection_Index(id);
+        return (i != CONNECTION_NONE ? Connection[i]->Queue->Smooth_Response_Time() : 0);
+    }
+
+    for (i = 0; i < NumConnections; i++) {
+        resp = Connection[i]->Queue->Smooth_Response_Time();
+        if (resp > maxresp) {
+            maxresp = resp;
+        }
+    }
+
+    return (maxresp);
+
+} /* end of Smooth_Response_Time */
+
+/***************************************************************************
+ * IPXManagerClass::Response_Jitter -- Returns response time jitter        *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		id			connection ID; CONNECTION_NONE = all connections				*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		response time deviation of that connection, or the largest of all		*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+unsigned int IPXManagerClass::Response_Jitter(int id)
+{
+    unsigned int jitter;
+    unsigned int maxjitter = 0;
+    int i;
+
+    if (id != CONNECTION_NONE) {
+        i = Connection_Index(id);
+        return (i != CONNECTION_NONE ? Connection[i]->Queue->Response_Jitter() : 0);
+    }
+
+    for (i = 0; i < NumConnections; i++) {
+        jitter = Connection[i]->Queue->Response_Jitter();
+        if (jitter > maxjitter) {
+            maxjitter = jitter;
+        }
+    }
+
+    return (maxjitter);
+
+} /* end of Response_Jitter */
+
+/***************************************************************************
+ * IPXManagerClass::Response_Percentile -- Returns a delay percentile      *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		percent	percentile to find, 0 - 100											*
+ *		id			connection ID; CONNECTION_NONE = all connections				*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		that percentile of the connection's recent delays, or the largest of	*
+ *		all connections																		*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+unsigned int IPXManagerClass::Response_Percentile(int percent, int id)
+{
+    unsigned int resp;
+    unsigned int maxresp = 0;
+    int i;
+
+    if (id != CONNECTION_NONE) {
+        i = Connection_Index(id);
+        return (i != CONNECTION_NONE ? Connection[i]->Queue->Response_Percentile(percent) : 0);
+    }
+
+    for (i = 0; i < NumConnections; i++) {
+        resp = Connection[i]->Queue->Response_Percentile(percent);
+        if (resp > maxresp) {
+            maxresp = resp;
+        }
+    }
+
+    return (maxresp);
+
+} /* end of Response_Percentile */
+
+/***************************************************************************
+ * IPXManagerClass::Add_Stall -- Records a frame-sync stall                *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		id			ID of the connection we were waiting on							*
+ *		ticks		how long we waited														*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		none.																						*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+void IPXManagerClass::Add_Stall(int id, unsigned int ticks)
+{
+    int i = Connection_Index(id);
+
+    if (i != CONNECTION_NONE) {
+        Connection[i]->Queue->Add_Stall(ticks);
+    }
+
+} /* end of Add_Stall */
+
+/***************************************************************************
+ * IPXManagerClass::Stall_Count -- Returns # frame-sync stalls             *
+ *                                                                         *
+ * INPUT:                                                                  *
+ *		id			connection ID; CONNECTION_NONE = all connections				*
+ *                                                                         *
+ * OUTPUT:                                                                 *
+ *		# stalls on that connection, or the total of all connections			*
+ *                                                                         *
+ * WARNINGS:                                                               *
+ *		none.																						*
+ *=========================================================================*/
+unsigned int IPXManagerClass::Stall_Count(int id)
+{
+    unsigned int count = 0;
+    int i;
+
+    if (id != CONNECTION_NONE) {
+        i = Connection_Index(id);
+        return (i != CONNECTION_NONE ? Connection[i]->Queue->Stall_Count() : 0);
+    }
+
+    for (i = 0; i < NumConnections; i++) {
+        count += Connection[i]->Queue->Stall_Count();
+    }
+
+    return (count);
+
+} /* end of Stall_Count */
+
 /***************************************************************************
  * IPXManagerClass::Oldest_Send -- gets ptr to oldest send buf             *
  *                                                                         *
@@ -1552,6 +1714,7 @@ void IPXManagerClass::Mono_Debug_Print(int index, int refresh)
 #ifdef WWLIB32_H
     char txt[80];
     int i;
+    CommBufferClass* queue;
 
     if (index == -1)
         GlobalChannel->Queue->Mono_Debug_Print(refresh);
@@ -1563,8 +1726,14 @@ void IPXManagerClass::Mono_Debug_Print(int index, int refresh)
         Mono_Set_Cursor(20, 1);
         Mono_Printf("IPX Queue:");
 
-        Mono_Set_Cursor(9, 2);
-        Mono_Printf("Average Response Time:");
+        Mono_Set_Cursor(3, 2);
+        Mono_Printf("Avg/Smooth/P90 Resp:");
+
+        Mono_Set_Cursor(64, 1);
+        Mono_Printf("Jitter:");
+
+        Mono_Set_Cursor(64, 2);
+        Mono_Printf("Stalls:");
 
         Mono_Set_Cursor(43, 1);
         Mono_Printf("Send Overflows:");
@@ -1576,12 +1745,17 @@ void IPXManagerClass::Mono_Debug_Print(int index, int refresh)
     Mono_Set_Cursor(32, 1);
     Mono_Printf("%d", index);
 
-    Mono_Set_Cursor(32, 2);
-    if (index == -1) {
-        Mono_Printf("%d  ", GlobalChannel->Queue->Avg_Response_Time());
-    } else {
-        Mono_Printf("%d  ", Connection[index]->Queue->Avg_Response_Time());
-    }
+    queue = (index == -1) ? GlobalChannel->Queue : Connection[index]->Queue;
+
+    Mono_Set_Cursor(24, 2);
+    Mono_Printf(
+        "%d/%d/%d  ", queue->Avg_Response_Time(), queue->Smooth_Response_Time(), queue->Response_Percentile(90));
+
+    Mono_Set_Cursor(72, 1);
+    Mono_Printf("%d  ", queue->Response_Jitter());
+
+    Mono_Set_Cursor(72, 2);
+    Mono_Printf("%d  ", queue->Stall_Count());
 
     Mono_Set_Cursor(59, 1);
     Mono_Printf("%d  ", SendOverflows);
@@ -39,6 +39,7 @@
 #include "textblit.h"
 #include "common/irandom.h"
 #include "common/settings.h"
+#include "common/tickwait.h"
 
 #ifndef DEMO
 
@@ -604,7 +605,7 @@ void Map_Selection(void)
     Increase_Palette_Luminance(InterpolationPalette, 30, 30, 30, 63);
     Read_Interpolation_Palette("MAP_LOCL.PAL");
     Play_Sample(appear1, 255, Options.Normalize_Sound(110));
-    Fade_Palette_To(localpalette, FADE_PALETTE_MEDIUM, Call_Back);
+    Start_Palette_Fade(localpalette, FADE_PALETTE_MEDIUM);
     int i;
     for (i = 1; i < Get_Animation_Frame_Count(greyearth); i++) {
         Call_Back_Delay(4);
@@ -643,6 +644,7 @@ void Map_Selection(void)
 
     while (CountDownTimer.Time() || Is_Speaking()) {
         Call_Back();
+        Wait_For_Tick();
         //		if (Keyboard->Check()) CountDownTimer.Set(0);
     }
 
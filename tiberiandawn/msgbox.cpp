@@ -38,6 +38,7 @@
 #include "msgbox.h"
 #include "gadget.h"
 #include "common/framelimit.h"
+#include "common/tickwait.h"
 
 #ifdef JAPANESE
 WWMessageBox::WWMessageBox(int caption, bool pict)
@@ -433,6 +434,7 @@ int WWMessageBox::Process(const char* msg, const char* b1txt, const char* b2txt,
         timer.Set(TICKS_PER_SECOND * 4);
         while (timer.Time() > 0) {
             Call_Back();
+            Wait_For_Tick();
         }
         Keyboard->Clear();
     }
@@ -92,6 +92,7 @@
 #include "function.h"
 #include <time.h>
 #include "framelimit.h"
+#include "tickwait.h"
 #define SHOW_MONO 0
 
 // ST = 12/17/2018 5:44PM
@@ -1939,6 +1940,7 @@ static int Net_Join_Dialog(void)
         starttime = WinTickCount.Time();
         while (WinTickCount.Time() - starttime < (unsigned)i) {
             Ipx.Service();
+            Wait_For_Tick(WAKE_NETWORK);
         }
     }
 
@@ -3433,8 +3435,10 @@ static int Net_New_Dialog(void)
             a chance to know about this new guy)
             ...............................................................*/
             i = MAX(Ipx.Global_Response_Time() * 2, (unsigned int)60);
-            while (WinTickCount.Time() - ok_timer < i)
+            while (WinTickCount.Time() - ok_timer < i) {
                 Ipx.Service();
+                Wait_For_Tick(WAKE_NETWORK);
+            }
 
             /*...............................................................
             If there are at least 2 players, go ahead & play; error otherwise
@@ -4559,8 +4563,10 @@ static int Net_Fake_New_Dialog(void)
                 a chance to know about this new guy)
                 ...............................................................*/
                 i = MAX(Ipx.Global_Response_Time() * 2, (unsigned int)120);
-                while (WinTickCount.Time() - ok_timer < i)
+                while (WinTickCount.Time() - ok_timer < i) {
                     Ipx.Service();
+                    Wait_For_Tick(WAKE_NETWORK);
+                }
 
                 /*...............................................................
                 If there are at least 2 players, go ahead & play; error otherwise
@@ -5435,6 +5441,7 @@ static int Net_Fake_Join_Dialog(void)
         starttime = WinTickCount.Time();
         while (WinTickCount.Time() - starttime < (unsigned)i) {
             Ipx.Service();
+            Wait_For_Tick(WAKE_NETWORK);
         }
     }
 
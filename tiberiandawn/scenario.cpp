@@ -603,7 +603,7 @@ void Do_Win(void)
     SabotagedType = STRUCT_NONE;
 
     Map.Render();
-    Fade_Palette_To(GamePalette, FADE_PALETTE_FAST, Call_Back);
+    Start_Palette_Fade(GamePalette, FADE_PALETTE_FAST);
     Show_Mouse();
 }
 
@@ -696,7 +696,7 @@ void Do_Lose(void)
         GameActive = false;
     }
 
-    Fade_Palette_To(GamePalette, FADE_PALETTE_FAST, Call_Back);
+    Start_Palette_Fade(GamePalette, FADE_PALETTE_FAST);
     Show_Mouse();
 }
 
@@ -38,6 +38,7 @@
 #include "common/ini.h"
 #include "common/paths.h"
 #include "common/utfargs.h"
+#include "common/tickwait.h"
 #include "settings.h"
 
 bool Read_Private_Config_Struct(FileClass& file, NewConfigType* config);
@@ -540,6 +541,17 @@ void Prog_End(const char* why, bool fatal) // Added why and fatal parameters. ST
         *((int*)0) = 0;
     }
 
+    /*
+    ** Log how much of the session the tick waits spent asleep against the work done between them.
+    */
+    TickWaitStatsType waits;
+    Get_Tick_Wait_Stats(waits);
+    DBG_INFO("Tick waits: %u waits, %u woken early, %llu ms asleep, %llu ms working",
+             waits.Waits,
+             waits.Wakeups,
+             (unsigned long long)(waits.WaitTime / 1000),
+             (unsigned long long)(waits.WorkTime / 1000));
+
 #ifndef DEMO
     if (GameToPlay == GAME_MODEM || GameToPlay == GAME_NULL_MODEM) {
         //		NullModem.Change_IRQ_Priority(0);
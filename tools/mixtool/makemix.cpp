@@ -22,9 +22,14 @@
 #include "readline.h"
 #include "rndstraw.h"
 #include "gitinfo.h"
+#include "workerpool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <getopt.h>
 #include <string>
 #include <set>
+#include <vector>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -56,7 +61,7 @@ void Print_Help()
 
     printf("\nvanillamix %s%s%s\n\n"
            "Usage:\n"
-           "  vanillamix (-c | -x) [-d <path>] [-f <file>] <mixfile>\n"
+           "  vanillamix (-c | -x) [-j <jobs>] [-d <path>] [-f <file>] <mixfile>\n"
            "  vanillamix -l <mixfile>\n"
            "  vanillamix -h | --help\n\n"
            "Options:\n"
@@ -77,6 +82,9 @@ void Print_Help()
            "  -f --file       File to either pack or extract.\n"
            "                  Can be specified multiple times for multiple files.\n"
            "  -m --manifest   Text file containing a list of files to pack, one per line.\n"
+           "  -j --jobs       Number of files to read or extract at once.\n"
+           "                  0 uses one per CPU, the default is 1.\n"
+           "  -t --timing     Print how long packing or extracting took.\n"
            "  -h --help       Displays this help.\n\n",
            revision,
            GitUncommittedChanges ? "~" : "",
@@ -100,6 +108,7 @@ bool Encrypt;
 bool Checksum;
 bool Verbose;
 bool UseCRC32;
+bool Timing;
 PKey PublicKey;
 PKey PrivateKey;
 RandomStraw CryptRandom;
@@ -128,7 +137,7 @@ template <typename CRC> void List_Mix(const char* filename, MixNameDatabase& nam
     printf("%-24s  %10s  %10s\n", "========================", "==========", "==========");
 
     for (int i = 0; i < mixfile.Get_File_Count(); ++i) {
-        std::string filename = name_db.Get_Entry(index[i].CRC, hash).file_name;
+        std::string filename(name_db.Get_Entry(index[i].CRC, hash).file_name);
 
         if (filename.empty()) {
             filename = Int_To_Hex(index[i].CRC);
@@ -138,34 +147,91 @@ template <typename CRC> void List_Mix(const char* filename, MixNameDatabase& nam
     }
 }
 
+/*
+**	A file to copy out of a mix file.
+*/
+struct ExtractJobType
+{
+    std::string MixName;
+    std::string FileName;
+    int Offset;
+    int Size;
+};
+
+/*
+**	Copy one file out of a mix file, returns the number of bytes copied.
+*/
+static int Extract_File(const ExtractJobType& job)
+{
+    const int BUFFER_SIZE = 1024 * 1024;
+    RawFileClass reader(job.MixName.c_str());
+    RawFileClass writer(job.FileName.c_str());
+
+    if (!reader.Open(READ)) {
+        return 0;
+    }
+
+    // If file won't open for writing then try next file.
+    if (!writer.Open(WRITE)) {
+        if (Verbose) {
+            printf("Couldn't open '%s' for writing.\n", writer.File_Name());
+        }
+
+        return 0;
+    }
+
+    if (Verbose) {
+        printf("Extracting '%s'.\n", writer.File_Name());
+    }
+
+    std::vector<uint8_t> buffer(std::min(job.Size, BUFFER_SIZE));
+    int size = job.Size;
+
+    // Seek to the file in question and start copying its contents.
+    reader.Seek(job.Offset, SEEK_SET);
+
+    while (size > 0) {
+        int chunk = std::min(size, BUFFER_SIZE);
+
+        // Make sure we actually read the amount of data we expected to.
+        if (reader.Read(buffer.data(), chunk) != chunk) {
+            if (Verbose) {
+                printf("Failed to read sufficient data.\n");
+            }
+
+            break;
+        }
+
+        writer.Write(buffer.data(), chunk);
+        size -= chunk;
+    }
+
+    return job.Size - size;
+}
+
 template <typename CRC>
-void Extract_Mix(const char* filename,
-                 const char* base_path,
-                 MixNameDatabase& name_db,
-                 MixNameDatabase::HashMethod hash,
-                 const std::set<std::string>& files)
+int64_t Extract_Mix(const char* filename,
+                    const char* base_path,
+                    MixNameDatabase& name_db,
+                    MixNameDatabase::HashMethod hash,
+                    const std::set<std::string>& files,
+                    int jobs)
 {
-    const size_t BUFFER_SIZE = 2048;
     MixFileClass<RawFileClass, CRC> mixfile(filename, &PublicKey);
+    std::vector<ExtractJobType> extract;
+    std::string path;
 
+    if (base_path != nullptr && *base_path != '\0') {
+        path = base_path;
+        path += "/";
+    }
+
+    // Work out where everything is from the index first, then copy the files out.
     if (files.empty()) {
         const typename MixFileClass<RawFileClass, CRC>::SubBlock* index = mixfile.Get_Index();
-        RawFileClass reader(filename);
-
-        if (!reader.Open(READ)) {
-            return;
-        }
 
         // Iterate the mix file index and extract the files found.
         for (int i = 0; i < mixfile.Get_File_Count(); ++i) {
-            uint8_t buffer[BUFFER_SIZE];
-            std::string filename;
-
-            if (base_path != nullptr && *base_path != '\0') {
-                filename = base_path;
-                filename += "/";
-            }
-
             if ((hash == MixNameDatabase::HASH_RACRC && (uint32_t)index[i].CRC == 0x54C2D545)
                 || (hash == MixNameDatabase::HASH_CRC32 && (uint32_t)index[i].CRC == 0x366E051F)) {
                 if (Verbose) {
@@ -175,13 +241,6 @@ void Extract_Mix(const char* filename,
                 continue;
             }
 
-            // If we don't get a useable filename back, then use the hex version of the file CRC to create a filename.
-            if (name_db.Get_Entry(index[i].CRC, hash).file_name.empty()) {
-                filename += Int_To_Hex(index[i].CRC);
-            } else {
-                filename += name_db.Get_Entry(index[i].CRC, hash).file_name;
-            }
-
             int offset;
             int size;
             MixFileClass<RawFileClass, CRC>* mp;
@@ -202,45 +261,14 @@ void Extract_Mix(const char* filename,
                 continue;
             }
 
-            RawFileClass writer(filename.c_str());
-
-            // If file won't open for writing then try next file.
-            if (!writer.Open(WRITE)) {
-                if (Verbose) {
-                    printf("Couldn't open '%s' for writing.\n", writer.File_Name());
-                }
-
-                continue;
-            }
-
-            if (Verbose) {
-                printf("Extracting '%s'.\n", writer.File_Name());
-            }
-
-            // Seek to the file in question and start copying its contents.
-            reader.Seek(offset, SEEK_SET);
-
-            while (size > BUFFER_SIZE) {
-                // Make sure we actually read the amount of data we expected to.
-                if (reader.Read(buffer, BUFFER_SIZE) == BUFFER_SIZE) {
-                    writer.Write(buffer, BUFFER_SIZE);
-                    size -= BUFFER_SIZE;
-                } else {
-                    if (Verbose) {
-                        printf("Failed to read sufficient data.\n");
-                    }
+            // If we don't get a useable filename back, then use the hex version of the file CRC to create a filename.
+            std::string name(name_db.Get_Entry(index[i].CRC, hash).file_name);
 
-                    break;
-                }
+            if (name.empty()) {
+                name = Int_To_Hex(index[i].CRC);
             }
 
-            if (size > 0 && size < BUFFER_SIZE) {
-                if (reader.Read(buffer, size) == size) {
-                    writer.Write(buffer, size);
-                } else if (Verbose) {
-                    printf("Failed to read sufficient data.\n");
-                }
-            }
+            extract.push_back({mp->Filename, path + name, offset, size});
         }
     } else {
         for (auto it = files.begin(); it != files.end(); ++it) {
@@ -256,58 +284,31 @@ void Extract_Mix(const char* filename,
                 continue;
             }
 
-            RawFileClass reader(mp->Filename);
-
-            if (!reader.Open(READ)) {
-                continue;
-            }
-
-            uint8_t buffer[BUFFER_SIZE];
-            std::string filename;
-
-            if (base_path != nullptr && *base_path != '\0') {
-                filename = base_path;
-                filename += "/";
-            }
-
-            filename += *it;
-
-            RawFileClass writer(filename.c_str());
-
-            // If file won't open for writing then try next file.
-            if (!writer.Open(WRITE)) {
-                if (Verbose) {
-                    printf("Couldn't open '%s' for writing.\n", writer.File_Name());
-                }
-
-                continue;
-            }
+            extract.push_back({mp->Filename, path + *it, offset, size});
+        }
+    }
 
-            // Seek to the file in question and start copying its contents.
-            reader.Seek(offset, SEEK_SET);
+    // Each file is copied with its own reader, so as many as the pool has threads are copied at once.
+    WorkerPoolClass pool;
+    std::atomic<int64_t> total(0);
 
-            while (size > BUFFER_SIZE) {
-                reader.Read(buffer, BUFFER_SIZE);
-                writer.Write(buffer, BUFFER_SIZE);
-                size -= BUFFER_SIZE;
-            }
+    pool.Init(jobs);
+    pool.Run(int(extract.size()), [&](int index) { total += Extract_File(extract[index]); });
 
-            if (size > 0) {
-                reader.Read(buffer, size);
-                writer.Write(buffer, size);
-            }
-        }
-    }
+    return total;
 }
+
 template <typename CRC>
 int Create_Mix(const char* outfile,
                unsigned alignment,
                MixNameDatabase* name_db = nullptr,
                const char* search_dir = nullptr,
                std::set<std::string>* files = nullptr,
-               const char* manifest = nullptr)
+               const char* manifest = nullptr,
+               int jobs = 1)
 {
     MixFileCreatorClass<RawFileClass, CRC> mc(outfile, alignment, Checksum, Encrypt, !Verbose, false, name_db);
+    mc.Set_Jobs(jobs);
     std::set<std::string> default_files;
     bool no_loose_files = false;
 
@@ -456,6 +457,7 @@ int main(int argc, char* argv[])
     int extracting = false;
     int listing = false;
     unsigned alignment = 1;
+    int jobs = 1;
     std::set<std::string> files;
 
     if (argc <= 1) {
@@ -481,6 +483,8 @@ int main(int argc, char* argv[])
             {"file", required_argument, 0, 'f'},
             {"directory", required_argument, 0, 'd'},
             {"manifest", required_argument, 0, 'm'},
+            {"jobs", required_argument, 0, 'j'},
+            {"timing", no_argument, 0, 't'},
             {"help", no_argument, 0, 'h'},
             {nullptr, no_argument, nullptr, 0},
         };
@@ -488,7 +492,7 @@ int main(int argc, char* argv[])
         int this_option_optind = optind ? optind : 1;
         int option_index = 0;
 
-        int c = getopt_long(args.ArgC, args.ArgV, "+chxelv?f:d:m:", long_options, &option_index);
+        int c = getopt_long(args.ArgC, args.ArgV, "+chxelvt?f:d:m:j:", long_options, &option_index);
 
         if (c == -1) {
             break;
@@ -528,6 +532,12 @@ int main(int argc, char* argv[])
         case 'm':
             manifest = optarg;
             break;
+        case 'j':
+            jobs = std::max(atoi(optarg), 0);
+            break;
+        case 't':
+            Timing = true;
+            break;
         case '?':
             printf("\nOption not recognised.\n");
             Print_Help();
@@ -549,24 +559,21 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    // Load the local mix name database and if one doesn't exist, start one.
+    // Load any names added on top of the built in ones, moving them over from the old text database the first time.
     Paths.Init("vanillatools");
     MixNameDatabase namedb;
-    bool prog_dir = false;
-    std::string user_db = std::string(Paths.User_Path()) + "/filenames.db";
-    std::string prog_db = std::string(Paths.Program_Path()) + "/filenames.db";
-    if (!namedb.Read_From_Ini(user_db.c_str())) {
-        if (!namedb.Read_From_Ini(prog_db.c_str())) {
-            // Saving the internal to the user directory by default so it will auto save any changes later on exit.
-            if (Verbose) {
-                printf("Failed to read file name database generating from internal db.\n");
-            }
-            namedb.Read_Internal();
-            namedb.Save_To_Ini(user_db.c_str());
-        } else {
-            prog_dir = true;
+    std::string user_db = std::string(Paths.User_Path()) + "/filenames.bin";
+    std::string prog_db = std::string(Paths.Program_Path()) + "/filenames.bin";
+    std::string old_db = std::string(Paths.User_Path()) + "/filenames.db";
+    namedb.Read_From_Binary(prog_db.c_str());
+    if (!namedb.Read_From_Binary(user_db.c_str()) && namedb.Read_From_Ini(old_db.c_str())) {
+        if (Verbose) {
+            printf("Moving file name database '%s' to '%s'.\n", old_db.c_str(), user_db.c_str());
         }
     }
+    namedb.Set_Save_Name(user_db.c_str());
+
+    auto start = std::chrono::steady_clock::now();
 
     if (create_file) {
         Init_Random();
@@ -578,12 +585,18 @@ int main(int argc, char* argv[])
             if (Verbose) {
                 printf("Creating CRC32 Mix file suitable for TS and RA2.\n");
             }
-            Create_Mix<CRC32Engine>(argv[argc - 1], alignment, &namedb, base_path, &files, manifest);
+            Create_Mix<CRC32Engine>(argv[argc - 1], alignment, &namedb, base_path, &files, manifest, jobs);
         } else {
             if (Verbose) {
                 printf("Creating C&C Hash Mix file suitable for TD and RA.\n");
             }
-            Create_Mix<CRCEngine>(argv[argc - 1], alignment, &namedb, base_path, &files, manifest);
+            Create_Mix<CRCEngine>(argv[argc - 1], alignment, &namedb, base_path, &files, manifest, jobs);
+        }
+
+        if (Timing) {
+            printf("Packed '%s' in %.3f seconds.\n",
+                   argv[argc - 1],
+                   std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
         }
     } else { // Extraction/listing mode.
         // Load any file names we got on the command line into the database.
@@ -601,12 +614,21 @@ int main(int argc, char* argv[])
         }
 
         if (extracting) {
+            int64_t total;
+
             if (UseCRC32) {
-                Extract_Mix<CRC32Engine>(
-                    argv[argc - 1], base_path, namedb, MixNameDatabase::HashMethod::HASH_CRC32, files);
+                total = Extract_Mix<CRC32Engine>(
+                    argv[argc - 1], base_path, namedb, MixNameDatabase::HashMethod::HASH_CRC32, files, jobs);
             } else {
-                Extract_Mix<CRCEngine>(
-                    argv[argc - 1], base_path, namedb, MixNameDatabase::HashMethod::HASH_RACRC, files);
+                total = Extract_Mix<CRCEngine>(
+                    argv[argc - 1], base_path, namedb, MixNameDatabase::HashMethod::HASH_RACRC, files, jobs);
+            }
+
+            if (Timing) {
+                printf("Extracted %lld bytes from '%s' in %.3f seconds.\n",
+                       (long long)total,
+                       argv[argc - 1],
+                       std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
             }
         }
     }
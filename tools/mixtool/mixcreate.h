@@ -24,10 +24,12 @@
 #include "pkpipe.h"
 #include "shapipe.h"
 #include "rndstraw.h"
+#include "workerpool.h"
 #include <string.h>
 #include <libgen.h>
 #include <strings.h>
 #include <algorithm>
+#include <vector>
 
 #ifndef PATH_MAX
 #define PATH_MAX MAX_PATH
@@ -125,6 +127,12 @@ public:
     void Add_File(char const* filename);
     void Write_Mix();
 
+    // Number of input files to read at once while writing the mix, 0 uses one per CPU.
+    void Set_Jobs(int jobs)
+    {
+        Jobs = jobs;
+    }
+
 private:
     // This helper is used for alignment.
     // If an alignment is passed that is not a power of two, the next largest power of 2 will be returned.
@@ -166,10 +174,15 @@ protected:
     bool IsEncrypted;
     bool ForceFlags;
     bool Quiet;
+    int Jobs;
     FileHeader Header;
 
 private:
-    int Write_File(char const* filename, Pipe* pipe);
+    // Limits on how much of the body is read into memory ahead of being written.
+    static const unsigned BATCH_FILES = 256;
+    static const unsigned BATCH_BYTES = 64 * 1024 * 1024;
+
+    static void Read_Whole_File(char const* filename, std::vector<uint8_t>& data);
 };
 
 template <typename TFC, typename TCRC> char MixFileCreatorClass<TFC, TCRC>::TempFilename[] = "makemix.mix";
@@ -198,6 +211,7 @@ MixFileCreatorClass<TFC, TCRC>::MixFileCreatorClass(char const* filename,
     , IsEncrypted(is_encrypted)
     , ForceFlags(force_flags)
     , Quiet(quiet)
+    , Jobs(1)
     , Header()
     , NameDatabase(name_db)
 {
@@ -340,17 +354,44 @@ template <typename TFC, typename TCRC> void MixFileCreatorClass<TFC, TCRC>::Writ
 
     // Loop through the file nodes and write the file data to the body of the
     // mix. These are written in the order they were added to the list, not the
-    // sorted order that the index must be written in.
-    for (FileDataNode* node = FileList.First(); node->Next() != nullptr; node = node->Next()) {
-        if (!Quiet) {
-            printf("Writing file %s\n", node->FilePath);
+    // sorted order that the index must be written in. The files are read in
+    // batches, several at a time, and each batch is then written out in order
+    // with one write per file so the mix is the same however many are read at once.
+    WorkerPoolClass pool;
+    pool.Init(Jobs);
+
+    std::vector<FileDataNode*> batch;
+    std::vector<std::vector<uint8_t>> data;
+    FileDataNode* node = FileList.First();
+
+    while (node->Next() != nullptr) {
+        unsigned batch_bytes = 0;
+        batch.clear();
+
+        while (node->Next() != nullptr && batch.size() < BATCH_FILES && batch_bytes < BATCH_BYTES) {
+            batch_bytes += le32toh(node->Entry.Size);
+            batch.push_back(node);
+            node = node->Next();
         }
 
-        bodysize += Write_File(node->FilePath, pipe_to_use);
+        data.resize(batch.size());
+        pool.Run(int(batch.size()), [&](int index) { Read_Whole_File(batch[index]->FilePath, data[index]); });
+
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (!Quiet) {
+                printf("Writing file %s\n", batch[i]->FilePath);
+            }
 
-        if (node->Padding != 0) {
-            DBG_INFO("Writing %u bytes of padding.", node->Padding);
-            bodysize += pipe_to_use->Put(padding, node->Padding);
+            if (!data[i].empty()) {
+                bodysize += pipe_to_use->Put(data[i].data(), int(data[i].size()));
+            }
+
+            if (batch[i]->Padding != 0) {
+                DBG_INFO("Writing %u bytes of padding.", batch[i]->Padding);
+                bodysize += pipe_to_use->Put(padding, batch[i]->Padding);
+            }
+
+            std::vector<uint8_t>().swap(data[i]);
         }
     }
 
@@ -369,24 +410,23 @@ template <typename TFC, typename TCRC> void MixFileCreatorClass<TFC, TCRC>::Writ
     }
 }
 
-template <typename TFC, typename TCRC> int MixFileCreatorClass<TFC, TCRC>::Write_File(const char* filename, Pipe* pipe)
+template <typename TFC, typename TCRC>
+void MixFileCreatorClass<TFC, TCRC>::Read_Whole_File(const char* filename, std::vector<uint8_t>& data)
 {
     TFC filereader(filename);
-    uint8_t buffer[1024];
     int data_read;
-    int total = 0;
+    size_t total = 0;
 
     filereader.Open(READ);
+    data.resize(std::max(filereader.Size(), 0));
 
-    // We loop through the file reading chunks into our buffer and then writing
-    // them to the destination pipe.
-    while ((data_read = filereader.Read(buffer, 1024)) > 0) {
-        total += pipe->Put(buffer, data_read);
+    // A file that can't be read in full only gets what could be read written for it.
+    while (total < data.size() && (data_read = filereader.Read(&data[total], int(data.size() - total))) > 0) {
+        total += data_read;
     }
 
+    data.resize(total);
     filereader.Close();
-
-    return total;
 }
 
 #endif // MIXCREATE_H
@@ -11,26 +11,98 @@
 // with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
 #include "mixnamedb.h"
 #include "debugstring.h"
+#include "endianness.h"
 #include "fastini.h"
 #include "rawfile.h"
-#include "ramfile.h"
 #include "crc.h"
 #include "crc32.h"
 #include <algorithm>
 #include <cstdio>
+#include <string.h>
+#include <strings.h>
+#include <vector>
+
+/*
+** Binary name database layout, all values little endian.
+**
+**   char     magic[4]      "MXNB"
+**   uint32_t version       1
+**   uint32_t count
+**   count entries of
+**     int32_t  ra_crc
+**     int32_t  ts_crc
+**     uint16_t name_length
+**     uint16_t desc_length
+**     char     name[name_length]
+**     char     desc[desc_length]
+*/
+static const char BinaryMagic[4] = {'M', 'X', 'N', 'B'};
+static const uint32_t BinaryVersion = 1;
+
+const MixNameDatabase::DefaultDataEntry* MixNameDatabase::Find_Builtin(int32_t hash, HashMethod crc_type)
+{
+    if (crc_type < 0 || crc_type >= HASH_COUNT || hash == 0) {
+        return nullptr;
+    }
 
-bool MixNameDatabase::Read_From_Ini(const char* ini_file)
+    const PerfectHash& table = s_builtinHash[crc_type];
+
+    if (table.slot_count == 0) {
+        return nullptr;
+    }
+
+    int32_t seed = table.seeds[Name_Hash(hash, 0) % table.seed_count];
+    uint32_t slot = seed < 0 ? uint32_t(-(seed + 1)) : Name_Hash(hash, seed) % table.slot_count;
+    const DefaultDataEntry* entry = &s_defaultDB[table.slots[slot]];
+
+    // Hashes that aren't in the table still land on a slot, so check it really is the one asked for.
+    if ((crc_type == HASH_RACRC ? entry->ra_crc : entry->ts_crc) != hash) {
+        return nullptr;
+    }
+
+    return entry;
+}
+
+bool MixNameDatabase::Add_Data(const DataEntry& entry)
 {
-    if (ini_file != nullptr) {
-        m_saveName = ini_file;
+    // If the file name exists, just ignore it and move on
+    if (m_nameMap.find(entry.file_name) != m_nameMap.end()) {
+        return false;
+    }
+
+    // Names the built in tables already know don't need keeping.
+    int32_t hashes[HASH_COUNT] = {entry.ra_crc, entry.ts_crc};
+    bool known = true;
+
+    for (int i = 0; i < HASH_COUNT; ++i) {
+        if (hashes[i] != 0) {
+            const DefaultDataEntry* builtin = Find_Builtin(hashes[i], HashMethod(i));
+
+            if (builtin == nullptr || strcasecmp(builtin->file_name, entry.file_name.c_str()) != 0
+                || (!entry.file_desc.empty() && entry.file_desc != builtin->file_desc)) {
+                known = false;
+            }
+        }
+    }
+
+    if (known) {
+        return false;
     }
 
-    if (ini_file == nullptr && m_saveName.empty()) {
+    m_nameMap[entry.file_name] = entry;
+    m_isMapDirty = true;
+
+    return true;
+}
+
+bool MixNameDatabase::Read_From_Ini(const char* ini_file)
+{
+    if (ini_file == nullptr) {
         return false;
     }
 
     FastINIClass ini;
-    RawFileClass fc(m_saveName.c_str());
+    RawFileClass fc(ini_file);
 
     if (ini.Load(fc) == 0) {
         return false;
@@ -46,50 +118,107 @@ bool MixNameDatabase::Read_From_Ini(const char* ini_file)
         tmp.ra_crc = ini.Get_Hex(node->Get_Name(), "CnCHash");
         tmp.ts_crc = ini.Get_Hex(node->Get_Name(), "CRC32Hash");
 
-        auto nameit = m_nameMap.find(tmp.file_name);
+        if (Add_Data(tmp)) {
+            m_isSaveNeeded = true;
+        }
+    }
 
-        // If the file name exists, just ignore it and move on
-        if (nameit == m_nameMap.end()) {
-            m_nameMap[tmp.file_name] = tmp;
-            m_isMapDirty = true;
+    return true;
+}
+
+bool MixNameDatabase::Read_From_Binary(const char* db_file)
+{
+    if (db_file == nullptr) {
+        return false;
+    }
+
+    RawFileClass fc(db_file);
+
+    if (!fc.Is_Available() || fc.Size() < int(sizeof(BinaryMagic) + sizeof(uint32_t) * 2)) {
+        return false;
+    }
+
+    std::vector<char> data(fc.Size());
+
+    if (fc.Read(data.data(), int(data.size())) != int(data.size())) {
+        return false;
+    }
+
+    uint32_t version;
+    uint32_t count;
+    memcpy(&version, &data[sizeof(BinaryMagic)], sizeof(version));
+    memcpy(&count, &data[sizeof(BinaryMagic) + sizeof(version)], sizeof(count));
+
+    if (memcmp(data.data(), BinaryMagic, sizeof(BinaryMagic)) != 0 || le32toh(version) != BinaryVersion) {
+        DBG_LOG("'%s' is not a name database.\n", db_file);
+        return false;
+    }
+
+    size_t pos = sizeof(BinaryMagic) + sizeof(version) + sizeof(count);
+
+    for (count = le32toh(count); count != 0; --count) {
+        DataEntry tmp;
+        uint16_t name_length;
+        uint16_t desc_length;
+
+        if (pos + sizeof(int32_t) * 2 + sizeof(uint16_t) * 2 > data.size()) {
+            break;
         }
+
+        memcpy(&tmp.ra_crc, &data[pos], sizeof(int32_t));
+        memcpy(&tmp.ts_crc, &data[pos + 4], sizeof(int32_t));
+        memcpy(&name_length, &data[pos + 8], sizeof(uint16_t));
+        memcpy(&desc_length, &data[pos + 10], sizeof(uint16_t));
+        tmp.ra_crc = le32toh(tmp.ra_crc);
+        tmp.ts_crc = le32toh(tmp.ts_crc);
+        name_length = le16toh(name_length);
+        desc_length = le16toh(desc_length);
+        pos += 12;
+
+        if (pos + name_length + desc_length > data.size()) {
+            break;
+        }
+
+        tmp.file_name.assign(&data[pos], name_length);
+        tmp.file_desc.assign(&data[pos + name_length], desc_length);
+        pos += name_length + desc_length;
+
+        Add_Data(tmp);
     }
 
-    if (m_isMapDirty) {
-        Regenerate_Hash_Maps();
-        m_isMapDirty = false;
+    if (count != 0) {
+        DBG_LOG("Name database '%s' is truncated.\n", db_file);
     }
 
     return true;
 }
 
-const MixNameDatabase::NameEntry& MixNameDatabase::Get_Entry(int32_t hash, HashMethod crc_type)
+MixNameDatabase::NameEntry MixNameDatabase::Get_Entry(int32_t hash, HashMethod crc_type)
 {
-    static const NameEntry _empty;
-
     // If additional name data has been added, the maps key'd on the filename hash need updating too.
     if (m_isMapDirty) {
         Regenerate_Hash_Maps();
         m_isMapDirty = false;
     }
 
-    if (crc_type != HASH_ANY) {
-        auto it = m_hashMaps[crc_type].find(hash);
+    int first = crc_type == HASH_ANY ? 0 : crc_type;
+    int last = crc_type == HASH_ANY ? HASH_COUNT - 1 : crc_type;
 
-        if (it != m_hashMaps[crc_type].end()) {
-            return it->second;
+    for (int i = first; i <= last; ++i) {
+        const DefaultDataEntry* builtin = Find_Builtin(hash, HashMethod(i));
+
+        if (builtin != nullptr) {
+            return {builtin->file_name, builtin->file_desc};
         }
-    } else {
-        for (int i = 0; i < HASH_COUNT; ++i) {
-            auto it = m_hashMaps[i].find(hash);
 
-            if (it != m_hashMaps[i].end()) {
-                return it->second;
-            }
+        auto it = m_hashMaps[i].find(hash);
+
+        if (it != m_hashMaps[i].end()) {
+            return {it->second->file_name, it->second->file_desc};
         }
     }
 
-    return _empty;
+    return {};
 }
 
 bool MixNameDatabase::Add_Entry(const char* file_name, const char* comment, HashMethod crc_type)
@@ -98,170 +227,131 @@ bool MixNameDatabase::Add_Entry(const char* file_name, const char* comment, Hash
     std::string name = tmp.file_name;
     std::transform(name.begin(), name.end(), name.begin(), ::toupper);
 
-    auto it = m_nameMap.find(tmp.file_name);
-
-    if (it == m_nameMap.end()) {
-        // If the name wasn't found then just add what we have for it.
-        m_nameMap[tmp.file_name] = tmp;
-        m_isMapDirty = true;
-        it = m_nameMap.find(tmp.file_name);
-    }
-
     switch (crc_type) {
     case HASH_RACRC: // Just add the C&C hash
-        if (it->second.ra_crc != 0) {
-            return false;
-        }
-
-        it->second.ra_crc = Calculate_CRC<CRCEngine>(name.c_str(), (unsigned)name.size());
-        m_isMapDirty = true;
+        tmp.ra_crc = Calculate_CRC<CRCEngine>(name.c_str(), (unsigned)name.size());
         break;
     case HASH_CRC32: // Just add the CRC32 hash.
-        if (it->second.ts_crc != 0) {
-            return false;
-        }
-
-        it->second.ts_crc = Calculate_CRC<CRC32Engine>(name.c_str(), (unsigned)name.size());
-        m_isMapDirty = true;
+        tmp.ts_crc = Calculate_CRC<CRC32Engine>(name.c_str(), (unsigned)name.size());
         break;
     case HASH_ANY: // add for all known hash methods.
-        if (it->second.ra_crc != 0 && it->second.ts_crc != 0) {
-            return false;
+        tmp.ra_crc = Calculate_CRC<CRCEngine>(name.c_str(), (unsigned)name.size());
+        tmp.ts_crc = Calculate_CRC<CRC32Engine>(name.c_str(), (unsigned)name.size());
+        break;
+    default:
+        DBG_LOG("Requested unhandled hash method.");
+        return false;
+    }
+
+    auto it = m_nameMap.find(tmp.file_name);
+
+    // If the name is already known just fill in any hashes it is missing.
+    if (it != m_nameMap.end()) {
+        bool added = false;
+
+        if (tmp.ra_crc != 0 && it->second.ra_crc == 0) {
+            it->second.ra_crc = tmp.ra_crc;
+            added = true;
         }
-        if (it->second.ra_crc == 0) {
-            it->second.ra_crc = Calculate_CRC<CRCEngine>(name.c_str(), (unsigned)name.size());
-            m_isMapDirty = true;
+
+        if (tmp.ts_crc != 0 && it->second.ts_crc == 0) {
+            it->second.ts_crc = tmp.ts_crc;
+            added = true;
         }
 
-        if (it->second.ts_crc == 0) {
-            it->second.ts_crc = Calculate_CRC<CRC32Engine>(name.c_str(), (unsigned)name.size());
+        if (added) {
             m_isMapDirty = true;
+            m_isSaveNeeded = true;
         }
 
-        break;
-    default:
-        DBG_LOG("Requested unhandled hash method.");
+        return added;
+    }
+
+    if (!Add_Data(tmp)) {
         return false;
     }
 
+    m_isSaveNeeded = true;
     return true;
 }
 
 void MixNameDatabase::Regenerate_Hash_Maps()
 {
+    for (int i = 0; i < HASH_COUNT; ++i) {
+        m_hashMaps[i].clear();
+    }
+
     for (auto it = m_nameMap.begin(); it != m_nameMap.end(); ++it) {
-        if (it->second.ra_crc != 0) {
-            // Check for collisions and null out the crc and remove the entry from the respective map.
-            auto rait = m_hashMaps[HASH_RACRC].find(it->second.ra_crc);
-
-            if (rait != m_hashMaps[HASH_RACRC].end()) {
-                // If the name matches the hash map already has this entry.
-                if (rait->second.file_name != it->second.file_name) {
-                    DBG_LOG("Hash collision, '%s' hashes to same value as '%s' with HashMethod C&C Hash. File name "
-                            "ignored.\n",
-                            it->second.file_name.c_str(),
-                            rait->second.file_name.c_str());
-                    it->second.ra_crc = 0;
-                }
-            } else {
-                m_hashMaps[HASH_RACRC][it->second.ra_crc] = {it->second.file_name, it->second.file_desc};
+        int32_t hashes[HASH_COUNT] = {it->second.ra_crc, it->second.ts_crc};
+
+        for (int i = 0; i < HASH_COUNT; ++i) {
+            if (hashes[i] == 0) {
+                continue;
             }
-        }
 
-        if (it->second.ts_crc != 0) {
-            // Check for collisions and null out the crc and remove the entry from the respective map.
-            auto tsit = m_hashMaps[HASH_CRC32].find(it->second.ts_crc);
+            // Check for collisions, the built in names and then the first name in order keep the hash.
+            const DefaultDataEntry* builtin = Find_Builtin(hashes[i], HashMethod(i));
+            const char* other = nullptr;
 
-            if (tsit != m_hashMaps[HASH_CRC32].end()) {
-                // If the name matches the hash map already has this entry.
-                if (tsit->second.file_name != it->second.file_name) {
-                    DBG_LOG(
-                        "Hash collision, '%s' hashes to same value as '%s' with HashMethod CRC32. File name ignored.\n",
-                        it->second.file_name.c_str(),
-                        tsit->second.file_name.c_str());
-                    it->second.ts_crc = 0;
-                }
+            if (builtin != nullptr) {
+                other = builtin->file_name;
             } else {
-                m_hashMaps[HASH_CRC32][it->second.ts_crc] = {it->second.file_name, it->second.file_desc};
-            }
-        }
-    }
-}
+                auto found = m_hashMaps[i].find(hashes[i]);
 
-void MixNameDatabase::Get_String(FileClass& fc, std::string& dst)
-{
-    char c;
-    dst = "";
+                if (found == m_hashMaps[i].end()) {
+                    m_hashMaps[i][hashes[i]] = &it->second;
+                    continue;
+                }
 
-    // Get the string.
-    while (true) {
-        if (fc.Read(&c, sizeof(c)) != sizeof(c)) {
-            return;
-        }
+                other = found->second->file_name.c_str();
+            }
 
-        if (c == '\0') {
-            return;
+            if (strcasecmp(other, it->second.file_name.c_str()) != 0) {
+                DBG_LOG("Hash collision, '%s' hashes to same value as '%s' with HashMethod %s. File name ignored.\n",
+                        it->second.file_name.c_str(),
+                        other,
+                        i == HASH_RACRC ? "C&C Hash" : "CRC32");
+            }
         }
-
-        dst += c;
     }
 }
 
-void MixNameDatabase::Read_Internal()
+void MixNameDatabase::Save_To_Binary(const char* db_file)
 {
-    const DefaultDataEntry* data = s_defaultDB;
-
-    while (data->file_name[0] != '\0') {
-        DataEntry tmp;
-        tmp.file_name = data->file_name;
-        tmp.file_desc = data->file_desc;
-        tmp.ra_crc = data->ra_crc;
-        tmp.ts_crc = data->ts_crc;
-        m_nameMap[tmp.file_name] = tmp;
-        ++data;
+    if (db_file != nullptr) {
+        m_saveName = db_file;
     }
 
-    if (m_isMapDirty) {
-        Regenerate_Hash_Maps();
-        m_isMapDirty = false;
-    }
-}
-
-void MixNameDatabase::Save_To_Ini(const char* ini_file)
-{
-    if (ini_file != nullptr) {
-        m_saveName = ini_file;
-    }
-
-    if (ini_file == nullptr && m_saveName.empty()) {
+    if (m_saveName.empty()) {
         return;
     }
 
-    // faster to skip building the ini class and then saving and just write the file direct.
-    FILE* fp = std::fopen(m_saveName.c_str(), "w");
+    FILE* fp = std::fopen(m_saveName.c_str(), "wb");
 
     if (fp == nullptr) {
         return;
     }
 
-    // TODO: This currently saves in file name order, we may want alternate sorts.
-    for (auto it = m_nameMap.begin(); it != m_nameMap.end(); ++it) {
-        fprintf(fp, "[%s]\n", it->second.file_name.c_str());
+    uint32_t version = htole32(BinaryVersion);
+    uint32_t count = htole32(uint32_t(m_nameMap.size()));
+    fwrite(BinaryMagic, sizeof(BinaryMagic), 1, fp);
+    fwrite(&version, sizeof(version), 1, fp);
+    fwrite(&count, sizeof(count), 1, fp);
 
-        if (!it->second.file_desc.empty()) {
-            fprintf(fp, "Comment=%s\n", it->second.file_desc.c_str());
-        }
-
-        if (it->second.ra_crc != 0) {
-            fprintf(fp, "CnCHash=%08X\n", it->second.ra_crc);
-        }
-
-        if (it->second.ts_crc != 0) {
-            fprintf(fp, "CRC32Hash=%08X\n", it->second.ts_crc);
-        }
-
-        fprintf(fp, "\n");
+    for (auto it = m_nameMap.begin(); it != m_nameMap.end(); ++it) {
+        int32_t ra_crc = htole32(it->second.ra_crc);
+        int32_t ts_crc = htole32(it->second.ts_crc);
+        uint16_t name_length = htole16(uint16_t(std::min<size_t>(it->second.file_name.size(), UINT16_MAX)));
+        uint16_t desc_length = htole16(uint16_t(std::min<size_t>(it->second.file_desc.size(), UINT16_MAX)));
+
+        fwrite(&ra_crc, sizeof(ra_crc), 1, fp);
+        fwrite(&ts_crc, sizeof(ts_crc), 1, fp);
+        fwrite(&name_length, sizeof(name_length), 1, fp);
+        fwrite(&desc_length, sizeof(desc_length), 1, fp);
+        fwrite(it->second.file_name.data(), le16toh(name_length), 1, fp);
+        fwrite(it->second.file_desc.data(), le16toh(desc_length), 1, fp);
     }
 
     fclose(fp);
+    m_isSaveNeeded = false;
 }
@@ -13,10 +13,17 @@
 #define MIXNAMEDB_H
 
 #include <map>
+#include <stdint.h>
 #include <string>
+#include <string_view>
 
 class FileClass;
 
+/*
+ * Looks up file names from the hashes mix files store them as. The built in names are found through
+ * minimal perfect hash tables generated from mixnamedb_data.cpp when the tools are built, so they
+ * cost nothing to set up. Names added on top of those are kept in a compact binary database.
+ */
 class MixNameDatabase
 {
 public:
@@ -30,8 +37,8 @@ public:
 
     struct NameEntry
     {
-        std::string file_name;
-        std::string file_desc;
+        std::string_view file_name;
+        std::string_view file_desc;
     };
 
     struct DataEntry
@@ -51,32 +58,70 @@ public:
     };
 
     MixNameDatabase()
-        : m_isMapDirty(true)
+        : m_isMapDirty(false)
+        , m_isSaveNeeded(false)
     {
     }
 
     ~MixNameDatabase()
     {
-        Save_To_Ini();
-    } // Write the file to the configured file name.
+        if (m_isSaveNeeded) {
+            Save_To_Binary();
+        }
+    } // Write any added names to the configured file name.
 
     bool Read_From_Ini(const char* ini_file);
-    void Read_Internal();
-    const NameEntry& Get_Entry(int32_t hash, HashMethod crc_type = HASH_ANY);
+    bool Read_From_Binary(const char* db_file);
+    NameEntry Get_Entry(int32_t hash, HashMethod crc_type = HASH_ANY);
     bool Add_Entry(const char* file_name, const char* comment, HashMethod crc_type = HASH_ANY);
-    void Save_To_Ini(const char* ini_file = nullptr);
+    void Save_To_Binary(const char* db_file = nullptr);
+
+    void Set_Save_Name(const char* db_file)
+    {
+        m_saveName = db_file;
+    }
+
+    // Hash used to pick the bucket and slot in the built in tables, shared with mixnamedbgen.
+    static uint32_t Name_Hash(uint32_t key, uint32_t seed)
+    {
+        key ^= seed * 0x9E3779B9u;
+        key ^= key >> 16;
+        key *= 0x85EBCA6Bu;
+        key ^= key >> 13;
+        key *= 0xC2B2AE35u;
+        key ^= key >> 16;
+
+        return key;
+    }
+
+    // The built in names, ending with an entry with an empty name.
+    static const DefaultDataEntry s_defaultDB[];
 
 private:
+    struct PerfectHash
+    {
+        const int32_t* seeds;
+        uint32_t seed_count;
+        const uint16_t* slots;
+        uint32_t slot_count;
+    };
+
     void Regenerate_Hash_Maps();
-    static void Get_String(FileClass& fc, std::string& dst);
+    bool Add_Data(const DataEntry& entry);
+    static const DefaultDataEntry* Find_Builtin(int32_t hash, HashMethod crc_type);
 
 private:
-    std::map<int, NameEntry> m_hashMaps[HASH_COUNT];
+    std::map<int32_t, const DataEntry*> m_hashMaps[HASH_COUNT];
     std::map<std::string, DataEntry> m_nameMap;
     std::string m_saveName;
     bool m_isMapDirty;
+    bool m_isSaveNeeded;
 
-    static const DefaultDataEntry s_defaultDB[];
+    static const int32_t s_raCRCSeeds[];
+    static const uint16_t s_raCRCSlots[];
+    static const int32_t s_crc32Seeds[];
+    static const uint16_t s_crc32Slots[];
+    static const PerfectHash s_builtinHash[HASH_COUNT];
 };
 
 #endif
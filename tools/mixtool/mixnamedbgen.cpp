@@ -0,0 +1,207 @@
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is free
+// software: you can redistribute it and/or modify it under the terms of
+// the GNU General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+
+// TiberianDawn.DLL and RedAlert.dll and corresponding source code is distributed
+// in the hope that it will be useful, but with permitted additional restrictions
+// under Section 7 of the GPL. See the GNU General Public License in LICENSE.TXT
+// distributed with this program. You should have received a copy of the
+// GNU General Public License along with permitted additional restrictions
+// with this program. If not, see https://github.com/electronicarts/CnC_Remastered_Collection
+
+/*
+ * Generates the minimal perfect hash tables that map each hash method's file name hashes to the
+ * built in name database entries, run as part of the build so the tables always match
+ * mixnamedb_data.cpp.
+ *
+ * The keys are split into buckets, then starting with the fullest bucket a seed is searched for
+ * that sends every key in it to a free slot. Buckets holding a single key are placed directly
+ * into one of the slots left over, so there are exactly as many slots as keys.
+ */
+#include "mixnamedb.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+struct KeyType
+{
+    uint32_t hash;
+    int index;
+};
+
+static bool Build_Table(const std::vector<KeyType>& keys, std::vector<int32_t>& seeds, std::vector<uint16_t>& slots)
+{
+    uint32_t count = uint32_t(keys.size());
+    uint32_t bucket_count = std::max(1u, (count + 3) / 4);
+    std::vector<std::vector<KeyType>> buckets(bucket_count);
+    std::vector<bool> used(count, false);
+    std::vector<uint32_t> tried;
+
+    seeds.assign(bucket_count, 0);
+    slots.assign(count, 0);
+
+    for (const KeyType& key : keys) {
+        buckets[MixNameDatabase::Name_Hash(key.hash, 0) % bucket_count].push_back(key);
+    }
+
+    std::vector<uint32_t> order(bucket_count);
+
+    for (uint32_t i = 0; i < bucket_count; ++i) {
+        order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    uint32_t next_free = 0;
+
+    for (uint32_t b : order) {
+        const std::vector<KeyType>& bucket = buckets[b];
+
+        if (bucket.empty()) {
+            break;
+        }
+
+        if (bucket.size() == 1) {
+            while (used[next_free]) {
+                ++next_free;
+            }
+
+            used[next_free] = true;
+            slots[next_free] = uint16_t(bucket[0].index);
+            seeds[b] = -int32_t(next_free) - 1;
+            continue;
+        }
+
+        for (int32_t seed = 1;; ++seed) {
+            if (seed == INT32_MAX) {
+                return false;
+            }
+
+            tried.clear();
+
+            for (const KeyType& key : bucket) {
+                uint32_t slot = MixNameDatabase::Name_Hash(key.hash, seed) % count;
+
+                if (used[slot] || std::find(tried.begin(), tried.end(), slot) != tried.end()) {
+                    break;
+                }
+
+                tried.push_back(slot);
+            }
+
+            if (tried.size() == bucket.size()) {
+                for (size_t i = 0; i < bucket.size(); ++i) {
+                    used[tried[i]] = true;
+                    slots[tried[i]] = uint16_t(bucket[i].index);
+                }
+
+                seeds[b] = seed;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename T> static void Write_Array(FILE* fp, const char* type, const char* name, const std::vector<T>& data)
+{
+    fprintf(fp, "const %s MixNameDatabase::%s[] = {", type, name);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        fprintf(fp, "%s%d,", (i % 16) == 0 ? "\n    " : " ", int(data[i]));
+    }
+
+    // Keep the array from being empty if the database ever is.
+    fprintf(fp, "%s\n};\n\n", data.empty() ? "\n    0," : "");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "Usage: mixnamedbgen <output.cpp>\n");
+        return 1;
+    }
+
+    /*
+    ** Entries are taken the way the text database was read, a later entry replaces an earlier
+    ** one with the same name and where names collide on a hash the first by name keeps it.
+    */
+    std::map<std::string, int> names;
+
+    for (int i = 0; MixNameDatabase::s_defaultDB[i].file_name[0] != '\0'; ++i) {
+        names[MixNameDatabase::s_defaultDB[i].file_name] = i;
+    }
+
+    if (names.size() > UINT16_MAX) {
+        fprintf(stderr, "mixnamedbgen: too many names for 16 bit slots.\n");
+        return 1;
+    }
+
+    std::vector<KeyType> keys[MixNameDatabase::HASH_COUNT];
+    std::map<uint32_t, int> seen[MixNameDatabase::HASH_COUNT];
+
+    for (auto& it : names) {
+        const MixNameDatabase::DefaultDataEntry& entry = MixNameDatabase::s_defaultDB[it.second];
+        uint32_t hashes[MixNameDatabase::HASH_COUNT] = {uint32_t(entry.ra_crc), uint32_t(entry.ts_crc)};
+
+        for (int m = 0; m < MixNameDatabase::HASH_COUNT; ++m) {
+            if (hashes[m] != 0 && seen[m].find(hashes[m]) == seen[m].end()) {
+                seen[m][hashes[m]] = it.second;
+                keys[m].push_back({hashes[m], it.second});
+            }
+        }
+    }
+
+    FILE* fp = fopen(argv[1], "w");
+
+    if (fp == nullptr) {
+        fprintf(stderr, "mixnamedbgen: couldn't open '%s' for writing.\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(fp, "// Generated by mixnamedbgen from mixnamedb_data.cpp, do not edit.\n");
+    fprintf(fp, "#include \"mixnamedb.h\"\n\n");
+
+    static const char* const prefixes[MixNameDatabase::HASH_COUNT] = {"s_raCRC", "s_crc32"};
+    uint32_t counts[MixNameDatabase::HASH_COUNT][2];
+
+    for (int m = 0; m < MixNameDatabase::HASH_COUNT; ++m) {
+        std::vector<int32_t> seeds;
+        std::vector<uint16_t> slots;
+
+        if (!Build_Table(keys[m], seeds, slots)) {
+            fprintf(stderr, "mixnamedbgen: no perfect hash found.\n");
+            fclose(fp);
+            return 1;
+        }
+
+        std::string seed_name = std::string(prefixes[m]) + "Seeds";
+        std::string slot_name = std::string(prefixes[m]) + "Slots";
+        Write_Array(fp, "int32_t", seed_name.c_str(), seeds);
+        Write_Array(fp, "uint16_t", slot_name.c_str(), slots);
+        counts[m][0] = uint32_t(seeds.size());
+        counts[m][1] = uint32_t(slots.size());
+    }
+
+    fprintf(fp, "const MixNameDatabase::PerfectHash MixNameDatabase::s_builtinHash[HASH_COUNT] = {\n");
+
+    for (int m = 0; m < MixNameDatabase::HASH_COUNT; ++m) {
+        fprintf(fp,
+                "    {%sSeeds, %uu, %sSlots, %uu},\n",
+                prefixes[m],
+                unsigned(counts[m][0]),
+                prefixes[m],
+                unsigned(counts[m][1]));
+    }
+
+    fprintf(fp, "};\n");
+    fclose(fp);
+
+    return 0;
+}